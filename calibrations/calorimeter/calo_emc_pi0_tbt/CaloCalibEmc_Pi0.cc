@@ -26,9 +26,15 @@
 #include <TH3.h>
 #include <TLorentzVector.h>
 #include <TNtuple.h>
+#include <TROOT.h>
 #include <TStyle.h>
 #include <TSystem.h>
 #include <TTree.h>
+#include <TVector2.h>
+
+#include <Math/MinimizerOptions.h>
+
+#include <omp.h>
 
 #include <CLHEP/Vector/ThreeVector.h>  // for Hep3Vector
 
@@ -40,6 +46,185 @@
 #include <utility>  // for pair
 #include <vector>   // for vector
 
+namespace
+{
+  // cluster kinematics for the pair loops, replaces one heap allocated
+  // TLorentzVector per cluster and event
+  struct ClusterKin
+  {
+    double pt{0};
+    double eta{0};
+    double phi{0};
+    double E{0};
+    double px{0};
+    double py{0};
+    double pz{0};
+  };
+
+  ClusterKin makeClusterKin(const double pt, const double eta, const double phi, const double E)
+  {
+    return {pt, eta, phi, E, pt * std::cos(phi), pt * std::sin(phi), pt * std::sinh(eta)};
+  }
+
+  // squared opening angle, compare against cut*cut to avoid the sqrt
+  double deltaR2(const ClusterKin &c1, const ClusterKin &c2)
+  {
+    const double deta = c1.eta - c2.eta;
+    const double dphi = TVector2::Phi_mpi_pi(c1.phi - c2.phi);
+    return deta * deta + dphi * dphi;
+  }
+
+  double pairPt(const ClusterKin &c1, const ClusterKin &c2)
+  {
+    return std::hypot(c1.px + c2.px, c1.py + c2.py);
+  }
+
+  // same convention as TLorentzVector::M()
+  double pairMass(const ClusterKin &c1, const ClusterKin &c2)
+  {
+    const double e = c1.E + c2.E;
+    const double px = c1.px + c2.px;
+    const double py = c1.py + c2.py;
+    const double pz = c1.pz + c2.pz;
+    const double m2 = e * e - px * px - py * py - pz * pz;
+    return (m2 < 0) ? -std::sqrt(-m2) : std::sqrt(m2);
+  }
+
+  // one pair mass for the tower by tower and eta slice calibration
+  struct TowerPair
+  {
+    int ieta{0};
+    int iphi{0};
+    float mass{0};
+  };
+
+  // pairs of one event for Loop_for_eta_slices. Only reads the event clusters,
+  // so that events can be processed concurrently
+  void buildEtaSlicePairs(const ClusterKin *clus, const std::pair<int, int> *towers, const int nclus, std::vector<TowerPair> &pairs)
+  {
+    for (int jCs = 0; jCs < nclus; jCs++)
+    {
+      const ClusterKin &pho1 = clus[jCs];
+
+      if (std::abs(pho1.pt) < 1.0)
+      {
+        continue;
+      }
+
+      // another loop to go into the saved cluster
+      for (int kCs = 0; kCs < nclus; kCs++)
+      {
+        if (jCs == kCs)
+        {
+          continue;
+        }
+
+        const ClusterKin &pho2 = clus[kCs];
+
+        if (std::abs(pho2.pt) < 0.6)
+        {
+          continue;
+        }
+
+        // cheap cuts first, the pair kinematics only for surviving pairs
+        const float alpha = std::abs((pho1.E - pho2.E) / (pho1.E + pho2.E));
+        if (alpha > 0.50)
+        {
+          continue;  // 0.50 to begin with
+        }
+
+        if (deltaR2(pho1, pho2) > 0.45 * 0.45)
+        {
+          continue;
+        }
+
+        if (pairPt(pho1, pho2) < 1.0)
+        {
+          continue;
+        }
+        pairs.push_back({towers[jCs].first, towers[jCs].second, static_cast<float>(pairMass(pho1, pho2))});
+      }
+    }
+  }
+
+  struct TowerFitResult
+  {
+    bool has_hist{false};
+    bool ok{false};
+    float pkloc{0};
+    float fpkloc2{0};
+    double mean{-999.};
+    double mean_err{-999.};
+    TGraphErrors *bkg{nullptr};
+  };
+
+  // gaus + pol2 fit of one tower mass histogram, touches nothing but the
+  // histogram and the objects it creates so towers can be fitted concurrently
+  void fitTowerMass(TH1 *hist, const std::string &bkgname, const std::string &extraopt, TowerFitResult &result)
+  {
+    result.has_hist = true;
+
+    //  find max bin around peak
+    float pkloc = 0.0;
+    float bsavloc = 0.0;
+    for (int kfi = 1; kfi < 20; kfi++)  // old kfi<25
+    {
+      float locbv = hist->GetBinContent(kfi);
+      if (locbv > bsavloc)
+      {
+        pkloc = hist->GetBinCenter(kfi);
+        bsavloc = locbv;
+      }
+    }
+
+    TF1 f1("f1", "gaus", 0.06, 0.20);  //"gaus",pkloc-0.03,pkloc+0.03
+    TF1 f2("f2", "pol2", 0.01, 0.4);
+
+    hist->Fit(&f1, extraopt.c_str(), "", pkloc - 0.04, pkloc + 0.04);
+    float fpkloc2 = f1.GetParameter(1);
+
+    TGraphErrors *grtemp = new TGraphErrors();
+    grtemp->SetName(bkgname.c_str());
+    int ingr = 0;
+    for (int gj = 1; gj < hist->GetNbinsX() + 1; gj++)
+    {
+      float binc = hist->GetBinCenter(gj);
+      float cntc = hist->GetBinContent(gj);
+      if ((binc > 0.06 * fpkloc2 / 0.145 && binc < 0.09 * fpkloc2 / 0.145) || (binc > 0.22 * fpkloc2 / 0.145 && binc < 0.35 * fpkloc2 / 0.145))
+      {
+        grtemp->SetPoint(ingr, binc, cntc);
+        grtemp->SetPointError(ingr++, 0.001, std::sqrt(cntc));
+      }
+    }
+
+    grtemp->Fit(&f2, extraopt.c_str());
+
+    TF1 total("total", "gaus(0)+pol2(3)", 0.06, 0.25);  // 0.3*fpkloc2/0.145
+
+    double par[6];
+
+    f1.GetParameters(&par[0]);
+    f2.GetParameters(&par[3]);
+
+    total.SetParameters(par);
+    total.SetParLimits(2, 0.01, 0.027);
+
+    hist->Fit(&total, ("R" + extraopt).c_str());
+    TF1 *fit_fn = hist->GetFunction("total");
+
+    result.pkloc = pkloc;
+    result.fpkloc2 = fpkloc2;
+    result.bkg = grtemp;
+    if (fit_fn)
+    {
+      result.ok = true;
+      result.mean = fit_fn->GetParameter(1);
+      result.mean_err = fit_fn->GetParError(1);
+    }
+  }
+
+}  // namespace
+
 //____________________________________________________________________________..
 CaloCalibEmc_Pi0::CaloCalibEmc_Pi0(const std::string &name, const std::string &filename)
   : SubsysReco(name)
@@ -373,7 +558,7 @@ int CaloCalibEmc_Pi0::process_event(PHCompositeNode *topNode)
               //  mass_eta_phi->Fill(pairInvMass, tt_clus_eta, tt_clus_phi);
 
               // fill the tower by tower histograms with invariant mass
-              cemc_hist_eta_phi.at(maxTowerEta).at(maxTowerPhi)->Fill(pairInvMass);
+              m_massbank.Fill(maxTowerEta, maxTowerPhi, pairInvMass);
               eta_hist.at(maxTowerEta)->Fill(pairInvMass);
             }
           }
@@ -406,6 +591,8 @@ int CaloCalibEmc_Pi0::End(PHCompositeNode *topNode)
   }
 
   cal_output->cd();
+  // tower by tower mass histograms as one mergeable object
+  m_massbank.MakeTH2("h_mass_tower");
   //	_eventTree->Write();
   cal_output->Write();
   cal_output->Close();
@@ -496,9 +683,10 @@ void CaloCalibEmc_Pi0::Loop(int nevts, const std::string &filename, TTree *intre
   t1->SetBranchAddress("_maxTowerEtas", _maxTowerEtas);
   t1->SetBranchAddress("_maxTowerPhis", _maxTowerPhis);
 
-  // pre-loop to save all the clusters LorentzVector
+  // pre-loop to save all the clusters kinematics
 
-  TLorentzVector *savClusLV[10000];
+  std::vector<ClusterKin> savClus;
+  savClus.reserve(1000);
 
   //  int nEntries = (int) t1->GetEntriesFast();
   int nEntries = (int) t1->GetEntries();
@@ -536,6 +724,7 @@ void CaloCalibEmc_Pi0::Loop(int nevts, const std::string &filename, TTree *intre
     float pt1cut = 0;
     float pt2cut = 0;
 
+    savClus.clear();
     for (int j = 0; j < nClusters; j++)
     {
       // float px, py, pz;
@@ -567,16 +756,13 @@ void CaloCalibEmc_Pi0::Loop(int nevts, const std::string &filename, TTree *intre
       pt *= aggcv;
       E *= aggcv;
 
-      savClusLV[j] = new TLorentzVector();
-      savClusLV[j]->SetPtEtaPhiE(pt, eta, phi, E);
+      savClus.push_back(makeClusterKin(pt, eta, phi, E));
     }
 
-    TLorentzVector *pho1;
-    TLorentzVector *pho2;
     int iCs = nClusters;
     for (int jCs = 0; jCs < iCs; jCs++)
     {
-      pho1 = savClusLV[jCs];
+      const ClusterKin &pho1 = savClus[jCs];
       /////////////////////////////////////////////////////////////////
       //////////////////////////////////////////////////////
       // *********************************
@@ -629,12 +815,13 @@ void CaloCalibEmc_Pi0::Loop(int nevts, const std::string &filename, TTree *intre
       ///////////////////////////////////////
       /////////////////////////////////////
 
-      if (std::abs(pho1->Pt()) < pt1cut)
+      if (std::abs(pho1.pt) < pt1cut)
       {
         continue;
       }
 
       // another loop to go into the saved cluster
+      // the cheap cuts (pt, asymmetry, opening angle) come before the pair kinematics
       for (int kCs = 0; kCs < iCs; kCs++)
       {
         if (jCs == kCs)
@@ -642,37 +829,35 @@ void CaloCalibEmc_Pi0::Loop(int nevts, const std::string &filename, TTree *intre
           continue;
         }
 
-        pho2 = savClusLV[kCs];
+        const ClusterKin &pho2 = savClus[kCs];
 
-        if (std::abs(pho2->Pt()) < pt2cut)
+        if (std::abs(pho2.pt) < pt2cut)
         {
           continue;
         }
 
-        alphaCut = std::abs((pho1->E() - pho2->E()) / (pho1->E() + pho2->E()));
+        alphaCut = std::abs((pho1.E - pho2.E) / (pho1.E + pho2.E));
 
         if (alphaCut > alphacutval)
         {
           continue;
         }
 
-        TLorentzVector pi0lv;
-
-        if (pho1->DeltaR(*pho2) > deltaRconecut)
+        if (deltaR2(pho1, pho2) > deltaRconecut * deltaRconecut)
         {
           continue;
         }
 
-        pi0lv = *pho1 + *pho2;
-        if (std::abs(pi0lv.Pt()) > pi0ptcut)
+        float pi0pt = pairPt(pho1, pho2);
+        if (pi0pt > pi0ptcut)
         {
-          float pairInvMass = pi0lv.M();
+          float pairInvMass = pairMass(pho1, pho2);
 
           // fill the tower by tower histograms with invariant mass
           // cemc_hist_eta_phi[_maxTowerEtas[jCs]][_maxTowerPhis[jCs]]->Fill(pairInvMass);
           // not useful in summer 23 data
           eta_hist.at(_maxTowerEtas[jCs])->Fill(pairInvMass);
-          pt1_ptpi0_alpha->Fill(pho1->Pt(), pi0lv.Pt(), alphaCut);
+          pt1_ptpi0_alpha->Fill(pho1.pt, pi0pt, alphaCut);
           pairInvMassTotal->Fill(pairInvMass);
           mass_eta->Fill(pairInvMass, _clusterEtas[jCs]);
           mass_eta_phi->Fill(pairInvMass, _clusterEtas[jCs], _clusterPhis[jCs]);
@@ -758,9 +943,53 @@ void CaloCalibEmc_Pi0::Loop_for_eta_slices(int nevts, const std::string &filenam
   t1->SetBranchAddress("_maxTowerEtas", _maxTowerEtas);
   t1->SetBranchAddress("_maxTowerPhis", _maxTowerPhis);
 
-  // pre-loop to save all the clusters LorentzVector
+  // events are read serially in batches. The pairs of a batch are built in parallel into
+  // thread local fill buffers, which are then flushed in event order into the mass bank
+  // and the eta slices, so that the output does not depend on the number of threads
+  const int nthreads = (m_fill_threads > 0) ? m_fill_threads : omp_get_max_threads();
+  constexpr int batchsize = 10000;
 
-  std::array<TLorentzVector *, 10000> savClusLV{};
+  // cluster kinematics and max tower of all events of the batch
+  std::vector<ClusterKin> batchClus;
+  std::vector<std::pair<int, int>> batchTowers;
+  std::vector<size_t> batchOffsets{0};
+  batchClus.reserve(batchsize * 10);
+  batchTowers.reserve(batchsize * 10);
+  batchOffsets.reserve(batchsize + 1);
+
+  std::vector<std::vector<TowerPair>> fillBuffers(nthreads);
+
+  auto processBatch = [&]()
+  {
+    const int nbatch = batchOffsets.size() - 1;
+#pragma omp parallel num_threads(nthreads)
+    {
+      // static scheduling gives each thread a contiguous range of events, in thread order
+      auto &buffer = fillBuffers[omp_get_thread_num()];
+#pragma omp for schedule(static)
+      for (int iev = 0; iev < nbatch; iev++)
+      {
+        const size_t first = batchOffsets[iev];
+        buildEtaSlicePairs(&batchClus[first], &batchTowers[first], batchOffsets[iev + 1] - first, buffer);
+      }
+    }
+
+    for (auto &buffer : fillBuffers)
+    {
+      for (const auto &pair : buffer)
+      {
+        // fill the tower by tower mass bank and the eta slices
+        m_massbank.Fill(pair.ieta, pair.iphi, pair.mass);
+        eta_hist.at(pair.ieta)->Fill(pair.mass);
+        // pt1_ptpi0_alpha->Fill(pho1->Pt(), pi0lv.Pt(), alphaCut);
+      }
+      buffer.clear();
+    }
+
+    batchClus.clear();
+    batchTowers.clear();
+    batchOffsets.resize(1);
+  };
 
   //  int nEntries = (int) t1->GetEntriesFast();
   int nEntries = (int) t1->GetEntries();
@@ -806,80 +1035,17 @@ void CaloCalibEmc_Pi0::Loop_for_eta_slices(int nevts, const std::string &filenam
       pt *= aggcv;
       E *= aggcv;
 
-      savClusLV.at(j) = new TLorentzVector();
-      savClusLV.at(j)->SetPtEtaPhiE(pt, eta, phi, E);
+      batchClus.push_back(makeClusterKin(pt, eta, phi, E));
+      batchTowers.emplace_back(_maxTowerEtas[j], _maxTowerPhis[j]);
     }
+    batchOffsets.push_back(batchClus.size());
 
-    TLorentzVector *pho1;
-    TLorentzVector *pho2;
-    int iCs = nClusters;
-    for (int jCs = 0; jCs < iCs; jCs++)
+    if (static_cast<int>(batchOffsets.size()) > batchsize)
     {
-      pho1 = savClusLV.at(jCs);
-
-      if (std::abs(pho1->Pt()) < 1.0)
-      {
-        continue;
-      }
-
-      // another loop to go into the saved cluster
-      for (int kCs = 0; kCs < iCs; kCs++)
-      {
-        if (jCs == kCs)
-        {
-          continue;
-        }
-
-        pho2 = savClusLV.at(kCs);
-
-        if (std::abs(pho2->Pt()) < 0.6)
-        {
-          continue;
-        }
-
-        TLorentzVector pi0lv;
-        if (pho1->DeltaR(*pho2) > 0.45)
-        {
-          continue;
-        }
-        pi0lv = *pho1 + *pho2;
-        float pairInvMass = pi0lv.M();
-        if (pi0lv.Pt() < 1.0)
-        {
-          continue;
-        }
-
-        /*
-        if (_maxTowerEtas[jCs]==50 && ((pi0lv.M()>=0.015 && pi0lv.M()<=0.095) || (pi0lv.M()>=0.175 && pi0lv.M()<=0.255)))
-        {
-                e1_hist_wo_alpha->Fill(pho1->E());
-                e2_hist_wo_alpha->Fill(pho2->E());
-        }
-        */
-
-        alphaCut = std::abs((pho1->E() - pho2->E()) / (pho1->E() + pho2->E()));
-        if (alphaCut > 0.50)
-        {
-          continue;  // 0.50 to begin with
-        }
-
-        /*
-        if  (_maxTowerEtas[jCs]==50 && ((pi0lv.M()>=0.015 && pi0lv.M()<=0.095) || (pi0lv.M()>=0.175 && pi0lv.M()<=0.255)))
-        {
-                e1_hist_w_alpha->Fill(pho1->E());
-                e2_hist_w_alpha->Fill(pho2->E());
-        }
-        */
-
-        // fill the tower by tower histograms with invariant mass
-        // we don't need to fill tower-by-tower level when we do for eta slices
-        // although filling here just so we don't have to change codes in other places
-        cemc_hist_eta_phi.at(_maxTowerEtas[jCs]).at(_maxTowerPhis[jCs])->Fill(pairInvMass);
-        eta_hist.at(_maxTowerEtas[jCs])->Fill(pairInvMass);
-        // pt1_ptpi0_alpha->Fill(pho1->Pt(), pi0lv.Pt(), alphaCut);
-      }
+      processBatch();
     }
   }
+  processBatch();
 }
 
 // _______________________________________________________________..
@@ -930,124 +1096,79 @@ void CaloCalibEmc_Pi0::Fit_Histos(const std::string &incorrFile)
 
   cal_output->cd();
 
-  TF1 *f1[25000];
-  TF1 *f2[25000];
-  TF1 *total[25000];
-  TF1 *fit_fn[25000];
-  int kj = 0;
-
   // arrays to hold the fit results (cemc)
   fitp1_eta_phi2d = new TH2F("fitp1_eta_phi2d", "fit p1 eta phi", 96, 0, 96, 256, 0, 256);
 
-  double cemc_par1_values[96][256] = {{0.0}};  // mising braces Werror w/o double braces
-  // double cemc_par0_values[96][256] = {0.0};
-  // double cemc_par0_errors[96][256] = {0.0};
-  double cemc_par1_errors[96][256] = {{0.0}};
-  // double cemc_par2_values[96][256] = {0.0};
-  // double cemc_par2_errors[96][256] = {0.0};
-
   // create Ntuple object of the fit result from the data
   TNtuple *nt_corrVals = new TNtuple("nt_corrVals", "Ntuple of the corrections", "tower_eta:tower_phi:corr_val:agg_cv");
 
-  for (int ieta = 0; ieta < 96; ieta++)  // eta loop
-  {
-    for (int iphi = 0; iphi < 256; iphi++)
-    {
-      // for(int ithirds=0; ithirds<3; ithirds++)
-      //{
-      //	for (int ieta=0+ithirds*32; ieta<(ithirds*32+16); ieta++)
-      //	{
-      //		for (int iphi=0; iphi<16; iphi++)
-      //		{
-      //		}
-      //	}
-      // }
-      //  find max bin around peak
-      float pkloc = 0.0;
-      float bsavloc = 0.0;
-      for (int kfi = 1; kfi < 20; kfi++)  // old kfi<25
-      {
-        float locbv = cemc_hist_eta_phi.at(ieta).at(iphi)->GetBinContent(kfi);
-        if (locbv > bsavloc)
-        {
-          pkloc = cemc_hist_eta_phi.at(ieta).at(iphi)->GetBinCenter(kfi);
-          bsavloc = locbv;
-        }
-      }
+  // the towers are independent, fit them concurrently and do everything
+  // touching the output file serially afterwards
+  constexpr int ntowers = 96 * 256;
+  std::vector<TowerFitResult> fitresults(ntowers);
 
-      f1[kj] = new TF1("f1", "gaus", 0.06, 0.20);  //"gaus",pkloc-0.03,pkloc+0.03
-      f2[kj] = new TF1("f2", "pol2", 0.01, 0.4);
+  const int nthreads = (m_fit_threads > 0) ? m_fit_threads : omp_get_max_threads();
+  const std::string default_minimizer = ROOT::Math::MinimizerOptions::DefaultMinimizerType();
+  std::string extraopt;
+  if (nthreads > 1)
+  {
+    // TMinuit is not thread safe, Minuit2 is. No graphics from the workers
+    ROOT::EnableThreadSafety();
+    ROOT::Math::MinimizerOptions::SetDefaultMinimizer("Minuit2");
+    extraopt = "Q0";
+    std::cout << " fitting " << ntowers << " towers with " << nthreads << " threads" << std::endl;
+  }
 
-      cemc_hist_eta_phi.at(ieta).at(iphi)->Fit(f1[kj], "", "", pkloc - 0.04, pkloc + 0.04);
-      float fpkloc2 = f1[kj]->GetParameter(1);
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads)
+  for (int itower = 0; itower < ntowers; itower++)
+  {
+    const int ieta = itower / 256;
+    const int iphi = itower % 256;
+    TH1 *hist = cemc_hist_eta_phi.at(ieta).at(iphi);
+    if (!hist)
+    {
+      continue;
+    }
+    std::string bkgNm = std::string("grBkgEta_phi_") + std::to_string(ieta) + std::string("_") + std::to_string(iphi);
+    fitTowerMass(hist, bkgNm, extraopt, fitresults[itower]);
+  }
 
-      TGraphErrors *grtemp = new TGraphErrors();
-      std::string bkgNm = std::string("grBkgEta_phi_") + std::to_string(ieta) + std::string("_") + std::to_string(iphi);
+  if (nthreads > 1)
+  {
+    ROOT::Math::MinimizerOptions::SetDefaultMinimizer(default_minimizer.c_str());
+  }
 
-      std::cout << " getting " << bkgNm << " mean was " << fpkloc2
-                << " " << pkloc << std::endl;
+  for (int ieta = 0; ieta < 96; ieta++)  // eta loop
+  {
+    for (int iphi = 0; iphi < 256; iphi++)
+    {
+      TowerFitResult &result = fitresults[ieta * 256 + iphi];
 
-      grtemp->SetName(bkgNm.c_str());
-      int ingr = 0;
-      for (int gj = 1; gj < cemc_hist_eta_phi.at(ieta).at(iphi)->GetNbinsX() + 1; gj++)
+      double cemc_par1_value = -999.0;
+      double cemc_par1_error = -999.0;
+      if (result.has_hist)
       {
-        float binc = cemc_hist_eta_phi.at(ieta).at(iphi)->GetBinCenter(gj);
-        float cntc = cemc_hist_eta_phi.at(ieta).at(iphi)->GetBinContent(gj);
-        if ((binc > 0.06 * fpkloc2 / 0.145 && binc < 0.09 * fpkloc2 / 0.145) || (binc > 0.22 * fpkloc2 / 0.145 && binc < 0.35 * fpkloc2 / 0.145))
-        {
-          grtemp->SetPoint(ingr, binc, cntc);
-          grtemp->SetPointError(ingr++, 0.001, std::sqrt(cntc));
-        }
-      }
-
-      grtemp->Fit(f2[kj]);
-
-      total[kj] = new TF1("total", "gaus(0)+pol2(3)", 0.06, 0.25);  // 0.3*fpkloc2/0.145
-
-      double par[6];
-
-      f1[kj]->GetParameters(&par[0]);
-      f2[kj]->GetParameters(&par[3]);
+        std::cout << " getting " << result.bkg->GetName() << " mean was " << result.fpkloc2
+                  << " " << result.pkloc << std::endl;
 
-      total[kj]->SetParameters(par);
-      total[kj]->SetParLimits(2, 0.01, 0.027);
-
-      cemc_hist_eta_phi.at(ieta).at(iphi)->Fit(total[kj], "R");
-      fit_fn[kj] = cemc_hist_eta_phi.at(ieta).at(iphi)->GetFunction("total");
-
-      grtemp->Write();
+        result.bkg->Write();
+        delete result.bkg;
+      }
 
-      if (fit_fn[kj])
+      if (result.ok)
       {
-        // cemc_hist_eta_phi.at(ieta).at(iphi) = i;
-        cemc_par1_values[ieta][iphi] = fit_fn[kj]->GetParameter(1);
-
-        //	if (!(cemc_par1_values[ieta][iphi]>0.0))
-        //	{
-        //		cemc_par1_values[ieta][iphi] = 0.5;
-        //	}
-        // cemc_par0_values[ieta][iphi]	= cemc_eta_phi_result->GetParameter(0);
-        cemc_par1_errors[ieta][iphi] = fit_fn[kj]->GetParError(1);
-        // cemc_par2_values[ieta][iphi]  = cemc_eta_phi_result->GetParameter(2);
-        // cemc_par2_errors[ieta][iphi] = cemc_eta_phi_result->GetParError(2);
+        cemc_par1_value = result.mean;
+        cemc_par1_error = result.mean_err;
       }
       else
       {
         std::cout << "Warning::Fit Failed for eta bin : " << ieta << iphi << std::endl;
-        cemc_par1_values[ieta][iphi] = -999.0;
-        cemc_par1_errors[ieta][iphi] = -999.0;
       }
 
-      nt_corrVals->Fill(ieta, iphi, 0.135 / cemc_par1_values[ieta][iphi], 0.135 / cemc_par1_values[ieta][iphi] * myaggcorr.at(ieta).at(iphi));
-      //}
-
-      // cemc_p1_eta_phi->Fill(cemc_par1_values[ieta][iphi],ieta,iphi);
-
-      // fitp0_eta_phi2d->SetBinContent(ieta+1,iphi+1,cemc_par0_values[ieta][iphi]);
-      fitp1_eta_phi2d->SetBinContent(ieta + 1, iphi + 1, cemc_par1_values[ieta][iphi]);
-      fitp1_eta_phi2d->SetBinError(ieta + 1, iphi + 1, cemc_par1_errors[ieta][iphi]);
+      nt_corrVals->Fill(ieta, iphi, 0.135 / cemc_par1_value, 0.135 / cemc_par1_value * myaggcorr.at(ieta).at(iphi));
 
-      kj++;
+      fitp1_eta_phi2d->SetBinContent(ieta + 1, iphi + 1, cemc_par1_value);
+      fitp1_eta_phi2d->SetBinError(ieta + 1, iphi + 1, cemc_par1_error);
     }
   }
 
@@ -1730,6 +1851,11 @@ void CaloCalibEmc_Pi0::Get_Histos(const std::string &infile, const std::string &
   cal_output = new TFile(outfile.c_str(), "UPDATE");
   // load the file from the fun4all 1st run
 
+  // tower by tower histograms come from the mass bank if the file has one
+  TH2 *h_mass_tower{nullptr};
+  cal_output->GetObject("h_mass_tower", h_mass_tower);
+  bool use_massbank = (h_mass_tower && m_massbank.Load(h_mass_tower));
+
   for (int i = 0; i < 96; i++)
   {
     // getting eta towers
@@ -1745,7 +1871,14 @@ void CaloCalibEmc_Pi0::Get_Histos(const std::string &infile, const std::string &
     {
       std::string hist_name = std::string("emc_ieta") + std::to_string(i) + std::string("_phi") + std::to_string(j);
       TH1 *h_eta_phi_temp{nullptr};
-      cal_output->GetObject(hist_name.c_str(), h_eta_phi_temp);
+      if (use_massbank)
+      {
+        h_eta_phi_temp = m_massbank.MakeTowerHist(i, j, hist_name);
+      }
+      else
+      {
+        cal_output->GetObject(hist_name.c_str(), h_eta_phi_temp);
+      }
       cemc_hist_eta_phi.at(i).at(j) = h_eta_phi_temp;
     }
   }
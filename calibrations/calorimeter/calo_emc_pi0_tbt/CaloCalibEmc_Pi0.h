@@ -3,6 +3,8 @@
 #ifndef CALOEMCPI0TBT_CALOCALIBEMCPI0_H
 #define CALOEMCPI0TBT_CALOCALIBEMCPI0_H
 
+#include "Pi0MassBank.h"
+
 #include <fun4all/SubsysReco.h>
 
 #include <array>
@@ -47,6 +49,12 @@ class CaloCalibEmc_Pi0 : public SubsysReco
 
   void set_centrality_nclusters_cut(int n) { m_cent_nclus_cut = n; }
 
+  /// threads for the tower by tower fits, 0 = OpenMP default (OMP_NUM_THREADS)
+  void set_fit_threads(int n) { m_fit_threads = n; }
+
+  /// threads for the pair building in Loop_for_eta_slices, 0 = OpenMP default (OMP_NUM_THREADS)
+  void set_fill_threads(int n) { m_fill_threads = n; }
+
   void Add_32();
   void Add_96();
 
@@ -85,10 +93,14 @@ class CaloCalibEmc_Pi0 : public SubsysReco
   std::string _inputtownodename;
 
   int m_cent_nclus_cut{0};
+  int m_fit_threads{1};
+  int m_fill_threads{1};
 
   // histos lists
   //  std::arrays have their indices backward, this is the old TH1 *cemc_hist_eta_phi[96][258];
   std::array<std::array<TH1 *, 258>, 96> cemc_hist_eta_phi{};
+  // dense tower x mass accumulation, written as the single TH2 h_mass_tower
+  Pi0MassBank m_massbank;
   std::array<TH1 *, 96> eta_hist{};
   TH2 *mass_eta{nullptr};
   TH3 *mass_eta_phi{nullptr};
@@ -0,0 +1,103 @@
+#include "Pi0MassBank.h"
+
+#include <TH1.h>
+#include <TH2.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+Pi0MassBank::Pi0MassBank(const int neta, const int nphi, const int nbins, const double massmin, const double massmax)
+  : m_neta(neta)
+  , m_nphi(nphi)
+  , m_nbins(nbins)
+  , m_massmin(massmin)
+  , m_massmax(massmax)
+  , m_invbinwidth(nbins / (massmax - massmin))
+  , m_counts(static_cast<size_t>(neta) * nphi * nbins, 0.)
+{
+}
+
+bool Pi0MassBank::Add(const Pi0MassBank &other)
+{
+  if (other.m_counts.size() != m_counts.size() || other.m_nbins != m_nbins)
+  {
+    std::cout << "Pi0MassBank::Add - incompatible binning, not adding" << std::endl;
+    return false;
+  }
+  std::transform(m_counts.begin(), m_counts.end(), other.m_counts.begin(), m_counts.begin(),
+                 [](float a, float b)
+                 { return a + b; });
+  return true;
+}
+
+void Pi0MassBank::Reset()
+{
+  std::fill(m_counts.begin(), m_counts.end(), 0.);
+}
+
+double Pi0MassBank::GetEntries(const int ieta, const int iphi) const
+{
+  const auto begin = m_counts.begin() + (static_cast<size_t>(ieta) * m_nphi + iphi) * m_nbins;
+  double sum = 0;
+  for (auto iter = begin; iter != begin + m_nbins; ++iter)
+  {
+    sum += *iter;
+  }
+  return sum;
+}
+
+TH2 *Pi0MassBank::MakeTH2(const std::string &name) const
+{
+  const int ntowers = m_neta * m_nphi;
+  TH2 *h2 = new TH2F(name.c_str(), "pair mass vs tower (ieta*nphi+iphi)", ntowers, -0.5, ntowers - 0.5, m_nbins, m_massmin, m_massmax);
+  double entries = 0;
+  for (int itower = 0; itower < ntowers; itower++)
+  {
+    for (int ibin = 0; ibin < m_nbins; ibin++)
+    {
+      const float count = m_counts[static_cast<size_t>(itower) * m_nbins + ibin];
+      if (count != 0)
+      {
+        h2->SetBinContent(itower + 1, ibin + 1, count);
+        entries += count;
+      }
+    }
+  }
+  h2->SetEntries(entries);
+  return h2;
+}
+
+bool Pi0MassBank::Load(const TH2 *h2)
+{
+  const int ntowers = m_neta * m_nphi;
+  if (!h2 || h2->GetNbinsX() != ntowers || h2->GetNbinsY() != m_nbins)
+  {
+    std::cout << "Pi0MassBank::Load - histogram binning does not match bank" << std::endl;
+    return false;
+  }
+  for (int itower = 0; itower < ntowers; itower++)
+  {
+    for (int ibin = 0; ibin < m_nbins; ibin++)
+    {
+      m_counts[static_cast<size_t>(itower) * m_nbins + ibin] = h2->GetBinContent(itower + 1, ibin + 1);
+    }
+  }
+  return true;
+}
+
+TH1 *Pi0MassBank::MakeTowerHist(const int ieta, const int iphi, const std::string &name) const
+{
+  TH1 *h = new TH1F(name.c_str(), "Hist_ieta_phi_", m_nbins, m_massmin, m_massmax);
+  h->SetDirectory(nullptr);
+  double entries = 0;
+  for (int ibin = 0; ibin < m_nbins; ibin++)
+  {
+    const double count = GetBinContent(ieta, iphi, ibin);
+    h->SetBinContent(ibin + 1, count);
+    h->SetBinError(ibin + 1, std::sqrt(count));
+    entries += count;
+  }
+  h->SetEntries(entries);
+  return h;
+}
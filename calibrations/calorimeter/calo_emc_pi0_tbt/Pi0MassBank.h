@@ -0,0 +1,67 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef CALOEMCPI0TBT_PI0MASSBANK_H
+#define CALOEMCPI0TBT_PI0MASSBANK_H
+
+#include <string>
+#include <vector>
+
+class TH1;
+class TH2;
+
+/**
+ * Dense tower x mass-bin accumulator for the tower by tower pi0 calibration.
+ *
+ * Replaces ~25k booked TH1's with one contiguous array. Banks are mergeable
+ * (Add) so thread or job local copies can be summed, and are written out as a
+ * single TH2 (x = tower index ieta*nphi+iphi, y = pair mass) which hadd merges
+ * as one object.
+ */
+class Pi0MassBank
+{
+ public:
+  Pi0MassBank(const int neta = 96, const int nphi = 256, const int nbins = 70, const double massmin = 0.0, const double massmax = 0.7);
+
+  void Fill(const int ieta, const int iphi, const double mass, const double weight = 1.)
+  {
+    if (ieta < 0 || ieta >= m_neta || iphi < 0 || iphi >= m_nphi || mass < m_massmin || mass >= m_massmax)
+    {
+      return;
+    }
+    const int ibin = static_cast<int>((mass - m_massmin) * m_invbinwidth);
+    m_counts[(static_cast<size_t>(ieta) * m_nphi + iphi) * m_nbins + ibin] += weight;
+  }
+
+  /// sum another bank with the same binning into this one
+  bool Add(const Pi0MassBank &other);
+  void Reset();
+
+  double GetBinContent(const int ieta, const int iphi, const int ibin) const
+  {
+    return m_counts[(static_cast<size_t>(ieta) * m_nphi + iphi) * m_nbins + ibin];
+  }
+  double GetEntries(const int ieta, const int iphi) const;
+
+  int NEta() const { return m_neta; }
+  int NPhi() const { return m_nphi; }
+  int NBins() const { return m_nbins; }
+
+  /// single object representation for writing and merging
+  TH2 *MakeTH2(const std::string &name) const;
+  /// load contents from a TH2 made by MakeTH2, returns false if binning differs
+  bool Load(const TH2 *h2);
+
+  /// per tower mass histogram (not attached to any directory)
+  TH1 *MakeTowerHist(const int ieta, const int iphi, const std::string &name) const;
+
+ private:
+  int m_neta;
+  int m_nphi;
+  int m_nbins;
+  double m_massmin;
+  double m_massmax;
+  double m_invbinwidth;
+  std::vector<float> m_counts;
+};
+
+#endif  // CALOEMCPI0TBT_PI0MASSBANK_H
@@ -25,6 +25,7 @@
 #include <TH3.h>
 #include <TLatex.h>
 #include <TLegend.h>
+#include <TSpline.h>
 #include <TStyle.h>
 #include <TSystem.h>
 
@@ -40,10 +41,31 @@ class RawTowerGeom;
 namespace
 {
   TGraph *LCE_grff{nullptr};
+  /// spline through LCE_grff. TGraph::Eval(x,nullptr,"S") builds a new spline on every
+  /// call, which dominated the fit time; build it once per reference instead
+  TSpline3 *LCE_spline{nullptr};
+
+  /// set the reference graph for LCE_fitf, takes ownership
+  void LCE_setRef(TGraph *gr)
+  {
+    delete LCE_spline;
+    LCE_spline = nullptr;
+    delete LCE_grff;
+    LCE_grff = gr;
+    if (LCE_grff->GetN() > 1)
+    {
+      LCE_spline = new TSpline3("LCE_spline", LCE_grff);
+    }
+  }
+
   /// This function is used for the histo fitting process. x is a 1d array that holds xaxis values.
   /// par is an array of 1d array of parameters we set our fit function to. So p[0] = p[1] = 1 unless otherwise noted
   double LCE_fitf(const Double_t *x, const Double_t *par)
   {
+    if (LCE_spline)
+    {
+      return par[0] * LCE_spline->Eval(x[0] * par[1]);
+    }
     return par[0] * LCE_grff->Eval(x[0] * par[1], nullptr, "S");
   }
 }  // namespace
@@ -81,15 +103,22 @@ int LiteCaloEval::InitRun(PHCompositeNode * /*topNode*/)
     hcalin_energy_eta = new TH2F("hcalin_energy_eta", "hcalin energy eta", 100, 0, 10, 24, -0.5, 23.5);
     hcalin_e_eta_phi = new TH3F("hcalin_e_eta_phi", "hcalin e eta phi", 60, 0, 6, 24, -0.5, 23.5, 64, -0.5, 63.5);
 
-    /// create tower histos
-    for (int i = 0; i < 24; i++)
+    /// create tower histos, or the columnar bank with the same binning
+    if (m_columnar)
     {
-      for (int j = 0; j < 64; j++)
+      m_towerbank.Init(24, 64, 40000, 0, 4);
+    }
+    else
+    {
+      for (int i = 0; i < 24; i++)
       {
-        std::string hist_name = "hcal_in_eta_" + std::to_string(i) + "_phi_" + std::to_string(j);
+        for (int j = 0; j < 64; j++)
+        {
+          std::string hist_name = "hcal_in_eta_" + std::to_string(i) + "_phi_" + std::to_string(j);
 
-        hcal_in_eta_phi[i][j] = new TH1F(hist_name.c_str(), "Hcal_in_energy", 40000, 0, 4);
-        hcal_in_eta_phi[i][j]->SetXTitle("Energy [GeV]");
+          hcal_in_eta_phi[i][j] = new TH1F(hist_name.c_str(), "Hcal_in_energy", 40000, 0, 4);
+          hcal_in_eta_phi[i][j]->SetXTitle("Energy [GeV]");
+        }
       }
     }
 
@@ -116,15 +145,22 @@ int LiteCaloEval::InitRun(PHCompositeNode * /*topNode*/)
     hcalout_energy_eta = new TH2F("hcalout_energy_eta", "hcalout energy eta", 100, 0, 10, 24, 0.5, 23.5);
     hcalout_e_eta_phi = new TH3F("hcalout_e_eta_phi", "hcalout e eta phi", 100, 0, 10, 24, -0.5, 23.5, 64, -0.5, 63.5);
 
-    /// create tower histos
-    for (int i = 0; i < 24; i++)
+    /// create tower histos, or the columnar bank with the same binning
+    if (m_columnar)
     {
-      for (int j = 0; j < 64; j++)
+      m_towerbank.Init(24, 64, 10000, 0, 10);
+    }
+    else
+    {
+      for (int i = 0; i < 24; i++)
       {
-        std::string hist_name = "hcal_out_eta_" + std::to_string(i) + "_phi_" + std::to_string(j);
+        for (int j = 0; j < 64; j++)
+        {
+          std::string hist_name = "hcal_out_eta_" + std::to_string(i) + "_phi_" + std::to_string(j);
 
-        hcal_out_eta_phi[i][j] = new TH1F(hist_name.c_str(), "Hcal_out energy", 10000, 0, 10);
-        hcal_out_eta_phi[i][j]->SetXTitle("Energy [GeV]");
+          hcal_out_eta_phi[i][j] = new TH1F(hist_name.c_str(), "Hcal_out energy", 10000, 0, 10);
+          hcal_out_eta_phi[i][j]->SetXTitle("Energy [GeV]");
+        }
       }
     }
 
@@ -147,15 +183,22 @@ int LiteCaloEval::InitRun(PHCompositeNode * /*topNode*/)
 
   else if (calotype == LiteCaloEval::CEMC)
   {
-    /// create tower histos
-    for (int i = 0; i < 96; i++)
+    /// create tower histos, or the columnar bank with the same binning
+    if (m_columnar)
     {
-      for (int j = 0; j < 256; j++)
+      m_towerbank.Init(96, 256, 400, 0, 2);
+    }
+    else
+    {
+      for (int i = 0; i < 96; i++)
       {
-        std::string hist_name = "emc_ieta" + std::to_string(i) + "_phi" + std::to_string(j);
+        for (int j = 0; j < 256; j++)
+        {
+          std::string hist_name = "emc_ieta" + std::to_string(i) + "_phi" + std::to_string(j);
 
-        cemc_hist_eta_phi[i][j] = new TH1F(hist_name.c_str(), "Hist_ieta_phi_leaf(e)", 400, 0, 2);
-        cemc_hist_eta_phi[i][j]->SetXTitle("Energy [GeV]");
+          cemc_hist_eta_phi[i][j] = new TH1F(hist_name.c_str(), "Hist_ieta_phi_leaf(e)", 400, 0, 2);
+          cemc_hist_eta_phi[i][j]->SetXTitle("Energy [GeV]");
+        }
       }
     }
 
@@ -336,7 +379,14 @@ int LiteCaloEval::process_event(PHCompositeNode *topNode)
         e *= 0.88 + llet * 0.04 - 0.01 + 0.01 * ppkket;
       }
 
-      cemc_hist_eta_phi[ieta][iphi]->Fill(e);
+      if (m_columnar)
+      {
+        m_towerbank.Fill(ieta, iphi, e);
+      }
+      else
+      {
+        cemc_hist_eta_phi[ieta][iphi]->Fill(e);
+      }
 
       eta_hist[96]->Fill(e);
 
@@ -362,7 +412,14 @@ int LiteCaloEval::process_event(PHCompositeNode *topNode)
         }
       }
 
-      hcal_out_eta_phi[ieta][iphi]->Fill(e);
+      if (m_columnar)
+      {
+        m_towerbank.Fill(ieta, iphi, e);
+      }
+      else
+      {
+        hcal_out_eta_phi[ieta][iphi]->Fill(e);
+      }
 
       hcalout_eta[24]->Fill(e);
 
@@ -388,7 +445,14 @@ int LiteCaloEval::process_event(PHCompositeNode *topNode)
         }
       }
 
-      hcal_in_eta_phi[ieta][iphi]->Fill(e);
+      if (m_columnar)
+      {
+        m_towerbank.Fill(ieta, iphi, e);
+      }
+      else
+      {
+        hcal_in_eta_phi[ieta][iphi]->Fill(e);
+      }
 
       hcalin_eta[24]->Fill(e);
 
@@ -418,6 +482,12 @@ int LiteCaloEval::End(PHCompositeNode * /*topNode*/)
 
   std::cout << " writing lite calo file" << std::endl;
 
+  if (m_columnar)
+  {
+    // all tower spectra as one object
+    m_towerbank.MakeTH2(towerBankName(), "tower spectra (x = ieta*nphi+iphi)");
+  }
+
   cal_output->Write();
 
   return Fun4AllReturnCodes::EVENT_OK;
@@ -461,6 +531,20 @@ void LiteCaloEval::Get_Histos(const std::string &infile, const std::string &outf
     max_iphi = 64;
   }
 
+  /// tower spectra written in columnar mode are unpacked into the usual per tower histos
+  TH2 *h_towerbank{nullptr};
+  f_temp->GetObject(towerBankName().c_str(), h_towerbank);
+  bool use_towerbank = false;
+  if (h_towerbank)
+  {
+    m_towerbank.Init(max_ieta, max_iphi, h_towerbank->GetNbinsY(), h_towerbank->GetYaxis()->GetXmin(), h_towerbank->GetYaxis()->GetXmax());
+    use_towerbank = m_towerbank.Load(h_towerbank);
+    if (use_towerbank)
+    {
+      std::cout << "Using columnar tower spectra " << towerBankName() << std::endl;
+    }
+  }
+
   /// start of eta loop
   for (int i = 0; i < max_ieta + 1; i++)
   {
@@ -531,7 +615,16 @@ void LiteCaloEval::Get_Histos(const std::string &infile, const std::string &outf
 
       /// heta_tempp holds tower histogram
       TH1 *heta_tempp{nullptr};
-      f_temp->GetObject(hist_name_p.c_str(), heta_tempp);
+      if (use_towerbank)
+      {
+        // same ownership as the histograms read from the file
+        heta_tempp = m_towerbank.MakeTowerHist(i, j, hist_name_p, "tower energy", f_temp);
+        heta_tempp->SetXTitle("Energy [GeV]");
+      }
+      else
+      {
+        f_temp->GetObject(hist_name_p.c_str(), heta_tempp);
+      }
 
       if (i == 0 && j == 0)
       {
@@ -750,14 +843,14 @@ void LiteCaloEval::FitRelativeShifts(LiteCaloEval *ref_lce, int modeFitShifts)
     {
       cleanEtaRef->Smooth(nsmooth);
 
-      LCE_grff = new TGraph(cleanEtaRef);
+      LCE_setRef(new TGraph(cleanEtaRef));
     }
 
     else
     {
       hnewf->Smooth(nsmooth);
 
-      LCE_grff = new TGraph(hnewf);
+      LCE_setRef(new TGraph(hnewf));
     }
 
     /// this function will be used to fit eta slice histos
@@ -938,13 +1031,13 @@ void LiteCaloEval::FitRelativeShifts(LiteCaloEval *ref_lce, int modeFitShifts)
       if (flag_fit_rings == false)
       {
         hnewfp->Smooth(nsmooth);
-        LCE_grff = new TGraph(hnewfp);
+        LCE_setRef(new TGraph(hnewfp));
       }
 
       if (flag_fit_rings == true)
       {
         // cleanEtaRef->Smooth(nsmooth);
-        LCE_grff = new TGraph(cleanEtaRef);
+        LCE_setRef(new TGraph(cleanEtaRef));
       }
 
       /// make tf1 that will hold the resulting fit of towers
@@ -1079,6 +1172,19 @@ void LiteCaloEval::FitRelativeShifts(LiteCaloEval *ref_lce, int modeFitShifts)
   f_temp->Close();
 }
 
+std::string LiteCaloEval::towerBankName() const
+{
+  if (calotype == LiteCaloEval::HCALOUT)
+  {
+    return "hcal_out_tower_spectra";
+  }
+  if (calotype == LiteCaloEval::HCALIN)
+  {
+    return "hcal_in_tower_spectra";
+  }
+  return "emc_tower_spectra";
+}
+
 bool LiteCaloEval::chk_isChimney(int ieta, int iphi)
 {
   if ((ieta < 4 || ieta > 19) && (iphi > 13 && iphi < 20))
@@ -3,6 +3,8 @@
 #ifndef CALOTOWERSLOPE_LITECALOEVAL_H
 #define CALOTOWERSLOPE_LITECALOEVAL_H
 
+#include "TowerSpectrumBank.h"
+
 #include <fun4all/SubsysReco.h>
 
 #include <string>
@@ -76,6 +78,13 @@ class LiteCaloEval : public SubsysReco
     m_UseTowerInfo = setTowerInfo;
   }
 
+  /// accumulate tower spectra in one contiguous uint32 array instead of one TH1 per tower.
+  /// Written as a single TH2, Get_Histos unpacks it into the usual per tower histos
+  void set_columnar(bool status = true)
+  {
+    m_columnar = status;
+  }
+
   /// Getters________________________________________
 
   void Get_Histos(const std::string &infile, const std::string &outfile = "");
@@ -107,6 +116,8 @@ class LiteCaloEval : public SubsysReco
   static bool chk_isChimney(int, int);
 
  private:
+  std::string towerBankName() const;
+
   TFile *f_temp{nullptr};
   TFile *cal_output{nullptr};
 
@@ -149,6 +160,10 @@ class LiteCaloEval : public SubsysReco
 
   // flag for using tower info
   int m_UseTowerInfo{1};
+
+  // columnar tower spectra
+  bool m_columnar{false};
+  TowerSpectrumBank m_towerbank;
 };
 
 #endif  // LITECALOEVAL_H
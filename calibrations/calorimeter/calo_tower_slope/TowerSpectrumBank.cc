@@ -0,0 +1,95 @@
+#include "TowerSpectrumBank.h"
+
+#include <TH1.h>
+#include <TH2.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+void TowerSpectrumBank::Init(const int neta, const int nphi, const int nbins, const double xmin, const double xmax)
+{
+  m_neta = neta;
+  m_nphi = nphi;
+  m_nbins = nbins;
+  m_xmin = xmin;
+  m_xmax = xmax;
+  m_counts.assign(static_cast<size_t>(neta) * nphi * (nbins + 2), 0);
+}
+
+bool TowerSpectrumBank::Add(const TowerSpectrumBank &other)
+{
+  if (other.m_counts.size() != m_counts.size() || other.m_nbins != m_nbins || other.m_xmin != m_xmin || other.m_xmax != m_xmax)
+  {
+    std::cout << "TowerSpectrumBank::Add - incompatible binning, not adding" << std::endl;
+    return false;
+  }
+  std::transform(m_counts.begin(), m_counts.end(), other.m_counts.begin(), m_counts.begin(),
+                 [](uint32_t a, uint32_t b)
+                 { return a + b; });
+  return true;
+}
+
+void TowerSpectrumBank::Reset()
+{
+  std::fill(m_counts.begin(), m_counts.end(), 0);
+}
+
+TH2 *TowerSpectrumBank::MakeTH2(const std::string &name, const std::string &title) const
+{
+  const int ntowers = m_neta * m_nphi;
+  TH2 *h2 = new TH2I(name.c_str(), title.c_str(), ntowers, -0.5, ntowers - 0.5, m_nbins, m_xmin, m_xmax);
+  double entries = 0;
+  for (int itower = 0; itower < ntowers; itower++)
+  {
+    const size_t offset = static_cast<size_t>(itower) * (m_nbins + 2);
+    for (int ibin = 0; ibin < m_nbins + 2; ibin++)
+    {
+      const uint32_t count = m_counts[offset + ibin];
+      if (count)
+      {
+        h2->SetBinContent(itower + 1, ibin, count);
+        entries += count;
+      }
+    }
+  }
+  h2->SetEntries(entries);
+  return h2;
+}
+
+bool TowerSpectrumBank::Load(const TH2 *h2)
+{
+  if (!h2 || !IsInit() || h2->GetNbinsX() != m_neta * m_nphi || h2->GetNbinsY() != m_nbins)
+  {
+    std::cout << "TowerSpectrumBank::Load - histogram binning does not match bank" << std::endl;
+    return false;
+  }
+  const int ntowers = m_neta * m_nphi;
+  for (int itower = 0; itower < ntowers; itower++)
+  {
+    const size_t offset = static_cast<size_t>(itower) * (m_nbins + 2);
+    for (int ibin = 0; ibin < m_nbins + 2; ibin++)
+    {
+      m_counts[offset + ibin] = static_cast<uint32_t>(std::lround(h2->GetBinContent(itower + 1, ibin)));
+    }
+  }
+  return true;
+}
+
+TH1 *TowerSpectrumBank::MakeTowerHist(const int ieta, const int iphi, const std::string &name, const std::string &title, TDirectory *dir) const
+{
+  TH1 *h = new TH1F(name.c_str(), title.c_str(), m_nbins, m_xmin, m_xmax);
+  h->SetDirectory(dir);
+  double entries = 0;
+  for (int ibin = 0; ibin < m_nbins + 2; ibin++)
+  {
+    const uint32_t count = GetBinContent(ieta, iphi, ibin);
+    if (count)
+    {
+      h->SetBinContent(ibin, count);
+      entries += count;
+    }
+  }
+  h->SetEntries(entries);
+  return h;
+}
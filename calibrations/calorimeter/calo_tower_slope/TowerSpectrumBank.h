@@ -0,0 +1,92 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef CALOTOWERSLOPE_TOWERSPECTRUMBANK_H
+#define CALOTOWERSLOPE_TOWERSPECTRUMBANK_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class TDirectory;
+class TH1;
+class TH2;
+
+/**
+ * Columnar per tower spectrum accumulation: fixed binning uint32 counts for
+ * all towers of a calorimeter in one contiguous array. The per tower layout
+ * matches a TH1 (bin 0 underflow, nbins+1 overflow), so histograms made from
+ * the bank are identical to filling a TH1 per tower.
+ *
+ * Banks are summed with Add(), and are written as a single TH2I
+ * (x = tower index ieta*nphi+iphi, y = energy) that hadd merges as one object.
+ */
+class TowerSpectrumBank
+{
+ public:
+  TowerSpectrumBank() = default;
+
+  void Init(const int neta, const int nphi, const int nbins, const double xmin, const double xmax);
+  bool IsInit() const { return !m_counts.empty(); }
+
+  void Fill(const int ieta, const int iphi, const double x)
+  {
+    if (ieta < 0 || ieta >= m_neta || iphi < 0 || iphi >= m_nphi)
+    {
+      return;
+    }
+    ++m_counts[index(ieta, iphi, x)];
+  }
+
+  /// sum another bank with the same binning into this one
+  bool Add(const TowerSpectrumBank &other);
+  void Reset();
+
+  /// ibin follows the TH1 convention (0 underflow, nbins+1 overflow)
+  uint32_t GetBinContent(const int ieta, const int iphi, const int ibin) const
+  {
+    return m_counts[tower_offset(ieta, iphi) + ibin];
+  }
+
+  int NEta() const { return m_neta; }
+  int NPhi() const { return m_nphi; }
+  int NBins() const { return m_nbins; }
+  size_t MemorySize() const { return m_counts.size() * sizeof(uint32_t); }
+
+  /// single object representation for writing and merging
+  TH2 *MakeTH2(const std::string &name, const std::string &title) const;
+  /// load contents from a TH2 made by MakeTH2, returns false if binning differs
+  bool Load(const TH2 *h2);
+
+  /// per tower spectrum, attached to dir (not attached to any directory if dir is null)
+  TH1 *MakeTowerHist(const int ieta, const int iphi, const std::string &name, const std::string &title, TDirectory *dir = nullptr) const;
+
+ private:
+  size_t tower_offset(const int ieta, const int iphi) const
+  {
+    return (static_cast<size_t>(ieta) * m_nphi + iphi) * (m_nbins + 2);
+  }
+
+  size_t index(const int ieta, const int iphi, const double x) const
+  {
+    int ibin = 0;
+    if (x >= m_xmax)
+    {
+      ibin = m_nbins + 1;
+    }
+    else if (x >= m_xmin)
+    {
+      // same arithmetic as TAxis::FindFixBin
+      ibin = 1 + static_cast<int>(m_nbins * (x - m_xmin) / (m_xmax - m_xmin));
+    }
+    return tower_offset(ieta, iphi) + ibin;
+  }
+
+  int m_neta{0};
+  int m_nphi{0};
+  int m_nbins{0};
+  double m_xmin{0};
+  double m_xmax{1};
+  std::vector<uint32_t> m_counts;
+};
+
+#endif  // CALOTOWERSLOPE_TOWERSPECTRUMBANK_H
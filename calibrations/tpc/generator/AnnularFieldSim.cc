@@ -15,6 +15,7 @@
 #include <TStyle.h>
 #include <TTree.h>
 #include <TVector3.h>
+#include <omp.h>
 
 #include <algorithm>
 #include <cassert>  // for assert
@@ -168,15 +169,11 @@ AnnularFieldSim::AnnularFieldSim(float in_innerRadius, float in_outerRadius, flo
 
   if (lookupCase == Full3D)
   {
-    std::cout << std::format("AnnularFieldSim::AnnularFieldSim building Epartial (full3D) with nr_roi={} nphi_roi={} nz_roi={}  =~{:.2f}M TVector3 objects",
-                             nr_roi, nphi_roi, nz_roi, nr_roi * nphi_roi * nz_roi * nr * nphi * nz / 1.0e6)
+    std::cout << std::format("AnnularFieldSim::AnnularFieldSim building Epartial (full3D) with nr_roi={} nphi_roi={} nz_roi={}  =~{:.2f}M field elements",
+                             nr_roi, nphi_roi, nz_roi, 1.0 * nr_roi * nphi_roi * nz_roi * nr * nphi * nz / 1.0e6)
               << std::endl;
 
-    Epartial = new MultiArray<TVector3>(nr_roi, nphi_roi, nz_roi, nr, nphi, nz);
-    for (int i = 0; i < Epartial->Length(); i++)
-    {
-      Epartial->GetFlat(i)->SetXYZ(0, 0, 0);
-    }
+    Epartial = new GreenLookupTable(nr_roi, nphi_roi, nz_roi, nr, nphi, nz);
     // and kill the arrays we shouldn't be using:
     Epartial_highres = new MultiArray<TVector3>(1);
     Epartial_highres->GetFlat(0)->SetXYZ(0, 0, 0);
@@ -184,8 +181,7 @@ AnnularFieldSim::AnnularFieldSim(float in_innerRadius, float in_outerRadius, flo
     Epartial_lowres = new MultiArray<TVector3>(1);
     Epartial_lowres->GetFlat(0)->SetXYZ(0, 0, 0);
 
-    Epartial_phislice = new MultiArray<TVector3>(1);
-    Epartial_phislice->GetFlat(0)->SetXYZ(0, 0, 0);
+    Epartial_phislice = new GreenLookupTable(1, 1, 1, 1, 1, 1);
     q_lowres = new MultiArray<double>(1);
     *(q_lowres->GetFlat(0)) = 0;
     q_local = new MultiArray<double>(1);
@@ -195,24 +191,17 @@ AnnularFieldSim::AnnularFieldSim(float in_innerRadius, float in_outerRadius, flo
   {
     std::cout << "lookupCase==HybridRes" << std::endl;
     // zero out the other two:
-    Epartial = new MultiArray<TVector3>(1);
-    Epartial->GetFlat(0)->SetXYZ(0, 0, 0);
+    Epartial = new GreenLookupTable(1, 1, 1, 1, 1, 1);
 
-    Epartial_phislice = new MultiArray<TVector3>(1);
-    Epartial_phislice->GetFlat(0)->SetXYZ(0, 0, 0);
+    Epartial_phislice = new GreenLookupTable(1, 1, 1, 1, 1, 1);
   }
   else if (lookupCase == PhiSlice)
   {
     std::cout << "lookupCase==PhiSlice" << std::endl;
 
-    Epartial_phislice = new MultiArray<TVector3>(nr_roi, 1, nz_roi, nr, nphi, nz);
-    for (int i = 0; i < Epartial_phislice->Length(); i++)
-    {
-      Epartial_phislice->GetFlat(i)->SetXYZ(0, 0, 0);
-    }
+    Epartial_phislice = new GreenLookupTable(nr_roi, 1, nz_roi, nr, nphi, nz);
     // zero out the other two:
-    Epartial = new MultiArray<TVector3>(1);
-    Epartial->GetFlat(0)->SetXYZ(0, 0, 0);
+    Epartial = new GreenLookupTable(1, 1, 1, 1, 1, 1);
     Epartial_highres = new MultiArray<TVector3>(1);
     Epartial_highres->GetFlat(0)->SetXYZ(0, 0, 0);
 
@@ -229,11 +218,9 @@ AnnularFieldSim::AnnularFieldSim(float in_innerRadius, float in_outerRadius, flo
     std::cout << "lookupCase==Analytic (or NoLookup)" << std::endl;
 
     // zero them all out:
-    Epartial_phislice = new MultiArray<TVector3>(1);
-    Epartial_phislice->GetFlat(0)->SetXYZ(0, 0, 0);
+    Epartial_phislice = new GreenLookupTable(1, 1, 1, 1, 1, 1);
 
-    Epartial = new MultiArray<TVector3>(1);
-    Epartial->GetFlat(0)->SetXYZ(0, 0, 0);
+    Epartial = new GreenLookupTable(1, 1, 1, 1, 1, 1);
 
     Epartial_highres = new MultiArray<TVector3>(1);
     Epartial_highres->GetFlat(0)->SetXYZ(0, 0, 0);
@@ -880,6 +867,7 @@ TVector3 AnnularFieldSim::interpolatedFieldIntegral(float zdest, const TVector3
 
   TVector3 fieldInt(0, 0, 0);
   TVector3 partialInt;  // where we'll store integrals as we generate them.
+  const ColumnIntegral *columns = FindColumnIntegral(field);
 
   for (int i = 0; i < 4; i++)
   {
@@ -889,10 +877,24 @@ TVector3 AnnularFieldSim::interpolatedFieldIntegral(float zdest, const TVector3
       continue;  // we invalidated this one for some reason.
     }
     partialInt.SetXYZ(0, 0, 0);
-    for (int j = zi; j < zf; j++)
-    {  // count the whole cell of the lower end, and skip the whole cell of the high end.
+    if (columns)
+    {
+      // same sum as below, as the difference of the running integrals at the two ends
+      const size_t column = (static_cast<size_t>(ri[i] - rmin_roi) * nphi_roi + (pi[i] - phimin_roi)) * (nz_roi + 1);
+      if (zf > zi)
+      {
+        const size_t lo = column + (zi - zmin_roi);
+        const size_t hi = column + (zf - zmin_roi);
+        partialInt.SetXYZ(columns->ix[hi] - columns->ix[lo], columns->iy[hi] - columns->iy[lo], columns->iz[hi] - columns->iz[lo]);
+      }
+    }
+    else
+    {
+      for (int j = zi; j < zf; j++)
+      {  // count the whole cell of the lower end, and skip the whole cell of the high end.
 
-      partialInt += field->Get(ri[i] - rmin_roi, pi[i] - phimin_roi, j - zmin_roi) * step.Z();
+        partialInt += field->Get(ri[i] - rmin_roi, pi[i] - phimin_roi, j - zmin_roi) * step.Z();
+      }
     }
     if (startBound != OnLowEdge)
     {
@@ -1582,33 +1584,43 @@ void AnnularFieldSim::populate_fieldmap()
   unsigned long long percent = totalelements / 100 * debug_npercent;
   std::cout << std::format("total elements = {}", totalelements * nr * nphi * nz) << std::endl;
 
+  // the table sums are independent per cell and read a snapshot of the charge, so they can run in parallel.
+  // other cases (analytic model, hybrid tables, debug printing) are not thread safe and stay serial.
+  const bool tableLookup = (lookupCase == Full3D || lookupCase == PhiSlice);
+  const bool parallel = tableLookup && debug_printActionEveryN <= 0;
+  const std::vector<float> charge = tableLookup ? charge_snapshot() : std::vector<float>();
+  const int ncells = nr_roi * nphi_roi * nz_roi;
+  const int cellpercent = std::max(1, static_cast<int>(percent));
   int el = 0;
+  const int nthreads = NumThreads();
 
-  TVector3 localF;  // holder for the summed field at the current position.
-  for (int ir = rmin_roi; ir < rmax_roi; ir++)
+#pragma omp parallel for schedule(dynamic, 64) if (parallel) num_threads(nthreads)
+  for (int icell = 0; icell < ncells; icell++)
   {
-    for (int iphi = phimin_roi; iphi < phimax_roi; iphi++)
+    const int ir = rmin_roi + icell / (nphi_roi * nz_roi);
+    const int iphi = phimin_roi + (icell / nz_roi) % nphi_roi;
+    const int iz = zmin_roi + icell % nz_roi;
+    const TVector3 localF = sum_field_at(ir, iphi, iz, tableLookup ? charge.data() : nullptr);  // asks in global coordinates
+    Efield->Set(ir - rmin_roi, iphi - phimin_roi, iz - zmin_roi, localF);  // sets in roi coordinates.
+#pragma omp critical(annularfieldsim_progress)
     {
-      for (int iz = zmin_roi; iz < zmax_roi; iz++)
+      if (!(el % cellpercent))
       {
-        localF = sum_field_at(ir, iphi, iz);  // asks in global coordinates
-        if (!(el % percent))
-        {
-          std::cout << std::format("populate_fieldmap {}%:  ", static_cast<uint64_t>(debug_npercent) * el / percent);
+        std::cout << std::format("populate_fieldmap {}%:  ", static_cast<uint64_t>(debug_npercent) * el / cellpercent);
 
-          std::cout << std::format("sum_field_at (ir={}, iphi={}, iz={}) gives ({:E},{:E},{:E})", ir, iphi, iz, localF.X(), localF.Y(), localF.Z()) << std::endl;
-        }
-        el++;
-
-        Efield->Set(ir - rmin_roi, iphi - phimin_roi, iz - zmin_roi, localF);  // sets in roi coordinates.
-                                                                               // if (localF.Mag()>1e-9)
-                                                                               // if(debugFlag()) print_need_cout("%d: AnnularFieldSim::populate_fieldmap fieldmap@ (%d,%d,%d) mag=%f\n",__LINE__,ir,iphi,iz,localF.Mag());
+        std::cout << std::format("sum_field_at (ir={}, iphi={}, iz={}) gives ({:E},{:E},{:E})", ir, iphi, iz, localF.X(), localF.Y(), localF.Z()) << std::endl;
       }
+      el++;
     }
   }
   return;
 }
 
+int AnnularFieldSim::NumThreads() const
+{
+  return (num_threads > 0) ? num_threads : omp_get_max_threads();
+}
+
 void AnnularFieldSim::populate_lookup()
 {
   // with 'f' being the position the field is being measured at, and 'o' being the position of the charge generating the field.
@@ -1616,6 +1628,12 @@ void AnnularFieldSim::populate_lookup()
   //   TVector3 (*f)[fx][fy][fz][ox][oy][oz]=field_;
   // print_need_cout("populating lookup for (%dx%dx%d)x(%dx%dx%d) grid\n",fx,fy,fz,ox,oy,oz);
 
+  if (ActiveLookup() && ActiveLookup()->IsMapped())
+  {
+    std::cout << "Populating lookup:  table was loaded with load_lookup_binary ===> skipping!" << std::endl;
+    return;
+  }
+
   if (lookupCase == Full3D)
   {
     std::cout << "lookupCase==Full3D" << std::endl;
@@ -1662,48 +1680,44 @@ void AnnularFieldSim::populate_full3d_lookup()
   totalelements *= nr;
   totalelements *= nphi;
   totalelements *= nz;  // breaking up this multiplication prevents a 32bit math overflow
-  unsigned long long percent = totalelements / 100 * debug_npercent;
   std::cout << std::format("total elements = {}", totalelements) << std::endl;
-  TVector3 at(1, 0, 0);
-  TVector3 from(1, 0, 0);
-  TVector3 zero(0, 0, 0);
-
-  int el = 0;
-  for (int ifr = rmin_roi; ifr < rmax_roi; ifr++)
-  {
-    for (int ifphi = phimin_roi; ifphi < phimax_roi; ifphi++)
+  precalc_green_radii();
+
+  // each target cell fills its own contiguous block of sources, so target cells are independent.
+  const int ntargets = nr_roi * nphi_roi * nz_roi;
+  const int percent = std::max(1, static_cast<int>(ntargets / 100 * debug_npercent));
+  int done = 0;
+  const int nthreads = NumThreads();
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads)
+  for (int itarget = 0; itarget < ntargets; itarget++)
+  {
+    const int ifr = rmin_roi + itarget / (nphi_roi * nz_roi);
+    const int ifphi = phimin_roi + (itarget / nz_roi) % nphi_roi;
+    const int ifz = zmin_roi + itarget % nz_roi;
+    const TVector3 at = GetCellCenter(ifr, ifphi, ifz);
+    size_t index = Epartial->TargetOffset(ifr - rmin_roi, ifphi - phimin_roi, ifz - zmin_roi);
+    for (int ior = 0; ior < nr; ior++)
     {
-      for (int ifz = zmin_roi; ifz < zmax_roi; ifz++)
+      for (int iophi = 0; iophi < nphi; iophi++)
       {
-        at = GetCellCenter(ifr, ifphi, ifz);
-        for (int ior = 0; ior < nr; ior++)
+        for (int ioz = 0; ioz < nz; ioz++, index++)
         {
-          for (int iophi = 0; iophi < nphi; iophi++)
+          if (ifr == ior && ifphi == iophi && ifz == ioz)
           {
-            for (int ioz = 0; ioz < nz; ioz++)
-            {
-              el++;
-              if (!(el % percent))
-              {
-                std::cout << std::format("populate_full3d_lookup {}%", static_cast<uint64_t>(debug_npercent) * el / percent) << std::endl;
-              }
-              from = GetCellCenter(ior, iophi, ioz);
-
-              //*f[ifx][ify][ifz][iox][ioy][ioz]=cacl_unit_field(at,from);
-              // print_need_cout("calc_unit_field...\n");
-              if (ifr == ior && ifphi == iophi && ifz == ioz)
-              {
-                Epartial->Set(ifr - rmin_roi, ifphi - phimin_roi, ifz - zmin_roi, ior, iophi, ioz, zero);
-              }
-              else
-              {
-                Epartial->Set(ifr - rmin_roi, ifphi - phimin_roi, ifz - zmin_roi, ior, iophi, ioz, calc_unit_field(at, from));
-              }
-            }
+            continue;  // self-to-self stays zero
           }
+          const TVector3 unitf = calc_unit_field(at, GetCellCenter(ior, iophi, ioz));
+          Epartial->Set(index, unitf.X(), unitf.Y(), unitf.Z());
         }
       }
     }
+#pragma omp critical(annularfieldsim_progress)
+    {
+      if (!(++done % percent))
+      {
+        std::cout << std::format("populate_full3d_lookup {}%", static_cast<uint64_t>(debug_npercent) * done / percent) << std::endl;
+      }
+    }
   }
   return;
 }
@@ -1991,61 +2005,48 @@ void AnnularFieldSim::populate_phislice_lookup()
   totalelements *= nz;
   totalelements *= nr_roi;
   totalelements *= nz_roi;  // breaking up this multiplication prevents a 32bit math overflow
-  unsigned long long percent = totalelements / 100 * debug_npercent;
   std::cout << std::format("total elements = {}", totalelements) << std::endl;
-  TVector3 at(1, 0, 0);
-  TVector3 from(1, 0, 0);
-  TVector3 zero(0, 0, 0);
-
-  int el = 0;
-  for (int ifr = rmin_roi; ifr < rmax_roi; ifr++)
-  {
-    for (int ifz = zmin_roi; ifz < zmax_roi; ifz++)
+  precalc_green_radii();
+
+  // each target cell fills its own contiguous block of sources, so target cells are independent.
+  const int ntargets = nr_roi * nz_roi;
+  const int percent = std::max(1, static_cast<int>(ntargets / 100 * debug_npercent));
+  int done = 0;
+  const int nthreads = NumThreads();
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads)
+  for (int itarget = 0; itarget < ntargets; itarget++)
+  {
+    const int ifr = rmin_roi + itarget / nz_roi;
+    const int ifz = zmin_roi + itarget % nz_roi;
+    const TVector3 at = GetCellCenter(ifr, 0, ifz);
+    size_t index = Epartial_phislice->TargetOffset(ifr - rmin_roi, 0, ifz - zmin_roi);
+    TVector3 unitf(0, 0, 0);
+    for (int ior = 0; ior < nr; ior++)
     {
-      at = GetCellCenter(ifr, 0, ifz);
-      for (int ior = 0; ior < nr; ior++)
+      for (int iophi = 0; iophi < nphi; iophi++)
       {
-        for (int iophi = 0; iophi < nphi; iophi++)
+        for (int ioz = 0; ioz < nz; ioz++, index++)
         {
-          for (int ioz = 0; ioz < nz; ioz++)
+          if (ifr == ior && 0 == iophi && ifz == ioz)
           {
-            el++;
-            from = GetCellCenter(ior, iophi, ioz);
-            //*f[ifx][ify][ifz][iox][ioy][ioz]=cacl_unit_field(at,from);
-            // print_need_cout("calc_unit_field...\n");
-            if (ifr == ior && 0 == iophi && ifz == ioz)
-            {
-              if (!(el % percent))
-              {
-                std::cout << std::format("populate_phislice_lookup {}%:  ", static_cast<uint64_t>(debug_npercent) * el / percent);
-
-                std::cout << std::format("self-to-self is zero (ir={}, iphi={}, iz={}) to (or={}, ophi=0, oz={}) gives ({:E},{:E},{:E})",
-                                         ior, iophi, ioz, ifr, ifz, zero.X(), zero.Y(), zero.Z())
-                          << std::endl;
-              }
-              Epartial_phislice->Set(ifr - rmin_roi, 0, ifz - zmin_roi, ior, iophi, ioz, zero);
-            }
-            else
-            {
-              TVector3 unitf = calc_unit_field(at, from);
-              if (true)
-              {
-                if (!(el % percent))
-                {
-                  std::cout << std::format("populate_phislice_lookup {}%:  ", static_cast<uint64_t>(debug_npercent) * el / percent);
-
-                  std::cout << std::format("calc_unit_field (ir={}, iphi={}, iz={}) to (or={}, ophi=0, oz={}) gives ({:E},{:E},{:E})",
-                                           ior, iophi, ioz, ifr, ifz, unitf.X(), unitf.Y(), unitf.Z())
-                            << std::endl;
-                }
-              }
-
-              Epartial_phislice->Set(ifr - rmin_roi, 0, ifz - zmin_roi, ior, iophi, ioz, unitf);  // the origin phi is relative to zero anyway.
-            }
+            continue;  // self-to-self stays zero
           }
+          unitf = calc_unit_field(at, GetCellCenter(ior, iophi, ioz));
+          Epartial_phislice->Set(index, unitf.X(), unitf.Y(), unitf.Z());  // the origin phi is relative to zero anyway.
         }
       }
     }
+#pragma omp critical(annularfieldsim_progress)
+    {
+      if (!(++done % percent))
+      {
+        std::cout << std::format("populate_phislice_lookup {}%:  ", static_cast<uint64_t>(debug_npercent) * done / percent);
+
+        std::cout << std::format("calc_unit_field at (ir={}, iphi=0, iz={}) from (or={}, ophi={}, oz={}) gives ({:E},{:E},{:E})",
+                                 ifr, ifz, nr - 1, nphi - 1, nz - 1, unitf.X(), unitf.Y(), unitf.Z())
+                  << std::endl;
+      }
+    }
   }
   return;
 }
@@ -2063,6 +2064,12 @@ void AnnularFieldSim::load_phislice_lookup(const std::string &sourcefile)
   unsigned long long percent = totalelements / 100 * debug_npercent;
   std::cout << std::format("total elements = {}", totalelements) << std::endl;
 
+  if (Epartial_phislice->IsMapped())
+  {
+    std::cout << "phislice lookup was already loaded with load_lookup_binary, not reading it again" << std::endl;
+    return;
+  }
+
   TFile *input = TFile::Open(sourcefile.c_str(), "READ");
   TTree *tInfo;
   input->GetObject("info", tInfo);
@@ -2141,7 +2148,8 @@ void AnnularFieldSim::load_phislice_lookup(const std::string &sourcefile)
     el++;
     tLookup->GetEntry(i);
     // print_need_cout("loading i=%d\n",i);
-    Epartial_phislice->Set(ifr - rmin_roi, 0, ifz - zmin_roi, ior, iophi, ioz, (*unitf) * (-1.0) * (V / (cm * C)));  // load assuming field has units V/(C*cm), which is how we save it.
+    TVector3 loaded = (*unitf) * (-1.0) * (V / (cm * C));  // load assuming field has units V/(C*cm), which is how we save it.
+    Epartial_phislice->Set(Epartial_phislice->Index(ifr - rmin_roi, 0, ifz - zmin_roi, ior, iophi, ioz), loaded.X(), loaded.Y(), loaded.Z());
     // note that we save the gradient terms, not the field, hence we need to multiply by (-1.0)
     if (!(el % percent))
     {
@@ -2216,7 +2224,9 @@ void AnnularFieldSim::save_phislice_lookup(const std::string &destfile)
           for (ioz = 0; ioz < nz; ioz++)
           {
             el++;
-            unitf = Epartial_phislice->Get(ifr - rmin_roi, 0, ifz - zmin_roi, ior, iophi, ioz) * (-1 / (V / (C * cm)));  // save in units of V/(C*cm) note that we introduce a -1 here for legcy reasons.
+            const size_t index = Epartial_phislice->Index(ifr - rmin_roi, 0, ifz - zmin_roi, ior, iophi, ioz);
+            unitf.SetXYZ(Epartial_phislice->X()[index], Epartial_phislice->Y()[index], Epartial_phislice->Z()[index]);
+            unitf *= (-1 / (V / (C * cm)));  // save in units of V/(C*cm) note that we introduce a -1 here for legcy reasons.
             if (true)
             {
               if (!(el % percent))
@@ -2243,6 +2253,97 @@ void AnnularFieldSim::save_phislice_lookup(const std::string &destfile)
   return;
 }
 
+GreenLookupTable *AnnularFieldSim::ActiveLookup() const
+{
+  if (lookupCase == Full3D)
+  {
+    return Epartial;
+  }
+  if (lookupCase == PhiSlice)
+  {
+    return Epartial_phislice;
+  }
+  return nullptr;
+}
+
+GreenLookupTable::Geometry AnnularFieldSim::LookupGeometry() const
+{
+  GreenLookupTable::Geometry geo;
+  geo.rmin = rmin;
+  geo.rmax = rmax;
+  geo.zmin = zmin;
+  geo.zmax = zmax;
+  geo.rmin_roi = rmin_roi;
+  geo.rmax_roi = rmax_roi;
+  geo.phimin_roi = phimin_roi;
+  geo.phimax_roi = phimax_roi;
+  geo.zmin_roi = zmin_roi;
+  geo.zmax_roi = zmax_roi;
+  geo.nr = nr;
+  geo.nphi = nphi;
+  geo.nz = nz;
+  geo.lookup = lookupCase;
+  return geo;
+}
+
+bool AnnularFieldSim::load_lookup_binary(const std::string &sourcefile)
+{
+  GreenLookupTable *table = ActiveLookup();
+  if (!table)
+  {
+    std::cout << "AnnularFieldSim::load_lookup_binary: binary lookup tables are only available for Full3D and PhiSlice" << std::endl;
+    return false;
+  }
+  std::cout << std::format("AnnularFieldSim::load_lookup_binary: mapping {} elements from {}", table->Length(), sourcefile) << std::endl;
+  return table->Map(sourcefile, LookupGeometry());
+}
+
+bool AnnularFieldSim::save_lookup_binary(const std::string &destfile)
+{
+  GreenLookupTable *table = ActiveLookup();
+  if (!table)
+  {
+    std::cout << "AnnularFieldSim::save_lookup_binary: binary lookup tables are only available for Full3D and PhiSlice" << std::endl;
+    return false;
+  }
+  std::cout << std::format("AnnularFieldSim::save_lookup_binary: saving {} elements to {}", table->Length(), destfile) << std::endl;
+  return table->Save(destfile, LookupGeometry());
+}
+
+std::vector<float> AnnularFieldSim::charge_snapshot() const
+{
+  // copy of the charge in every f-bin, indexed [r][phi][z], so that the field sums read contiguous memory
+  std::vector<float> charge(static_cast<size_t>(nr) * nphi * nz);
+  size_t index = 0;
+  for (int ir = 0; ir < nr; ir++)
+  {
+    for (int iphi = 0; iphi < nphi; iphi++)
+    {
+      for (int iz = 0; iz < nz; iz++)
+      {
+        charge[index++] = q->GetChargeInBin(ir, iphi, iz);
+      }
+    }
+  }
+  return charge;
+}
+
+void AnnularFieldSim::precalc_green_radii()
+{
+  // lookup tables only ask for fields between cell centers, so the radial Bessel terms can be computed once per radial bin.
+  if (green == nullptr)
+  {
+    return;
+  }
+  std::vector<double> radii;
+  for (int ir = 0; ir < nr; ir++)
+  {
+    radii.push_back(GetCellCenter(ir, 0, 0).Perp());
+  }
+  green->PrecalcRnk(radii);
+  return;
+}
+
 void AnnularFieldSim::setFlatFields(float B, float E)
 {
   // these only cover the roi, but since we address them flat, we don't need to know that here.
@@ -2265,7 +2366,7 @@ void AnnularFieldSim::setFlatFields(float B, float E)
   return;
 }
 
-TVector3 AnnularFieldSim::sum_field_at(int r, int phi, int z)
+TVector3 AnnularFieldSim::sum_field_at(int r, int phi, int z, const float *charge)
 {
   // sum the E field over all nr by ny by nz cells of sources, at the global coordinate position r,phi,z.
   // note the specific position in Epartial is in relative coordinates.
@@ -2282,7 +2383,7 @@ TVector3 AnnularFieldSim::sum_field_at(int r, int phi, int z)
   TVector3 sum(0, 0, 0);
   if (lookupCase == Full3D)
   {
-    sum += sum_full3d_field_at(r, phi, z);
+    sum += sum_full3d_field_at(r, phi, z, charge);
   }
   else if (lookupCase == HybridRes)
   {
@@ -2291,7 +2392,7 @@ TVector3 AnnularFieldSim::sum_field_at(int r, int phi, int z)
   }
   else if (lookupCase == PhiSlice)
   {
-    sum += sum_phislice_field_at(r, phi, z);
+    sum += sum_phislice_field_at(r, phi, z, charge);
   }
   else if (lookupCase == Analytic)
   {
@@ -2310,12 +2411,24 @@ TVector3 AnnularFieldSim::sum_field_at(int r, int phi, int z)
   return sum;
 }
 
-TVector3 AnnularFieldSim::sum_full3d_field_at(int r, int phi, int z)
+TVector3 AnnularFieldSim::sum_full3d_field_at(int r, int phi, int z, const float *charge)
 {
   // sum the E field over all nr by ny by nz cells of sources, at the specific position r,phi,z.
   // note the specific position in Epartial is in relative coordinates.
   // print_need_cout("AnnularFieldSim::sum_field_at(r=%d,phi=%d, z=%d)\n",r,phi,z);
-  TVector3 sum(0, 0, 0);
+  std::vector<float> snapshot;
+  if (!charge)
+  {
+    snapshot = charge_snapshot();
+    charge = snapshot.data();
+  }
+  const size_t offset = Epartial->TargetOffset(r - rmin_roi, phi - phimin_roi, z - zmin_roi);
+  const float *ex = Epartial->X() + offset;
+  const float *ey = Epartial->Y() + offset;
+  const float *ez = Epartial->Z() + offset;
+  double sumx = 0;
+  double sumy = 0;
+  double sumz = 0;
   float rdist;
   float phidist;
   float zdist;
@@ -2342,6 +2455,7 @@ TVector3 AnnularFieldSim::sum_full3d_field_at(int r, int phi, int z)
           continue;  // skip if we're too far away
         }
       }
+      const size_t row = (static_cast<size_t>(ir) * nphi + iphi) * nz;
       for (int iz = 0; iz < nz; iz++)
       {
         if (truncation_length > 0)
@@ -2354,16 +2468,16 @@ TVector3 AnnularFieldSim::sum_full3d_field_at(int r, int phi, int z)
           }
         }
         // sum+=*partial[x][phi][z][ix][iphi][iz] * *q[ix][iphi][iz];
-        if (r == ir && phi == iphi && z == iz)
-        {
-          continue;  // dont' compute self-to-self field.
-        }
-        sum += Epartial->Get(r - rmin_roi, phi - phimin_roi, z - zmin_roi, ir, iphi, iz) * q->GetChargeInBin(ir, iphi, iz);
+        // the self-to-self element of the table is zero, so it does not need to be skipped.
+        const double qbin = charge[row + iz];
+        sumx += ex[row + iz] * qbin;
+        sumy += ey[row + iz] * qbin;
+        sumz += ez[row + iz] * qbin;
       }
     }
   }
   // print_need_cout("summed field at (%d,%d,%d)=(%f,%f,%f)\n",x,y,z,sum.X(),sum.Y(),sum.Z());
-  return sum;
+  return TVector3(sumx, sumy, sumz);
 }
 
 TVector3 AnnularFieldSim::sum_local_field_at(int r, int phi, int z)
@@ -2680,7 +2794,7 @@ TVector3 AnnularFieldSim::sum_nonlocal_field_at(int r, int phi, int z)
   return sum;
 }
 
-TVector3 AnnularFieldSim::sum_phislice_field_at(int r, int phi, int z)
+TVector3 AnnularFieldSim::sum_phislice_field_at(int r, int phi, int z, const float *charge)
 {
   // sum the E field over all nr by ny by nz cells of sources, at the specific position r,phi,z.
   // note the specific position in Epartial is in relative coordinates.
@@ -2689,44 +2803,41 @@ TVector3 AnnularFieldSim::sum_phislice_field_at(int r, int phi, int z)
   TVector3 slicepos = GetRoiCellCenter(r - rmin_roi, 0, z - zmin_roi);
   float rotphi = pos.Phi() - slicepos.Phi();  // probably this is phi*step.Phi();
 
-  // caution:  if you print progress of each of these, it will print a great deal of data, since this is called per-bin
-  // unsigned long long totalelements=nr*nphi*nz;
-  //  unsigned long long percent=totalelements/100;
-
-  // unsigned long long el=0;
+  std::vector<float> snapshot;
+  if (!charge)
+  {
+    snapshot = charge_snapshot();
+    charge = snapshot.data();
+  }
 
-  TVector3 sum(0, 0, 0);
-  TVector3 unrotatedField(0, 0, 0);
-  TVector3 unitField(0, 0, 0);
-  int phirel;
+  // the table holds the field in the phi=0 slice.  Sum it there, with the charge shifted by phi, and rotate the total once:
+  // rotation is linear, so this is the same as rotating every term.
+  // the self-to-self element of the table is zero, so it does not need to be skipped.
+  const size_t offset = Epartial_phislice->TargetOffset(r - rmin_roi, 0, z - zmin_roi);
+  const float *ex = Epartial_phislice->X() + offset;
+  const float *ey = Epartial_phislice->Y() + offset;
+  const float *ez = Epartial_phislice->Z() + offset;
+  double sumx = 0;
+  double sumy = 0;
+  double sumz = 0;
   for (int ir = 0; ir < nr; ir++)
   {
     for (int iphi = 0; iphi < nphi; iphi++)
     {
+      const int phirel = FilterPhiIndex(iphi - phi);
+      const float *qrow = charge + (static_cast<size_t>(ir) * nphi + iphi) * nz;
+      const size_t row = (static_cast<size_t>(ir) * nphi + phirel) * nz;
       for (int iz = 0; iz < nz; iz++)
       {
-        // sum+=*partial[x][phi][z][ix][iphi][iz] * *q[ix][iphi][iz];
-        if (r == ir && phi == iphi && z == iz)
-        {
-          continue;  // dont' compute self-to-self field.
-        }
-        phirel = FilterPhiIndex(iphi - phi);
-        unitField = Epartial_phislice->Get(r - rmin_roi, 0, z - zmin_roi, ir, phirel, iz);
-        unitField.RotateZ(rotphi);  // previously was rotate by the step.Phi()*phi.    //annoying that I can't rename this to 'rotated field' here without unnecessary overhead.
-
-        sum += unitField * q->GetChargeInBin(ir, iphi, iz);
-        ;
-
-        /*
-        if(!(el%percent)) {print_need_cout("summing phislices %d%%:  ",(int)(el/percent));
-          print_need_cout("unit field at (r=%d,p=%d,z=%d) from  (ir=%d,ip=%d,iz=%d) is (%E,%E,%E) (xyz), q=%E\n",
-                 r,phi,z,ir,iphi,iz,unitField.X(),unitField.Y(),unitField.Z(),q->GetChargeInBin(ir,iphi,iz));
-        }
-        el++;
-        */
+        const double qbin = qrow[iz];
+        sumx += ex[row + iz] * qbin;
+        sumy += ey[row + iz] * qbin;
+        sumz += ez[row + iz] * qbin;
       }
     }
   }
+  TVector3 sum(sumx, sumy, sumz);
+  sum.RotateZ(rotphi);  // previously was rotate by the step.Phi()*phi.
   // print_need_cout("summed field at (%d,%d,%d)=(%f,%f,%f)\n",x,y,z,sum.X(),sum.Y(),sum.Z());
   return sum;
 }
@@ -2952,6 +3063,81 @@ TVector3 AnnularFieldSim::GetTotalDistortion(float zdest, const TVector3 &start,
   return accumulated_distortion;
 }
 
+void AnnularFieldSim::BuildColumnIntegral(MultiArray<TVector3> *field, ColumnIntegral &columns)
+{
+  const size_t length = static_cast<size_t>(nr_roi) * nphi_roi * (nz_roi + 1);
+  columns.ix.assign(length, 0);
+  columns.iy.assign(length, 0);
+  columns.iz.assign(length, 0);
+  size_t index = 0;
+  for (int ir = 0; ir < nr_roi; ir++)
+  {
+    for (int iphi = 0; iphi < nphi_roi; iphi++)
+    {
+      double sumx = 0;
+      double sumy = 0;
+      double sumz = 0;
+      for (int iz = 0; iz < nz_roi; iz++, index++)
+      {
+        columns.ix[index] = sumx;
+        columns.iy[index] = sumy;
+        columns.iz[index] = sumz;
+        const TVector3 contribution = field->Get(ir, iphi, iz) * step.Z();
+        sumx += contribution.X();
+        sumy += contribution.Y();
+        sumz += contribution.Z();
+      }
+      columns.ix[index] = sumx;
+      columns.iy[index] = sumy;
+      columns.iz[index] = sumz;
+      index++;
+    }
+  }
+  return;
+}
+
+const AnnularFieldSim::ColumnIntegral *AnnularFieldSim::FindColumnIntegral(const MultiArray<TVector3> *field) const
+{
+  if (!useColumnIntegrals)
+  {
+    return nullptr;
+  }
+  if (field == Efield)
+  {
+    return &EfieldColumns;
+  }
+  if (field == Bfield)
+  {
+    return &BfieldColumns;
+  }
+  return nullptr;
+}
+
+void AnnularFieldSim::GetTotalDistortionBatch(float zdest, int n, const double *x, const double *y, const double *z, int nsteps,
+                                              double *dx, double *dy, double *dz, int *goodToStep, int *success)
+{
+  // the fields do not change while drifting, so the z integrals along each column are computed once for the whole batch.
+  BuildColumnIntegral(Efield, EfieldColumns);
+  BuildColumnIntegral(Bfield, BfieldColumns);
+  useColumnIntegrals = true;
+
+  // each electron is independent.  The R vs deltaR monitor histogram is the only shared output, so fill it serially.
+  const bool parallel = !RdeltaRswitch;
+  const int nthreads = NumThreads();
+#pragma omp parallel for schedule(dynamic, 16) if (parallel) num_threads(nthreads)
+  for (int i = 0; i < n; i++)
+  {
+    const TVector3 start(x[i], y[i], z[i]);
+    const TVector3 distortion = GetTotalDistortion(zdest, start, nsteps, true, &goodToStep[i], &success[i]);
+    dx[i] = distortion.X();
+    dy[i] = distortion.Y();
+    dz[i] = distortion.Z();
+  }
+
+  useColumnIntegrals = false;
+  return;
+}
+
 void AnnularFieldSim::PlotFieldSlices(const std::string &filebase, const TVector3 &pos, char which)
 {
   bool mapEfield = true;
@@ -3342,6 +3528,11 @@ void AnnularFieldSim::GenerateSeparateDistortionMaps(const std::string &filebase
   //  normal.
 
   // note that we apply the adjustment to the particle position (inpart) and not the plotted position (partR etc)
+  const size_t npoints = static_cast<size_t>(nrh) * nph * nzh;
+  std::vector<double> startX(npoints);
+  std::vector<double> startY(npoints);
+  std::vector<double> startZ[2];
+  startZ[0].resize(npoints);
   inpart.SetXYZ(1, 0, 0);
   for (ir = 0; ir < nrh; ir++)
   {
@@ -3378,23 +3569,64 @@ void AnnularFieldSim::GenerateSeparateDistortionMaps(const std::string &filebase
         {
           inpart.SetZ(partZ);
         }
-        partZ += 0.5 * deltaz;  // move to center of histogram bin.
+        const size_t ipoint = (static_cast<size_t>(ir) * nph + ip) * nzh + iz;
+        startX[ipoint] = inpart.X();
+        startY[ipoint] = inpart.Y();
+        startZ[0][ipoint] = inpart.Z();
+      }
+    }
+  }
+
+  // drift the whole grid for each side in one batch.  If we have more than one side,
+  // flip z coords and do the twin instead.
+  std::vector<double> batchX[2];
+  std::vector<double> batchY[2];
+  std::vector<double> batchZ[2];
+  std::vector<int> batchValidToStep[2];
+  std::vector<int> batchSuccess[2];
+  for (int localside = 0; localside < nSides; localside++)
+  {
+    if (localside == 1)
+    {
+      startZ[1].resize(npoints);
+      std::transform(startZ[0].begin(), startZ[0].end(), startZ[1].begin(), [](double zpos)
+                     { return -zpos; });
+    }
+    batchX[localside].resize(npoints);
+    batchY[localside].resize(npoints);
+    batchZ[localside].resize(npoints);
+    batchValidToStep[localside].resize(npoints);
+    batchSuccess[localside].resize(npoints);
+    AnnularFieldSim *sim = (localside == 0) ? this : twin;
+    sim->GetTotalDistortionBatch(localside == 0 ? z_readout : -z_readout, static_cast<int>(npoints), startX.data(), startY.data(), startZ[localside].data(), nSteps,
+                                 batchX[localside].data(), batchY[localside].data(), batchZ[localside].data(),
+                                 batchValidToStep[localside].data(), batchSuccess[localside].data());
+  }
+  std::cout << "Drifted all starting points.  Filling maps..." << std::endl;
+
+  for (ir = 0; ir < nrh; ir++)
+  {
+    partR = (ir + 0.5) * deltar + rih;
+    for (ip = 0; ip < nph; ip++)
+    {
+      partP = (ip + 0.5) * deltap + pih;
+      for (iz = 0; iz < nzh; iz++)
+      {
+        partZ = (iz) *deltaz + zih;  // start us at the EDGE of the bin,
+        partZ += 0.5 * deltaz;       // move to center of histogram bin.
+        const size_t ipoint = (static_cast<size_t>(ir) * nph + ip) * nzh + iz;
+        inpart.SetXYZ(startX[ipoint], startY[ipoint], startZ[0][ipoint]);
         for (int localside = 0; localside < nSides; localside++)
         {
-          if (localside == 0)
-          {
-            diffdistort = zero_vector;  // GetTotalDistortion(inpart.Z() + deltaz, inpart, nSteps, true, &validToStep, &successCheck);
-            distort = GetTotalDistortion(z_readout, inpart, nSteps, true, &validToStep, &successCheck);
-          }
-          else
+          if (localside == 1)
           {
-            // if we have more than one side,
-            // flip z coords and do the twin instead:
             partZ *= -1;                   // position to place in histogram
             inpart.SetZ(-1 * inpart.Z());  // position to seek in sim
-            diffdistort = zero_vector;     // twin->GetTotalDistortion(inpart.Z() - deltaz, inpart, nSteps, true, &validToStep, &successCheck);
-            distort = twin->GetTotalDistortion(-z_readout, inpart, nSteps, true, &validToStep, &successCheck);
           }
+          diffdistort = zero_vector;  // differential distortions are not generated.
+          distort.SetXYZ(batchX[localside][ipoint], batchY[localside][ipoint], batchZ[localside][ipoint]);
+          validToStep = batchValidToStep[localside][ipoint];
+          successCheck = batchSuccess[localside][ipoint];
 
           diffdistort.RotateZ(-inpart.Phi());  // rotate so that distortion components are wrt the x axis
           diffdistP = diffdistort.Y();         // the phi component is now the y component.
@@ -1,3 +1,4 @@
+#include "GreenLookupTable.h"
 #include "Rossegger.h"
 
 #include <TVector3.h>
@@ -5,6 +6,7 @@
 #include <cmath>
 #include <limits>
 #include <string>
+#include <vector>
 
 class AnalyticFieldModel;
 class ChargeMapReader;
@@ -94,6 +96,12 @@ class AnnularFieldSim
     truncation_length = x;
     return;
   }
+  // threads used to build the lookup tables, sum the fields and drift electron batches.  0 means all available threads
+  void SetNumThreads(int n)
+  {
+    num_threads = n;
+    return;
+  }
 
   // getters for internal states:
   std::string GetLookupString();
@@ -201,22 +209,30 @@ class AnnularFieldSim
 
   void load_phislice_lookup(const std::string &sourcefile);
   void save_phislice_lookup(const std::string &destfile);
+  // flat binary copy of the Full3D or PhiSlice lookup table.  Loading maps the file read-only, so concurrent jobs on one node share it.
+  bool load_lookup_binary(const std::string &sourcefile);
+  bool save_lookup_binary(const std::string &destfile);
 
   Rossegger *green;   // stand-alone class to compute greens functions.
   float green_shift;  // how far to offset our position in z when querying our green's functions.
   AnnularFieldSim *twin = nullptr;
   bool hasTwin = false;
 
-  TVector3 sum_field_at(int r, int phi, int z);
-  TVector3 sum_full3d_field_at(int r, int phi, int z);
+  // charge is an optional snapshot of the full charge map, indexed [r][phi][z], as made by charge_snapshot()
+  TVector3 sum_field_at(int r, int phi, int z, const float *charge = nullptr);
+  TVector3 sum_full3d_field_at(int r, int phi, int z, const float *charge = nullptr);
   TVector3 sum_local_field_at(int r, int phi, int z);
   TVector3 sum_nonlocal_field_at(int r, int phi, int z);
-  TVector3 sum_phislice_field_at(int r, int phi, int z);
+  TVector3 sum_phislice_field_at(int r, int phi, int z, const float *charge = nullptr);
   TVector3 swimToInAnalyticSteps(float zdest, TVector3 start, int steps, int *goodToStep);
   TVector3 swimToInSteps(float zdest, const TVector3 &start, int steps, bool interpolate, int *goodToStep);
   TVector3 swimTo(float zdest, const TVector3 &start, bool interpolate = true, bool useAnalytic = false);
   TVector3 GetStepDistortion(float zdest, const TVector3 &start, bool interpolate = true, bool useAnalytic = false);
   TVector3 GetTotalDistortion(float zdest, const TVector3 &start, int nsteps, bool interpolate = true, int *goodToStep = 0, int *success = 0);
+  // drift n electrons from (x,y,z)[i] to zdest, filling the total distortion (dx,dy,dz)[i] and the GetTotalDistortion status flags.
+  // electrons are drifted in parallel, with the interpolated field integrals read from per-column running sums.
+  void GetTotalDistortionBatch(float zdest, int n, const double *x, const double *y, const double *z, int nsteps,
+                               double *dx, double *dy, double *dz, int *goodToStep, int *success);
 
  private:
   BoundsCase GetRindexAndCheckBounds(float pos, int *r);
@@ -226,6 +242,22 @@ class AnnularFieldSim
   int GetPhiIndex(float pos);
   int GetZindex(float pos);
 
+  // running z integral of a field along each (r,phi) column of the roi, so that interpolatedFieldIntegral
+  // does not need to loop over z.  Indexed [r][phi][z] with nz_roi+1 entries in z: the integral from the
+  // low edge of the roi to the low edge of each cell.
+  struct ColumnIntegral
+  {
+    std::vector<double> ix, iy, iz;
+  };
+  void BuildColumnIntegral(MultiArray<TVector3> *field, ColumnIntegral &columns);
+  const ColumnIntegral *FindColumnIntegral(const MultiArray<TVector3> *field) const;
+
+  GreenLookupTable *ActiveLookup() const;
+  GreenLookupTable::Geometry LookupGeometry() const;
+  std::vector<float> charge_snapshot() const;
+  void precalc_green_radii();
+  int NumThreads() const;
+
   void UpdateOmegaTau()
   {
     omegatau_nominal = -Bnominal * vdrift / std::abs(Enominal);
@@ -339,10 +371,14 @@ class AnnularFieldSim
   MultiArray<TVector3> *Efield;             // total electric field in each f-bin in the roi for given configuration of charge AND external field.
   MultiArray<TVector3> *Epartial_highres;   // electric field in each f-bin in the roi from charge in a given f-bin or summed bin in the high res region.
   MultiArray<TVector3> *Epartial_lowres;    // electric field in each l-bin in the roi from charge in a given l-bin anywhere in the volume.
-  MultiArray<TVector3> *Epartial;           // electric field for the old brute-force model.
-  MultiArray<TVector3> *Epartial_phislice;  // electric field in a 2D phi-slice from the full 3D region.
+  GreenLookupTable *Epartial;               // electric field for the old brute-force model.
+  GreenLookupTable *Epartial_phislice;      // electric field in a 2D phi-slice from the full 3D region.
   MultiArray<TVector3> *Eexternal;          // externally applied electric field in each f-bin in the roi
   MultiArray<TVector3> *Bfield;             // magnetic field in each f-bin in the roi
+  ColumnIntegral EfieldColumns;             // column integrals of Efield and Bfield, only used while drifting a batch
+  ColumnIntegral BfieldColumns;
+  bool useColumnIntegrals{false};
+  int num_threads{1};  // opt-in threading, see SetNumThreads
 
   ChargeMapReader *q;            // //class to read and report charge.
                                  //  MultiArray<double> *q;                    //space charge in each f-bin in the whole volume
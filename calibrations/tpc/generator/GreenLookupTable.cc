@@ -0,0 +1,168 @@
+#include "GreenLookupTable.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+  const char fileMagic[8] = {'A', 'F', 'S', 'G', 'R', 'E', 'E', 'N'};
+  const uint32_t fileVersion = 1;
+  const size_t dataOffset = 4096;  // keep the arrays page aligned in the file
+
+  struct FileHeader
+  {
+    char magic[8];
+    uint32_t version;
+    uint32_t offset;
+    int64_t n[6];
+    GreenLookupTable::Geometry geo;
+  };
+}  // namespace
+
+bool GreenLookupTable::Geometry::operator==(const Geometry &other) const
+{
+  return rmin == other.rmin && rmax == other.rmax && zmin == other.zmin && zmax == other.zmax &&
+         rmin_roi == other.rmin_roi && rmax_roi == other.rmax_roi &&
+         phimin_roi == other.phimin_roi && phimax_roi == other.phimax_roi &&
+         zmin_roi == other.zmin_roi && zmax_roi == other.zmax_roi &&
+         nr == other.nr && nphi == other.nphi && nz == other.nz &&
+         lookup == other.lookup;
+}
+
+GreenLookupTable::GreenLookupTable(int tr, int tphi, int tz, int sr, int sphi, int sz)
+  : n{tr, tphi, tz, sr, sphi, sz}
+  , sourceLength(static_cast<size_t>(sr) * sphi * sz)
+  , length(static_cast<size_t>(tr) * tphi * tz * sourceLength)
+{
+  owned = static_cast<float *>(calloc(3 * length, sizeof(float)));
+  if (!owned)
+  {
+    std::cout << std::format("GreenLookupTable: could not allocate {} elements", 3 * length) << std::endl;
+    exit(1);
+  }
+  fx = owned;
+  fy = fx + length;
+  fz = fy + length;
+}
+
+GreenLookupTable::~GreenLookupTable()
+{
+  Release();
+}
+
+void GreenLookupTable::Release()
+{
+  free(owned);
+  owned = nullptr;
+  if (mapped)
+  {
+    munmap(mapped, mappedSize);
+    mapped = nullptr;
+    mappedSize = 0;
+  }
+}
+
+bool GreenLookupTable::Save(const std::string &filename, const Geometry &geo) const
+{
+  const std::string tmpname = std::format("{}.tmp{}", filename, static_cast<int>(getpid()));
+  std::ofstream out(tmpname, std::ios::binary | std::ios::trunc);
+  if (!out)
+  {
+    std::cout << std::format("GreenLookupTable::Save - could not open {}", tmpname) << std::endl;
+    return false;
+  }
+
+  FileHeader header{};
+  std::memcpy(header.magic, fileMagic, sizeof(fileMagic));
+  header.version = fileVersion;
+  header.offset = dataOffset;
+  for (int i = 0; i < 6; i++)
+  {
+    header.n[i] = n[i];
+  }
+  header.geo = geo;
+
+  std::vector<char> block(dataOffset, 0);
+  std::memcpy(block.data(), &header, sizeof(header));
+  out.write(block.data(), block.size());
+  for (const float *component : {fx, fy, fz})
+  {
+    out.write(reinterpret_cast<const char *>(component), length * sizeof(float));
+  }
+  out.close();
+  if (!out || std::rename(tmpname.c_str(), filename.c_str()) != 0)
+  {
+    std::cout << std::format("GreenLookupTable::Save - error writing {}", filename) << std::endl;
+    std::remove(tmpname.c_str());
+    return false;
+  }
+  return true;
+}
+
+bool GreenLookupTable::Map(const std::string &filename, const Geometry &geo)
+{
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    std::cout << std::format("GreenLookupTable::Map - could not open {}", filename) << std::endl;
+    return false;
+  }
+
+  struct stat st{};
+  const size_t expected = dataOffset + 3 * length * sizeof(float);
+  if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) != expected)
+  {
+    std::cout << std::format("GreenLookupTable::Map - {} has size {}, expected {}", filename, static_cast<size_t>(st.st_size), expected) << std::endl;
+    close(fd);
+    return false;
+  }
+
+  void *ptr = mmap(nullptr, expected, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);  // the mapping stays valid
+  if (ptr == MAP_FAILED)
+  {
+    std::cout << std::format("GreenLookupTable::Map - mmap of {} failed", filename) << std::endl;
+    return false;
+  }
+
+  FileHeader header{};
+  std::memcpy(&header, ptr, sizeof(header));
+  bool ok = std::memcmp(header.magic, fileMagic, sizeof(fileMagic)) == 0 && header.version == fileVersion && header.offset == dataOffset;
+  for (int i = 0; ok && i < 6; i++)
+  {
+    ok = header.n[i] == n[i];
+  }
+  if (!ok)
+  {
+    std::cout << std::format("GreenLookupTable::Map - {} is not a lookup table with matching dimensions", filename) << std::endl;
+    munmap(ptr, expected);
+    return false;
+  }
+  if (header.geo != geo)
+  {
+    std::cout << std::format("GreenLookupTable::Map - {} was built for a different geometry", filename) << std::endl;
+    munmap(ptr, expected);
+    return false;
+  }
+
+  // advise the kernel that we will read everything, then drop our own copy
+  madvise(ptr, expected, MADV_WILLNEED);
+  Release();
+  mapped = ptr;
+  mappedSize = expected;
+  char *data = static_cast<char *>(ptr) + dataOffset;
+  fx = reinterpret_cast<float *>(data);
+  fy = fx + length;
+  fz = fy + length;
+  return true;
+}
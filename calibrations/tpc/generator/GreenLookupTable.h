@@ -0,0 +1,95 @@
+#ifndef GREENLOOKUPTABLE_H
+#define GREENLOOKUPTABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Green's function lookup table: field at a target cell from unit charge in a source cell.
+// Stored as three float arrays (x, y, z components), indexed [target r][target phi][target z][source r][source phi][source z],
+// so that the source block of a given target is contiguous.  This is a third of the footprint of the equivalent MultiArray<TVector3>
+// and can be summed without unpacking TVector3s.
+//
+// Tables can be saved to a flat binary file, which Map() attaches read-only with mmap.  Jobs on the same node then share one copy
+// of the table through the page cache instead of each rebuilding or reading it.
+class GreenLookupTable
+{
+ public:
+  // parameters the table was built for.  A table is only valid for an identical configuration.
+  struct Geometry
+  {
+    float rmin{0};
+    float rmax{0};
+    float zmin{0};
+    float zmax{0};
+    int32_t rmin_roi{0};
+    int32_t rmax_roi{0};
+    int32_t phimin_roi{0};
+    int32_t phimax_roi{0};
+    int32_t zmin_roi{0};
+    int32_t zmax_roi{0};
+    int32_t nr{0};
+    int32_t nphi{0};
+    int32_t nz{0};
+    int32_t lookup{0};  // AnnularFieldSim::LookupCase
+
+    bool operator==(const Geometry &other) const;
+    bool operator!=(const Geometry &other) const { return !(*this == other); }
+  };
+
+  // allocates a zeroed table.  Memory is only committed when written to, so a table that is then mapped from a file costs nothing.
+  GreenLookupTable(int tr, int tphi, int tz, int sr, int sphi, int sz);
+  ~GreenLookupTable();
+  //! delete copy ctor and assignment operator
+  GreenLookupTable(const GreenLookupTable &) = delete;
+  GreenLookupTable &operator=(const GreenLookupTable &) = delete;
+
+  size_t Length() const { return length; }
+  size_t SourceLength() const { return sourceLength; }
+
+  // offset of the source block for a given target cell
+  size_t TargetOffset(int tr, int tphi, int tz) const
+  {
+    return ((static_cast<size_t>(tr) * n[1] + tphi) * n[2] + tz) * sourceLength;
+  }
+  size_t Index(int tr, int tphi, int tz, int sr, int sphi, int sz) const
+  {
+    return TargetOffset(tr, tphi, tz) + (static_cast<size_t>(sr) * n[4] + sphi) * n[5] + sz;
+  }
+
+  const float *X() const { return fx; }
+  const float *Y() const { return fy; }
+  const float *Z() const { return fz; }
+
+  // writing is only allowed to tables we own (not mapped from a file).  Different threads may fill different elements.
+  void Set(size_t index, double x, double y, double z)
+  {
+    fx[index] = x;
+    fy[index] = y;
+    fz[index] = z;
+  }
+
+  bool IsMapped() const { return mapped != nullptr; }
+
+  // write the table as a flat binary file.  The file is written under a temporary name and renamed, so concurrent jobs never see a partial file.
+  bool Save(const std::string &filename, const Geometry &geo) const;
+  // attach a file written by Save, read-only, replacing the current contents.  Fails if dimensions or geometry differ.
+  bool Map(const std::string &filename, const Geometry &geo);
+
+ private:
+  void Release();
+
+  int n[6]{0, 0, 0, 0, 0, 0};
+  size_t sourceLength{0};
+  size_t length{0};
+
+  float *owned{nullptr};  // owned components, x then y then z.  calloc'd so untouched pages are never committed
+  float *fx{nullptr};
+  float *fy{nullptr};
+  float *fz{nullptr};
+
+  void *mapped{nullptr};  // mmap'd file, if any
+  size_t mappedSize{0};
+};
+
+#endif
@@ -350,6 +350,8 @@ double Rossegger::Limu(double mu, double x)
   int IERRO = 0;
 
   double X = x;
+  // the fortran routines keep intermediate values in COMMON blocks
+#pragma omp critical(rossegger_fortran)
   dlia_(&IFAC, &X, &A, &DLI, &DERR, &IERRO);
   return DLI;
 }
@@ -362,10 +364,50 @@ double Rossegger::Kimu(double mu, double x)
   int IERRO = 0;
 
   double X = x;
+#pragma omp critical(rossegger_fortran)
   dkia_(&IFAC, &X, &A, &DKI, &DERR, &IERRO);
   return DKI;
 }
 
+void Rossegger::PrecalcRnk(const std::vector<double> &radii)
+{
+  RnkRadii = radii;
+  std::sort(RnkRadii.begin(), RnkRadii.end());
+  RnkRadii.erase(std::unique(RnkRadii.begin(), RnkRadii.end()), RnkRadii.end());
+
+  // fill with the uncached function
+  std::vector<double> values(RnkRadii.size() * NumberOfOrders * NumberOfOrders);
+  for (size_t i = 0; i < RnkRadii.size(); i++)
+  {
+    for (int n = 0; n < NumberOfOrders; n++)
+    {
+      for (int k = 0; k < NumberOfOrders; k++)
+      {
+        values[(i * NumberOfOrders + n) * NumberOfOrders + k] = liMunk_BetaN_a[n][k] * kimu(Munk[n][k], BetaN[n] * RnkRadii[i]) - kiMunk_BetaN_a[n][k] * limu(Munk[n][k], BetaN[n] * RnkRadii[i]);
+      }
+    }
+  }
+  RnkValues.swap(values);
+  std::cout << std::format("Rossegger::PrecalcRnk: precalculated Rnk at {} radii", RnkRadii.size()) << std::endl;
+  return;
+}
+
+const double *Rossegger::FindRnk(double r) const
+{
+  if (RnkRadii.empty())
+  {
+    return nullptr;
+  }
+  // positions are recomputed from cartesian coordinates, so allow for rounding
+  static constexpr double tolerance = 1e-9;
+  auto iter = std::lower_bound(RnkRadii.begin(), RnkRadii.end(), r - tolerance * b);
+  if (iter == RnkRadii.end() || std::abs(*iter - r) > tolerance * b)
+  {
+    return nullptr;
+  }
+  return &RnkValues[(iter - RnkRadii.begin()) * NumberOfOrders * NumberOfOrders];
+}
+
 double Rossegger::Rmn_for_zeroes(int m, double x) // NOLINT(readability-make-member-function-const)
 {
   double lx = a * x / b;
@@ -727,6 +769,10 @@ double Rossegger::Rnk(int n, int k, double r)
   //  Rossegger Equation 5.45
   //       Rnk(r) = Limu_nk (BetaN a) Kimu_nk (BetaN r) - Kimu_nk(BetaN a) Limu_nk (BetaN r)
 
+  if (const double *precalc = FindRnk(r))
+  {
+    return precalc[n * NumberOfOrders + k];
+  }
   return liMunk_BetaN_a[n][k] * kimu(Munk[n][k], BetaN[n] * r) - kiMunk_BetaN_a[n][k] * limu(Munk[n][k], BetaN[n] * r);
 }
 
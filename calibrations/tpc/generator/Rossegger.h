@@ -23,6 +23,7 @@
 #include <limits>
 #include <map>
 #include <string>
+#include <vector>
 
 class TH2;
 class TH3;
@@ -54,6 +55,10 @@ class Rossegger
   double Limu(double mu, double x);  // Bessel functions of purely imaginary order
   double Kimu(double mu, double x);  // Bessel functions of purely imaginary order
 
+  // precalculate Rnk at a fixed set of radii (eg. the cell centers of a lookup table).  Rnk at those radii then
+  // skips the imaginary order Bessel functions, which are the slowest part of Ephi and share fortran COMMON blocks.
+  void PrecalcRnk(const std::vector<double> &radii);
+
   double Ez(double r, double phi, double z, double r1, double phi1, double z1);
   double Er(double r, double phi, double z, double r1, double phi1, double z1);
   double Ephi(double r, double phi, double z, double r1, double phi1, double z1);
@@ -117,6 +122,10 @@ class Rossegger
   double sinh_Betamn_L[NumberOfOrders][NumberOfOrders]{};   // sinh(Betamn[m][n]*L)  as in Rossegger 5.64
   double sinh_pi_Munk[NumberOfOrders][NumberOfOrders]{};    // sinh(pi*Munk[n][k]) as in Rossegger 5.66
 
+  const double *FindRnk(double r) const;  // precalculated Rnk[n][k] at radius r, or nullptr
+  std::vector<double> RnkRadii;           // sorted radii with precalculated Rnk
+  std::vector<double> RnkValues;          // Rnk[radius][n][k]
+
   TH2 *Tags {nullptr};
   std::map<std::string, TH3 *> Grid;
 };
@@ -44,6 +44,7 @@ bool PHPy8JetTrigger::Apply(Pythia8::Pythia *pythia)
 
   // Loop over all particles in the event
   std::vector<fastjet::PseudoJet> pseudojets;
+  double sum_pt = 0;
   for (int i = 0; i < pythia->event.size(); ++i)
   {
     if (pythia->event[i].status() > 0)
@@ -77,15 +78,27 @@ bool PHPy8JetTrigger::Apply(Pythia8::Pythia *pythia)
                                    pythia->event[i].e());
       pseudojet.set_user_index(i);
       pseudojets.push_back(pseudojet);
+      sum_pt += pseudojet.pt();
     }
   }
 
+  // cheap pre-filter: a jet pT (E scheme) cannot exceed the scalar pT sum of its
+  // constituents, nor have more constituents than there are particles in acceptance.
+  // Events which fail are rejected without clustering, with the same result
+  if (sum_pt <= _minPt || static_cast<int>(pseudojets.size()) < _nconst)
+  {
+    if (Verbosity() > 2)
+    {
+      std::cout << "PHPy8JetTrigger::Apply - sum_pt = " << sum_pt << ", and jetFound = 0" << std::endl;
+    }
+    return false;
+  }
+
   // Call FastJet
 
-  fastjet::JetDefinition *jetdef = new fastjet::JetDefinition(fastjet::antikt_algorithm, _R, fastjet::E_scheme, fastjet::Best);
-  fastjet::ClusterSequence jetFinder(pseudojets, *jetdef);
+  fastjet::JetDefinition jetdef(fastjet::antikt_algorithm, _R, fastjet::E_scheme, fastjet::Best);
+  fastjet::ClusterSequence jetFinder(pseudojets, jetdef);
   std::vector<fastjet::PseudoJet> fastjets = jetFinder.inclusive_jets();
-  delete jetdef;
 
   bool jetFound = false;
   double max_pt = -1;
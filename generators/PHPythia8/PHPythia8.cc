@@ -57,13 +57,13 @@ PHPythia8::PHPythia8(const std::string &name)
     return;
   }
 
-  std::string thePath(charPath);
-  thePath += "/xmldoc/";
+  m_XmlPath = charPath;
+  m_XmlPath += "/xmldoc/";
   // the pythia8 ctor messes with the formatting, so we save the cout state here
   // and restore it later
   std::ios old_state(nullptr);
   old_state.copyfmt(std::cout);
-  m_Pythia8.reset(new Pythia8::Pythia(thePath));
+  m_Pythia8.reset(new Pythia8::Pythia(m_XmlPath));
   std::cout.copyfmt(old_state);
   m_Pythia8ToHepMC.reset(new HepMC::Pythia8ToHepMC());
   m_Pythia8ToHepMC->set_store_proc(true);
@@ -82,6 +82,9 @@ PHPythia8::PHPythia8(const std::string &name)
  * into Pythia's valid range) and prints it for reproducibility, then calls
  * Pythia8::init().
  *
+ * With parallel instances, the additional instances get the same configuration
+ * and their own seed, each drawn from PHRandomSeed.
+ *
  * @param topNode Top-level PHCompositeNode under which generator nodes are created.
  * @return int Fun4All return code; returns Fun4AllReturnCodes::EVENT_OK on success.
  */
@@ -98,6 +101,39 @@ int PHPythia8::Init(PHCompositeNode *topNode)
 
   create_node_tree(topNode);
 
+  init_pythia(m_Pythia8.get(), pythia_seed());
+  m_Instances.assign(1, m_Pythia8.get());
+
+  for (unsigned int i = 1; i < m_NumInstances; ++i)
+  {
+    std::ios old_state(nullptr);
+    old_state.copyfmt(std::cout);
+    m_ExtraPythia8.emplace_back(new Pythia8::Pythia(m_XmlPath, false));
+    std::cout.copyfmt(old_state);
+
+    Pythia8::Pythia *pythia = m_ExtraPythia8.back().get();
+    if (!m_ConfigFileName.empty())
+    {
+      pythia->readFile(m_ConfigFileName);
+    }
+    for (auto &m_Command : m_Commands)
+    {
+      pythia->readString(m_Command);
+    }
+    init_pythia(pythia, pythia_seed());
+    m_Instances.push_back(pythia);
+  }
+  m_EmittedStatistics.assign(m_Instances.size(), InstanceStatistics());
+  if (m_Instances.size() > 1)
+  {
+    std::cout << "PHPythia8 generating with " << m_Instances.size() << " parallel instances" << std::endl;
+  }
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+unsigned int PHPythia8::pythia_seed() const
+{
   // PYTHIA8 has very specific requires for its random number range
   // I map the designated unique seed from recoconst into something
   // acceptable for PYTHIA8
@@ -109,29 +145,29 @@ int PHPythia8::Init(PHCompositeNode *topNode)
     seed = seed % 900000000;
   }
 
-  if ((seed > 0) && (seed <= 900000000))
-  {
-    m_Pythia8->readString("Random:setSeed = on");
-    m_Pythia8->readString(std::format("Random:seed = {}", seed));
-  }
-  else
+  if ((seed == 0) || (seed > 900000000))
   {
     std::cout << PHWHERE << " ERROR: seed " << seed << " is not valid" << std::endl;
     exit(1);
   }
+  return seed;
+}
+
+void PHPythia8::init_pythia(Pythia8::Pythia *pythia, const unsigned int seed)
+{
+  pythia->readString("Random:setSeed = on");
+  pythia->readString(std::format("Random:seed = {}", seed));
+
   // print out seed so we can make this is reproducible
   std::cout << "PHPythia8 random seed: " << seed << std::endl;
 
-
-// pythia again messes with the cout formatting
+  // pythia again messes with the cout formatting
   std::ios old_state(nullptr);
-  old_state.copyfmt(std::cout); // save current state
+  old_state.copyfmt(std::cout);  // save current state
 
-  m_Pythia8->init();
+  pythia->init();
 
-  std::cout.copyfmt(old_state); // restore state to saved state
-
-  return Fun4AllReturnCodes::EVENT_OK;
+  std::cout.copyfmt(old_state);  // restore state to saved state
 }
 
 int PHPythia8::End(PHCompositeNode * /*topNode*/)
@@ -144,7 +180,14 @@ int PHPythia8::End(PHCompositeNode * /*topNode*/)
   if (Verbosity() >= VERBOSITY_SOME)
   {
     //-* dump out closing info (cross-sections, etc)
-    m_Pythia8->stat();
+    for (auto *pythia : m_Instances)
+    {
+      pythia->stat();
+    }
+    long nAccepted = 0;
+    double weightSum = 0;
+    double sigmaGen = 0;
+    accepted_statistics(nAccepted, weightSum, sigmaGen);
 
     // match pythia printout
     std::cout << " |                                                                "
@@ -152,8 +195,8 @@ int PHPythia8::End(PHCompositeNode * /*topNode*/)
     std::cout << "                         PHPythia8::End - " << m_EventCount
               << " events passed trigger" << std::endl;
     std::cout << "                         Fraction passed: " << m_EventCount
-              << "/" << m_Pythia8->info.nAccepted()
-              << " = " << m_EventCount / float(m_Pythia8->info.nAccepted()) << std::endl;
+              << "/" << nAccepted
+              << " = " << m_EventCount / float(nAccepted) << std::endl;
     std::cout << " *-------  End PYTHIA Trigger Statistics  ------------------------"
               << "-------------------------------------------------* " << std::endl;
 
@@ -204,80 +247,49 @@ int PHPythia8::process_event(PHCompositeNode * /*topNode*/)
     std::cout << Name() << " PHPythia8::process_event - event: " << m_EventCount << std::endl;
   }
 
-  bool passedGen = false;
-  bool passedTrigger = false;
-  //  int genCounter = 0;
-// pythia again messes with the cout formatting in its event loop
+  // pythia again messes with the cout formatting in its event loop
   std::ios old_state(nullptr);
   old_state.copyfmt(std::cout); // save current state
 
-  while (!passedTrigger)
+  unsigned int instance = 0;
+  if (m_Instances.size() > 1)
   {
-    //    ++genCounter;
-
-    // generate another pythia event
-    while (!passedGen)
-    {
-      passedGen = m_Pythia8->next();
-    }
-
-    // test trigger logic
-    bool andScoreKeeper = true;
-    if (Verbosity() >= VERBOSITY_EVEN_MORE)
-    {
-      std::cout << "PHPythia8::process_event - triggersize: " << m_RegisteredTriggers.size() << std::endl;
-    }
-
-    for (auto &m_RegisteredTrigger : m_RegisteredTriggers)
-    {
-      bool trigResult = m_RegisteredTrigger->Apply(m_Pythia8.get());
-
-      if (Verbosity() >= VERBOSITY_EVEN_MORE)
-      {
-        std::cout << "PHPythia8::process_event trigger: "
-                  << m_RegisteredTrigger->GetName() << "  " << trigResult << std::endl;
-      }
-
-      if (m_TriggersOR && trigResult)
-      {
-        passedTrigger = true;
-        break;
-      }
-      if (m_TriggersAND)
-      {
-        andScoreKeeper &= trigResult;
-      }
-
-      if (Verbosity() >= VERBOSITY_EVEN_MORE && !passedTrigger && !andScoreKeeper)
-      {
-        std::cout << "PHPythia8::process_event - failed trigger: "
-                  << m_RegisteredTrigger->GetName() << std::endl;
-      }
-    }
-
-    if ((andScoreKeeper && m_TriggersAND) || (m_RegisteredTriggers.empty()))
+    // a new round of accepted events once the previous one has been emitted
+    if (m_NextInstance == 0)
     {
-      passedTrigger = true;
-      //      genCounter = 0;
+      fill_instances();
     }
-
-    passedGen = false;
+    instance = m_NextInstance;
+    m_NextInstance = (m_NextInstance + 1) % m_Instances.size();
+  }
+  else
+  {
+    generate_triggered(m_Pythia8.get());
   }
+  Pythia8::Pythia *pythia = m_Instances[instance];
+
+  // the counters of an instance include everything it generated up to the event
+  // emitted now. Events generated by the other instances for the next events are not
+  // counted before they are emitted themselves
+  InstanceStatistics &stat = m_EmittedStatistics[instance];
+  stat.nAccepted = pythia->info.nAccepted();
+  stat.weightSum = pythia->info.weightSum();
+  stat.sigmaGen = pythia->info.sigmaGen();
 
   // print
   if (Verbosity())
   {
-    m_Pythia8->event.list();
+    pythia->event.list();
   }
 
   // fill HepMC object with event & pass to
 
   auto *genevent = new HepMC::GenEvent(HepMC::Units::GEV, HepMC::Units::MM);
-  m_Pythia8ToHepMC->fill_next_event(*m_Pythia8, genevent, m_EventCount);
+  m_Pythia8ToHepMC->fill_next_event(*pythia, genevent, m_EventCount);
   // Enable continuous reweighting by storing additional reweighting factor
   if (m_SaveEventWeightFlag)
   {
-    genevent->weights().push_back(m_Pythia8->info.weight());
+    genevent->weights().push_back(pythia->info.weight());
   }
 
   /* pass HepMC to PHNode*/
@@ -297,11 +309,11 @@ int PHPythia8::process_event(PHCompositeNode * /*topNode*/)
   }
   if (m_EventCount < 2 && Verbosity() >= VERBOSITY_SOME)
   {
-    m_Pythia8->event.list();
+    pythia->event.list();
   }
   if (m_EventCount >= 2 && Verbosity() >= VERBOSITY_A_LOT)
   {
-    m_Pythia8->event.list();
+    pythia->event.list();
   }
 
   ++m_EventCount;
@@ -311,15 +323,102 @@ int PHPythia8::process_event(PHCompositeNode * /*topNode*/)
   // save statistics
   if (m_IntegralNode)
   {
-    m_IntegralNode->set_N_Generator_Accepted_Event(m_Pythia8->info.nAccepted());
+    long nAccepted = 0;
+    double weightSum = 0;
+    double sigmaGen = 0;
+    accepted_statistics(nAccepted, weightSum, sigmaGen);
+    m_IntegralNode->set_N_Generator_Accepted_Event(nAccepted);
     m_IntegralNode->set_N_Processed_Event(m_EventCount);
-    m_IntegralNode->set_Sum_Of_Weight(m_Pythia8->info.weightSum());
-    m_IntegralNode->set_Integrated_Lumi(m_Pythia8->info.nAccepted() / (m_Pythia8->info.sigmaGen() * 1e9));
+    m_IntegralNode->set_Sum_Of_Weight(weightSum);
+    m_IntegralNode->set_Integrated_Lumi(nAccepted / (sigmaGen * 1e9));
   }
 
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+void PHPythia8::generate_triggered(Pythia8::Pythia *pythia) const
+{
+  bool passedTrigger = false;
+  while (!passedTrigger)
+  {
+    // generate another pythia event
+    bool passedGen = false;
+    while (!passedGen)
+    {
+      passedGen = pythia->next();
+    }
+
+    passedTrigger = apply_triggers(pythia);
+  }
+}
+
+bool PHPythia8::apply_triggers(Pythia8::Pythia *pythia) const
+{
+  if (Verbosity() >= VERBOSITY_EVEN_MORE)
+  {
+    std::cout << "PHPythia8::process_event - triggersize: " << m_RegisteredTriggers.size() << std::endl;
+  }
+  if (m_RegisteredTriggers.empty())
+  {
+    return true;
+  }
+
+  // triggers are applied in registration order and we stop as soon as the
+  // result is known, so cheap triggers registered first spare the expensive ones
+  for (auto *m_RegisteredTrigger : m_RegisteredTriggers)
+  {
+    bool trigResult = m_RegisteredTrigger->Apply(pythia);
+
+    if (Verbosity() >= VERBOSITY_EVEN_MORE)
+    {
+      std::cout << "PHPythia8::process_event trigger: "
+                << m_RegisteredTrigger->GetName() << "  " << trigResult << std::endl;
+    }
+
+    if (m_TriggersOR && trigResult)
+    {
+      return true;
+    }
+    if (m_TriggersAND && !trigResult)
+    {
+      if (Verbosity() >= VERBOSITY_EVEN_MORE)
+      {
+        std::cout << "PHPythia8::process_event - failed trigger: "
+                  << m_RegisteredTrigger->GetName() << std::endl;
+      }
+      return false;
+    }
+  }
+  return m_TriggersAND;
+}
+
+void PHPythia8::fill_instances()
+{
+  // each instance only uses its own random number sequence, so the accepted
+  // events do not depend on how the instances are spread over threads
+  const int ninstances = m_Instances.size();
+#pragma omp parallel for schedule(dynamic, 1)
+  for (int i = 0; i < ninstances; ++i)
+  {
+    generate_triggered(m_Instances[i]);
+  }
+}
+
+void PHPythia8::accepted_statistics(long &nAccepted, double &weightSum, double &sigmaGen) const
+{
+  // the cross section estimates of the instances are averaged, weighted by their accepted events
+  nAccepted = 0;
+  weightSum = 0;
+  double sigmaSum = 0;
+  for (const auto &stat : m_EmittedStatistics)
+  {
+    nAccepted += stat.nAccepted;
+    weightSum += stat.weightSum;
+    sigmaSum += stat.sigmaGen * stat.nAccepted;
+  }
+  sigmaGen = (nAccepted > 0) ? sigmaSum / nAccepted : 0;
+}
+
 int PHPythia8::create_node_tree(PHCompositeNode *topNode)
 {
   // HepMC IO
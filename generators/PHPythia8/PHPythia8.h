@@ -73,8 +73,33 @@ class PHPythia8 : public SubsysReco, public PHHepMCGenHelper
   void save_event_weight(const bool b) { m_SaveEventWeightFlag = b; }
   void save_integrated_luminosity(const bool b) { m_SaveIntegratedLuminosityFlag = b; }
 
+  /// generate and filter candidate events with n independently seeded pythia instances
+  /**
+   * each instance is seeded with its own PHRandomSeed, so a job is reproducible for a given n
+   * and fixed seed.
+   * Each instance generates until its event passes the triggers, all instances running
+   * concurrently (openmp). Accepted events are then emitted round robin in instance order,
+   * so the output does not depend on thread scheduling.
+   * Registered triggers are called from several threads and must not modify their own state
+   * in Apply (the triggers in this package do not).
+   * Default is 1, which is the usual single instance generation.
+   */
+  void set_parallel_instances(const unsigned int n) { m_NumInstances = (n > 0 ? n : 1); }
+
  private:
   int read_config(const std::string &cfg_file);
+  //! map the next PHRandomSeed into the pythia seed range
+  unsigned int pythia_seed() const;
+  //! configure (config file, commands, seed) and initialize one pythia instance
+  void init_pythia(Pythia8::Pythia *pythia, const unsigned int seed);
+  //! generate events until one passes the registered triggers
+  void generate_triggered(Pythia8::Pythia *pythia) const;
+  //! apply the registered triggers, combined with OR or AND
+  bool apply_triggers(Pythia8::Pythia *pythia) const;
+  //! fill the next accepted events of all instances whose previous event has been emitted
+  void fill_instances();
+  //! generator statistics of the emitted events, summed over all instances
+  void accepted_statistics(long &nAccepted, double &weightSum, double &sigmaGen) const;
   int create_node_tree(PHCompositeNode *topNode) final;
   double percent_diff(const double a, const double b) { return std::fabs((a - b) / a); }
   int m_EventCount = 0;
@@ -86,6 +111,25 @@ class PHPythia8 : public SubsysReco, public PHHepMCGenHelper
 
   // PYTHIA
   std::unique_ptr<Pythia8::Pythia> m_Pythia8;
+  std::string m_XmlPath;
+
+  //! additional pythia instances for parallel generation, m_Pythia8 being the first one
+  std::vector<std::unique_ptr<Pythia8::Pythia>> m_ExtraPythia8;
+  //! all instances, in seed order
+  std::vector<Pythia8::Pythia *> m_Instances;
+  //! instance whose accepted event is emitted next
+  unsigned int m_NextInstance{0};
+
+  //! generator counters of one instance
+  struct InstanceStatistics
+  {
+    long nAccepted{0};
+    double weightSum{0};
+    double sigmaGen{0};
+  };
+  //! counters of each instance, recorded when its last accepted event was emitted
+  std::vector<InstanceStatistics> m_EmittedStatistics;
+  unsigned int m_NumInstances{1};
 
   std::string m_ConfigFileName{"phpythia8.cfg"};
   std::vector<std::string> m_Commands;
@@ -15,6 +15,21 @@ InttRawHitv1::InttRawHitv1(InttRawHit *intthit)
   set_amplitude(intthit->get_amplitude());
 }
 
+void InttRawHitv1::Reset()
+{
+  bco = std::numeric_limits<uint64_t>::max();
+  packetid = std::numeric_limits<int32_t>::max();
+  word = std::numeric_limits<uint32_t>::max();
+  fee = std::numeric_limits<uint16_t>::max();
+  channel_id = std::numeric_limits<uint16_t>::max();
+  chip_id = std::numeric_limits<uint16_t>::max();
+  adc = std::numeric_limits<uint16_t>::max();
+  FPHX_BCO = std::numeric_limits<uint16_t>::max();
+  full_FPHX = std::numeric_limits<uint16_t>::max();
+  full_ROC = std::numeric_limits<uint16_t>::max();
+  amplitude = std::numeric_limits<uint16_t>::max();
+}
+
 void InttRawHitv1::identify(std::ostream &os) const
 {
   os << "BCO: 0x" << std::hex << bco << std::dec << std::endl;
@@ -17,6 +17,9 @@ class InttRawHitv1 : public InttRawHit
    */
   void identify(std::ostream &os = std::cout) const override;
 
+  //! reset to the default constructed state
+  void Reset() override;
+
   uint64_t get_bco() const override { return bco; }
   // cppcheck-suppress virtualCallInConstructor
   void set_bco(const uint64_t val) override { bco = val; }
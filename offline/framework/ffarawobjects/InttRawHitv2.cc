@@ -6,6 +6,12 @@ InttRawHitv2::InttRawHitv2(InttRawHit *intthit)
   InttRawHitv2::set_event_counter(intthit->get_event_counter());
 }
 
+void InttRawHitv2::Reset()
+{
+  InttRawHitv1::Reset();
+  event_counter = std::numeric_limits<uint32_t>::max();
+}
+
 void InttRawHitv2::identify(std::ostream &os) const
 {
   os << "BCO: 0x" << std::hex << bco << std::dec << std::endl;
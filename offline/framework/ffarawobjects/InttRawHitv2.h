@@ -17,6 +17,9 @@ class InttRawHitv2 : public InttRawHitv1
    */
   void identify(std::ostream &os = std::cout) const override;
 
+  //! reset to the default constructed state
+  void Reset() override;
+
   uint32_t get_event_counter() const override { return event_counter; }
   void set_event_counter(uint32_t val) override { event_counter = val; }
 
@@ -60,6 +60,22 @@ uint16_t MicromegasRawHitv3::get_adc(const uint16_t sample) const
   return iter == m_adcData.end() ? 0 : iter->second[sample - iter->first];
 }
 
+void MicromegasRawHitv3::Reset()
+{
+  bco = std::numeric_limits<uint64_t>::max();
+  packetid = std::numeric_limits<int32_t>::max();
+  fee = std::numeric_limits<uint16_t>::max();
+  channel = std::numeric_limits<uint16_t>::max();
+  type = std::numeric_limits<uint16_t>::max();
+  checksum = std::numeric_limits<uint16_t>::max();
+  data_parity = std::numeric_limits<uint16_t>::max();
+  checksumerror = true;
+  parityerror = true;
+
+  // unlike Clear, keep the waveform list capacity so that a recycled hit does not reallocate it
+  m_adcData.clear();
+}
+
 void MicromegasRawHitv3::Clear(Option_t * /*unused*/)
 {
   m_adcData.clear();
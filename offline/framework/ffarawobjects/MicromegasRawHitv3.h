@@ -23,6 +23,9 @@ class MicromegasRawHitv3 : public MicromegasRawHit
    */
   void identify(std::ostream &os = std::cout) const override;
 
+  //! reset to the default constructed state
+  void Reset() override;
+
   void Clear(Option_t * /*unused*/) override;
 
   uint64_t get_bco() const override { return bco; }
@@ -12,6 +12,18 @@ MvtxRawHitv1::MvtxRawHitv1(MvtxRawHit *mvtxhit)
   set_col(mvtxhit->get_col());
 }
 
+void MvtxRawHitv1::Reset()
+{
+  bco = std::numeric_limits<uint64_t>::max();
+  strobe_bc = std::numeric_limits<uint32_t>::max();
+  chip_bc = std::numeric_limits<uint32_t>::max();
+  layer_id = std::numeric_limits<uint8_t>::max();
+  stave_id = std::numeric_limits<uint8_t>::max();
+  chip_id = std::numeric_limits<uint8_t>::max();
+  row = std::numeric_limits<uint16_t>::max();
+  col = std::numeric_limits<uint16_t>::max();
+}
+
 void MvtxRawHitv1::identify(std::ostream &os) const
 {
   os << "BCO: 0x" << std::hex << bco << std::dec << std::endl;
@@ -43,6 +43,25 @@ uint16_t TpcRawHitv2::get_adc(const uint16_t sample) const
   return 0;
 }
 
+void TpcRawHitv2::Reset()
+{
+  bco = std::numeric_limits<uint64_t>::max();
+  gtm_bco = std::numeric_limits<uint64_t>::max();
+  packetid = std::numeric_limits<int32_t>::max();
+  fee = std::numeric_limits<uint16_t>::max();
+  channel = std::numeric_limits<uint16_t>::max();
+  sampaaddress = std::numeric_limits<uint16_t>::max();
+  sampachannel = std::numeric_limits<uint16_t>::max();
+  samples = std::numeric_limits<uint16_t>::max();
+  type = std::numeric_limits<uint16_t>::max();
+  userword = std::numeric_limits<uint16_t>::max();
+  checksum = std::numeric_limits<uint16_t>::max();
+  data_parity = std::numeric_limits<uint16_t>::max();
+  checksumerror = true;
+  parityerror = true;
+  adcmap.clear();
+}
+
 void TpcRawHitv2::Clear(Option_t * /*unused*/)
 {
   adcmap.clear();
@@ -21,6 +21,9 @@ class TpcRawHitv2 : public TpcRawHit
    */
   void identify(std::ostream &os = std::cout) const override;
 
+  //! reset to the default constructed state
+  void Reset() override;
+
   void Clear(Option_t *) override;
 
   uint64_t get_bco() const override { return bco; }
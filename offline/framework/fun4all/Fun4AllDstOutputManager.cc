@@ -239,14 +239,7 @@ int Fun4AllDstOutputManager::WriteNode(PHCompositeNode *thisNode)
     m_UsedOutFileName = OutFileName() + std::string("?reproducible=") + std::string(p.filename());
   }
   dstOut = new PHNodeIOManager(UsedOutFileName(), access_type, PHRunTree);
-  if (SplitLevel() != std::numeric_limits<int>::min())
-  {
-    dstOut->SplitLevel(SplitLevel());
-  }
-  if (BufferSize() != std::numeric_limits<int>::min())
-  {
-    dstOut->BufferSize(BufferSize());
-  }
+  ApplyBranchSettings();
   Fun4AllServer *se = Fun4AllServer::instance();
   PHNodeIterator nodeiter(thisNode);
   if (saverunnodes.empty())
@@ -338,14 +331,7 @@ int Fun4AllDstOutputManager::outfile_open_first_write()
   }
   m_UsedOutFileName = OutFileName() + std::string("?reproducible=") + std::string(p.filename());
   dstOut = new PHNodeIOManager(UsedOutFileName(), PHWrite);
-  if (SplitLevel() != std::numeric_limits<int>::min())
-  {
-    dstOut->SplitLevel(SplitLevel());
-  }
-  if (BufferSize() != std::numeric_limits<int>::min())
-  {
-    dstOut->BufferSize(BufferSize());
-  }
+  ApplyBranchSettings();
   if (!dstOut->isFunctional())
   {
     delete dstOut;
@@ -358,6 +344,34 @@ int Fun4AllDstOutputManager::outfile_open_first_write()
   return 0;
 }
 
+void Fun4AllDstOutputManager::ApplyBranchSettings()
+{
+  if (SplitLevel() != std::numeric_limits<int>::min())
+  {
+    dstOut->SplitLevel(SplitLevel());
+  }
+  if (BufferSize() != std::numeric_limits<int>::min())
+  {
+    dstOut->BufferSize(BufferSize());
+  }
+  for (const auto &[nodename, size] : m_NodeBufferSize)
+  {
+    dstOut->NodeBufferSize(nodename, size);
+  }
+  for (const auto &[nodename, split] : m_NodeSplitLevel)
+  {
+    dstOut->NodeSplitLevel(nodename, split);
+  }
+  for (const auto &[nodename, setting] : m_NodeCompressionSetting)
+  {
+    dstOut->NodeCompressionSetting(nodename, setting);
+  }
+  if (m_ImplicitMT)
+  {
+    dstOut->ImplicitMT(true, m_ImplicitMTThreads);
+  }
+}
+
 // this method figures out the last event number to be saved before rolling over
 // an integer div of the current event by the number of events gives the first event we can expect
 // in this process (this is not needed), then adding the number of events we want gives us the last event
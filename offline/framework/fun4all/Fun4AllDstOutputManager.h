@@ -5,6 +5,7 @@
 
 #include "Fun4AllOutputManager.h"
 
+#include <map>
 #include <set>
 #include <string>
 
@@ -36,14 +37,29 @@ class Fun4AllDstOutputManager : public Fun4AllOutputManager
   const std::string &UsedOutFileName() const { return m_UsedOutFileName; }
   void CompressionSetting(const int i) override { m_CompressionSetting = i; }
   void InitializeLastEvent(int eventnumber) override;
-  
+
+  //! per node basket size, split level and compression (e.g. 404 for LZ4 on hot reco nodes, 509 for ZSTD-high on truth)
+  void NodeBufferSize(const std::string &nodename, const int size) { m_NodeBufferSize[nodename] = size; }
+  void NodeSplitLevel(const std::string &nodename, const int split) { m_NodeSplitLevel[nodename] = split; }
+  void NodeCompressionSetting(const std::string &nodename, const int setting) { m_NodeCompressionSetting[nodename] = setting; }
+
+  //! compress baskets in background threads (ROOT implicit MT) while filling the tree
+  void ImplicitMT(const bool b, const unsigned int nthreads = 0)
+  {
+    m_ImplicitMT = b;
+    m_ImplicitMTThreads = nthreads;
+  }
+
  private:
   int outfile_open_first_write();
+  void ApplyBranchSettings();
   PHNodeIOManager *dstOut{nullptr};
   int m_SaveRunNodeFlag{1};
   int m_SaveDstNodeFlag{1};
   int m_CompressionSetting{505};
   bool m_LastEventInitialized{false};
+  bool m_ImplicitMT{false};
+  unsigned int m_ImplicitMTThreads{0};
   std::string m_FileNameStem;
   std::string m_UsedOutFileName;
   std::set<std::string> savenodes;
@@ -51,6 +67,9 @@ class Fun4AllDstOutputManager : public Fun4AllOutputManager
   std::set<std::string> m_StripCompositeNodes;
   std::set<std::string> stripnodes;
   std::set<std::string> striprunnodes;
+  std::map<std::string, int> m_NodeBufferSize;
+  std::map<std::string, int> m_NodeSplitLevel;
+  std::map<std::string, int> m_NodeCompressionSetting;
 };
 
 #endif
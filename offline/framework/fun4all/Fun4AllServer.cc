@@ -12,6 +12,7 @@
 #include "SubsysReco.h"
 
 #include <phool/PHCompositeNode.h>
+#include <phool/PHEventArena.h>
 #include <phool/PHNode.h>  // for PHNode
 #include <phool/PHNodeIterator.h>
 #include <phool/PHNodeReset.h>
@@ -824,6 +825,8 @@ int Fun4AllServer::ResetNodeTree()
       }
     }
   }
+  // all containers have been reset, objects they owned in the event arena can go in one step
+  PHEventArena::instance()->Release();
   return 0;  // anything except 0 would abort the event loop in pmonitor
 }
 
@@ -45,8 +45,11 @@
 #include <cstdlib>
 #include <format>
 #include <iostream>  // for operator<<, basic_ostream, endl
+#include <iterator>  // for size
 #include <utility>   // for pair
 
+thread_local Fun4AllStreamingInputManager::DecodedHits *Fun4AllStreamingInputManager::m_ThreadDecodedHits = nullptr;
+
 Fun4AllStreamingInputManager::Fun4AllStreamingInputManager(const std::string &name, const std::string &dstnodename, const std::string &topnodename)
   : Fun4AllInputManager(name, dstnodename, topnodename)
   , m_SyncObject(new SyncObjectv1())
@@ -147,25 +150,30 @@ Fun4AllStreamingInputManager::~Fun4AllStreamingInputManager()
 int Fun4AllStreamingInputManager::run(const int /*nevents*/)
 {
   int iret = 0;
+  m_InputsDecoded = false;
   if (m_gl1_registered_flag)  // Gl1 first to get the reference
   {
     iret += FillGl1();
   }
   if (m_intt_registered_flag)
   {
+    DecodeInputs(InputManagerType::INTT);
     iret += FillIntt();
   }
   if (m_mvtx_registered_flag)
   {
+    DecodeInputs(InputManagerType::MVTX);
     iret += FillMvtx();
   }
   if (m_tpc_registered_flag)
   {
+    DecodeInputs(InputManagerType::TPC);
     iret += FillTpc();
   }
 
   if (m_micromegas_registered_flag)
   {
+    DecodeInputs(InputManagerType::MICROMEGAS);
     iret += FillMicromegas();
   }
 
@@ -494,6 +502,11 @@ void Fun4AllStreamingInputManager::AddGl1RawHit(uint64_t bclk, Gl1Packet *hit)
 
 void Fun4AllStreamingInputManager::AddMvtxRawHit(uint64_t bclk, MvtxRawHit *hit)
 {
+  if (m_ThreadDecodedHits)
+  {
+    m_ThreadDecodedHits->MvtxRawHitVector.emplace_back(bclk, hit);
+    return;
+  }
   if (Verbosity() > 1)
   {
     std::cout << "Adding mvtx hit to bclk 0x"
@@ -504,6 +517,11 @@ void Fun4AllStreamingInputManager::AddMvtxRawHit(uint64_t bclk, MvtxRawHit *hit)
 
 void Fun4AllStreamingInputManager::AddMvtxFeeIdInfo(uint64_t bclk, uint16_t feeid, uint32_t detField)
 {
+  if (m_ThreadDecodedHits)
+  {
+    m_ThreadDecodedHits->MvtxFeeIdInfoVector.push_back({bclk, feeid, detField});
+    return;
+  }
   if (Verbosity() > 1)
   {
     std::cout << "Adding mvtx feeid info to bclk 0x"
@@ -518,6 +536,11 @@ void Fun4AllStreamingInputManager::AddMvtxFeeIdInfo(uint64_t bclk, uint16_t feei
 
 void Fun4AllStreamingInputManager::AddMvtxL1TrgBco(uint64_t bclk, uint64_t lv1Bco)
 {
+  if (m_ThreadDecodedHits)
+  {
+    m_ThreadDecodedHits->MvtxL1TrgBcoVector.emplace_back(bclk, lv1Bco);
+    return;
+  }
   if (Verbosity() > 1)
   {
     std::cout << "Adding mvtx L1Trg to bclk 0x"
@@ -528,6 +551,11 @@ void Fun4AllStreamingInputManager::AddMvtxL1TrgBco(uint64_t bclk, uint64_t lv1Bc
 
 void Fun4AllStreamingInputManager::AddInttRawHit(uint64_t bclk, InttRawHit *hit)
 {
+  if (m_ThreadDecodedHits)  // added to the maps once all inputs are decoded
+  {
+    m_ThreadDecodedHits->InttRawHitVector.emplace_back(bclk, hit);
+    return;
+  }
   if (Verbosity() > 1)
   {
     std::cout << "Adding intt hit to bclk 0x"
@@ -539,6 +567,11 @@ void Fun4AllStreamingInputManager::AddInttRawHit(uint64_t bclk, InttRawHit *hit)
 
 void Fun4AllStreamingInputManager::AddMicromegasRawHit(uint64_t bclk, MicromegasRawHit *hit)
 {
+  if (m_ThreadDecodedHits)
+  {
+    m_ThreadDecodedHits->MicromegasRawHitVector.emplace_back(bclk, hit);
+    return;
+  }
   if (Verbosity() > 1)
   {
     std::cout << "Adding micromegas hit to bclk 0x"
@@ -549,6 +582,11 @@ void Fun4AllStreamingInputManager::AddMicromegasRawHit(uint64_t bclk, Micromegas
 
 void Fun4AllStreamingInputManager::AddTpcRawHit(uint64_t bclk, TpcRawHit *hit)
 {
+  if (m_ThreadDecodedHits)
+  {
+    m_ThreadDecodedHits->TpcRawHitVector.emplace_back(bclk, hit);
+    return;
+  }
   if (Verbosity() > 1)
   {
     std::cout << "Adding tpc hit to bclk 0x"
@@ -1200,51 +1238,187 @@ int Fun4AllStreamingInputManager::FillTpc()
 
 void Fun4AllStreamingInputManager::SetInttBcoRange(const unsigned int i)
 {
+  std::lock_guard<std::mutex> lock(m_ConfigMutex);
   m_intt_bco_range = std::max(i, m_intt_bco_range);
 }
 
 void Fun4AllStreamingInputManager::SetInttNegativeBco(const unsigned int i)
 {
+  std::lock_guard<std::mutex> lock(m_ConfigMutex);
   m_intt_negative_bco = std::max(i, m_intt_negative_bco);
 }
 
 void Fun4AllStreamingInputManager::SetMicromegasBcoRange(const unsigned int i)
 {
+  std::lock_guard<std::mutex> lock(m_ConfigMutex);
   m_micromegas_bco_range = std::max(i, m_micromegas_bco_range);
 }
 
 void Fun4AllStreamingInputManager::SetMicromegasNegativeBco(const unsigned int i)
 {
+  std::lock_guard<std::mutex> lock(m_ConfigMutex);
   m_micromegas_negative_bco = std::max(i, m_micromegas_negative_bco);
 }
 
 void Fun4AllStreamingInputManager::SetMvtxNegativeBco(const unsigned int i)
 {
+  std::lock_guard<std::mutex> lock(m_ConfigMutex);
   m_mvtx_negative_bco = std::max(i, m_mvtx_negative_bco);
 }
 
 void Fun4AllStreamingInputManager::SetTpcBcoRange(const unsigned int i)
 {
+  std::lock_guard<std::mutex> lock(m_ConfigMutex);
   m_tpc_bco_range = std::max(i, m_tpc_bco_range);
 }
 
 void Fun4AllStreamingInputManager::SetTpcNegativeBco(const unsigned int i)
 {
+  std::lock_guard<std::mutex> lock(m_ConfigMutex);
   m_tpc_negative_bco = std::max(i, m_tpc_negative_bco);
 }
 
 void Fun4AllStreamingInputManager::SetMvtxBcoRange(const unsigned int i)
 {
+  std::lock_guard<std::mutex> lock(m_ConfigMutex);
   m_mvtx_bco_range = std::max(i, m_mvtx_bco_range);
 }
 
-int Fun4AllStreamingInputManager::FillInttPool()
+void Fun4AllStreamingInputManager::runMvtxTriggered(bool b)
+{
+  std::lock_guard<std::mutex> lock(m_ConfigMutex);
+  m_mvtx_is_triggered = b;
+}
+
+uint64_t Fun4AllStreamingInputManager::PoolMinBco(const InputManagerType::enu_subsystem system) const
+{
+  switch (system)
+  {
+  case InputManagerType::INTT:
+    return m_RefBCO > m_intt_negative_bco ? m_RefBCO - m_intt_negative_bco : 0;
+  case InputManagerType::MVTX:
+    return m_RefBCO < m_mvtx_negative_bco ? m_mvtx_negative_bco : m_RefBCO - m_mvtx_negative_bco;
+  case InputManagerType::TPC:
+    return m_RefBCO > m_tpc_negative_bco ? m_RefBCO - m_tpc_negative_bco : 0;
+  case InputManagerType::MICROMEGAS:
+    return m_RefBCO > m_micromegas_negative_bco ? m_RefBCO - m_micromegas_negative_bco : 0;
+  default:
+    return 0;
+  }
+}
+
+std::vector<SingleStreamingInput *> &Fun4AllStreamingInputManager::InputVector(const InputManagerType::enu_subsystem system)
 {
-  uint64_t ref_bco_minus_range = 0;
-  if (m_RefBCO > m_intt_negative_bco)
+  switch (system)
   {
-    ref_bco_minus_range = m_RefBCO - m_intt_negative_bco;
+  case InputManagerType::INTT:
+    return m_InttInputVector;
+  case InputManagerType::MVTX:
+    return m_MvtxInputVector;
+  case InputManagerType::TPC:
+    return m_TpcInputVector;
+  case InputManagerType::MICROMEGAS:
+    return m_MicromegasInputVector;
+  default:
+    return m_Gl1InputVector;
   }
+}
+
+void Fun4AllStreamingInputManager::DecodeInputs(const InputManagerType::enu_subsystem first_system)
+{
+  // the pools are filled starting at the reference BCO minus the negative range,
+  // without GL1 the reference comes from the first subsystem which then runs serially
+  if (!m_ConcurrentDecodingFlag || m_InputsDecoded || m_RefBCO == 0)
+  {
+    return;
+  }
+
+  // decode this subsystem and all the ones which are filled after it in run()
+  static const InputManagerType::enu_subsystem fill_order[] = {InputManagerType::INTT, InputManagerType::MVTX, InputManagerType::TPC, InputManagerType::MICROMEGAS};
+  const bool *registered[] = {&m_intt_registered_flag, &m_mvtx_registered_flag, &m_tpc_registered_flag, &m_micromegas_registered_flag};
+  m_DecodeInputs.clear();
+  bool selected = false;
+  for (unsigned int i = 0; i < std::size(fill_order); ++i)
+  {
+    selected |= (fill_order[i] == first_system);
+    if (!selected || !*registered[i])
+    {
+      continue;
+    }
+    const uint64_t min_bco = PoolMinBco(fill_order[i]);
+    for (auto *iter : InputVector(fill_order[i]))
+    {
+      if (fill_order[i] == InputManagerType::INTT && !m_gl1_registered_flag)
+      {
+        iter->SetStandaloneMode(true);
+      }
+      m_DecodeInputs.emplace_back(iter, min_bco);
+    }
+  }
+
+  // staging buffers are kept between events so their capacity is reused
+  if (m_DecodedHits.size() < m_DecodeInputs.size())
+  {
+    m_DecodedHits.resize(m_DecodeInputs.size());
+  }
+  const int ninputs = m_DecodeInputs.size();
+#pragma omp parallel for schedule(dynamic, 1)
+  for (int i = 0; i < ninputs; ++i)
+  {
+    if (Verbosity() > 0)
+    {
+      std::cout << "Fun4AllStreamingInputManager::DecodeInputs - fill pool for " << m_DecodeInputs[i].first->Name() << std::endl;
+    }
+    m_ThreadDecodedHits = &m_DecodedHits[i];
+    m_DecodeInputs[i].first->FillPool(m_DecodeInputs[i].second);
+    m_ThreadDecodedHits = nullptr;
+  }
+
+  // hand the hits over in registration order, same as filling the pools one after the other
+  for (int i = 0; i < ninputs; ++i)
+  {
+    AddDecodedHits(m_DecodedHits[i]);
+  }
+  m_InputsDecoded = true;
+}
+
+void Fun4AllStreamingInputManager::AddDecodedHits(DecodedHits &decoded)
+{
+  for (const auto &[bclk, hit] : decoded.InttRawHitVector)
+  {
+    AddInttRawHit(bclk, hit);
+  }
+  for (const auto &[bclk, hit] : decoded.MvtxRawHitVector)
+  {
+    AddMvtxRawHit(bclk, hit);
+  }
+  for (const auto &feeidinfo : decoded.MvtxFeeIdInfoVector)
+  {
+    AddMvtxFeeIdInfo(feeidinfo.bclk, feeidinfo.feeid, feeidinfo.detField);
+  }
+  for (const auto &[bclk, lv1Bco] : decoded.MvtxL1TrgBcoVector)
+  {
+    AddMvtxL1TrgBco(bclk, lv1Bco);
+  }
+  for (const auto &[bclk, hit] : decoded.TpcRawHitVector)
+  {
+    AddTpcRawHit(bclk, hit);
+  }
+  for (const auto &[bclk, hit] : decoded.MicromegasRawHitVector)
+  {
+    AddMicromegasRawHit(bclk, hit);
+  }
+  decoded.InttRawHitVector.clear();
+  decoded.MvtxRawHitVector.clear();
+  decoded.MvtxFeeIdInfoVector.clear();
+  decoded.MvtxL1TrgBcoVector.clear();
+  decoded.TpcRawHitVector.clear();
+  decoded.MicromegasRawHitVector.clear();
+}
+
+int Fun4AllStreamingInputManager::FillInttPool()
+{
+  const uint64_t ref_bco_minus_range = PoolMinBco(InputManagerType::INTT);
   for (auto *iter : m_InttInputVector)
   {
     if (!m_gl1_registered_flag)
@@ -1255,8 +1429,10 @@ int Fun4AllStreamingInputManager::FillInttPool()
     {
       std::cout << "Fun4AllStreamingInputManager::FillInttPool - fill pool for " << iter->Name() << std::endl;
     }
-    iter->FillPool(ref_bco_minus_range);
-    // iter->FillPool();
+    if (!m_InputsDecoded)
+    {
+      iter->FillPool(ref_bco_minus_range);
+    }
     if (m_RunNumber == 0)
     {
       m_RunNumber = iter->RunNumber();
@@ -1286,11 +1462,7 @@ int Fun4AllStreamingInputManager::FillInttPool()
 
 int Fun4AllStreamingInputManager::FillTpcPool()
 {
-  uint64_t ref_bco_minus_range = 0;
-  if (m_RefBCO > m_tpc_negative_bco)
-  {
-    ref_bco_minus_range = m_RefBCO - m_tpc_negative_bco;
-  }
+  const uint64_t ref_bco_minus_range = PoolMinBco(InputManagerType::TPC);
 
   for (auto *iter : m_TpcInputVector)
   {
@@ -1298,7 +1470,10 @@ int Fun4AllStreamingInputManager::FillTpcPool()
     {
       std::cout << "Fun4AllStreamingInputManager::FillTpcPool - fill pool for " << iter->Name() << std::endl;
     }
-    iter->FillPool(ref_bco_minus_range);
+    if (!m_InputsDecoded)
+    {
+      iter->FillPool(ref_bco_minus_range);
+    }
     const int fill_pool_status = iter->FillPoolStatus();
     if (fill_pool_status < 0)
     {
@@ -1334,11 +1509,7 @@ int Fun4AllStreamingInputManager::FillTpcPool()
 int Fun4AllStreamingInputManager::FillMicromegasPool()
 {
 
-  uint64_t ref_bco_minus_range = 0;
-  if (m_RefBCO > m_micromegas_negative_bco)
-  {
-    ref_bco_minus_range = m_RefBCO - m_micromegas_negative_bco;
-  }
+  const uint64_t ref_bco_minus_range = PoolMinBco(InputManagerType::MICROMEGAS);
 
   for (auto *iter : m_MicromegasInputVector)
   {
@@ -1346,7 +1517,10 @@ int Fun4AllStreamingInputManager::FillMicromegasPool()
     {
       std::cout << "Fun4AllStreamingInputManager::FillMicromegasPool - fill pool for " << iter->Name() << std::endl;
     }
-    iter->FillPool(ref_bco_minus_range);
+    if (!m_InputsDecoded)
+    {
+      iter->FillPool(ref_bco_minus_range);
+    }
     if (m_RunNumber == 0)
     {
       m_RunNumber = iter->RunNumber();
@@ -1376,14 +1550,17 @@ int Fun4AllStreamingInputManager::FillMicromegasPool()
 
 int Fun4AllStreamingInputManager::FillMvtxPool()
 {
-  uint64_t ref_bco_minus_range = m_RefBCO < m_mvtx_negative_bco ? m_mvtx_negative_bco : m_RefBCO - m_mvtx_negative_bco;
+  const uint64_t ref_bco_minus_range = PoolMinBco(InputManagerType::MVTX);
   for (auto *iter : m_MvtxInputVector)
   {
     if (Verbosity() > 3)
     {
       std::cout << "Fun4AllStreamingInputManager::FillMvtxPool - fill pool for " << iter->Name() << std::endl;
     }
-    iter->FillPool(ref_bco_minus_range);
+    if (!m_InputsDecoded)
+    {
+      iter->FillPool(ref_bco_minus_range);
+    }
     if (m_RunNumber == 0)
     {
       m_RunNumber = iter->RunNumber();
@@ -7,9 +7,13 @@
 
 #include <fun4all/Fun4AllInputManager.h>
 
+#include <cstdint>
 #include <map>
+#include <mutex>
 #include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
 class SingleStreamingInput;
 class Gl1Packet;
@@ -67,7 +71,16 @@ class Fun4AllStreamingInputManager : public Fun4AllInputManager
   int FillTpcPool();
   void Streaming(bool b = true) { m_StreamingFlag = b; }
 
-  void runMvtxTriggered(bool b = true) { m_mvtx_is_triggered = b; }
+  void runMvtxTriggered(bool b = true);
+
+  //! decode the INTT, MVTX, TPC and Micromegas inputs concurrently, one input per openmp thread
+  /**
+   * decoding starts once the reference BCO is known (from the GL1, or from the first
+   * subsystem which is then filled serially). Raw hits are staged per input and added
+   * to the BCO maps in registration order once all inputs are done, so that the BCO
+   * matching sees the same hits in the same order as in the serial mode
+   */
+  void ConcurrentDecoding(bool b = true) { m_ConcurrentDecodingFlag = b; }
 
  private:
   struct MvtxRawHitInfo
@@ -102,7 +115,32 @@ class Fun4AllStreamingInputManager : public Fun4AllInputManager
     unsigned int EventFoundCounter{0};
   };
 
+  //! raw hits from one input, staged while the inputs are decoded concurrently
+  struct DecodedHits
+  {
+    struct MvtxFeeIdInfoData
+    {
+      uint64_t bclk{0};
+      uint16_t feeid{0};
+      uint32_t detField{0};
+    };
+
+    std::vector<std::pair<uint64_t, InttRawHit *>> InttRawHitVector;
+    std::vector<std::pair<uint64_t, MicromegasRawHit *>> MicromegasRawHitVector;
+    std::vector<std::pair<uint64_t, MvtxRawHit *>> MvtxRawHitVector;
+    std::vector<MvtxFeeIdInfoData> MvtxFeeIdInfoVector;
+    std::vector<std::pair<uint64_t, uint64_t>> MvtxL1TrgBcoVector;
+    std::vector<std::pair<uint64_t, TpcRawHit *>> TpcRawHitVector;
+  };
+
   void createQAHistos();
+  uint64_t PoolMinBco(const InputManagerType::enu_subsystem system) const;
+  std::vector<SingleStreamingInput *> &InputVector(const InputManagerType::enu_subsystem system);
+  void DecodeInputs(const InputManagerType::enu_subsystem first_system);
+  void AddDecodedHits(DecodedHits &decoded);
+
+  //! staging area of the input decoded by the current thread, null outside of DecodeInputs
+  static thread_local DecodedHits *m_ThreadDecodedHits;
 
   SyncObject *m_SyncObject{nullptr};
   PHCompositeNode *m_topNode{nullptr};
@@ -126,6 +164,11 @@ class Fun4AllStreamingInputManager : public Fun4AllInputManager
   bool m_StreamingFlag{false};
   bool m_tpc_registered_flag{false};
   bool m_mvtx_is_triggered{false};
+  bool m_ConcurrentDecodingFlag{false};
+  bool m_InputsDecoded{false};
+
+  //! inputs configure the manager from their FillPool, guard against concurrent decoding
+  std::mutex m_ConfigMutex;
 
   std::vector<SingleStreamingInput *> m_Gl1InputVector;
   std::vector<SingleStreamingInput *> m_InttInputVector;
@@ -138,6 +181,8 @@ class Fun4AllStreamingInputManager : public Fun4AllInputManager
   std::map<uint64_t, MvtxRawHitInfo> m_MvtxRawHitMap;
   std::map<uint64_t, TpcRawHitInfo> m_TpcRawHitMap;
   std::map<int, std::map<int, uint64_t>> m_InttPacketFeeBcoMap;
+  std::vector<std::pair<SingleStreamingInput *, uint64_t>> m_DecodeInputs;
+  std::vector<DecodedHits> m_DecodedHits;
 
   // QA histos
   TH1 *h_refbco_mvtx[12]{nullptr};
@@ -0,0 +1,68 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef FUN4ALLRAW_RAWHITPOOL_H
+#define FUN4ALLRAW_RAWHITPOOL_H
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * Recycles raw hit objects between BCO windows, so that the streaming inputs
+ * do not allocate one new hit per decoded hit once the pool has grown to the
+ * largest number of hits in flight.
+ *
+ * Hits are still allocated one by one with new, so hits which are never
+ * released can be deleted as before by whoever still owns them
+ * (e.g. the streaming input manager when it is destroyed).
+ * Only hits on the free list are deleted with the pool.
+ */
+template <class T>
+class RawHitPool
+{
+ public:
+  RawHitPool() = default;
+  ~RawHitPool()
+  {
+    for (auto *hit : m_FreeHits)
+    {
+      delete hit;
+    }
+  }
+
+  //! delete copy ctor and assignment operator
+  RawHitPool(const RawHitPool &) = delete;
+  RawHitPool &operator=(const RawHitPool &) = delete;
+
+  //! get a default constructed hit, recycled if possible
+  T *get()
+  {
+    if (m_FreeHits.empty())
+    {
+      return new T;
+    }
+    T *hit = m_FreeHits.back();
+    m_FreeHits.pop_back();
+    return hit;
+  }
+
+  //! return a hit obtained from get() to the pool. It is reset to its default state
+  /**
+   * the hit is reset in place with T::Reset(), which keeps the capacity of its
+   * containers, its dynamic type must be T
+   */
+  template <class B>
+  void release(B *hit)
+  {
+    T *thishit = static_cast<T *>(hit);
+    thishit->Reset();
+    m_FreeHits.push_back(thishit);
+  }
+
+  //! number of hits waiting to be reused
+  size_t size() const { return m_FreeHits.size(); }
+
+ private:
+  std::vector<T *> m_FreeHits;
+};
+
+#endif
@@ -287,7 +287,7 @@ void SingleInttPoolInput::FillPool(const uint64_t minBCO)
             {
               continue;
             }
-            auto newhit = std::make_unique<InttRawHitv2>();
+            auto *newhit = m_RawHitPool.get();
             int FEE = pool->iValue(j, "FEE");
             newhit->set_packetid(pool->getIdentifier());
             newhit->set_fee(FEE);
@@ -324,9 +324,9 @@ void SingleInttPoolInput::FillPool(const uint64_t minBCO)
             }
             if (StreamingInputManager())
             {
-              StreamingInputManager()->AddInttRawHit(gtm_bco, newhit.get());
+              StreamingInputManager()->AddInttRawHit(gtm_bco, newhit);
             }
-            m_InttRawHitMap[gtm_bco].push_back(newhit.release());
+            m_InttRawHitMap[gtm_bco].push_back(newhit);
           }
         }
         //    Print("FEEBCLK");
@@ -394,7 +394,7 @@ void SingleInttPoolInput::CleanupUsedPackets(const uint64_t bclk)
   {
     for (const auto &rawhit : it->second)
     {
-      delete rawhit;
+      m_RawHitPool.release(rawhit);
     }
   }
   m_InttRawHitMap.erase(m_InttRawHitMap.begin(), m_InttRawHitMap.upper_bound(bclk));
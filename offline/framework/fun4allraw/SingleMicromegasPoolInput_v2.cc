@@ -357,8 +357,8 @@ void SingleMicromegasPoolInput_v2::CleanupUsedPackets(const uint64_t bclk, bool
           h_fee_waveform_count_dropped_pool->Fill(rawhit->get_fee(), 1);
         }
 
-        // delete raw hit
-        delete rawhit;
+        // recycle raw hit
+        m_RawHitPool.release(rawhit);
       }
     }
   }
@@ -922,7 +922,7 @@ void SingleMicromegasPoolInput_v2::process_fee_data(int packet_id, unsigned int
     }
 
     // create new hit
-    auto newhit = std::make_unique<MicromegasRawHit_impl>();
+    auto* newhit = m_RawHitPool.get();
     newhit->set_bco(fee_bco);
     newhit->set_gtm_bco(gtm_bco);
 
@@ -943,10 +943,10 @@ void SingleMicromegasPoolInput_v2::process_fee_data(int packet_id, unsigned int
 
     // add hit to streaming input manager
     if (StreamingInputManager())
-    { StreamingInputManager()->AddMicromegasRawHit(gtm_bco, newhit.get()); }
+    { StreamingInputManager()->AddMicromegasRawHit(gtm_bco, newhit); }
 
     // add to local map
-    m_MicromegasRawHitMap[fee_id][gtm_bco].emplace_back(newhit.release());
+    m_MicromegasRawHitMap[fee_id][gtm_bco].emplace_back(newhit);
   }
 }
 
@@ -1066,9 +1066,8 @@ void SingleMicromegasPoolInput_v2::recover_truncated_waveforms( const uint64_t t
       }
     }
 
-    // keep track of newly created hits
-    using rawhit_impl_pointer_t = std::unique_ptr<MicromegasRawHit_impl>; // unique_ptr to raw hit implementation object
-    using rawhit_impl_array_t = std::array<rawhit_impl_pointer_t, MAX_FEECHANNELCOUNT>; // fixed size array of the above
+    // keep track of newly created hits, obtained from the raw hit pool
+    using rawhit_impl_array_t = std::array<MicromegasRawHit_impl*, MAX_FEECHANNELCOUNT>;
     rawhit_impl_array_t new_rawhits{};
 
     // find candidate overlapping bco if any
@@ -1115,7 +1114,7 @@ void SingleMicromegasPoolInput_v2::recover_truncated_waveforms( const uint64_t t
             const auto target_fee_bco = bco_matching_information.get_predicted_fee_bco( target_bco_corrected ).value();
 
             // create new hit with shifted waveform
-            target = new MicromegasRawHit_impl;
+            target = m_RawHitPool.get();
 
             // copy relevant members from source
             target->set_bco(target_fee_bco);
@@ -1127,7 +1126,7 @@ void SingleMicromegasPoolInput_v2::recover_truncated_waveforms( const uint64_t t
             target->set_sampachannel(source->get_sampachannel());
 
             // store in new array
-            new_rawhits[target->get_channel()].reset(target);
+            new_rawhits[target->get_channel()] = target;
 
           }
 
@@ -1162,16 +1161,20 @@ void SingleMicromegasPoolInput_v2::recover_truncated_waveforms( const uint64_t t
     }
 
     // copy new hits in internal storage and add to streaming manager
-    for( auto&& rawhit:new_rawhits )
+    for( auto* rawhit:new_rawhits )
     {
-      if( rawhit && !rawhit->get_adc_waveforms().empty() )
+      if( !rawhit ) { continue; }
+      if( !rawhit->get_adc_waveforms().empty() )
       {
         // add hit to streaming input manager
         if (StreamingInputManager())
-        { StreamingInputManager()->AddMicromegasRawHit(found_bco, rawhit.get()); }
+        { StreamingInputManager()->AddMicromegasRawHit(found_bco, rawhit); }
 
         // add hit to insternal storage
-        m_MicromegasRawHitMap[fee][found_bco].emplace_back(rawhit.release());
+        m_MicromegasRawHitMap[fee][found_bco].emplace_back(rawhit);
+      } else {
+        // unused, return to pool
+        m_RawHitPool.release(rawhit);
       }
     }
 
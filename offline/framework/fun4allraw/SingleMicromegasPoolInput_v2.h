@@ -2,6 +2,7 @@
 #define FUN4ALLRAW_SINGLEMICROMEGASPOOLINPUT_V2_H
 
 #include "MicromegasBcoMatchingInformation_v2.h"
+#include "RawHitPool.h"
 #include "SingleStreamingInput.h"
 
 #include <phool/PHTimer.h>
@@ -16,6 +17,7 @@
 #include <vector>
 
 class MicromegasRawHit;
+class MicromegasRawHitv3;
 class Packet;
 
 class TFile;
@@ -162,6 +164,9 @@ class SingleMicromegasPoolInput_v2 : public SingleStreamingInput
   /// store list of raw hits matching a given GTM bco on a per FEE basis
   std::array<rawhit_map_t,MAX_FEECOUNT> m_MicromegasRawHitMap{};
 
+  /// recycled raw hits
+  RawHitPool<MicromegasRawHitv3> m_RawHitPool;
+
   /// map bco_information_t to packet id
   using bco_matching_information_map_t = std::map<unsigned int, MicromegasBcoMatchingInformation_v2>;
   bco_matching_information_map_t m_bco_matching_information_map{};
@@ -167,32 +167,31 @@ void SingleTpcPoolInput::FillPool(const uint64_t minBCO)
       else
       {
         int m_nWaveFormInFrame = packet->iValue(0, "NR_WF");
-        static int once = 0;
         for (int wf = 0; wf < m_nWaveFormInFrame; wf++)
         {
           if (m_TpcRawHitMap[gtm_bco].size() > 20000)
           {
-            if (!once)
+            if (!m_TooManyHits)
             {
               std::cout << "too many hits" << std::endl;
             }
-            once++;
+            m_TooManyHits++;
             continue;
           }
-          
-                      if (once)
-            {
-              std::cout << "many more hits: " << once << std::endl;
-            }
-            once = 0;
-         
+
+          if (m_TooManyHits)
+          {
+            std::cout << "many more hits: " << m_TooManyHits << std::endl;
+          }
+          m_TooManyHits = 0;
+
           bool checksumerror = (packet->iValue(wf, "CHECKSUMERROR") > 0);
           if (checksumerror)
           {
             continue;
           }
           bool parityerror = (packet->iValue(wf, "DATAPARITYERROR") > 0);
-          auto newhit = std::make_unique<TpcRawHitv2>();
+          auto *newhit = m_RawHitPool.get();
           int FEE = packet->iValue(wf, "FEE");
           newhit->set_bco(packet->iValue(wf, "BCO"));
 
@@ -253,9 +252,9 @@ void SingleTpcPoolInput::FillPool(const uint64_t minBCO)
           // {
           if (StreamingInputManager())
           {
-            StreamingInputManager()->AddTpcRawHit(gtm_bco, newhit.get());
+            StreamingInputManager()->AddTpcRawHit(gtm_bco, newhit);
           }
-          m_TpcRawHitMap[gtm_bco].push_back(newhit.release());
+          m_TpcRawHitMap[gtm_bco].push_back(newhit);
           m_BclkStack.insert(gtm_bco);
           //	}
         }
@@ -333,7 +332,7 @@ void SingleTpcPoolInput::CleanupUsedPackets(const uint64_t bclk)
     {
       for (auto *pktiter : iter.second)
       {
-        delete pktiter;
+        m_RawHitPool.release(pktiter);
       }
       toclearbclk.push_back(iter.first);
     }
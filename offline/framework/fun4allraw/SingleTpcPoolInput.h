@@ -1,6 +1,7 @@
 #ifndef FUN4ALLRAW_SINGLETPCPOOLINPUT_H
 #define FUN4ALLRAW_SINGLETPCPOOLINPUT_H
 
+#include "RawHitPool.h"
 #include "SingleStreamingInput.h"
 
 #include <array>
@@ -11,6 +12,7 @@
 #include <vector>
 
 class TpcRawHit;
+class TpcRawHitv2;
 class Packet;
 
 class SingleTpcPoolInput : public SingleStreamingInput
@@ -37,12 +39,15 @@ class SingleTpcPoolInput : public SingleStreamingInput
   unsigned int m_BcoRange{0};
   unsigned int m_NegativeBco{0};
   unsigned int m_max_tpc_time_samples{425};
+  //! waveforms dropped since the last "too many hits" printout. A member, inputs can be decoded concurrently
+  unsigned int m_TooManyHits{0};
   bool m_skipEarlyEvents{true};
   //! map bco to packet
   std::map<unsigned int, uint64_t> m_packet_bco;
 
   std::map<uint64_t, std::set<int>> m_BeamClockFEE;
   std::map<uint64_t, std::vector<TpcRawHit *>> m_TpcRawHitMap;
+  RawHitPool<TpcRawHitv2> m_RawHitPool;
   std::map<int, uint64_t> m_FEEBclkMap;
   std::set<uint64_t> m_BclkStack;
 };
@@ -0,0 +1,90 @@
+#include "PHEventArena.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+
+void *PHEventArena::Allocate(const std::size_t size, const std::size_t alignment)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  while (m_CurrentChunk < m_Chunks.size())
+  {
+    Chunk &chunk = m_Chunks[m_CurrentChunk];
+    const auto base = reinterpret_cast<std::uintptr_t>(chunk.data.get());
+    const std::uintptr_t aligned = (base + m_Offset + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+    if (aligned + size <= base + chunk.size)
+    {
+      m_Offset = aligned + size - base;
+      return reinterpret_cast<void *>(aligned);
+    }
+    // this chunk is full, move to the next one
+    ++m_CurrentChunk;
+    m_Offset = 0;
+  }
+
+  // no chunk left, allocate a new one, large enough for the request
+  std::size_t chunksize = m_Chunks.empty() ? m_InitialChunkSize : 2 * m_Chunks.back().size;
+  chunksize = std::max(chunksize, size + alignment);
+  m_Chunks.push_back({std::make_unique<std::byte[]>(chunksize), chunksize});
+  m_CurrentChunk = m_Chunks.size() - 1;
+
+  Chunk &chunk = m_Chunks.back();
+  const auto base = reinterpret_cast<std::uintptr_t>(chunk.data.get());
+  const std::uintptr_t aligned = (base + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+  m_Offset = aligned + size - base;
+  return reinterpret_cast<void *>(aligned);
+}
+
+bool PHEventArena::Contains(const void *ptr) const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  const auto address = reinterpret_cast<std::uintptr_t>(ptr);
+  return std::any_of(m_Chunks.begin(), m_Chunks.end(), [address](const Chunk &chunk)
+                     {
+                       const auto base = reinterpret_cast<std::uintptr_t>(chunk.data.get());
+                       return address >= base && address < base + chunk.size; });
+}
+
+void PHEventArena::Release()
+{
+  if (m_LiveObjects > 0)
+  {
+    // some container did not destroy its objects, reusing the memory would leave them dangling
+    std::cout << "PHEventArena::Release - " << m_LiveObjects << " arena objects still alive, memory not released" << std::endl;
+    return;
+  }
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_CurrentChunk = 0;
+  m_Offset = 0;
+}
+
+std::size_t PHEventArena::BytesUsed() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  std::size_t used = m_Offset;
+  for (std::size_t i = 0; i < m_CurrentChunk && i < m_Chunks.size(); ++i)
+  {
+    used += m_Chunks[i].size;
+  }
+  return used;
+}
+
+std::size_t PHEventArena::BytesReserved() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  std::size_t reserved = 0;
+  for (const auto &chunk : m_Chunks)
+  {
+    reserved += chunk.size;
+  }
+  return reserved;
+}
+
+void PHEventArena::Print() const
+{
+  std::cout << "PHEventArena: " << (m_Enabled ? "enabled" : "disabled")
+            << ", chunks: " << m_Chunks.size()
+            << ", live objects: " << m_LiveObjects
+            << ", bytes used: " << BytesUsed()
+            << ", bytes reserved: " << BytesReserved() << std::endl;
+}
@@ -0,0 +1,120 @@
+#ifndef PHOOL_PHEVENTARENA_H
+#define PHOOL_PHEVENTARENA_H
+
+//  Declaration of class PHEventArena
+//  Purpose: per event monotonic memory arena for objects owned by event containers.
+//  Objects are allocated by bumping a pointer in large chunks, and all of them
+//  are released at once by the server at the end of the event (after the node reset).
+//  Chunks are kept from one event to the next, so that no memory is allocated nor
+//  freed in steady state.
+//  The arena is disabled by default. When disabled, Create and Destroy
+//  fall back to new and delete. Destroy works for both arena and heap objects,
+//  so containers can mix objects read from file and objects created in memory.
+//  Only objects owned by containers below the nodes reset every event (Fun4AllServer
+//  ResetNodeList) may be created in the arena.
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+class PHEventArena
+{
+ public:
+  //! thread safe, Create and Destroy are called from worker threads (e.g. TpcClusterizer).
+  //! The arena is never deleted, so that objects can still be destroyed at exit
+  static PHEventArena *instance()
+  {
+    static PHEventArena *arena = new PHEventArena();
+    return arena;
+  }
+
+  ~PHEventArena() = default;
+
+  // no copy
+  PHEventArena(const PHEventArena &) = delete;
+  PHEventArena &operator=(const PHEventArena &) = delete;
+
+  void Enable(const bool b) { m_Enabled = b; }
+  bool IsEnabled() const { return m_Enabled; }
+
+  //! number of arena objects created and not destroyed yet
+  std::size_t LiveObjects() const { return m_LiveObjects; }
+
+  //! raw aligned allocation. Thread safe
+  void *Allocate(const std::size_t size, const std::size_t alignment);
+
+  //! true if the pointer belongs to the arena. Thread safe
+  bool Contains(const void *ptr) const;
+
+  //! release all objects in O(1). Destructors are not called.
+  //! All arena objects must have been destroyed before, otherwise the arena is kept as is
+  void Release();
+
+  //! bytes currently in use
+  std::size_t BytesUsed() const;
+
+  //! bytes allocated from the system
+  std::size_t BytesReserved() const;
+
+  void Print() const;
+
+  //! construct object in the arena if enabled, on the heap otherwise
+  template <class T, class... Args>
+  static T *Create(Args &&...args)
+  {
+    PHEventArena *arena = instance();
+    if (!arena->IsEnabled())
+    {
+      return new T(std::forward<Args>(args)...);
+    }
+    T *obj = new (arena->Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    ++arena->m_LiveObjects;
+    return obj;
+  }
+
+  //! destroy object, either from the arena (destructor only) or from the heap
+  template <class T>
+  static void Destroy(T *obj)
+  {
+    if (!obj)
+    {
+      return;
+    }
+    // no lock needed when there are no arena objects, e.g. when the arena was never enabled
+    PHEventArena *arena = instance();
+    if (arena->m_LiveObjects > 0 && arena->Contains(obj))
+    {
+      obj->~T();
+      --arena->m_LiveObjects;
+    }
+    else
+    {
+      delete obj;
+    }
+  }
+
+ private:
+  PHEventArena() = default;
+
+  struct Chunk
+  {
+    std::unique_ptr<std::byte[]> data;
+    std::size_t size{0};
+  };
+
+  //! size of the first chunk, later chunks double in size
+  static constexpr std::size_t m_InitialChunkSize = 1UL << 20U;
+
+  std::atomic<bool> m_Enabled{false};
+  std::atomic<std::size_t> m_LiveObjects{0};
+  std::vector<Chunk> m_Chunks;
+  std::size_t m_CurrentChunk{0};
+  std::size_t m_Offset{0};
+  mutable std::mutex m_Mutex;
+};
+
+#endif
@@ -175,8 +175,29 @@ bool PHNodeIOManager::write(TObject** data, const std::string& path, int nodebuf
       {
         use_buffersize = nodebuffersize;
       }
-      tree->Branch(path.c_str(), (*data)->ClassName(),
-                   data, use_buffersize, use_splitlevel);
+      // per node settings take precedence, the node name is the last part of the branch path
+      int use_compression = -1;
+      std::string nodename = path.substr(path.rfind(phooldefs::branchpathdelim) + 1);
+      auto settingsiter = m_NodeBranchSettings.find(nodename);
+      if (settingsiter != m_NodeBranchSettings.end())
+      {
+        if (settingsiter->second.splitlevel != std::numeric_limits<int>::min())
+        {
+          use_splitlevel = settingsiter->second.splitlevel;
+        }
+        if (settingsiter->second.buffersize != std::numeric_limits<int>::min())
+        {
+          use_buffersize = settingsiter->second.buffersize;
+        }
+        use_compression = settingsiter->second.compression;
+      }
+      TBranch *newBranch = tree->Branch(path.c_str(), (*data)->ClassName(),
+                                        data, use_buffersize, use_splitlevel);
+      if (newBranch && use_compression >= 0)
+      {
+        // also applies to all sub branches of a split object
+        newBranch->SetCompressionSettings(use_compression);
+      }
     }
     else
     {
@@ -546,6 +567,19 @@ bool PHNodeIOManager::SetCompressionSetting(const int level)
   return true;
 }
 
+void PHNodeIOManager::ImplicitMT(const bool b, const unsigned int nthreads)
+{
+  m_ImplicitMT = b;
+  if (m_ImplicitMT && !ROOT::IsImplicitMTEnabled())
+  {
+    ROOT::EnableImplicitMT(nthreads);
+  }
+  if (tree)
+  {
+    tree->SetImplicitMT(m_ImplicitMT);
+  }
+}
+
 uint64_t
 PHNodeIOManager::GetBytesWritten()
 {
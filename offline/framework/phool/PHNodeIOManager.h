@@ -56,10 +56,27 @@ class PHNodeIOManager : public PHIOManager
   int BufferSize() const { return buffersize; }
   int CacheSize() const { return m_cacheSize; }
   void CacheSize(uint64_t size) { m_cacheSize = size;}
+
+  // per node settings, applied when the branch is created. They override
+  // the file wide buffer size, split level and compression setting
+  void NodeBufferSize(const std::string &nodename, const int size) { m_NodeBranchSettings[nodename].buffersize = size; }
+  void NodeSplitLevel(const std::string &nodename, const int split) { m_NodeBranchSettings[nodename].splitlevel = split; }
+  void NodeCompressionSetting(const std::string &nodename, const int setting) { m_NodeBranchSettings[nodename].compression = setting; }
+
+  // compress and write baskets in parallel using ROOT implicit multi threading
+  // nthreads = 0 lets ROOT pick the number of threads
+  void ImplicitMT(const bool b, const unsigned int nthreads = 0);
   
   void DisableReadCache();
 
 private:
+  struct BranchSettings
+  {
+    int buffersize{std::numeric_limits<int>::min()};
+    int splitlevel{std::numeric_limits<int>::min()};
+    int compression{-1};
+  };
+
   int FillBranchMap();
   PHCompositeNode *reconstructNodeTree(PHCompositeNode *);
   bool readEventFromFile(size_t requestedEvent);
@@ -76,6 +93,8 @@ private:
   int splitlevel{std::numeric_limits<int>::min()};
   std::map<std::string, TBranch *> fBranches;
   std::map<std::string, bool> objectToRead;
+  std::map<std::string, BranchSettings> m_NodeBranchSettings;
+  bool m_ImplicitMT{false};
 };
 
 #endif
@@ -2,6 +2,8 @@
 
 #include "RawCluster.h"
 
+#include <phool/PHEventArena.h>
+
 #include <iostream>
 
 RawClusterContainer::ConstRange
@@ -63,7 +65,7 @@ void RawClusterContainer::Reset()
 {
   while (_clusters.begin() != _clusters.end())
   {
-    delete _clusters.begin()->second;
+    PHEventArena::Destroy(_clusters.begin()->second);
     _clusters.erase(_clusters.begin());
   }
 }
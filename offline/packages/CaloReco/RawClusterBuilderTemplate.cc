@@ -29,6 +29,7 @@
 #include <fun4all/SubsysReco.h>
 
 #include <phool/PHCompositeNode.h>
+#include <phool/PHEventArena.h>
 #include <phool/PHIODataNode.h>
 #include <phool/PHNode.h>
 #include <phool/PHNodeIterator.h>
@@ -686,7 +687,7 @@ int RawClusterBuilderTemplate::process_event(PHCompositeNode *topNode)
       //      std::cout << "Prob/Chi2/NDF = " << prob << " " << chi2
       //           << " " << ndf << " Ecl = " << ecl << std::endl;
 
-      cluster = new RawClusterv1();
+      cluster = PHEventArena::Create<RawClusterv1>();
       cluster->set_energy(ecl);
       cluster->set_ecore(ecore);
       cluster->set_r(std::sqrt(xg * xg + yg * yg));
@@ -1,5 +1,7 @@
 #include "PHField2D.h"
 
+#include "PHFieldBinaryMap.h"
+
 // root framework
 #include <TDirectory.h>
 #include <TFile.h>
@@ -27,6 +29,22 @@ PHField2D::PHField2D(const std::string &filename, const int verb, const float ma
   {
     std::cout << " ------------- PHField2D::PHField2D() ------------------" << std::endl;
   }
+
+  magfield_rescale_ = magfield_rescale;
+
+  // binary field maps are mapped as they are, no need to go through ROOT
+  if (PHFieldBinaryMap::IsBinaryMap(filename))
+  {
+    load_binary_map(filename);
+    if (Verbosity() > 0)
+    {
+      std::cout << "  Mag field z boundaries (min,max): (" << minz_ / cm << ", " << maxz_ / cm << ") cm" << std::endl;
+      std::cout << "  Mag field r max boundary: " << r_map_.back() / cm << " cm" << std::endl;
+      std::cout << " -----------------------------------------------------------" << std::endl;
+    }
+    return;
+  }
+
   // open file
   TFile *rootinput = TFile::Open(filename.c_str());
   if (!rootinput)
@@ -154,9 +172,13 @@ PHField2D::PHField2D(const std::string &filename, const int verb, const float ma
   std::copy(z_set.begin(), z_set.end(), z_map_.begin());
   std::copy(r_set.begin(), r_set.end(), r_map_.begin());
 
-  // initialize the field map vectors to the correct sizes
-  BFieldR_.resize(nz, std::vector<float>(nr, 0));
-  BFieldZ_.resize(nz, std::vector<float>(nr, 0));
+  // initialize the field map arrays to the correct sizes
+  const size_t npoints = static_cast<size_t>(nz) * nr;
+  field_storage_.assign(2 * npoints, 0);
+  float *bfield_z = field_storage_.data();
+  float *bfield_r = bfield_z + npoints;
+  BFieldZ_ = bfield_z;
+  BFieldR_ = bfield_r;
 
   // all of this assumes that  z_prev < z , i.e. the table is ordered (as of right now)
   unsigned int ir = 0;
@@ -190,8 +212,9 @@ PHField2D::PHField2D(const std::string &filename, const int verb, const float ma
       std::cout << "!!!!!!!!! Your map isn't ordered.... z: " << z << " zprev: " << z_map_[iz - 1] << std::endl;
     }
 
-    BFieldR_[iz][ir] = Br * magfield_rescale;
-    BFieldZ_[iz][ir] = Bz * magfield_rescale;
+    const size_t ibin = grid_index(iz, ir);
+    bfield_r[ibin] = Br * magfield_rescale;
+    bfield_z[ibin] = Bz * magfield_rescale;
 
     // you can change this to check table values for correctness
     // print_map prints the values in the root table, and the
@@ -203,8 +226,8 @@ PHField2D::PHField2D(const std::string &filename, const int verb, const float ma
       std::cout << " B("
                 << r_map_[ir] << ", "
                 << z_map_[iz] << "):  ("
-                << BFieldR_[iz][ir] << ", "
-                << BFieldZ_[iz][ir] << ")" << std::endl;
+                << BFieldR_[ibin] << ", "
+                << BFieldZ_[ibin] << ")" << std::endl;
     }
 
   }  // end loop over root field map file
@@ -419,15 +442,15 @@ void PHField2D::GetFieldCyl(const double CylPoint[4], double *BfieldCyl) const
     z_index1_cache = z_index1;
   }
 
-  double Br000 = BFieldR_[z_index0][r_index0];
-  double Br010 = BFieldR_[z_index0][r_index1];
-  double Br100 = BFieldR_[z_index1][r_index0];
-  double Br110 = BFieldR_[z_index1][r_index1];
+  double Br000 = BFieldR_[grid_index(z_index0, r_index0)];
+  double Br010 = BFieldR_[grid_index(z_index0, r_index1)];
+  double Br100 = BFieldR_[grid_index(z_index1, r_index0)];
+  double Br110 = BFieldR_[grid_index(z_index1, r_index1)];
 
-  double Bz000 = BFieldZ_[z_index0][r_index0];
-  double Bz100 = BFieldZ_[z_index1][r_index0];
-  double Bz010 = BFieldZ_[z_index0][r_index1];
-  double Bz110 = BFieldZ_[z_index1][r_index1];
+  double Bz000 = BFieldZ_[grid_index(z_index0, r_index0)];
+  double Bz100 = BFieldZ_[grid_index(z_index1, r_index0)];
+  double Bz010 = BFieldZ_[grid_index(z_index0, r_index1)];
+  double Bz110 = BFieldZ_[grid_index(z_index1, r_index1)];
 
   double zweight = z - z_map_[z_index0];
   double zspacing = z_map_[z_index1] - z_map_[z_index0];
@@ -454,6 +477,13 @@ void PHField2D::GetFieldCyl(const double CylPoint[4], double *BfieldCyl) const
   // PHI Direction of B-field
   BfieldCyl[2] = 0;
 
+  // binary field maps are stored without rescaling
+  if (binary_map_)
+  {
+    BfieldCyl[0] *= magfield_rescale_;
+    BfieldCyl[1] *= magfield_rescale_;
+  }
+
   if (Verbosity() > 2)
   {
     std::cout << "End GFCyl Call: <bz,br,bphi> : {"
@@ -527,15 +557,15 @@ void PHField2D::GetFieldCyl_nocache(const double CylPoint[4], double *BfieldCyl)
     return;
   }
 
-  double Br000 = BFieldR_[z_index0][r_index0];
-  double Br010 = BFieldR_[z_index0][r_index1];
-  double Br100 = BFieldR_[z_index1][r_index0];
-  double Br110 = BFieldR_[z_index1][r_index1];
+  double Br000 = BFieldR_[grid_index(z_index0, r_index0)];
+  double Br010 = BFieldR_[grid_index(z_index0, r_index1)];
+  double Br100 = BFieldR_[grid_index(z_index1, r_index0)];
+  double Br110 = BFieldR_[grid_index(z_index1, r_index1)];
 
-  double Bz000 = BFieldZ_[z_index0][r_index0];
-  double Bz100 = BFieldZ_[z_index1][r_index0];
-  double Bz010 = BFieldZ_[z_index0][r_index1];
-  double Bz110 = BFieldZ_[z_index1][r_index1];
+  double Bz000 = BFieldZ_[grid_index(z_index0, r_index0)];
+  double Bz100 = BFieldZ_[grid_index(z_index1, r_index0)];
+  double Bz010 = BFieldZ_[grid_index(z_index0, r_index1)];
+  double Bz110 = BFieldZ_[grid_index(z_index1, r_index1)];
 
   double zweight = z - z_map_[z_index0];
   double zspacing = z_map_[z_index1] - z_map_[z_index0];
@@ -562,6 +592,13 @@ void PHField2D::GetFieldCyl_nocache(const double CylPoint[4], double *BfieldCyl)
   // PHI Direction of B-field
   BfieldCyl[2] = 0;
 
+  // binary field maps are stored without rescaling
+  if (binary_map_)
+  {
+    BfieldCyl[0] *= magfield_rescale_;
+    BfieldCyl[1] *= magfield_rescale_;
+  }
+
   if (Verbosity() > 2)
   {
     std::cout << "End GFCyl Call: <bz,br,bphi> : {"
@@ -572,6 +609,45 @@ void PHField2D::GetFieldCyl_nocache(const double CylPoint[4], double *BfieldCyl)
   return;
 }
 
+bool PHField2D::WriteBinaryMap(const std::string &filename) const
+{
+  if (!binary_map_ && magfield_rescale_ != 1)
+  {
+    std::cout << "PHField2D::WriteBinaryMap - field map was rescaled when reading "
+              << "it, read it with magfield_rescale = 1 to convert it" << std::endl;
+    return false;
+  }
+  return PHFieldBinaryMap::Write(filename, z_map_, r_map_, std::vector<float>(), BFieldZ_, BFieldR_);
+}
+
+void PHField2D::load_binary_map(const std::string &filename)
+{
+  if (Verbosity() > 0)
+  {
+    std::cout << "  Binary field grid file: " << filename << std::endl;
+  }
+
+  binary_map_ = PHFieldBinaryMap::Open(filename, Verbosity());
+  if (!binary_map_ || binary_map_->nphi() != 0)
+  {
+    std::cout << " could not map 2D field map " << filename << " exiting now" << std::endl;
+    gSystem->Exit(1);
+    exit(1);
+  }
+
+  // the axes are tiny, copy them for the upper_bound searches
+  z_map_.assign(binary_map_->z_map(), binary_map_->z_map() + binary_map_->nz());
+  r_map_.assign(binary_map_->r_map(), binary_map_->r_map() + binary_map_->nr());
+  minz_ = z_map_.front();
+  maxz_ = z_map_.back();
+
+  // field values are stored in Geant4 units
+  magfield_unit = tesla;
+
+  BFieldZ_ = binary_map_->Bz();
+  BFieldR_ = binary_map_->Br();
+}
+
 // debug function to print key/value pairs in map
 void PHField2D::print_map(std::map<trio, trio>::iterator &it) const
 {
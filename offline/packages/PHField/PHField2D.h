@@ -4,11 +4,18 @@
 
 #include "PHField.h"
 
+#include <cstddef>
 #include <map>
+#include <memory>
 #include <string>
 #include <tuple>
 #include <vector>
 
+class PHFieldBinaryMap;
+
+// 2D field map in ( z, r ), read from a ROOT ntuple or a binary field map
+// (see PHFieldBinaryMap), which is attached with mmap and shared with all
+// other jobs on the node.
 class PHField2D : public PHField
 {
   typedef std::tuple<float, float> trio;
@@ -16,6 +23,10 @@ class PHField2D : public PHField
  public:
   PHField2D(const std::string &filename, const int verb = 0, const float magfield_rescale = 1.0);
 
+  //! the field component pointers point into this object's storage or mapped file, no copies
+  PHField2D(const PHField2D &) = delete;
+  PHField2D &operator=(const PHField2D &) = delete;
+
   //! access field value
   //! Follow the convention of G4ElectroMagneticField
   //! @param[in]  Point   space time coordinate. x, y, z, t in Geant4/CLHEP units
@@ -29,11 +40,23 @@ class PHField2D : public PHField
 
   void GetFieldCyl_nocache(const double CylPoint[4], double *Bfield) const;
 
+  //! write the map as binary field map. Only maps read without rescaling can be converted
+  bool WriteBinaryMap(const std::string &filename) const;
+
   protected:
-  // < i, j, k > , this allows i and i+1 to be neighbors ( <i,j,k>=<z,r,phi> )
-  std::vector<std::vector<float> > BFieldZ_;
-  std::vector<std::vector<float> > BFieldR_;
-  std::vector<std::vector<float> > BFieldPHI_;
+  // < i, j > , this allows i and i+1 to be neighbors ( <i,j>=<z,r> )
+  size_t grid_index(unsigned int iz, unsigned int ir) const
+  {
+    return static_cast<size_t>(iz) * r_map_.size() + ir;
+  }
+
+  // field components, either read from the ROOT map (already rescaled) or
+  // mapped from a binary field map (rescaled at lookup)
+  std::vector<float> field_storage_;
+  std::shared_ptr<const PHFieldBinaryMap> binary_map_;
+  const float *BFieldZ_{nullptr};
+  const float *BFieldR_{nullptr};
+  float magfield_rescale_{1};
 
   // maps indices to values z_map[i] = z_value that corresponds to ith index
   std::vector<float> z_map_;    // < i >
@@ -44,6 +67,7 @@ class PHField2D : public PHField
   double magfield_unit;
 
  private:
+  void load_binary_map(const std::string &filename);
   void print_map(std::map<trio, trio>::iterator &it) const;
   // mutable allows to change internal data even in const methods
   // I don't like this too much but these are cached values to speed up
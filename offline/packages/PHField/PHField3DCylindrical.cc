@@ -1,5 +1,7 @@
 #include "PHField3DCylindrical.h"
 
+#include "PHFieldBinaryMap.h"
+
 #include <TDirectory.h>  // for TDirectory, gDirectory
 #include <TFile.h>
 #include <TNtuple.h>
@@ -23,6 +25,22 @@ PHField3DCylindrical::PHField3DCylindrical(const std::string &filename, const in
             << "\n      Magnetic field Module - Verbosity:" << Verbosity()
             << "\n-----------------------------------------------------------";
 
+  magfield_rescale_ = magfield_rescale;
+
+  // binary field maps are mapped as they are, no need to go through ROOT
+  if (PHFieldBinaryMap::IsBinaryMap(filename))
+  {
+    load_binary_map(filename);
+
+    std::cout << "\n ---> ... mapped file successfully "
+              << "\n ---> Z Boundaries ~ zlow, zhigh: "
+              << minz_ / cm << "," << maxz_ / cm << " cm " << std::endl;
+
+    std::cout << "\n================= End Construct Mag Field ======================\n"
+              << std::endl;
+    return;
+  }
+
   // open file
   TFile *rootinput = TFile::Open(filename.c_str());
   if (!rootinput)
@@ -142,10 +160,15 @@ PHField3DCylindrical::PHField3DCylindrical(const std::string &filename, const in
   std::copy(phi_set.begin(), phi_set.end(), phi_map_.begin());
   std::copy(r_set.begin(), r_set.end(), r_map_.begin());
 
-  // initialize the field map vectors to the correct sizes
-  BFieldR_.resize(nz, std::vector<std::vector<float> >(nr, std::vector<float>(nphi, 0)));
-  BFieldPHI_.resize(nz, std::vector<std::vector<float> >(nr, std::vector<float>(nphi, 0)));
-  BFieldZ_.resize(nz, std::vector<std::vector<float> >(nr, std::vector<float>(nphi, 0)));
+  // initialize the field map arrays to the correct sizes
+  const size_t npoints = static_cast<size_t>(nz) * nr * nphi;
+  field_storage_.assign(3 * npoints, 0);
+  float *bfield_z = field_storage_.data();
+  float *bfield_r = bfield_z + npoints;
+  float *bfield_phi = bfield_r + npoints;
+  BFieldZ_ = bfield_z;
+  BFieldR_ = bfield_r;
+  BFieldPHI_ = bfield_phi;
 
   // all of this assumes that  z_prev < z , i.e. the table is ordered (as of right now)
   unsigned int ir = 0;
@@ -188,9 +211,10 @@ PHField3DCylindrical::PHField3DCylindrical(const std::string &filename, const in
       std::cout << "!!!!!!!!! Your map isn't ordered.... z: " << z << " zprev: " << z_map_[iz - 1] << std::endl;
     }
 
-    BFieldR_[iz][ir][iphi] = Br * magfield_rescale;
-    BFieldPHI_[iz][ir][iphi] = Bphi * magfield_rescale;
-    BFieldZ_[iz][ir][iphi] = Bz * magfield_rescale;
+    const size_t ibin = grid_index(iz, ir, iphi);
+    bfield_r[ibin] = Br * magfield_rescale;
+    bfield_phi[ibin] = Bphi * magfield_rescale;
+    bfield_z[ibin] = Bz * magfield_rescale;
 
     // you can change this to check table values for correctness
     // print_map prints the values in the root table, and the
@@ -203,9 +227,9 @@ PHField3DCylindrical::PHField3DCylindrical(const std::string &filename, const in
                 << r_map_[ir] << ", "
                 << phi_map_[iphi] << ", "
                 << z_map_[iz] << "):  ("
-                << BFieldR_[iz][ir][iphi] << ", "
-                << BFieldPHI_[iz][ir][iphi] << ", "
-                << BFieldZ_[iz][ir][iphi] << ")" << std::endl;
+                << BFieldR_[ibin] << ", "
+                << BFieldPHI_[ibin] << ", "
+                << BFieldZ_[ibin] << ")" << std::endl;
     }
 
   }  // end loop over root field map file
@@ -370,32 +394,32 @@ void PHField3DCylindrical::GetFieldCyl(const double CylPoint[4], double *BfieldC
   assert(phi_index0 < (int) phi_map_.size());
   assert(phi_index1 >= 0);
 
-  double Br000 = BFieldR_[z_index0][r_index0][phi_index0];
-  double Br001 = BFieldR_[z_index0][r_index0][phi_index1];
-  double Br010 = BFieldR_[z_index0][r_index1][phi_index0];
-  double Br011 = BFieldR_[z_index0][r_index1][phi_index1];
-  double Br100 = BFieldR_[z_index1][r_index0][phi_index0];
-  double Br101 = BFieldR_[z_index1][r_index0][phi_index1];
-  double Br110 = BFieldR_[z_index1][r_index1][phi_index0];
-  double Br111 = BFieldR_[z_index1][r_index1][phi_index1];
-
-  double Bphi000 = BFieldPHI_[z_index0][r_index0][phi_index0];
-  double Bphi001 = BFieldPHI_[z_index0][r_index0][phi_index1];
-  double Bphi010 = BFieldPHI_[z_index0][r_index1][phi_index0];
-  double Bphi011 = BFieldPHI_[z_index0][r_index1][phi_index1];
-  double Bphi100 = BFieldPHI_[z_index1][r_index0][phi_index0];
-  double Bphi101 = BFieldPHI_[z_index1][r_index0][phi_index1];
-  double Bphi110 = BFieldPHI_[z_index1][r_index1][phi_index0];
-  double Bphi111 = BFieldPHI_[z_index1][r_index1][phi_index1];
-
-  double Bz000 = BFieldZ_[z_index0][r_index0][phi_index0];
-  double Bz001 = BFieldZ_[z_index0][r_index0][phi_index1];
-  double Bz100 = BFieldZ_[z_index1][r_index0][phi_index0];
-  double Bz101 = BFieldZ_[z_index1][r_index0][phi_index1];
-  double Bz010 = BFieldZ_[z_index0][r_index1][phi_index0];
-  double Bz110 = BFieldZ_[z_index1][r_index1][phi_index0];
-  double Bz011 = BFieldZ_[z_index0][r_index1][phi_index1];
-  double Bz111 = BFieldZ_[z_index1][r_index1][phi_index1];
+  double Br000 = BFieldR_[grid_index(z_index0, r_index0, phi_index0)];
+  double Br001 = BFieldR_[grid_index(z_index0, r_index0, phi_index1)];
+  double Br010 = BFieldR_[grid_index(z_index0, r_index1, phi_index0)];
+  double Br011 = BFieldR_[grid_index(z_index0, r_index1, phi_index1)];
+  double Br100 = BFieldR_[grid_index(z_index1, r_index0, phi_index0)];
+  double Br101 = BFieldR_[grid_index(z_index1, r_index0, phi_index1)];
+  double Br110 = BFieldR_[grid_index(z_index1, r_index1, phi_index0)];
+  double Br111 = BFieldR_[grid_index(z_index1, r_index1, phi_index1)];
+
+  double Bphi000 = BFieldPHI_[grid_index(z_index0, r_index0, phi_index0)];
+  double Bphi001 = BFieldPHI_[grid_index(z_index0, r_index0, phi_index1)];
+  double Bphi010 = BFieldPHI_[grid_index(z_index0, r_index1, phi_index0)];
+  double Bphi011 = BFieldPHI_[grid_index(z_index0, r_index1, phi_index1)];
+  double Bphi100 = BFieldPHI_[grid_index(z_index1, r_index0, phi_index0)];
+  double Bphi101 = BFieldPHI_[grid_index(z_index1, r_index0, phi_index1)];
+  double Bphi110 = BFieldPHI_[grid_index(z_index1, r_index1, phi_index0)];
+  double Bphi111 = BFieldPHI_[grid_index(z_index1, r_index1, phi_index1)];
+
+  double Bz000 = BFieldZ_[grid_index(z_index0, r_index0, phi_index0)];
+  double Bz001 = BFieldZ_[grid_index(z_index0, r_index0, phi_index1)];
+  double Bz100 = BFieldZ_[grid_index(z_index1, r_index0, phi_index0)];
+  double Bz101 = BFieldZ_[grid_index(z_index1, r_index0, phi_index1)];
+  double Bz010 = BFieldZ_[grid_index(z_index0, r_index1, phi_index0)];
+  double Bz110 = BFieldZ_[grid_index(z_index1, r_index1, phi_index0)];
+  double Bz011 = BFieldZ_[grid_index(z_index0, r_index1, phi_index1)];
+  double Bz111 = BFieldZ_[grid_index(z_index1, r_index1, phi_index1)];
 
   double zweight = z - z_map_[z_index0];
   double zspacing = z_map_[z_index1] - z_map_[z_index0];
@@ -434,6 +458,14 @@ void PHField3DCylindrical::GetFieldCyl(const double CylPoint[4], double *BfieldC
       zweight * ((1 - rweight) * ((1 - phiweight) * Bphi100 + phiweight * Bphi101) +
                  rweight * ((1 - phiweight) * Bphi110 + phiweight * Bphi111));
 
+  // binary field maps are stored without rescaling
+  if (binary_map_)
+  {
+    BfieldCyl[0] *= magfield_rescale_;
+    BfieldCyl[1] *= magfield_rescale_;
+    BfieldCyl[2] *= magfield_rescale_;
+  }
+
   //     std::cout << "wr: " << rweight << " wz: " << zweight << " wphi: " << phiweight << std::endl;
   //     std::cout << "Bz000: " << Bz000 << std::endl
   //          << "Bz001: " << Bz001 << std::endl
@@ -455,6 +487,42 @@ void PHField3DCylindrical::GetFieldCyl(const double CylPoint[4], double *BfieldC
   return;
 }
 
+bool PHField3DCylindrical::WriteBinaryMap(const std::string &filename) const
+{
+  if (!binary_map_ && magfield_rescale_ != 1)
+  {
+    std::cout << "PHField3DCylindrical::WriteBinaryMap - field map was rescaled when reading "
+              << "it, read it with magfield_rescale = 1 to convert it" << std::endl;
+    return false;
+  }
+  return PHFieldBinaryMap::Write(filename, z_map_, r_map_, phi_map_, BFieldZ_, BFieldR_, BFieldPHI_);
+}
+
+void PHField3DCylindrical::load_binary_map(const std::string &filename)
+{
+  std::cout << "\n ---> "
+               "Mapping the binary field grid from "
+            << filename << " ... " << std::endl;
+
+  binary_map_ = PHFieldBinaryMap::Open(filename, Verbosity());
+  if (!binary_map_ || binary_map_->nphi() < 2)
+  {
+    std::cout << "\n could not map 3D field map " << filename << " exiting now" << std::endl;
+    exit(1);
+  }
+
+  // the axes are tiny, copy them for the upper_bound searches
+  z_map_.assign(binary_map_->z_map(), binary_map_->z_map() + binary_map_->nz());
+  r_map_.assign(binary_map_->r_map(), binary_map_->r_map() + binary_map_->nr());
+  phi_map_.assign(binary_map_->phi_map(), binary_map_->phi_map() + binary_map_->nphi());
+  minz_ = z_map_.front();
+  maxz_ = z_map_.back();
+
+  BFieldZ_ = binary_map_->Bz();
+  BFieldR_ = binary_map_->Br();
+  BFieldPHI_ = binary_map_->Bphi();
+}
+
 // a binary search algorithm that puts the location that "key" would be, into index...
 // it returns true if key was found, and false if not.
 bool PHField3DCylindrical::bin_search(const std::vector<float> &vec, unsigned start, unsigned end, const float &key, unsigned &index) const
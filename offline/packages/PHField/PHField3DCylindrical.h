@@ -16,17 +16,24 @@
 // has much more to do with the way the PHENIX field map is formatted
 // in SimMap3D++.root i.e.  The z value is incremented only after
 // every phi and r point has been accounted for in that plane.
+//
+// The map can also be read from a binary field map (see PHFieldBinaryMap),
+// which is attached with mmap and shared with all other jobs on the node.
 
 #ifndef PHFIELD_PHFIELD3DCYLINDRICAL_H
 #define PHFIELD_PHFIELD3DCYLINDRICAL_H
 
 #include "PHField.h"
 
+#include <cstddef>
 #include <map>
+#include <memory>
 #include <string>
 #include <tuple>
 #include <vector>
 
+class PHFieldBinaryMap;
+
 class PHField3DCylindrical : public PHField
 {
   typedef std::tuple<float, float, float> trio;
@@ -34,14 +41,31 @@ class PHField3DCylindrical : public PHField
  public:
   PHField3DCylindrical(const std::string& filename, int verb = 0, const float magfield_rescale = 1.0);
   ~PHField3DCylindrical() override {}
+
+  //! the field component pointers point into this object's storage or mapped file, no copies
+  PHField3DCylindrical(const PHField3DCylindrical&) = delete;
+  PHField3DCylindrical& operator=(const PHField3DCylindrical&) = delete;
   void GetFieldValue(const double Point[4], double* Bfield) const override;
   void GetFieldCyl(const double CylPoint[4], double* Bfield) const;
 
+  //! write the map as binary field map. Only maps read without rescaling can be converted
+  bool WriteBinaryMap(const std::string& filename) const;
+
  protected:
   // < i, j, k > , this allows i and i+1 to be neighbors ( <i,j,k>=<z,r,phi> )
-  std::vector<std::vector<std::vector<float> > > BFieldZ_;
-  std::vector<std::vector<std::vector<float> > > BFieldR_;
-  std::vector<std::vector<std::vector<float> > > BFieldPHI_;
+  size_t grid_index(unsigned int iz, unsigned int ir, unsigned int iphi) const
+  {
+    return (static_cast<size_t>(iz) * r_map_.size() + ir) * phi_map_.size() + iphi;
+  }
+
+  // field components, either read from the ROOT map (already rescaled) or
+  // mapped from a binary field map (rescaled at lookup)
+  std::vector<float> field_storage_;
+  std::shared_ptr<const PHFieldBinaryMap> binary_map_;
+  const float* BFieldZ_{nullptr};
+  const float* BFieldR_{nullptr};
+  const float* BFieldPHI_{nullptr};
+  float magfield_rescale_{1};
 
   // maps indices to values z_map[i] = z_value that corresponds to ith index
   std::vector<float> z_map_;    // < i >
@@ -51,6 +75,7 @@ class PHField3DCylindrical : public PHField
   float maxz_, minz_;  // boundaries of magnetic field map cyl
 
  private:
+  void load_binary_map(const std::string& filename);
   bool bin_search(const std::vector<float>& vec, unsigned start, unsigned end, const float& key, unsigned& index) const;
   void print_map(std::map<trio, trio>::iterator& it) const;
 };
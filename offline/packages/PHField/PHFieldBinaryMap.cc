@@ -0,0 +1,194 @@
+#include "PHFieldBinaryMap.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+
+namespace
+{
+  const char fileMagic[8] = {'P', 'H', 'F', 'I', 'E', 'L', 'D', 'B'};
+  const uint32_t fileVersion = 1;
+  const size_t dataOffset = 4096;  // keep the arrays page aligned in the file
+
+  struct FileHeader
+  {
+    char magic[8];
+    uint32_t version;
+    uint32_t offset;
+    uint32_t nz;
+    uint32_t nr;
+    uint32_t nphi;
+    uint32_t ncomponents;
+  };
+
+  // maps already attached in this process, by file name
+  std::mutex openMapsMutex;
+  std::map<std::string, std::weak_ptr<const PHFieldBinaryMap>> openMaps;
+}  // namespace
+
+PHFieldBinaryMap::~PHFieldBinaryMap()
+{
+  if (m_mapped)
+  {
+    munmap(m_mapped, m_mapped_size);
+  }
+}
+
+bool PHFieldBinaryMap::IsBinaryMap(const std::string &filename)
+{
+  std::ifstream in(filename, std::ios::binary);
+  char magic[sizeof(fileMagic)];
+  if (!in.read(magic, sizeof(magic)))
+  {
+    return false;
+  }
+  return std::memcmp(magic, fileMagic, sizeof(fileMagic)) == 0;
+}
+
+std::shared_ptr<const PHFieldBinaryMap> PHFieldBinaryMap::Open(const std::string &filename, const int verbosity)
+{
+  std::lock_guard<std::mutex> lock(openMapsMutex);
+  if (auto existing = openMaps[filename].lock())
+  {
+    if (verbosity > 0)
+    {
+      std::cout << "PHFieldBinaryMap::Open - reusing mapping of " << filename << std::endl;
+    }
+    return existing;
+  }
+
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    std::cout << "PHFieldBinaryMap::Open - could not open " << filename << std::endl;
+    return nullptr;
+  }
+
+  struct stat st{};
+  if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < dataOffset)
+  {
+    std::cout << "PHFieldBinaryMap::Open - " << filename << " is too short for a binary field map" << std::endl;
+    close(fd);
+    return nullptr;
+  }
+  const size_t filesize = st.st_size;
+
+  void *ptr = mmap(nullptr, filesize, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);  // the mapping stays valid
+  if (ptr == MAP_FAILED)
+  {
+    std::cout << "PHFieldBinaryMap::Open - mmap of " << filename << " failed" << std::endl;
+    return nullptr;
+  }
+
+  FileHeader header{};
+  std::memcpy(&header, ptr, sizeof(header));
+  const bool is_2d = header.nphi == 0;
+  const size_t npoints = static_cast<size_t>(header.nz) * header.nr * (is_2d ? 1 : header.nphi);
+  const size_t expected = dataOffset + (header.nz + header.nr + header.nphi + header.ncomponents * npoints) * sizeof(float);
+  if (std::memcmp(header.magic, fileMagic, sizeof(fileMagic)) != 0 ||
+      header.version != fileVersion || header.offset != dataOffset ||
+      header.nz < 2 || header.nr < 2 ||
+      header.ncomponents != (is_2d ? 2U : 3U) ||
+      filesize != expected)
+  {
+    std::cout << "PHFieldBinaryMap::Open - " << filename << " is not a valid binary field map" << std::endl;
+    munmap(ptr, filesize);
+    return nullptr;
+  }
+
+  // we interpolate all over the map, have the kernel read it in one go
+  madvise(ptr, filesize, MADV_WILLNEED);
+
+  std::shared_ptr<PHFieldBinaryMap> fieldmap(new PHFieldBinaryMap);
+  fieldmap->m_mapped = ptr;
+  fieldmap->m_mapped_size = filesize;
+  fieldmap->m_nz = header.nz;
+  fieldmap->m_nr = header.nr;
+  fieldmap->m_nphi = header.nphi;
+
+  const float *data = reinterpret_cast<const float *>(static_cast<const char *>(ptr) + dataOffset);
+  fieldmap->m_z = data;
+  fieldmap->m_r = fieldmap->m_z + header.nz;
+  fieldmap->m_phi = fieldmap->m_r + header.nr;
+  fieldmap->m_bz = fieldmap->m_phi + header.nphi;
+  fieldmap->m_br = fieldmap->m_bz + npoints;
+  if (!is_2d)
+  {
+    fieldmap->m_bphi = fieldmap->m_br + npoints;
+  }
+
+  if (verbosity > 0)
+  {
+    std::cout << "PHFieldBinaryMap::Open - mapped " << filename
+              << " (nz, nr, nphi) = (" << header.nz << ", " << header.nr << ", " << header.nphi << ")" << std::endl;
+  }
+
+  openMaps[filename] = fieldmap;
+  return fieldmap;
+}
+
+bool PHFieldBinaryMap::Write(const std::string &filename,
+                             const std::vector<float> &z, const std::vector<float> &r, const std::vector<float> &phi,
+                             const float *bz, const float *br, const float *bphi)
+{
+  const bool is_2d = phi.empty();
+  if (z.size() < 2 || r.size() < 2 || !bz || !br || (is_2d != (bphi == nullptr)))
+  {
+    std::cout << "PHFieldBinaryMap::Write - inconsistent field map, not writing " << filename << std::endl;
+    return false;
+  }
+
+  const std::string tmpname = filename + ".tmp" + std::to_string(getpid());
+  std::ofstream out(tmpname, std::ios::binary | std::ios::trunc);
+  if (!out)
+  {
+    std::cout << "PHFieldBinaryMap::Write - could not open " << tmpname << std::endl;
+    return false;
+  }
+
+  FileHeader header{};
+  std::memcpy(header.magic, fileMagic, sizeof(fileMagic));
+  header.version = fileVersion;
+  header.offset = dataOffset;
+  header.nz = z.size();
+  header.nr = r.size();
+  header.nphi = phi.size();
+  header.ncomponents = is_2d ? 2 : 3;
+
+  std::vector<char> block(dataOffset, 0);
+  std::memcpy(block.data(), &header, sizeof(header));
+  out.write(block.data(), block.size());
+
+  for (const std::vector<float> *axis : {&z, &r, &phi})
+  {
+    out.write(reinterpret_cast<const char *>(axis->data()), axis->size() * sizeof(float));
+  }
+
+  const size_t npoints = z.size() * r.size() * (is_2d ? 1 : phi.size());
+  for (const float *component : {bz, br, bphi})
+  {
+    if (component)
+    {
+      out.write(reinterpret_cast<const char *>(component), npoints * sizeof(float));
+    }
+  }
+
+  out.close();
+  if (!out || std::rename(tmpname.c_str(), filename.c_str()) != 0)
+  {
+    std::cout << "PHFieldBinaryMap::Write - error writing " << filename << std::endl;
+    std::remove(tmpname.c_str());
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,72 @@
+#ifndef PHFIELD_PHFIELDBINARYMAP_H
+#define PHFIELD_PHFIELDBINARYMAP_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Binary field map on a regular cylindrical grid, used by PHField2D and PHField3DCylindrical.
+//
+// The file holds a page sized header, then the z, r and phi axis values and the Bz, Br (and Bphi)
+// components as flat float arrays, indexed ( iz * nr + ir ) * nphi + iphi, in Geant4 units and
+// without rescaling. 2D maps have no phi axis (nphi = 0) and no Bphi component.
+// Files are attached read-only with mmap, so there is nothing to parse and all jobs on a node
+// share one copy of the map through the page cache. Opening the same file again in a process
+// returns the existing mapping.
+// Binary maps are written once from the ROOT maps with PHField2D::WriteBinaryMap or
+// PHField3DCylindrical::WriteBinaryMap (see PHFieldUtility::ConvertToBinaryFieldMap).
+class PHFieldBinaryMap
+{
+ public:
+  ~PHFieldBinaryMap();
+  //! delete copy ctor and assignment operator
+  PHFieldBinaryMap(const PHFieldBinaryMap &) = delete;
+  PHFieldBinaryMap &operator=(const PHFieldBinaryMap &) = delete;
+
+  //! true if the file starts with the binary field map header
+  static bool IsBinaryMap(const std::string &filename);
+
+  //! attach a file written by Write, read-only. Returns nullptr on failure
+  static std::shared_ptr<const PHFieldBinaryMap> Open(const std::string &filename, const int verbosity = 0);
+
+  //! write a binary field map. Pass an empty phi axis and no bphi for 2D maps.
+  //! The file is written under a temporary name and renamed, so concurrent jobs never see a partial file
+  static bool Write(const std::string &filename,
+                    const std::vector<float> &z, const std::vector<float> &r, const std::vector<float> &phi,
+                    const float *bz, const float *br, const float *bphi = nullptr);
+
+  unsigned int nz() const { return m_nz; }
+  unsigned int nr() const { return m_nr; }
+  unsigned int nphi() const { return m_nphi; }
+  //! number of grid points per component
+  size_t size() const { return static_cast<size_t>(m_nz) * m_nr * (m_nphi ? m_nphi : 1); }
+
+  const float *z_map() const { return m_z; }
+  const float *r_map() const { return m_r; }
+  const float *phi_map() const { return m_phi; }
+
+  const float *Bz() const { return m_bz; }
+  const float *Br() const { return m_br; }
+  //! nullptr for 2D maps
+  const float *Bphi() const { return m_bphi; }
+
+ private:
+  PHFieldBinaryMap() = default;
+
+  void *m_mapped{nullptr};
+  size_t m_mapped_size{0};
+
+  unsigned int m_nz{0};
+  unsigned int m_nr{0};
+  unsigned int m_nphi{0};
+
+  const float *m_z{nullptr};
+  const float *m_r{nullptr};
+  const float *m_phi{nullptr};
+  const float *m_bz{nullptr};
+  const float *m_br{nullptr};
+  const float *m_bphi{nullptr};
+};
+
+#endif
@@ -99,6 +99,28 @@ PHFieldUtility::BuildFieldMap(const PHFieldConfig *field_config, float inner_rad
   return field;
 }
 
+bool PHFieldUtility::ConvertToBinaryFieldMap(const PHFieldConfig *field_config, const std::string &binary_filename, const int verbosity)
+{
+  assert(field_config);
+
+  switch (field_config->get_field_config())
+  {
+  case PHFieldConfig::kField2D:
+  {
+    PHField2D field(field_config->get_filename(), verbosity, 1.);
+    return field.WriteBinaryMap(binary_filename);
+  }
+  case PHFieldConfig::kField3DCylindrical:
+  {
+    PHField3DCylindrical field(field_config->get_filename(), verbosity, 1.);
+    return field.WriteBinaryMap(binary_filename);
+  }
+  default:
+    std::cout << "PHFieldUtility::ConvertToBinaryFieldMap - no binary format for field configuration: " << field_config->get_field_config() << std::endl;
+    return false;
+  }
+}
+
 //! Make a default PHFieldConfig
 //! Field map = /phenix/upgrades/decadal/fieldmaps/sPHENIX.2d.root
 //! Field Scale to 1.4/1.5
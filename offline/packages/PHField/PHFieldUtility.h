@@ -33,6 +33,12 @@ class PHFieldUtility
   static PHField *
   BuildFieldMap(const PHFieldConfig *field_config, float inner_radius = 0., float outer_radius = 1.e10, float size_z = 1.e10, const int verbosity = 0);
 
+  //! Convert the ROOT field map of a kField2D or kField3DCylindrical configuration to a binary field map
+  //! (see PHFieldBinaryMap), which can then be used as file name of the same configuration.
+  //! The map is written without the rescaling of the configuration, which is applied when reading it.
+  static bool
+  ConvertToBinaryFieldMap(const PHFieldConfig *field_config, const std::string &binary_filename, const int verbosity = 0);
+
   //! DST node name for RunTime field map object
   static std::string
   GetDSTFieldMapNodeName()
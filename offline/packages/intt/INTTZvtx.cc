@@ -12,6 +12,7 @@
 #include <TTree.h>
 
 #include <algorithm>
+#include <cmath>
 #include <filesystem>
 #include <format>
 #include <iostream>
@@ -141,6 +142,32 @@ void INTTZvtx::Characterize_Pad(TPad* pad, float left, float right, float top, f
 
 void INTTZvtx::Init()
 {
+  if (m_production_mode)
+  {
+    if (draw_event_display || m_enable_qa)
+    {
+      std::cout << "class INTTZvtx, production mode, event display and QA are disabled" << std::endl;
+    }
+    draw_event_display = false;
+    m_enable_qa = false;
+
+    // note : same binning as evt_possible_z and line_breakdown_hist
+    m_possible_z_bins.init(evt_possible_z_nbins, evt_possible_z_range.first, evt_possible_z_range.second);
+    m_line_breakdown_bins.init(2 * line_breakdown_N + 1,
+                               -1 * (line_breakdown_width * line_breakdown_N + line_breakdown_width / 2.),
+                               line_breakdown_width * line_breakdown_N + line_breakdown_width / 2.);
+
+    // note : the Gaussian fits and the QA decision are the ones of the default path, so that
+    // zvtx, its error, the width and the good flag are the same in both modes.
+    // line_breakdown_hist is only a detached copy of m_line_breakdown_bins for the fits
+    line_breakdown_hist = new TH1F("line_breakdown_hist", "line_breakdown_hist", m_line_breakdown_bins.nbins, m_line_breakdown_bins.xmin, m_line_breakdown_bins.xmax);
+    line_breakdown_hist->SetDirectory(nullptr);
+    gaus_fit = new TF1("gaus_fit", InttVertexUtil::gaus_func, evt_possible_z_range.first, evt_possible_z_range.second, 4);
+
+    m_initialized = true;
+    return;
+  }
+
   if (!std::filesystem::exists(out_folder_directory))
   {
     std::filesystem::create_directory(out_folder_directory);
@@ -162,13 +189,13 @@ void INTTZvtx::Init()
 void INTTZvtx::InitHist()
 {
   // histos for z-vertex calculation
-  evt_possible_z = new TH1F("evt_possible_z", "evt_possible_z", 50, evt_possible_z_range.first, evt_possible_z_range.second);
+  evt_possible_z = new TH1F("evt_possible_z", "evt_possible_z", evt_possible_z_nbins, evt_possible_z_range.first, evt_possible_z_range.second);
   evt_possible_z->SetLineWidth(1);
   evt_possible_z->GetXaxis()->SetTitle("Z [mm]");
   evt_possible_z->GetYaxis()->SetTitle("Entry");
 
-  int N = 1200;        // note : N bins for each side, regardless the bin at zero
-  double width = 0.5;  // note : bin width with the unit [mm]
+  int N = line_breakdown_N;              // note : N bins for each side, regardless the bin at zero
+  double width = line_breakdown_width;  // note : bin width with the unit [mm]
   line_breakdown_hist = new TH1F("line_breakdown_hist", "line_breakdown_hist", 2 * N + 1, -1 * (width * N + width / 2.), width * N + width / 2.);
   line_breakdown_hist->SetLineWidth(1);
   line_breakdown_hist->GetXaxis()->SetTitle("Z [mm]");
@@ -620,6 +647,11 @@ bool INTTZvtx::ProcessEvt(
     return false;
   }
 
+  if (m_production_mode)
+  {
+    return ProcessEvtProduction(event_i, temp_sPH_inner_nocolumn_vec, temp_sPH_outer_nocolumn_vec, total_NClus);
+  }
+
   //--std::cout<<"--1--"<<std::endl;
   //-----------------
   // cluster pair
@@ -831,53 +863,13 @@ bool INTTZvtx::ProcessEvt(
     N_group_info = find_Ngroup(evt_possible_z);
     N_group_info_detail = find_Ngroup(line_breakdown_hist);
 
-    // note : first fit is for the width, so apply the constraints on the Gaussian offset
-    gaus_fit->SetParameters(line_breakdown_hist->GetBinContent(line_breakdown_hist->GetMaximumBin()),
-                            line_breakdown_hist->GetBinCenter(line_breakdown_hist->GetMaximumBin()),
-                            40,
-                            0);
-    gaus_fit->SetParLimits(0, 0, 100000);  // note : size
-    gaus_fit->SetParLimits(2, 5, 10000);   // note : Width
-    gaus_fit->SetParLimits(3, 0, 10000);   // note : offset
-    // todo : try to use single gaus to fit the distribution, and try to only fit the peak region (peak - 100 mm + peak + 100 mm)
-    line_breakdown_hist->Fit(gaus_fit, "NQ", "",
-                             line_breakdown_hist->GetBinCenter(line_breakdown_hist->GetMaximumBin()) - 90,
-                             line_breakdown_hist->GetBinCenter(line_breakdown_hist->GetMaximumBin()) + 90);
-    //----------------
-    // 1st try z-vertex
-    tight_offset_peak = gaus_fit->GetParameter(1);
-    tight_offset_width = fabs(gaus_fit->GetParameter(2));
+    double gaus_fit_offset = 0;
+    double gaus_ratio = 0;
+    fit_line_breakdown(gaus_fit_offset, gaus_ratio);
 
     double final_selection_widthU = (tight_offset_peak + tight_offset_width);
     double final_selection_widthD = (tight_offset_peak - tight_offset_width);
 
-    double gaus_fit_offset = gaus_fit->GetParameter(3);
-    gaus_fit->SetParameter(3, 0);  // note : in order to calculate the integration
-    double gaus_ratio = (fabs(gaus_fit->GetParameter(0)) / gaus_fit->Integral(-600, 600)) / fabs(gaus_fit->GetParameter(2));
-    gaus_fit->SetParameter(3, gaus_fit_offset);  // note : put the offset back to the function
-
-    // note : second fit is for the peak position, therefore, loose the constraints on the Gaussian offset
-    gaus_fit->SetParameters(line_breakdown_hist->GetBinContent(line_breakdown_hist->GetMaximumBin()),
-                            line_breakdown_hist->GetBinCenter(line_breakdown_hist->GetMaximumBin()),
-                            40,
-                            0);
-
-    gaus_fit->SetParLimits(0, 0, 100000);    // note : size
-    gaus_fit->SetParLimits(2, 5, 10000);     // note : Width
-    gaus_fit->SetParLimits(3, -200, 10000);  // note : offset
-    // todo : try to use single gaus to fit the distribution, and try to only fit the peak region (peak - 100 mm + peak + 100 mm)
-    line_breakdown_hist->Fit(gaus_fit, "NQ", "",
-                             line_breakdown_hist->GetBinCenter(line_breakdown_hist->GetMaximumBin()) - 90,
-                             line_breakdown_hist->GetBinCenter(line_breakdown_hist->GetMaximumBin()) + 90);
-
-    // line_breakdown_hist -> Fit(gaus_fit, "NQ", "", N_group_info_detail[2]-10, N_group_info_detail[3]+10);
-
-    //--std::cout<<"--5--"<<std::endl;
-    //----------------
-    // final z-vertex
-    loose_offset_peak = gaus_fit->GetParameter(1);
-    loose_offset_peakE = gaus_fit->GetParError(1);
-
     // additional QA below
     // note : eff sigma method, relatively sensitive to the background
     // note : use z-mid to do the effi_sig, because that line_breakdown takes too long time
@@ -1245,6 +1237,200 @@ bool INTTZvtx::ProcessEvt(
   return true;
 }
 
+void INTTZvtx::fit_line_breakdown(double& gaus_fit_offset, double& gaus_ratio)
+{
+  // note : first fit is for the width, so apply the constraints on the Gaussian offset
+  gaus_fit->SetParameters(line_breakdown_hist->GetBinContent(line_breakdown_hist->GetMaximumBin()),
+                          line_breakdown_hist->GetBinCenter(line_breakdown_hist->GetMaximumBin()),
+                          40,
+                          0);
+  gaus_fit->SetParLimits(0, 0, 100000);  // note : size
+  gaus_fit->SetParLimits(2, 5, 10000);   // note : Width
+  gaus_fit->SetParLimits(3, 0, 10000);   // note : offset
+  // todo : try to use single gaus to fit the distribution, and try to only fit the peak region (peak - 100 mm + peak + 100 mm)
+  line_breakdown_hist->Fit(gaus_fit, "NQ", "",
+                           line_breakdown_hist->GetBinCenter(line_breakdown_hist->GetMaximumBin()) - 90,
+                           line_breakdown_hist->GetBinCenter(line_breakdown_hist->GetMaximumBin()) + 90);
+  //----------------
+  // 1st try z-vertex
+  tight_offset_peak = gaus_fit->GetParameter(1);
+  tight_offset_width = fabs(gaus_fit->GetParameter(2));
+
+  gaus_fit_offset = gaus_fit->GetParameter(3);
+  gaus_fit->SetParameter(3, 0);  // note : in order to calculate the integration
+  gaus_ratio = (fabs(gaus_fit->GetParameter(0)) / gaus_fit->Integral(-600, 600)) / fabs(gaus_fit->GetParameter(2));
+  gaus_fit->SetParameter(3, gaus_fit_offset);  // note : put the offset back to the function
+
+  // note : second fit is for the peak position, therefore, loose the constraints on the Gaussian offset
+  gaus_fit->SetParameters(line_breakdown_hist->GetBinContent(line_breakdown_hist->GetMaximumBin()),
+                          line_breakdown_hist->GetBinCenter(line_breakdown_hist->GetMaximumBin()),
+                          40,
+                          0);
+
+  gaus_fit->SetParLimits(0, 0, 100000);    // note : size
+  gaus_fit->SetParLimits(2, 5, 10000);     // note : Width
+  gaus_fit->SetParLimits(3, -200, 10000);  // note : offset
+  // todo : try to use single gaus to fit the distribution, and try to only fit the peak region (peak - 100 mm + peak + 100 mm)
+  line_breakdown_hist->Fit(gaus_fit, "NQ", "",
+                           line_breakdown_hist->GetBinCenter(line_breakdown_hist->GetMaximumBin()) - 90,
+                           line_breakdown_hist->GetBinCenter(line_breakdown_hist->GetMaximumBin()) + 90);
+
+  // line_breakdown_hist -> Fit(gaus_fit, "NQ", "", N_group_info_detail[2]-10, N_group_info_detail[3]+10);
+
+  //----------------
+  // final z-vertex
+  loose_offset_peak = gaus_fit->GetParameter(1);
+  loose_offset_peakE = gaus_fit->GetParError(1);
+}
+
+void INTTZvtx::fill_clu_pos(const std::vector<clu_info>& clu_vec, std::vector<clu_pos>& pos_vec)
+{
+  pos_vec.clear();
+  for (const auto& clu : clu_vec)
+  {
+    // note : same phi definition as the phi map in ProcessEvt
+    double phi = (clu.y - beam_origin.second < 0)
+                     ? atan2(clu.y - beam_origin.second, clu.x - beam_origin.first) * (180. / M_PI) + 360
+                     : atan2(clu.y - beam_origin.second, clu.x - beam_origin.first) * (180. / M_PI);
+
+    pos_vec.push_back({phi, clu.x, clu.y, clu.z, get_radius(clu.x - beam_origin.first, clu.y - beam_origin.second)});
+
+    if (clu.z > 0)
+    {
+      out_N_cluster_north += 1;
+    }
+    else
+    {
+      out_N_cluster_south += 1;
+    }
+  }
+}
+
+bool INTTZvtx::ProcessEvtProduction(
+    int event_i,
+    const std::vector<clu_info>& temp_sPH_inner_nocolumn_vec,
+    const std::vector<clu_info>& temp_sPH_outer_nocolumn_vec,
+    long total_NClus)
+{
+  fill_clu_pos(temp_sPH_inner_nocolumn_vec, m_inner_pos);
+  fill_clu_pos(temp_sPH_outer_nocolumn_vec, m_outer_pos);
+  std::sort(m_outer_pos.begin(), m_outer_pos.end(), [](const clu_pos& a, const clu_pos& b)
+            { return a.phi < b.phi; });
+
+  // note : ProcessEvt only pairs clusters of neighbouring 1 degree phi cells,
+  // so no pair more than 2 degrees apart can pass the phi cut
+  const double phi_window = std::min(phi_diff_cut, 2.);
+
+  unsigned int ntracklets = 0;
+  auto pair_clusters = [&](const clu_pos& inner_pos, double phi_low, double phi_high)
+  {
+    auto outer_itr = std::lower_bound(m_outer_pos.begin(), m_outer_pos.end(), phi_low, [](const clu_pos& pos, double phi)
+                                      { return pos.phi < phi; });
+    for (; outer_itr != m_outer_pos.end() && outer_itr->phi <= phi_high; ++outer_itr)
+    {
+      const clu_pos& outer_pos = *outer_itr;
+
+      // note : the outer phi cell has to be the inner one -1, 0 or +1, as in ProcessEvt
+      int cell_diff = std::abs(int(inner_pos.phi) - int(outer_pos.phi));
+      if (cell_diff > 1 && cell_diff != 359)
+      {
+        continue;
+      }
+
+      double delta_phi = get_delta_phi(inner_pos.phi, outer_pos.phi);
+      if (!(fabs(delta_phi) < phi_diff_cut))
+      {
+        continue;
+      }
+
+      double DCA_sign = calculateAngleBetweenVectors(
+          outer_pos.x, outer_pos.y,
+          inner_pos.x, inner_pos.y,
+          beam_origin.first, beam_origin.second);
+      if (!(DCA_cut.first < DCA_sign && DCA_sign < DCA_cut.second))
+      {
+        continue;
+      }
+
+      std::pair<double, double> z_range_info = Get_possible_zvtx(0., inner_pos.r, inner_pos.z, outer_pos.r, outer_pos.z);
+      if (evt_possible_z_range.first < z_range_info.first && z_range_info.first < evt_possible_z_range.second)
+      {
+        m_possible_z_bins.content[m_possible_z_bins.find(z_range_info.first)] += 1;
+        line_breakdown(m_line_breakdown_bins,
+                       {z_range_info.first - z_range_info.second,
+                        z_range_info.first + z_range_info.second});
+        ntracklets++;
+      }
+    }
+  };
+
+  // note : phi window around each inner cluster, wrapped at 0 / 360 degree
+  for (const auto& inner_pos : m_inner_pos)
+  {
+    pair_clusters(inner_pos, inner_pos.phi - phi_window, inner_pos.phi + phi_window);
+    if (inner_pos.phi - phi_window < 0)
+    {
+      pair_clusters(inner_pos, inner_pos.phi - phi_window + 360, 360);
+    }
+    if (inner_pos.phi + phi_window >= 360)
+    {
+      pair_clusters(inner_pos, 0, inner_pos.phi + phi_window - 360);
+    }
+  }
+
+  if (ntracklets > zvtx_cal_require)
+  {
+    N_group_info = find_Ngroup(m_possible_z_bins);
+    N_group_info_detail = find_Ngroup(m_line_breakdown_bins);
+
+    // note : the fits run on the same bin contents as in the default path
+    const FixedBins& lb = m_line_breakdown_bins;
+    for (int bin = 0; bin < lb.nbins + 2; bin++)
+    {
+      if (lb.content[bin] != 0)
+      {
+        line_breakdown_hist->SetBinContent(bin, lb.content[bin]);
+      }
+    }
+
+    double gaus_fit_offset = 0;
+    double gaus_ratio = 0;
+    fit_line_breakdown(gaus_fit_offset, gaus_ratio);
+
+    good_zvtx_tag = zvtx_QA_width.first < tight_offset_width &&
+                    tight_offset_width < zvtx_QA_width.second &&
+                    100 < fabs(N_group_info_detail[3] - N_group_info_detail[2]) &&
+                    fabs(N_group_info_detail[3] - N_group_info_detail[2]) < 190 &&
+                    N_group_info[0] < 4 &&
+                    N_group_info[1] >= 0.6 &&
+                    N_group_info_detail[0] < 7 &&
+                    N_group_info_detail[1] > 0.9;
+    good_zvtx_tag_int = (good_zvtx_tag == true) ? 1 : 0;
+    final_zvtx = loose_offset_peak;
+
+    m_zvtxinfo.zvtx = loose_offset_peak;
+    m_zvtxinfo.zvtx_err = loose_offset_peakE;
+    m_zvtxinfo.width = gaus_fit->GetParameter(2);
+    m_zvtxinfo.chi2ndf = gaus_fit->GetChisquare() / double(gaus_fit->GetNDF());
+    m_zvtxinfo.good = good_zvtx_tag;
+    m_zvtxinfo.ngroup = N_group_info_detail[0];
+    m_zvtxinfo.peakratio = N_group_info_detail[1];
+    m_zvtxinfo.peakwidth = fabs(N_group_info_detail[3] - N_group_info_detail[2]) / 2.;
+  }
+
+  m_zvtxinfo.nclus = total_NClus;
+  m_zvtxinfo.ntracklets = ntracklets;
+
+  if (print_message_opt == true)
+  {
+    std::cout << "evt : " << event_i << ", good pair count : " << ntracklets
+              << ", zvtx : " << m_zvtxinfo.zvtx << " +- " << m_zvtxinfo.zvtx_err
+              << ", width : " << m_zvtxinfo.width << ", good : " << m_zvtxinfo.good << std::endl;
+  }
+
+  return true;
+}
+
 void INTTZvtx::ClearEvt()
 {
   if (!m_initialized)
@@ -1280,6 +1466,14 @@ void INTTZvtx::ClearEvt()
   N_group_info.clear();
   N_group_info_detail = {-1., -1., -1., -1.};
 
+  if (m_production_mode)
+  {
+    m_possible_z_bins.reset();
+    m_line_breakdown_bins.reset();
+    line_breakdown_hist->Reset("ICESM");
+    return;
+  }
+
   evt_possible_z->Reset("ICESM");
   line_breakdown_hist->Reset("ICESM");
 
@@ -1668,11 +1862,16 @@ double INTTZvtx::Get_extrapolation(double given_y, double p0x, double p0y, doubl
 
 std::pair<double, double> INTTZvtx::Get_possible_zvtx(double rvtx, std::vector<double> p0, std::vector<double> p1)  // note : inner p0, outer p1, vector {r,z}, -> {y,x}
 {
-  std::vector<double> p0_z_edge = {(fabs(p0[1]) < 130) ? p0[1] - 8. : p0[1] - 10., (fabs(p0[1]) < 130) ? p0[1] + 8. : p0[1] + 10.};  // note : vector {left edge, right edge}
-  std::vector<double> p1_z_edge = {(fabs(p1[1]) < 130) ? p1[1] - 8. : p1[1] - 10., (fabs(p1[1]) < 130) ? p1[1] + 8. : p1[1] + 10.};  // note : vector {left edge, right edge}
+  return Get_possible_zvtx(rvtx, p0[0], p0[1], p1[0], p1[1]);
+}
 
-  double edge_first = Get_extrapolation(rvtx, p0_z_edge[0], p0[0], p1_z_edge[1], p1[0]);
-  double edge_second = Get_extrapolation(rvtx, p0_z_edge[1], p0[0], p1_z_edge[0], p1[0]);
+std::pair<double, double> INTTZvtx::Get_possible_zvtx(double rvtx, double p0r, double p0z, double p1r, double p1z)  // note : inner p0, outer p1
+{
+  std::pair<double, double> p0_z_edge = {(fabs(p0z) < 130) ? p0z - 8. : p0z - 10., (fabs(p0z) < 130) ? p0z + 8. : p0z + 10.};  // note : {left edge, right edge}
+  std::pair<double, double> p1_z_edge = {(fabs(p1z) < 130) ? p1z - 8. : p1z - 10., (fabs(p1z) < 130) ? p1z + 8. : p1z + 10.};  // note : {left edge, right edge}
+
+  double edge_first = Get_extrapolation(rvtx, p0_z_edge.first, p0r, p1_z_edge.second, p1r);
+  double edge_second = Get_extrapolation(rvtx, p0_z_edge.second, p0r, p1_z_edge.first, p1r);
 
   double mid_point = (edge_first + edge_second) / 2.;
   double possible_width = fabs(edge_first - edge_second) / 2.;
@@ -1712,6 +1911,21 @@ void INTTZvtx::line_breakdown(TH1* hist_in, std::pair<double, double> line_range
   }
 }
 
+void INTTZvtx::line_breakdown(FixedBins& bins, std::pair<double, double> line_range)
+{
+  // note : same digitization as line_breakdown(TH1*), the under- and overflow bins are filled as well
+  int first_bin = int((line_range.first - bins.xmin) / bins.width()) + 1;
+  int last_bin = int((line_range.second - bins.xmin) / bins.width()) + 1;
+
+  first_bin = (first_bin < 1) ? 0 : std::min(first_bin, bins.nbins + 1);
+  last_bin = (last_bin < 1) ? 0 : std::min(last_bin, bins.nbins + 1);
+
+  for (int i = first_bin; i <= last_bin; i++)
+  {
+    bins.content[i] += 1;
+  }
+}
+
 // note : search_range : should be the gaus fit range
 double INTTZvtx::LB_geo_mean(TH1* hist_in, std::pair<double, double> search_range, int /*event_i*/)
 {
@@ -1760,8 +1974,19 @@ double INTTZvtx::LB_geo_mean(TH1* hist_in, std::pair<double, double> search_rang
 // note : {N_group, ratio (if two), peak widthL, peak widthR}
 std::vector<double> INTTZvtx::find_Ngroup(TH1* hist_in)
 {
-  double Highest_bin_Content = hist_in->GetBinContent(hist_in->GetMaximumBin());
-  double Highest_bin_Center = hist_in->GetBinCenter(hist_in->GetMaximumBin());
+  FixedBins bins;
+  bins.init(hist_in->GetNbinsX(), hist_in->GetXaxis()->GetXmin(), hist_in->GetXaxis()->GetXmax());
+  for (int i = 0; i < bins.nbins + 2; i++)
+  {
+    bins.content[i] = hist_in->GetBinContent(i);
+  }
+  return find_Ngroup(bins);
+}
+
+std::vector<double> INTTZvtx::find_Ngroup(const FixedBins& bins)
+{
+  double Highest_bin_Content = bins.content[bins.maximum_bin()];
+  double Highest_bin_Center = bins.center(bins.maximum_bin());
 
   int group_Nbin = 0;
   int peak_group_ID = 0;  // =0 added by TH 20240418
@@ -1776,16 +2001,16 @@ std::vector<double> INTTZvtx::find_Ngroup(TH1* hist_in)
   std::vector<double> group_widthR_vec;
   group_widthR_vec.clear();
 
-  for (int i = 0; i < hist_in->GetNbinsX(); i++)
+  for (int i = 0; i < bins.nbins; i++)
   {
     // todo : the background rejection is here : Highest_bin_Content/2. for the time being
-    double bin_content = (hist_in->GetBinContent(i + 1) <= Highest_bin_Content / 2.) ? 0. : (hist_in->GetBinContent(i + 1) - Highest_bin_Content / 2.);
+    double bin_content = (bins.content[i + 1] <= Highest_bin_Content / 2.) ? 0. : (bins.content[i + 1] - Highest_bin_Content / 2.);
 
     if (bin_content != 0)
     {
       if (group_Nbin == 0)
       {
-        group_widthL_vec.push_back(hist_in->GetBinCenter(i + 1) - (hist_in->GetBinWidth(i + 1) / 2.));
+        group_widthL_vec.push_back(bins.center(i + 1) - (bins.width() / 2.));
       }
 
       group_Nbin += 1;
@@ -1793,7 +2018,7 @@ std::vector<double> INTTZvtx::find_Ngroup(TH1* hist_in)
     }
     else if (bin_content == 0 && group_Nbin != 0)
     {
-      group_widthR_vec.push_back(hist_in->GetBinCenter(i + 1) - (hist_in->GetBinWidth(i + 1) / 2.));
+      group_widthR_vec.push_back(bins.center(i + 1) - (bins.width() / 2.));
       group_Nbin_vec.push_back(group_Nbin);
       group_entry_vec.push_back(group_entry);
       group_Nbin = 0;
@@ -1804,7 +2029,7 @@ std::vector<double> INTTZvtx::find_Ngroup(TH1* hist_in)
   {
     group_Nbin_vec.push_back(group_Nbin);
     group_entry_vec.push_back(group_entry);
-    group_widthR_vec.push_back(hist_in->GetXaxis()->GetXmax());
+    group_widthR_vec.push_back(bins.xmax);
   }  // note : the last group at the edge
 
   // note : find the peak group
@@ -3,6 +3,7 @@
 
 #include "InttVertexUtil.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -104,6 +105,11 @@ class INTTZvtx
   void EnableEventDisplay(const bool enableEvtDisp) { draw_event_display = enableEvtDisp; }
   void EnableQA(const bool enableQA) { m_enable_qa = enableQA; }
 
+  // production mode: z-vertex finding on plain arrays, without the QA histograms, canvases and trees.
+  // Only the Gaussian fits run on a detached histogram, so the results are the ones of the default path.
+  // The event display and QA output are not available in this mode
+  void SetProductionMode(const bool production) { m_production_mode = production; }
+
   double GetZdiffPeakMC();
   double GetZdiffWidthMC();
 
@@ -129,8 +135,12 @@ class INTTZvtx
   bool draw_event_display{false};
   bool m_enable_qa{false};
   bool print_message_opt;
+  bool m_production_mode{false};
 
   std::pair<double, double> evt_possible_z_range = {-700, 700};
+  int evt_possible_z_nbins = 50;
+  int line_breakdown_N = 1200;         // note : N bins for each side of line_breakdown_hist, regardless the bin at zero
+  double line_breakdown_width = 0.5;  // note : line_breakdown_hist bin width with the unit [mm]
 
   std::vector<std::string> conversion_mode_BD = {"ideal", "survey_1_XYAlpha_Peek", "full_survey_3.32"};
   double Integrate_portion_final = 0.68;  // cut in effSig, PrintPlots
@@ -145,6 +155,54 @@ class INTTZvtx
 
   ZvtxInfo m_zvtxinfo;
 
+  // note : fixed binning with the TH1 conventions, bin 0 is the underflow and bin nbins+1 the overflow
+  struct FixedBins
+  {
+    int nbins{0};
+    double xmin{0};
+    double xmax{0};
+    std::vector<double> content{};
+
+    void init(int n, double low, double high)
+    {
+      nbins = n;
+      xmin = low;
+      xmax = high;
+      content.assign(n + 2, 0);
+    }
+    void reset() { std::fill(content.begin(), content.end(), 0); }
+    double width() const { return (xmax - xmin) / double(nbins); }
+    double center(int bin) const { return xmin + (bin - 1) * width() + 0.5 * width(); }
+    int find(double x) const
+    {
+      if (x < xmin)
+      {
+        return 0;
+      }
+      if (!(x < xmax))
+      {
+        return nbins + 1;
+      }
+      return 1 + int(nbins * (x - xmin) / (xmax - xmin));
+    }
+    int maximum_bin() const { return int(std::max_element(content.begin() + 1, content.end() - 1) - content.begin()); }
+  };
+
+  // note : cluster position seen from the beam origin, for the production mode pair search
+  struct clu_pos
+  {
+    double phi{0};  // note : degree, [0, 360)
+    double x{0};
+    double y{0};
+    double z{0};
+    double r{0};
+  };
+
+  std::vector<clu_pos> m_inner_pos{};
+  std::vector<clu_pos> m_outer_pos{};  // note : sorted in phi
+  FixedBins m_possible_z_bins{};       // note : evt_possible_z in production mode
+  FixedBins m_line_breakdown_bins{};   // note : line_breakdown_hist in production mode
+
   TH1* evt_possible_z{nullptr};
   TH1* line_breakdown_hist{nullptr};  // note : try to fill the line into the histogram
   TF1* gaus_fit{nullptr};
@@ -280,11 +338,23 @@ class INTTZvtx
 
   // function for analysis
   std::pair<double, double> Get_possible_zvtx(double rvtx, std::vector<double> p0, std::vector<double> p1);
+  std::pair<double, double> Get_possible_zvtx(double rvtx, double p0r, double p0z, double p1r, double p1z);
   std::vector<double> find_Ngroup(TH1* hist_in);
+  std::vector<double> find_Ngroup(const FixedBins& bins);
   double get_radius(double x, double y);
   double calculateAngleBetweenVectors(double x1, double y1, double x2, double y2, double targetX, double targetY);
   double Get_extrapolation(double given_y, double p0x, double p0y, double p1x, double p1y);
   void line_breakdown(TH1* hist_in, std::pair<double, double> line_range);
+  void line_breakdown(FixedBins& bins, std::pair<double, double> line_range);
+
+  // production mode
+  bool ProcessEvtProduction(int event_i,
+                            const std::vector<clu_info>& temp_sPH_inner_nocolumn_vec,
+                            const std::vector<clu_info>& temp_sPH_outer_nocolumn_vec,
+                            long total_NClus);
+  void fill_clu_pos(const std::vector<clu_info>& clu_vec, std::vector<clu_pos>& pos_vec);
+  // the two Gaussian fits of line_breakdown_hist : tight (width) then loose (peak position)
+  void fit_line_breakdown(double& gaus_fit_offset, double& gaus_ratio);
 
   // tracklet reco
   double get_delta_phi(double angle_1, double angle_2);
@@ -29,16 +29,13 @@
 #include <phool/getClass.h>
 #include <phool/phool.h>
 
-#include <boost/graph/adjacency_list.hpp>
-#include <boost/graph/connected_components.hpp>
-
 #include <algorithm>
 #include <array>
 #include <cmath>
 #include <iostream>
 #include <limits>
+#include <map>
 #include <memory>  // for unique_ptr, make_...
-#include <set>
 #include <vector>  // for vector
 
 namespace
@@ -52,52 +49,6 @@ namespace
   }
 }  // namespace
 
-bool InttClusterizer::ladder_are_adjacent(const std::pair<TrkrDefs::hitkey, TrkrHit*>& lhs, const std::pair<TrkrDefs::hitkey, TrkrHit*>& rhs, const int layer) const
-{
-  if (get_z_clustering(layer))
-  {
-    if (std::abs(InttDefs::getCol(lhs.first) - InttDefs::getCol(rhs.first)) <= 1)
-    {
-      if (std::abs(InttDefs::getRow(lhs.first) - InttDefs::getRow(rhs.first)) <= 1)
-      {
-        return true;
-      }
-    }
-  }
-  else if (std::abs(InttDefs::getCol(lhs.first) - InttDefs::getCol(rhs.first)) == 0)
-  {
-    if (std::abs(InttDefs::getRow(lhs.first) - InttDefs::getRow(rhs.first)) <= 1)
-    {
-      return true;
-    }
-  }
-
-  return false;
-}
-
-bool InttClusterizer::ladder_are_adjacent(RawHit* lhs, RawHit* rhs, const int layer) const
-{
-  if (get_z_clustering(layer))
-  {
-    if (std::abs((int) (lhs->getPhiBin()) - (int) (rhs->getPhiBin())) <= 1)  // col
-    {
-      if (std::abs((int) (lhs->getTBin()) - (int) (rhs->getTBin())) <= 1)  // Row
-      {
-        return true;
-      }
-    }
-  }
-  else if (std::abs((int) (lhs->getPhiBin()) - (int)(rhs->getPhiBin())) <= 1)
-  {
-    if (std::abs((int) (lhs->getTBin()) - (int) (rhs->getTBin())) == 0)
-    {
-      return true;
-    }
-  }
-
-  return false;
-}
-
 InttClusterizer::InttClusterizer(const std::string& name,
                                  unsigned int /*min_layer*/,
                                  unsigned int /*max_layer*/)
@@ -401,45 +352,28 @@ void InttClusterizer::ClusterLadderCells(PHCompositeNode* topNode)
       std::cout << "hitvec.size(): " << hitvec.size() << std::endl;
     }
 
-    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS>;
-    Graph G;
-
-    // Find adjacent strips
-    for (unsigned int i = 0; i < hitvec.size(); i++)
+    // find adjacent strips
+    m_clusterer.clear();
+    if (get_z_clustering(layer))
     {
-      for (unsigned int j = i + 1; j < hitvec.size(); j++)
-      {
-        if (ladder_are_adjacent(hitvec[i], hitvec[j], layer))
-        {
-          add_edge(i, j, G);
-        }
-      }
-
-      add_edge(i, i, G);
+      m_clusterer.set_neighbourhood(1, 1);
     }
-
-    // Find the connections between the vertices of the graph (vertices are the rawhits,
-    // connections are made when they are adjacent to one another)
-    std::vector<int> component(num_vertices(G));
-
-    // this is the actual clustering, performed by boost
-    connected_components(G, component.data());
-
-    // Loop over the components(hit cells) compiling a list of the
-    // unique connected groups (ie. clusters).
-    std::set<int> cluster_ids;  // unique components
-
-    std::multimap<int, std::pair<TrkrDefs::hitkey, TrkrHit*>> clusters;
-    for (unsigned int i = 0; i < component.size(); i++)
+    else
     {
-      cluster_ids.insert(component[i]);                          // one entry per unique cluster id
-      clusters.insert(std::make_pair(component[i], hitvec[i]));  // multiple entries per unique cluster id
+      m_clusterer.set_neighbourhood(1, 0);
     }
+    for (const auto& hit : hitvec)
+    {
+      m_clusterer.add_hit(InttDefs::getRow(hit.first), InttDefs::getCol(hit.first));
+    }
+    m_clusterer.run();
 
-    // loop over the cluster ID's and make the clusters from the connected hits
-    for (int clusid : cluster_ids)
+    // loop over the clusters and make them from the connected hits
+    const auto& clusters = m_clusterer.clusters();
+    const auto& hit_order = m_clusterer.hit_order();
+    for (unsigned int clusid = 0; clusid < clusters.size(); ++clusid)
     {
-      // std::cout << " intt clustering: add cluster number " << clusid << std::endl;
+      const auto& cluster = clusters[clusid];
 
       // make the cluster directly in the node tree
       TrkrDefs::cluskey ckey = TrkrDefs::genClusKey(hitset->getHitSetKey(), clusid);
@@ -456,8 +390,8 @@ void InttClusterizer::ClusterLadderCells(PHCompositeNode* topNode)
       m_clustercrossingassoc->addAssoc(ckey, crossing);
 
       // determine the size of the cluster in phi and z, useful for track fitting the cluster
-      std::set<int> phibins;
-      std::set<int> zbins;
+      const unsigned int nphibins = cluster.nrows();
+      const unsigned int nzbins = cluster.ncols();
 
       // determine the cluster position...
       double xlocalsum = 0.0;
@@ -469,18 +403,12 @@ void InttClusterizer::ClusterLadderCells(PHCompositeNode* topNode)
       // std::cout << PHWHERE << " ckey " << ckey << ":" << std::endl;
 
       // get all hits for this cluster ID only
-      const auto clusrange = clusters.equal_range(clusid);
-      for (auto mapiter = clusrange.first; mapiter != clusrange.second; ++mapiter)
+      for (unsigned int ihit = cluster.first; ihit < cluster.first + cluster.nhits; ++ihit)
       {
-        // mapiter->second.first  is the hit key
-        // std::cout << " adding hitkey " << mapiter->second.first << std::endl;
-        int col = InttDefs::getCol((mapiter->second).first);
-        int row = InttDefs::getRow((mapiter->second).first);
-        zbins.insert(col);
-        phibins.insert(row);
-
-        // mapiter->second.second is the hit
-        unsigned int hit_adc = (mapiter->second).second->getAdc();
+        const auto& hit = hitvec[hit_order[ihit]];
+        int col = InttDefs::getCol(hit.first);
+        int row = InttDefs::getRow(hit.first);
+        unsigned int hit_adc = hit.second->getAdc();
 
         // now get the positions from the geometry
         double local_hit_location[3] = {0., 0., 0.};
@@ -507,7 +435,7 @@ void InttClusterizer::ClusterLadderCells(PHCompositeNode* topNode)
         ++nhits;
 
         // add this cluster-hit association to the association map of (clusterkey,hitkey)
-        m_clusterhitassoc->addAssoc(ckey, mapiter->second.first);
+        m_clusterhitassoc->addAssoc(ckey, hit.first);
 
         if (Verbosity() > 2)
         {
@@ -532,20 +460,20 @@ void InttClusterizer::ClusterLadderCells(PHCompositeNode* topNode)
       float phierror = pitch * invsqrt12;
 
       static constexpr std::array<double, 3> scalefactors_phi = {{0.85, 0.4, 0.33}};
-      if (phibins.size() == 1 && layer < 5)
+      if (nphibins == 1 && layer < 5)
       {
         phierror *= scalefactors_phi[0];
       }
-      else if (phibins.size() == 2 && layer < 5)
+      else if (nphibins == 2 && layer < 5)
       {
         phierror *= scalefactors_phi[1];
       }
-      else if (phibins.size() == 2 && layer > 4)
+      else if (nphibins == 2 && layer > 4)
       {
         phierror *= scalefactors_phi[2];
       }
       // z error.
-      const float zerror = zbins.size() * length * invsqrt12;
+      const float zerror = nzbins * length * invsqrt12;
 
       double cluslocaly = std::numeric_limits<double>::quiet_NaN();
       double cluslocalz = std::numeric_limits<double>::quiet_NaN();
@@ -568,8 +496,8 @@ void InttClusterizer::ClusterLadderCells(PHCompositeNode* topNode)
       clus->setLocalY(cluslocalz);
       clus->setPhiError(phierror);
       clus->setZError(zerror);
-      clus->setPhiSize(phibins.size());
-      clus->setZSize(zbins.size());
+      clus->setPhiSize(nphibins);
+      clus->setZSize(nzbins);
       // All silicon surfaces have a 1-1 map to hitsetkey.
       // So set subsurface key to 0
       clus->setSubSurfKey(0);
@@ -670,45 +598,31 @@ void InttClusterizer::ClusterLadderCellsRaw(PHCompositeNode* topNode)
       std::cout << "hitvec.size(): " << hitvec.size() << std::endl;
     }
 
-    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS>;
-    Graph G;
-
-    // Find adjacent strips
-    for (unsigned int i = 0; i < hitvec.size(); i++)
+    // find adjacent strips
+    m_clusterer.clear();
+    if (get_z_clustering(layer))
     {
-      for (unsigned int j = i + 1; j < hitvec.size(); j++)
-      {
-        if (ladder_are_adjacent(hitvec[i], hitvec[j], layer))
-        {
-          add_edge(i, j, G);
-        }
-      }
-
-      add_edge(i, i, G);
+      m_clusterer.set_neighbourhood(1, 1);
     }
-
-    // Find the connections between the vertices of the graph (vertices are the rawhits,
-    // connections are made when they are adjacent to one another)
-    std::vector<int> component(num_vertices(G));
-
-    // this is the actual clustering, performed by boost
-    connected_components(G, component.data());
-
-    // Loop over the components(hit cells) compiling a list of the
-    // unique connected groups (ie. clusters).
-    std::set<int> cluster_ids;  // unique components
-
-    std::multimap<int, RawHit*> clusters;
-    for (unsigned int i = 0; i < component.size(); i++)
+    else
     {
-      cluster_ids.insert(component[i]);                          // one entry per unique cluster id
-      clusters.insert(std::make_pair(component[i], hitvec[i]));  // multiple entries per unique cluster id
+      // adjacent phi bins, same time bin
+      m_clusterer.set_neighbourhood(0, 1);
     }
+    for (auto* hit : hitvec)
+    {
+      // row == time bin, column == phi bin
+      m_clusterer.add_hit(hit->getTBin(), hit->getPhiBin());
+    }
+    m_clusterer.run();
 
-    // loop over the cluster ID's and make the clusters from the connected hits
-    for (int clusid : cluster_ids)
+    // loop over the clusters and make them from the connected hits
+    const auto& clusters = m_clusterer.clusters();
+    const auto& hit_order = m_clusterer.hit_order();
+    for (unsigned int clusid = 0; clusid < clusters.size(); ++clusid)
     {
-      // std::cout << " intt clustering: add cluster number " << clusid << std::endl;
+      const auto& cluster = clusters[clusid];
+
       // make the cluster directly in the node tree
       TrkrDefs::cluskey ckey = TrkrDefs::genClusKey(hitset->getHitSetKey(), clusid);
 
@@ -724,8 +638,8 @@ void InttClusterizer::ClusterLadderCellsRaw(PHCompositeNode* topNode)
       m_clustercrossingassoc->addAssoc(ckey, crossing);
 
       // determine the size of the cluster in phi and z, useful for track fitting the cluster
-      std::set<int> phibins;
-      std::set<int> zbins;
+      const unsigned int nphibins = cluster.nrows();
+      const unsigned int nzbins = cluster.ncols();
 
       // determine the cluster position...
       double xlocalsum = 0.0;
@@ -739,17 +653,12 @@ void InttClusterizer::ClusterLadderCellsRaw(PHCompositeNode* topNode)
       std::map<int, unsigned int> m_z;  // hold data for
 
       // get all hits for this cluster ID only
-      const auto clusrange = clusters.equal_range(clusid);
-      for (auto mapiter = clusrange.first; mapiter != clusrange.second; ++mapiter)
+      for (unsigned int ihit = cluster.first; ihit < cluster.first + cluster.nhits; ++ihit)
       {
-        // mapiter->second.first  is the hit key
-        // std::cout << " adding hitkey " << mapiter->second.first << std::endl;
-        const auto energy = (mapiter->second)->getAdc();
-        int col = (mapiter->second)->getPhiBin();
-        int row = (mapiter->second)->getTBin();
-        //	    std::cout << " found Tbin(row) " << row << " Phibin(col) " << col << std::endl;
-        zbins.insert(col);
-        phibins.insert(row);
+        auto* hit = hitvec[hit_order[ihit]];
+        const auto energy = hit->getAdc();
+        int col = hit->getPhiBin();
+        int row = hit->getTBin();
 
         if (mClusHitsVerbose)
         {
@@ -766,8 +675,7 @@ void InttClusterizer::ClusterLadderCellsRaw(PHCompositeNode* topNode)
           }
         }
 
-        // mapiter->second.second is the hit
-        unsigned int hit_adc = (mapiter->second)->getAdc();
+        unsigned int hit_adc = hit->getAdc();
 
         // now get the positions from the geometry
         double local_hit_location[3] = {0., 0., 0.};
@@ -839,20 +747,20 @@ void InttClusterizer::ClusterLadderCellsRaw(PHCompositeNode* topNode)
       float phierror = pitch * invsqrt12;
 
       static constexpr std::array<double, 3> scalefactors_phi = {{0.85, 0.4, 0.33}};
-      if (phibins.size() == 1 && layer < 5)
+      if (nphibins == 1 && layer < 5)
       {
         phierror *= scalefactors_phi[0];
       }
-      else if (phibins.size() == 2 && layer < 5)
+      else if (nphibins == 2 && layer < 5)
       {
         phierror *= scalefactors_phi[1];
       }
-      else if (phibins.size() == 2 && layer > 4)
+      else if (nphibins == 2 && layer > 4)
       {
         phierror *= scalefactors_phi[2];
       }
       // z error.
-      const float zerror = zbins.size() * length * invsqrt12;
+      const float zerror = nzbins * length * invsqrt12;
 
       double cluslocaly = std::numeric_limits<double>::quiet_NaN();
       double cluslocalz = std::numeric_limits<double>::quiet_NaN();
@@ -874,8 +782,8 @@ void InttClusterizer::ClusterLadderCellsRaw(PHCompositeNode* topNode)
       clus->setLocalY(cluslocalz);
       clus->setPhiError(phierror);
       clus->setZError(zerror);
-      clus->setPhiSize(phibins.size());
-      clus->setZSize(zbins.size());
+      clus->setPhiSize(nphibins);
+      clus->setZSize(nzbins);
       // All silicon surfaces have a 1-1 map to hitsetkey.
       // So set subsurface key to 0
       clus->setSubSurfKey(0);
@@ -379,3 +379,11 @@ void InttZVertexFinder::EnableEventDisplay(const bool enableEvtDisp)
     m_inttzvtx->EnableEventDisplay(enableEvtDisp);
   }
 }
+
+void InttZVertexFinder::SetProductionMode(const bool production)
+{
+  if (m_inttzvtx != nullptr)
+  {
+    m_inttzvtx->SetProductionMode(production);
+  }
+}
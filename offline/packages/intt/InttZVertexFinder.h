@@ -36,6 +36,9 @@ class InttZVertexFinder : public SubsysReco
   void EnableQA(const bool enableQA);
   void EnableEventDisplay(const bool enableEvtDisp);
 
+  // z-vertex finding without QA histograms and trees, see INTTZvtx::SetProductionMode
+  void SetProductionMode(const bool production);
+
  private:
   int createNodes(PHCompositeNode *topNode);
 
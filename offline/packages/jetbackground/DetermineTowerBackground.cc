@@ -43,10 +43,9 @@
 #include <cstdlib>
 #include <iomanip>
 #include <iostream>
-#include <map>
+#include <limits>
 #include <utility>
 #include <vector>
-#include <set>
 
 DetermineTowerBackground::DetermineTowerBackground(const std::string &name)
   : SubsysReco(name)
@@ -106,6 +105,115 @@ int DetermineTowerBackground::LoadCalibrations()
 
   return Fun4AllReturnCodes::EVENT_OK;
 }
+
+void DetermineTowerBackground::InitGeometry(RawTowerGeomContainer *geomIH, RawTowerGeomContainer *geomOH)
+{
+  // tower centers in the common ( eta, phi ) binning
+  _ETA_CENTER.resize(_HCAL_NETA);
+  _PHI_CENTER.resize(_HCAL_NPHI);
+  for (int eta = 0; eta < _HCAL_NETA; eta++)
+  {
+    _ETA_CENTER[eta] = geomIH->get_etacenter(eta);
+  }
+  for (int phi = 0; phi < _HCAL_NPHI; phi++)
+  {
+    _PHI_CENTER[phi] = geomIH->get_phicenter(phi);
+  }
+
+  // cosh(eta) of the tower geometry to convert the seed constituent energies to ET
+  const std::array<std::pair<RawTowerGeomContainer *, RawTowerDefs::CalorimeterId>, 2> geoms = {{{geomIH, RawTowerDefs::CalorimeterId::HCALIN},
+                                                                                                {geomOH, RawTowerDefs::CalorimeterId::HCALOUT}}};
+  for (unsigned int igeom = 0; igeom < geoms.size(); igeom++)
+  {
+    _COSH_ETA[igeom].assign(_HCAL_NETA * _HCAL_NPHI, std::numeric_limits<double>::quiet_NaN());
+    for (int eta = 0; eta < _HCAL_NETA; eta++)
+    {
+      for (int phi = 0; phi < _HCAL_NPHI; phi++)
+      {
+        const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid(geoms[igeom].second, eta, phi);
+        RawTowerGeom *tower_geom = geoms[igeom].first->get_tower_geometry(key);
+        if (tower_geom)
+        {
+          _COSH_ETA[igeom][(eta * _HCAL_NPHI) + phi] = cosh(tower_geom->get_eta());
+        }
+      }
+    }
+  }
+
+  _CONSTITUENT_ET.assign(_HCAL_NETA * _HCAL_NPHI, 0);
+  _CONSTITUENT_USED.assign(_HCAL_NETA * _HCAL_NPHI, 0);
+}
+
+const std::vector<int> &DetermineTowerBackground::GetChannelBins(int layer, TowerInfoContainer *towers)
+{
+  // the channel mapping is fixed, rebuild only if the container changes size
+  std::vector<int> &bins = _CHANNEL_BIN[layer];
+  unsigned int nchannels = towers->size();
+  if (bins.size() != nchannels)
+  {
+    bins.resize(nchannels);
+    for (unsigned int channel = 0; channel < nchannels; channel++)
+    {
+      unsigned int key = towers->encode_key(channel);
+      bins[channel] = (towers->getTowerEtaBin(key) * _HCAL_NPHI) + towers->getTowerPhiBin(key);
+    }
+  }
+  return bins;
+}
+
+const TowerBackgroundCache::Entry &DetermineTowerBackground::GetTowers(PHCompositeNode *topNode, const std::array<TowerInfoContainer *, 3> &towers)
+{
+  TowerBackgroundCache *cache = nullptr;
+  if (_use_shared_towers)
+  {
+    cache = findNode::getClass<TowerBackgroundCache>(topNode, TowerBackgroundCache::nodeName);
+    if (!cache)
+    {
+      PHNodeIterator iter(topNode);
+      PHCompositeNode *dstNode = dynamic_cast<PHCompositeNode *>(iter.findFirst("PHCompositeNode", "DST"));
+      if (dstNode)
+      {
+        // transient node, reset at the end of every event
+        cache = new TowerBackgroundCache;
+        dstNode->addNode(new PHDataNode<TowerBackgroundCache>(cache, TowerBackgroundCache::nodeName, "PHObject"));
+      }
+    }
+  }
+  TowerBackgroundCache::Entry &entry = cache ? cache->get(m_towerNodePrefix) : _towers;
+  if (cache && entry.valid &&
+      entry.towers[0] == towers[0] && entry.towers[1] == towers[1] && entry.towers[2] == towers[2] &&
+      entry.E.size() == static_cast<size_t>(3 * _HCAL_NETA * _HCAL_NPHI))
+  {
+    if (Verbosity() > 1)
+    {
+      std::cout << "DetermineTowerBackground::process_event: using tower energies already unpacked in this event" << std::endl;
+    }
+    return entry;
+  }
+
+  entry.E.assign(3 * _HCAL_NETA * _HCAL_NPHI, 0);
+  entry.isBad.assign(3 * _HCAL_NETA * _HCAL_NPHI, 0);
+  for (int layer = 0; layer < 3; layer++)
+  {
+    const std::vector<int> &bins = GetChannelBins(layer, towers[layer]);
+    float *layer_E = &entry.E[CaloBin(layer, 0, 0)];
+    unsigned char *layer_isBad = &entry.isBad[CaloBin(layer, 0, 0)];
+    unsigned int nchannels = towers[layer]->size();
+    for (unsigned int channel = 0; channel < nchannels; channel++)
+    {
+      TowerInfo *tower = towers[layer]->get_tower_at_channel(channel);
+      int this_isBad = !tower->get_isGood();
+      layer_isBad[bins[channel]] = this_isBad;
+      if (!this_isBad)
+      { // just in case since all energy is summed
+        layer_E[bins[channel]] += tower->get_energy();
+      }
+    }
+    entry.towers[layer] = towers[layer];
+  }
+  entry.valid = true;
+  return entry;
+}
   
 int DetermineTowerBackground::process_event(PHCompositeNode *topNode)
 {
@@ -175,17 +283,9 @@ int DetermineTowerBackground::process_event(PHCompositeNode *topNode)
     _HCAL_NETA = geomIH->get_etabins();
     _HCAL_NPHI = geomIH->get_phibins();
     
-    // resize UE density and energy vectors
+    // resize UE density vectors
     _UE.resize(3 , std::vector<float>(_HCAL_NETA, 0));
 
-    _EMCAL_E.resize(_HCAL_NETA, std::vector<float>(_HCAL_NPHI, 0));
-    _IHCAL_E.resize(_HCAL_NETA, std::vector<float>(_HCAL_NPHI, 0));
-    _OHCAL_E.resize(_HCAL_NETA, std::vector<float>(_HCAL_NPHI, 0));
-
-    _EMCAL_ISBAD.resize(_HCAL_NETA, std::vector<int>(_HCAL_NPHI, 0));
-    _IHCAL_ISBAD.resize(_HCAL_NETA, std::vector<int>(_HCAL_NPHI, 0));
-    _OHCAL_ISBAD.resize(_HCAL_NETA, std::vector<int>(_HCAL_NPHI, 0));
-
     // for flow determination, build up a 1-D phi distribution of
     // energies from all layers summed together, populated only from eta
     // strips which do not have any excluded phi towers
@@ -193,9 +293,12 @@ int DetermineTowerBackground::process_event(PHCompositeNode *topNode)
     _FULLCALOFLOW_PHI_VAL.resize(_HCAL_NPHI, 0);
 
     // defualt set weights to 1.0 for all phi bins
-    _EMCAL_PHI_WEIGHTS.resize(_HCAL_NPHI, 1.0);
-    _IHCAL_PHI_WEIGHTS.resize(_HCAL_NPHI, 1.0);
-    _OHCAL_PHI_WEIGHTS.resize(_HCAL_NPHI, 1.0);
+    for (auto &weights : _PHI_WEIGHTS)
+    {
+      weights.resize(_HCAL_NPHI, 1.0);
+    }
+
+    InitGeometry(geomIH, geomOH);
     
     if (Verbosity() > 0)
     {
@@ -206,19 +309,16 @@ int DetermineTowerBackground::process_event(PHCompositeNode *topNode)
   // reset all maps map
   _UE.assign(3, std::vector<float>(_HCAL_NETA, 0));
 
-  // reset all energy vectors
-  _EMCAL_E.assign(_HCAL_NETA, std::vector<float>(_HCAL_NPHI, 0));
-  _IHCAL_E.assign(_HCAL_NETA, std::vector<float>(_HCAL_NPHI, 0));
-  _OHCAL_E.assign(_HCAL_NETA, std::vector<float>(_HCAL_NPHI, 0));
-
-  // reset bad tower masks
-  _EMCAL_ISBAD.assign(_HCAL_NETA, std::vector<int>(_HCAL_NPHI, 0));
-  _IHCAL_ISBAD.assign(_HCAL_NETA, std::vector<int>(_HCAL_NPHI, 0));
-  _OHCAL_ISBAD.assign(_HCAL_NETA, std::vector<int>(_HCAL_NPHI, 0));
-
-  // create a set for all eta strips to be updated
-  std::set<int> EtaStripsAvailbleForFlow = {};
-  for ( int eta = 0; eta < _HCAL_NETA; eta++) { EtaStripsAvailbleForFlow.insert(eta); }
+  // all eta strips are available for flow until a seed is found in them
+  _ETA_STRIP_AVAILABLE.assign(_HCAL_NETA, 1);
+  auto removeSeedEtaStrips = [this](int seed_ieta)
+  {
+    // remove eta-4 to eta+4 from the available eta strips
+    for (int ieta = std::max(seed_ieta - 4, 0); ieta <= std::min(seed_ieta + 4, _HCAL_NETA - 1); ieta++)
+    {
+      _ETA_STRIP_AVAILABLE[ieta] = 0;
+    }
+  };
 
   // seed type 0 is D > 3 R=0.2 jets run on retowerized CEMC
   if (_seed_type == 0)
@@ -234,6 +334,11 @@ int DetermineTowerBackground::process_event(PHCompositeNode *topNode)
       std::cout << "DetermineTowerBackground::process_event: examining possible seeds (1st iteration) ... " << std::endl;
     }
 
+    // channel -> ( eta, phi ) bin of the constituent towers
+    const std::vector<int> &binsEM = GetChannelBins(0, towerinfosEM3);
+    const std::vector<int> &binsIH = GetChannelBins(1, towerinfosIH3);
+    const std::vector<int> &binsOH = GetChannelBins(2, towerinfosOH3);
+
     _index_SeedD = reco2_jets->property_index(Jet::PROPERTY::prop_SeedD);
     _index_SeedItr = reco2_jets->property_index(Jet::PROPERTY::prop_SeedItr);
     for (auto *this_jet : *reco2_jets)
@@ -256,53 +361,38 @@ int DetermineTowerBackground::process_event(PHCompositeNode *topNode)
         std::cout << "DetermineTowerBackground::process_event: possible seed jet with pt / eta / phi = " << this_pt << " / " << this_eta << " / " << this_phi << ", examining constituents..." << std::endl;
       }
 
-      std::map<int, double> constituent_ETsum;
-
       for (const auto &comp : this_jet->get_comp_vec())
       {
-        int comp_ieta = -1;
-        int comp_iphi = -1;
+        int comp_bin = -1;
         float comp_ET = 0;
         int comp_isBad = -99;
 
         TowerInfo *towerinfo;
-        RawTowerGeom *tower_geom;
 
-  
+        // the retowered EMCal uses the IHCal geometry
         if (comp.first == 5 || comp.first == 26)
         {
           towerinfo = towerinfosIH3->get_tower_at_channel(comp.second);
-          unsigned int towerkey = towerinfosIH3->encode_key(comp.second);
-          comp_ieta = towerinfosIH3->getTowerEtaBin(towerkey);
-          comp_iphi = towerinfosIH3->getTowerPhiBin(towerkey);
-          const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid(RawTowerDefs::CalorimeterId::HCALIN, comp_ieta, comp_iphi);
-          tower_geom = geomIH->get_tower_geometry(key);
-          comp_ET = towerinfo->get_energy() / cosh(tower_geom->get_eta());
+          comp_bin = binsIH[comp.second];
+          comp_ET = towerinfo->get_energy() / _COSH_ETA[0][comp_bin];
           comp_isBad = !towerinfo->get_isGood();
         }
         else if (comp.first == 7 || comp.first == 27)
         {
           towerinfo = towerinfosOH3->get_tower_at_channel(comp.second);
-          unsigned int towerkey = towerinfosOH3->encode_key(comp.second);
-          comp_ieta = towerinfosOH3->getTowerEtaBin(towerkey);
-          comp_iphi = towerinfosOH3->getTowerPhiBin(towerkey);
-          const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid(RawTowerDefs::CalorimeterId::HCALOUT, comp_ieta, comp_iphi);
-          tower_geom = geomOH->get_tower_geometry(key);
-          comp_ET = towerinfo->get_energy() / cosh(tower_geom->get_eta());
+          comp_bin = binsOH[comp.second];
+          comp_ET = towerinfo->get_energy() / _COSH_ETA[1][comp_bin];
           comp_isBad = !towerinfo->get_isGood();
         }
         else if (comp.first == 13 || comp.first == 28)
         {
           towerinfo = towerinfosEM3->get_tower_at_channel(comp.second);
-          unsigned int towerkey = towerinfosEM3->encode_key(comp.second);
-          comp_ieta = towerinfosEM3->getTowerEtaBin(towerkey);
-          comp_iphi = towerinfosEM3->getTowerPhiBin(towerkey);
-          const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid(RawTowerDefs::CalorimeterId::HCALIN, comp_ieta, comp_iphi);
-          tower_geom = geomIH->get_tower_geometry(key);
-          comp_ET = towerinfo->get_energy() / cosh(tower_geom->get_eta());
+          comp_bin = binsEM[comp.second];
+          comp_ET = towerinfo->get_energy() / _COSH_ETA[0][comp_bin];
           comp_isBad = !towerinfo->get_isGood();
         }
-        
+        int comp_ieta = comp_bin < 0 ? -1 : comp_bin / _HCAL_NPHI;
+        int comp_iphi = comp_bin < 0 ? -1 : comp_bin % _HCAL_NPHI;
 
         if (comp_isBad)
         {
@@ -312,40 +402,51 @@ int DetermineTowerBackground::process_event(PHCompositeNode *topNode)
           }
           continue;
         }
-        int comp_ikey = (1000 * comp_ieta) + comp_iphi;
 
         if (Verbosity() > 4)
         {
-          std::cout << "DetermineTowerBackground::process_event: --> --> constituent in layer " << comp.first << " at ieta / iphi = " << comp_ieta << " / " << comp_iphi << ", filling map with key = " << comp_ikey << " and ET = " << comp_ET << std::endl;
+          std::cout << "DetermineTowerBackground::process_event: --> --> constituent in layer " << comp.first << " at ieta / iphi = " << comp_ieta << " / " << comp_iphi << ", filling bin = " << comp_bin << " with ET = " << comp_ET << std::endl;
         }
 
-        constituent_ETsum[comp_ikey] += comp_ET;
+        if (!_CONSTITUENT_USED[comp_bin])
+        {
+          _CONSTITUENT_USED[comp_bin] = 1;
+          _CONSTITUENT_BINS.push_back(comp_bin);
+        }
+        _CONSTITUENT_ET[comp_bin] += comp_ET;
 
         if (Verbosity() > 4)
         {
-          std::cout << "DetermineTowerBackground::process_event: --> --> ET sum map at key = " << comp_ikey << " now has ET = " << constituent_ETsum[comp_ikey] << std::endl;
+          std::cout << "DetermineTowerBackground::process_event: --> --> ET sum at bin = " << comp_bin << " now has ET = " << _CONSTITUENT_ET[comp_bin] << std::endl;
         }
       }
 
-      // now iterate over constituent_ET sums to find maximum and mean
+      // now iterate over constituent_ET sums to find maximum and mean,
+      // in ( eta, phi ) order so that the float sum does not depend on the constituent order
+      std::sort(_CONSTITUENT_BINS.begin(), _CONSTITUENT_BINS.end());
       float constituent_max_ET = 0;
       float constituent_sum_ET = 0;
       int nconstituents = 0;
 
       if (Verbosity() > 4)
       {
-        std::cout << "DetermineTowerBackground::process_event: --> now iterating over map..." << std::endl;
+        std::cout << "DetermineTowerBackground::process_event: --> now iterating over constituent towers..." << std::endl;
       }
-      for (auto &map_iter : constituent_ETsum)
+      for (int bin : _CONSTITUENT_BINS)
       {
         if (Verbosity() > 4)
         {
-          std::cout << "DetermineTowerBackground::process_event: --> --> map has key # " << map_iter.first << " and ET = " << map_iter.second << std::endl;
+          std::cout << "DetermineTowerBackground::process_event: --> --> bin # " << bin << " has ET = " << _CONSTITUENT_ET[bin] << std::endl;
         }
         nconstituents++;
-        constituent_sum_ET += map_iter.second;
-        constituent_max_ET = std::max<double>(map_iter.second, constituent_max_ET);
+        constituent_sum_ET += _CONSTITUENT_ET[bin];
+        constituent_max_ET = std::max<double>(_CONSTITUENT_ET[bin], constituent_max_ET);
+
+        // ready for the next jet
+        _CONSTITUENT_ET[bin] = 0;
+        _CONSTITUENT_USED[bin] = 0;
       }
+      _CONSTITUENT_BINS.clear();
 
       float mean_constituent_ET = constituent_sum_ET / nconstituents;
       float seed_D = constituent_max_ET / mean_constituent_ET;
@@ -362,11 +463,7 @@ int DetermineTowerBackground::process_event(PHCompositeNode *topNode)
       {
         _seed_eta.push_back(this_eta);
         _seed_phi.push_back(this_phi);
-        int seed_ieta = geomIH->get_etabin(this_eta);
-        
-        // remove eta-4 to eta+4 from the set of all eta strips
-        // dont need to worry about bounds since itsa set
-        for ( int ieta = -4; ieta <= 4; ieta++ ) { EtaStripsAvailbleForFlow.erase(seed_ieta + ieta); } 
+        removeSeedEtaStrips(geomIH->get_etabin(this_eta));
 
         // set first iteration seed property
         this_jet->set_property(_index_SeedItr, 1.0);
@@ -423,13 +520,7 @@ int DetermineTowerBackground::process_event(PHCompositeNode *topNode)
 
       _seed_eta.push_back(this_eta);
       _seed_phi.push_back(this_phi);
-
-      int seed_ieta = geomIH->get_etabin(this_eta);
-        
-      // remove eta-4 to eta+4 from the set of all eta strips
-      // dont need to worry about bounds since itsa set
-      for ( int ieta = -4; ieta <= 4; ieta++ ) { EtaStripsAvailbleForFlow.erase(seed_ieta + ieta); } 
-
+      removeSeedEtaStrips(geomIH->get_etabin(this_eta));
 
       // set second iteration seed property
       this_jet->set_property(_index_SeedItr, 2.0);
@@ -442,75 +533,24 @@ int DetermineTowerBackground::process_event(PHCompositeNode *topNode)
   }
 
 
-  int MaxEtaBinsWithoutSeeds = EtaStripsAvailbleForFlow.size();
+  int MaxEtaBinsWithoutSeeds = std::count(_ETA_STRIP_AVAILABLE.begin(), _ETA_STRIP_AVAILABLE.end(), 1);
   if (Verbosity() > 1)
   {
-    for (const auto &eta : EtaStripsAvailbleForFlow)
+    for (int eta = 0; eta < _HCAL_NETA; eta++)
     {
-      std::cout << "DetermineTowerBackground::process_event: Remaining eta strip for background determination: " << eta << std::endl;
+      if (_ETA_STRIP_AVAILABLE[eta])
+      {
+        std::cout << "DetermineTowerBackground::process_event: Remaining eta strip for background determination: " << eta << std::endl;
+      }
     }
     std::cout << "DetermineTowerBackground::process_event: Finished processing seeds. Remaining avilable eta strips for background determination: " << MaxEtaBinsWithoutSeeds << std::endl;
   }
 
-  // fill energy and status vectors
-  // iterate over EMCal towerinfos
-  if (!towerinfosEM3 || !towerinfosIH3 || !towerinfosOH3)
-  {
-    std::cout << PHWHERE << "missing tower info object, doing nothing" << std::endl;
-    return Fun4AllReturnCodes::ABORTRUN;
-  }
-  unsigned int nchannels_em = towerinfosEM3->size();
-  for (unsigned int channel = 0; channel < nchannels_em; channel++)
-  {
-    unsigned int key = towerinfosEM3->encode_key(channel);
-    int this_etabin = towerinfosEM3->getTowerEtaBin(key);
-    int this_phibin = towerinfosEM3->getTowerPhiBin(key);
-    TowerInfo *tower = towerinfosEM3->get_tower_at_channel(channel);
-    float this_E = tower->get_energy();
-    int this_isBad = !tower->get_isGood();
-    _EMCAL_ISBAD[this_etabin][this_phibin] = this_isBad;
-    if (!this_isBad)
-    { // just in case since all energy is summed
-      _EMCAL_E[this_etabin][this_phibin] += this_E;
-    }
-    
-  }
-
-  // iterate over IHCal towerinfos
-  unsigned int nchannels_ih = towerinfosIH3->size();
-  for (unsigned int channel = 0; channel < nchannels_ih; channel++)
-  {
-    unsigned int key = towerinfosIH3->encode_key(channel);
-    int this_etabin = towerinfosIH3->getTowerEtaBin(key);
-    int this_phibin = towerinfosIH3->getTowerPhiBin(key);
-    TowerInfo *tower = towerinfosIH3->get_tower_at_channel(channel);
-    float this_E = tower->get_energy();
-    int this_isBad = !tower->get_isGood();
-    _IHCAL_ISBAD[this_etabin][this_phibin] = this_isBad;
-    if (!this_isBad)
-    { // just in case since all energy is summed
-      _IHCAL_E[this_etabin][this_phibin] += this_E;
-    }
-    
-  }
-
-  // iterate over OHCal towerinfos
-  unsigned int nchannels_oh = towerinfosOH3->size();
-  for (unsigned int channel = 0; channel < nchannels_oh; channel++)
-  {
-    unsigned int key = towerinfosOH3->encode_key(channel);
-    int this_etabin = towerinfosOH3->getTowerEtaBin(key);
-    int this_phibin = towerinfosOH3->getTowerPhiBin(key);
-    TowerInfo *tower = towerinfosOH3->get_tower_at_channel(channel);
-    float this_E = tower->get_energy();
-    int this_isBad = !tower->get_isGood();
-    _OHCAL_ISBAD[this_etabin][this_phibin] = this_isBad;
-    if (!this_isBad)
-    { // just in case since all energy is summed
-      _OHCAL_E[this_etabin][this_phibin] += this_E;
-    }
-    
-  }
+  // fill energy and status arrays, shared with the other background iterations of this event
+  const TowerBackgroundCache::Entry &towers = GetTowers(topNode, {towerinfosEM3, towerinfosIH3, towerinfosOH3});
+  const std::vector<float> &calo_E = towers.E;
+  const std::vector<unsigned char> &calo_isBad = towers.isBad;
+  
   
   
   // first, calculate flow: Psi2 & v2, if enabled
@@ -638,14 +678,15 @@ int DetermineTowerBackground::process_event(PHCompositeNode *topNode)
     }
 
     // phi weights are set to 1.0 by default
-    _EMCAL_PHI_WEIGHTS.assign(_HCAL_NPHI, 1.0);
-    _IHCAL_PHI_WEIGHTS.assign(_HCAL_NPHI, 1.0);
-    _OHCAL_PHI_WEIGHTS.assign(_HCAL_NPHI, 1.0);
-
-    // copy the set of included eta strips to a new set for exclusion
-    std::set<int> AVAILIBLE_ETA_STRIPS_CEMC = EtaStripsAvailbleForFlow; 
-    std::set<int> AVAILIBLE_ETA_STRIPS_IHCAL = EtaStripsAvailbleForFlow;
-    std::set<int> AVAILIBLE_ETA_STRIPS_OHCAL = EtaStripsAvailbleForFlow;
+    for (auto &weights : _PHI_WEIGHTS)
+    {
+      weights.assign(_HCAL_NPHI, 1.0);
+    }
+
+    // copy the included eta strips to new masks for exclusion
+    std::array<std::vector<unsigned char>, 3> AVAILIBLE_ETA_STRIPS;
+    AVAILIBLE_ETA_STRIPS.fill(_ETA_STRIP_AVAILABLE);
+    static const std::array<std::string, 3> layer_names = {"EMCAL", "IHCAL", "OHCAL"};
     
     
     if ( _do_reweight )
@@ -663,104 +704,53 @@ int DetermineTowerBackground::process_event(PHCompositeNode *topNode)
       // loop over all phi bins
       for ( int phi = 0; phi < _HCAL_NPHI; phi++ )
       {
-
-        // initialize the maximum number of eta bins for this phi bin
-        //  to be the total number of eta strips available (after removing the seeds)
-        int EMCAL_MAX_TOWERS_THIS_PHI = MaxEtaBinsWithoutSeeds;
-        int IHCAL_MAX_TOWERS_THIS_PHI = MaxEtaBinsWithoutSeeds;
-        int OHCAL_MAX_TOWERS_THIS_PHI = MaxEtaBinsWithoutSeeds;
-
-        // loop over only the eta strips which are still available for flow determination
-        // already exclude strips don't get checked since they are not in the set EtaStripsAvailbleForFlow
-        for ( const auto &eta : EtaStripsAvailbleForFlow )
+        std::array<int, 3> MAX_TOWERS_THIS_PHI{};
+        for (int layer = 0; layer < 3; layer++)
         {
- 
-          EMCAL_MAX_TOWERS_THIS_PHI-= _EMCAL_ISBAD[eta][phi]; // decrement the possible count for this phi bin
-          IHCAL_MAX_TOWERS_THIS_PHI-= _IHCAL_ISBAD[eta][phi]; // decrement the possible count for this phi bin
-          OHCAL_MAX_TOWERS_THIS_PHI-= _OHCAL_ISBAD[eta][phi]; // decrement the possible count for this phi bin        
-          if ( Verbosity() > 10 )
+          // initialize the maximum number of eta bins for this phi bin
+          //  to be the total number of eta strips available (after removing the seeds)
+          MAX_TOWERS_THIS_PHI[layer] = MaxEtaBinsWithoutSeeds;
+
+          // loop over only the eta strips which are still available for flow determination
+          for ( int eta = 0; eta < _HCAL_NETA; eta++ )
           {
-            if ( _EMCAL_ISBAD[eta][phi] )
-            {
-              std::cout << "DetermineTowerBackground::process_event: --> found bad tower in EMCAL at ieta / iphi = " << eta << " / " << phi << std::endl;
-            }
-            if ( _IHCAL_ISBAD[eta][phi] )
-            {
-              std::cout << "DetermineTowerBackground::process_event: --> found bad tower in IHCAL at ieta / iphi = " << eta << " / " << phi << std::endl;
-            }
-            if ( _OHCAL_ISBAD[eta][phi] )
+            // decrement the possible count for this phi bin
+            MAX_TOWERS_THIS_PHI[layer] -= _ETA_STRIP_AVAILABLE[eta] & calo_isBad[CaloBin(layer, eta, phi)];
+            if ( Verbosity() > 10 && _ETA_STRIP_AVAILABLE[eta] && calo_isBad[CaloBin(layer, eta, phi)] )
             {
-              std::cout << "DetermineTowerBackground::process_event: --> found bad tower in OHCAL at ieta / iphi = " << eta << " / " << phi << std::endl;
+              std::cout << "DetermineTowerBackground::process_event: --> found bad tower in " << layer_names[layer] << " at ieta / iphi = " << eta << " / " << phi << std::endl;
             }
-          }
-        
-        } // end loop over eta strips
+          } // end loop over eta strips
+        }
 
         if (Verbosity() > 1 )
         {
           std::cout << "DetermineTowerBackground::process_event: --> after checking for bad towers, EMCAL / IHCAL / OHCAL max eta strips for phi = " 
-            << phi << " are: " << EMCAL_MAX_TOWERS_THIS_PHI << " / " << IHCAL_MAX_TOWERS_THIS_PHI << " / " << OHCAL_MAX_TOWERS_THIS_PHI << std::endl;
+            << phi << " are: " << MAX_TOWERS_THIS_PHI[0] << " / " << MAX_TOWERS_THIS_PHI[1] << " / " << MAX_TOWERS_THIS_PHI[2] << std::endl;
         }
 
         // update the phi weights for this phi bin
-        if ( EMCAL_MAX_TOWERS_THIS_PHI > 0 )
-        {
-          _EMCAL_PHI_WEIGHTS[phi] = static_cast<float>(MaxEtaBinsWithoutSeeds) / static_cast<float>(EMCAL_MAX_TOWERS_THIS_PHI);
-          if (Verbosity() > 0)
-          {
-            std::cout << "DetermineTowerBackground::process_event: --> setting EMCAL phi weight for phi = " << phi << " to " << _EMCAL_PHI_WEIGHTS[phi] << std::endl;
-          }
-        }
-        else
-        {
-          // all the eta strips for this phi bin are excluded (this shouldn't happen)
-          _EMCAL_PHI_WEIGHTS[phi] = 1.0;
-          if (Verbosity() > 0)
-          {
-            std::cout << "DetermineTowerBackground::process_event: --> WARNING: all eta strips for EMCAL phi = " << phi << " are excluded, setting weight to 1.0" << std::endl;
-            std::cout << "DeterminingTowerBackground::process_event: --> Defaulting to unweighted flow determination for this event." << std::endl;
-          }
-          _reweight_failed = true;
-        }
-        if ( IHCAL_MAX_TOWERS_THIS_PHI > 0 )
-        {
-          _IHCAL_PHI_WEIGHTS[phi] = static_cast<float>(MaxEtaBinsWithoutSeeds) / static_cast<float>(IHCAL_MAX_TOWERS_THIS_PHI);
-          if (Verbosity() > 0)
-          {
-            std::cout << "DetermineTowerBackground::process_event: --> setting IHCAL phi weight for phi = " << phi << " to " << _IHCAL_PHI_WEIGHTS[phi] << std::endl;
-          }
-        }
-        else
+        for (int layer = 0; layer < 3; layer++)
         {
-          // all the eta strips for this phi bin are excluded (this shouldn't happen)
-          _IHCAL_PHI_WEIGHTS[phi] = 1.0;
-          if (Verbosity() > 0)
+          if ( MAX_TOWERS_THIS_PHI[layer] > 0 )
           {
-            std::cout << "DetermineTowerBackground::process_event: --> WARNING: all eta strips for IHCAL phi = " << phi << " are excluded, setting weight to 1.0" << std::endl;
-            std::cout << "DeterminingTowerBackground::process_event: --> Defaulting to unweighted flow determination for this event." << std::endl;
+            _PHI_WEIGHTS[layer][phi] = static_cast<float>(MaxEtaBinsWithoutSeeds) / static_cast<float>(MAX_TOWERS_THIS_PHI[layer]);
+            if (Verbosity() > 0)
+            {
+              std::cout << "DetermineTowerBackground::process_event: --> setting " << layer_names[layer] << " phi weight for phi = " << phi << " to " << _PHI_WEIGHTS[layer][phi] << std::endl;
+            }
           }
-          _reweight_failed = true;
-
-        }
-        if ( OHCAL_MAX_TOWERS_THIS_PHI > 0 )
-        {
-          _OHCAL_PHI_WEIGHTS[phi] = static_cast<float>(MaxEtaBinsWithoutSeeds) / OHCAL_MAX_TOWERS_THIS_PHI;
-          if (Verbosity() > 0)
-          {
-            std::cout << "DetermineTowerBackground::process_event: --> setting OHCAL phi weight for phi = " << phi << " to " << _OHCAL_PHI_WEIGHTS[phi] << std::endl;
-          } 
-        }
-        else
-        {
-          // all the eta strips for this phi bin are excluded (this shouldn't happen)
-          _OHCAL_PHI_WEIGHTS[phi] = 1.0;
-          if (Verbosity() > 0)
+          else
           {
-            std::cout << "DetermineTowerBackground::process_event: --> WARNING: all eta strips for OHCAL phi = " << phi << " are excluded, setting weight to 1.0" << std::endl;
-            std::cout << "DeterminingTowerBackground::process_event: --> Defaulting to unweighted flow determination for this event." << std::endl;
+            // all the eta strips for this phi bin are excluded (this shouldn't happen)
+            _PHI_WEIGHTS[layer][phi] = 1.0;
+            if (Verbosity() > 0)
+            {
+              std::cout << "DetermineTowerBackground::process_event: --> WARNING: all eta strips for " << layer_names[layer] << " phi = " << phi << " are excluded, setting weight to 1.0" << std::endl;
+              std::cout << "DeterminingTowerBackground::process_event: --> Defaulting to unweighted flow determination for this event." << std::endl;
+            }
+            _reweight_failed = true;
           }
-          _reweight_failed = true;
-
         }
       } // end loop over phi bins
 
@@ -774,85 +764,65 @@ int DetermineTowerBackground::process_event(PHCompositeNode *topNode)
         std::cout << "DetermineTowerBackground::process_event: reweighting not enabled, checking for bad towers in avialible eta strips..." << std::endl;
       }
       // loop over all available eta strips
-      for ( const auto &eta : EtaStripsAvailbleForFlow )
+      for ( int eta = 0; eta < _HCAL_NETA; eta++ )
       {
-        if (Verbosity() > 2)
+        if (!_ETA_STRIP_AVAILABLE[eta])
         {
-          std::cout << "DetermineTowerBackground::process_event: checking for bad towers in eta strip " << eta << std::endl;
-        }
-        // get the number of bad phi towers within this eta strip
-        // only look at the eta strips which are still available for flow determination which are in the
-        // set EtaStripsAvailbleForFlow
-        int bad_phis_int_this_eta_EMCAL = std::count(_EMCAL_ISBAD[eta].begin(), _EMCAL_ISBAD[eta].end(), 1); // count bad towers in this eta strip
-        int bad_phis_int_this_eta_IHCAL = std::count(_IHCAL_ISBAD[eta].begin(), _IHCAL_ISBAD[eta].end(), 1); // count bad towers in this eta strip
-        int bad_phis_int_this_eta_OHCAL = std::count(_OHCAL_ISBAD[eta].begin(), _OHCAL_ISBAD[eta].end(), 1); // count bad towers in this eta strip
-        if (Verbosity() > 3)
-        {
-          std::cout << "DetermineTowerBackground::process_event: --> found " << bad_phis_int_this_eta_EMCAL << " bad towers in EMCAL, " 
-            << bad_phis_int_this_eta_IHCAL << " in IHCAL, and " << bad_phis_int_this_eta_OHCAL << " in OHCAL for eta strip " << eta << std::endl;
+          continue;
         }
-        // we will exclude this eta strip if there are any bad towers in it
-        if ( bad_phis_int_this_eta_EMCAL > 0 )
+        if (Verbosity() > 2)
         {
-          if (Verbosity() > 2)
-          {
-            std::cout << "DetermineTowerBackground::process_event: --> excluding EMCAL eta strip " << eta << " due to " << bad_phis_int_this_eta_EMCAL << " bad towers" << std::endl;
-          }
-          // remove this eta strip from the set of available eta strips
-          AVAILIBLE_ETA_STRIPS_CEMC.erase(eta);
+          std::cout << "DetermineTowerBackground::process_event: checking for bad towers in eta strip " << eta << std::endl;
         }
-        else 
+        // get the number of bad phi towers within this eta strip, in each layer
+        std::array<int, 3> bad_phis_in_this_eta{};
+        for (int layer = 0; layer < 3; layer++)
         {
-          if (Verbosity() > 4)
-          {
-            std::cout << "DetermineTowerBackground::process_event: --> EMCAL eta strip " << eta << " has no excluded towers and can be used for flow determination " << std::endl;
-          }
+          auto strip = calo_isBad.begin() + CaloBin(layer, eta, 0);
+          bad_phis_in_this_eta[layer] = std::count(strip, strip + _HCAL_NPHI, 1);  // count bad towers in this eta strip
         }
-
-        if ( bad_phis_int_this_eta_IHCAL > 0 )
-        {
-          if (Verbosity() > 2)
-          {
-            std::cout << "DetermineTowerBackground::process_event: --> excluding IHCAL eta strip " << eta << " due to " << bad_phis_int_this_eta_IHCAL << " bad towers" << std::endl;
-          }
-          // remove this eta strip from the set of available eta strips
-          AVAILIBLE_ETA_STRIPS_IHCAL.erase(eta);
-        }
-        else 
+        if (Verbosity() > 3)
         {
-          if (Verbosity() > 4)
-          {
-            std::cout << "DetermineTowerBackground::process_event: --> IHCAL eta strip " << eta << " has no excluded towers and can be used for flow determination " << std::endl;
-          }
+          std::cout << "DetermineTowerBackground::process_event: --> found " << bad_phis_in_this_eta[0] << " bad towers in EMCAL, " 
+            << bad_phis_in_this_eta[1] << " in IHCAL, and " << bad_phis_in_this_eta[2] << " in OHCAL for eta strip " << eta << std::endl;
         }
-
-        if ( bad_phis_int_this_eta_OHCAL > 0 )
+        // we will exclude this eta strip if there are any bad towers in it
+        for (int layer = 0; layer < 3; layer++)
         {
-          if (Verbosity() > 2)
+          if ( bad_phis_in_this_eta[layer] > 0 )
           {
-            std::cout << "DetermineTowerBackground::process_event: --> excluding OHCAL eta strip " << eta << " due to " << bad_phis_int_this_eta_OHCAL << " bad towers" << std::endl;
+            if (Verbosity() > 2)
+            {
+              std::cout << "DetermineTowerBackground::process_event: --> excluding " << layer_names[layer] << " eta strip " << eta << " due to " << bad_phis_in_this_eta[layer] << " bad towers" << std::endl;
+            }
+            // remove this eta strip from the available eta strips
+            AVAILIBLE_ETA_STRIPS[layer][eta] = 0;
           }
-          // remove this eta strip from the set of available eta strips
-          AVAILIBLE_ETA_STRIPS_OHCAL.erase(eta);
-        }
-        else 
-        {
-          if (Verbosity() > 4)
+          else 
           {
-            std::cout << "DetermineTowerBackground::process_event: --> OHCAL eta strip " << eta << " has no excluded towers and can be used for flow determination " << std::endl;
+            if (Verbosity() > 4)
+            {
+              std::cout << "DetermineTowerBackground::process_event: --> " << layer_names[layer] << " eta strip " << eta << " has no excluded towers and can be used for flow determination " << std::endl;
+            }
           }
         }
 
       } // end loop over eta strips
-      if (Verbosity() > 0)
-      {
-        std::cout << "DetermineTowerBackground::process_event: after checking for bad towers, available EMCAL eta strips = " << AVAILIBLE_ETA_STRIPS_CEMC.size() 
-          << ", IHCAL eta strips = " << AVAILIBLE_ETA_STRIPS_IHCAL.size() 
-          << ", OHCAL eta strips = " << AVAILIBLE_ETA_STRIPS_OHCAL.size() << std::endl;
-      }
+    }
+
+    std::array<int, 3> nStripsAvailable{};
+    for (int layer = 0; layer < 3; layer++)
+    {
+      nStripsAvailable[layer] = std::count(AVAILIBLE_ETA_STRIPS[layer].begin(), AVAILIBLE_ETA_STRIPS[layer].end(), 1);
+    }
+    if (Verbosity() > 0 && (!_do_reweight || _reweight_failed))
+    {
+      std::cout << "DetermineTowerBackground::process_event: after checking for bad towers, available EMCAL eta strips = " << nStripsAvailable[0]
+        << ", IHCAL eta strips = " << nStripsAvailable[1]
+        << ", OHCAL eta strips = " << nStripsAvailable[2] << std::endl;
     }
     
-    int nStripsAvailableForFlow = AVAILIBLE_ETA_STRIPS_CEMC.size() + AVAILIBLE_ETA_STRIPS_IHCAL.size() + AVAILIBLE_ETA_STRIPS_OHCAL.size();
+    int nStripsAvailableForFlow = nStripsAvailable[0] + nStripsAvailable[1] + nStripsAvailable[2];
     int nStripsUnavailableForFlow = (_HCAL_NETA*3) - nStripsAvailableForFlow;
     if (Verbosity() > 0)
     {
@@ -875,20 +845,17 @@ int DetermineTowerBackground::process_event(PHCompositeNode *topNode)
       float sum_E = 0;
       for (int phi = 0; phi < _HCAL_NPHI; phi++)
       {
-        _FULLCALOFLOW_PHI_VAL[phi] = geomIH->get_phicenter(phi);
+        _FULLCALOFLOW_PHI_VAL[phi] = _PHI_CENTER[phi];
         // loop over the available eta strips for each layer
-      
-        for (const auto &eta : AVAILIBLE_ETA_STRIPS_CEMC)
-        {
-          _FULLCALOFLOW_PHI_E[phi] += _EMCAL_E[eta][phi] * _EMCAL_PHI_WEIGHTS[phi]; // if reweighting is enabled, the weights are applied, if not, they are 1.0
-        }
-        for (const auto &eta : AVAILIBLE_ETA_STRIPS_IHCAL)
-        {
-          _FULLCALOFLOW_PHI_E[phi] += _IHCAL_E[eta][phi] * _IHCAL_PHI_WEIGHTS[phi]; // if reweighting is enabled, the weights are applied, if not, they are 1.0
-        }
-        for (const auto &eta : AVAILIBLE_ETA_STRIPS_OHCAL)
+        for (int layer = 0; layer < 3; layer++)
         {
-          _FULLCALOFLOW_PHI_E[phi] += _OHCAL_E[eta][phi] * _OHCAL_PHI_WEIGHTS[phi]; // if reweighting is enabled, the weights are applied, if not, they are 1.0
+          for (int eta = 0; eta < _HCAL_NETA; eta++)
+          {
+            if (AVAILIBLE_ETA_STRIPS[layer][eta])
+            {
+              _FULLCALOFLOW_PHI_E[phi] += calo_E[CaloBin(layer, eta, phi)] * _PHI_WEIGHTS[layer][phi]; // if reweighting is enabled, the weights are applied, if not, they are 1.0
+            }
+          }
         }
 
         // sum up the energy in this phi bin
@@ -981,114 +948,78 @@ int DetermineTowerBackground::process_event(PHCompositeNode *topNode)
 	}
     }
 
-  // now calculate energy densities...
-  _nTowers = 0;  // store how many towers were used to determine bkg
-
-  // starting with the EMCal first...
-  for (int layer = 0; layer < 3; layer++)
+  // seed exclusion and flow modulation do not depend on the layer, evaluate them once per tower bin
+  _SEED_EXCLUDED.assign(_HCAL_NETA * _HCAL_NPHI, 0);
+  for (int eta = 0; eta < _HCAL_NETA && !_seed_eta.empty(); eta++)
   {
-    int local_max_eta = _HCAL_NETA;
-    int local_max_phi = _HCAL_NPHI;
-
-    for (int eta = 0; eta < local_max_eta; eta++)
+    for (int phi = 0; phi < _HCAL_NPHI; phi++)
     {
-      float total_E = 0;
-      int total_tower = 0;
-
-      for (int phi = 0; phi < local_max_phi; phi++)
+      float this_eta = _ETA_CENTER[eta];
+      float this_phi = _PHI_CENTER[phi];
+      for (unsigned int iseed = 0; iseed < _seed_eta.size(); iseed++)
       {
-        float this_eta = geomIH->get_etacenter(eta);
-        float this_phi = geomIH->get_phicenter(phi);
-
-        bool isExcluded = false;
-
-        // nobody can understand these nested ?s, which just makes this error prone and a maintenance headache
-        //        float my_E = (layer == 0 ? _EMCAL_E[eta][phi] : (layer == 1 ? _IHCAL_E[eta][phi] : _OHCAL_E[eta][phi]));
-        //        int this_isBad = (layer == 0 ? _EMCAL_ISBAD[eta][phi] : (layer == 1 ? _IHCAL_ISBAD[eta][phi] : _OHCAL_ISBAD[eta][phi]));
-        //	please use the following if/else if/else
-        float my_E;
-        int this_isBad;
-        if (layer == 0)
-        {
-          my_E = _EMCAL_E[eta][phi];
-          this_isBad = _EMCAL_ISBAD[eta][phi];
-        }
-        else if (layer == 1)
+        float deta = this_eta - _seed_eta[iseed];
+        float dphi = this_phi - _seed_phi[iseed];
+        if (dphi > M_PI)
         {
-          my_E = _IHCAL_E[eta][phi];
-          this_isBad = _IHCAL_ISBAD[eta][phi];
+          dphi -= 2 * M_PI;
         }
-        else
+        if (dphi < -M_PI)
         {
-          my_E = _OHCAL_E[eta][phi];
-          this_isBad = _OHCAL_ISBAD[eta][phi];
+          dphi += 2 * M_PI;
         }
-        // if the tower is masked (energy identically zero), exclude it
-        if (this_isBad)
+        float dR = sqrt(pow(deta, 2) + pow(dphi, 2));
+        if (dR < 0.4)
         {
-          isExcluded = true;
+          _SEED_EXCLUDED[(eta * _HCAL_NPHI) + phi] = 1;
           if (Verbosity() > 10)
           {
-            std::cout << " tower in layer " << layer << " at eta / phi = " << this_eta << " / " << this_phi << " with E = " << my_E << " excluded due to masking" << std::endl;
-          }
-        }
-        for (unsigned int iseed = 0; iseed < _seed_eta.size(); iseed++)
-        {
-          float deta = this_eta - _seed_eta[iseed];
-          float dphi = this_phi - _seed_phi[iseed];
-          if (dphi > M_PI)
-          {
-            dphi -= 2 * M_PI;
-          }
-          if (dphi < -M_PI)
-          {
-            dphi += 2 * M_PI;
-          }
-          float dR = sqrt(pow(deta, 2) + pow(dphi, 2));
-          if (dR < 0.4)
-          {
-            isExcluded = true;
-            if (Verbosity() > 10)
-            {
-              std::cout << " setting excluded mark from seed at eta / phi = " << _seed_eta[iseed] << " / " << _seed_phi[iseed] << std::endl;
-            }
+            std::cout << " tower at eta / phi = " << this_eta << " / " << this_phi << " excluded due to seed at eta / phi = " << _seed_eta[iseed] << " / " << _seed_phi[iseed] << std::endl;
           }
+          break;
         }
+      }
+    }
+  }
 
-        float modulation_factor =  1 + 2 * _v2 * std::cos(2 * (this_phi - _Psi2));
-        if (!isExcluded && modulation_factor > 0)
+  _MODULATION.resize(_HCAL_NPHI);
+  for (int phi = 0; phi < _HCAL_NPHI; phi++)
+  {
+    float this_phi = _PHI_CENTER[phi];
+    _MODULATION[phi] = 1 + 2 * _v2 * std::cos(2 * (this_phi - _Psi2));
+  }
+
+  // now calculate energy densities...
+  _nTowers = 0;  // store how many towers were used to determine bkg
+
+  // starting with the EMCal first...
+  for (int layer = 0; layer < 3; layer++)
+  {
+    for (int eta = 0; eta < _HCAL_NETA; eta++)
+    {
+      float total_E = 0;
+      int total_tower = 0;
+
+      // contiguous phi rows of this ( layer, eta ) strip
+      const float *strip_E = &calo_E[CaloBin(layer, eta, 0)];
+      const unsigned char *strip_isBad = &calo_isBad[CaloBin(layer, eta, 0)];
+      const unsigned char *strip_excluded = &_SEED_EXCLUDED[eta * _HCAL_NPHI];
+
+      for (int phi = 0; phi < _HCAL_NPHI; phi++)
+      {
+        // masked towers (energy identically zero) and towers close to a seed are excluded
+        if ((strip_isBad[phi] | strip_excluded[phi]) == 0 && _MODULATION[phi] > 0)
         {
-          if (layer == 0)
-          {
-            total_E += _EMCAL_E[eta][phi] / modulation_factor;
-          }
-          if (layer == 1)
-          {
-            total_E += _IHCAL_E[eta][phi] / modulation_factor;
-          }
-          if (layer == 2)
-          {
-            total_E += _OHCAL_E[eta][phi] / modulation_factor;
-          }
+          total_E += strip_E[phi] / _MODULATION[phi];
           total_tower++;  // towers in this eta range & layer
           _nTowers++;     // towers in entire calorimeter
         }
-        else
+        else if (Verbosity() > 10)
         {
-          if (Verbosity() > 10)
-          {
-            std::cout << " tower at eta / phi = " << this_eta << " / " << this_phi << " with E = " << total_E << " excluded due to seed " << std::endl;
-          }
+          std::cout << " tower in layer " << layer << " at eta / phi = " << _ETA_CENTER[eta] << " / " << _PHI_CENTER[phi] << " with E = " << strip_E[phi] << " excluded due to " << (strip_isBad[phi] ? "masking" : "seed") << std::endl;
         }
       }
 
-      std::pair<float, float> etabounds = geomIH->get_etabounds(eta);
-      std::pair<float, float> phibounds = geomIH->get_phibounds(0);
-
-      float deta = etabounds.second - etabounds.first;
-      float dphi = phibounds.second - phibounds.first;
-      float total_area = total_tower * deta * dphi;
-
       if ( total_tower > 0 )
       {
         _UE[layer].at(eta) = total_E / total_tower; // calculate the UE density
@@ -1105,6 +1036,13 @@ int DetermineTowerBackground::process_event(PHCompositeNode *topNode)
 
       if (Verbosity() > 3)
       {
+        std::pair<float, float> etabounds = geomIH->get_etabounds(eta);
+        std::pair<float, float> phibounds = geomIH->get_phibounds(0);
+
+        float deta = etabounds.second - etabounds.first;
+        float dphi = phibounds.second - phibounds.first;
+        float total_area = total_tower * deta * dphi;
+
         std::cout << "DetermineTowerBackground::process_event: at layer / eta index ( eta range ) = " << layer << " / " << eta << " ( " << etabounds.first << " - " << etabounds.second << " ) , total E / total Ntower / total area = " << total_E << " / " << total_tower << " / " << total_area << " , UE per tower = " << total_E / total_tower << std::endl;
       }
     }
@@ -7,6 +7,8 @@
 /// \author Dennis V. Perepelitsa
 //===========================================================
 
+#include "TowerBackgroundCache.h"
+
 #include <fun4all/SubsysReco.h>
 
 // system includes
@@ -17,6 +19,8 @@
 
 // forward declarations
 class PHCompositeNode;
+class RawTowerGeomContainer;
+class TowerInfoContainer;
 
 /// \class DetermineTowerBackground
 ///
@@ -49,6 +53,12 @@ class DetermineTowerBackground : public SubsysReco
 
   void UseReweighting(bool do_reweight ) {  _do_reweight = do_reweight; }
 
+  // share the unpacked tower arrays with the other DetermineTowerBackground
+  // instances of the event which enable it too. Off by default: the shared arrays
+  // are only matched by tower container, so towers modified in place by a module
+  // running between two instances would be read stale
+  void UseSharedTowers(bool use_shared) { _use_shared_towers = use_shared; }
+
   void set_towerNodePrefix(const std::string &prefix)
   {
     m_towerNodePrefix = prefix;
@@ -62,6 +72,13 @@ class DetermineTowerBackground : public SubsysReco
 
   int LoadCalibrations();
 
+  void InitGeometry(RawTowerGeomContainer *geomIH, RawTowerGeomContainer *geomOH);
+  const std::vector<int> &GetChannelBins(int layer, TowerInfoContainer *towers);
+  const TowerBackgroundCache::Entry &GetTowers(PHCompositeNode *topNode, const std::array<TowerInfoContainer *, 3> &towers);
+
+  // index into the dense ( layer, eta, phi ) arrays
+  int CaloBin(int layer, int eta, int phi) const { return (layer * _HCAL_NETA + eta) * _HCAL_NPHI + phi; }
+
   std::vector<float> _CENTRALITY_V2;
   std::string m_calibName = "JET_AVERAGE_CALO_V2_SEPD_PSI2";
   bool m_overwrite_average_calo_v2{false};
@@ -77,14 +94,27 @@ class DetermineTowerBackground : public SubsysReco
   int _HCAL_NETA{-1};
   int _HCAL_NPHI{-1};
 
-  
-  std::vector<std::vector<float> > _EMCAL_E;
-  std::vector<std::vector<float> > _IHCAL_E;
-  std::vector<std::vector<float> > _OHCAL_E;
+  // tower geometry in ( eta, phi ) bins, filled on the first event
+  std::vector<float> _ETA_CENTER;
+  std::vector<float> _PHI_CENTER;
+  std::array<std::vector<double>, 2> _COSH_ETA;  // IHCal / OHCal tower geometry
+
+  // per layer ( eta * _HCAL_NPHI + phi ) bin of every tower channel
+  std::array<std::vector<int>, 3> _CHANNEL_BIN;
+
+  // energies and bad tower flags in ( layer, eta, phi ), see TowerBackgroundCache
+  bool _use_shared_towers{false};
+  TowerBackgroundCache::Entry _towers;
+
+  // eta strips without seeds, seed exclusion per ( eta, phi ) bin and flow modulation per phi bin
+  std::vector<unsigned char> _ETA_STRIP_AVAILABLE;
+  std::vector<unsigned char> _SEED_EXCLUDED;
+  std::vector<float> _MODULATION;
 
-  std::vector<std::vector<int> > _EMCAL_ISBAD;
-  std::vector<std::vector<int> > _IHCAL_ISBAD;
-  std::vector<std::vector<int> > _OHCAL_ISBAD;
+  // summed constituent ET per ( eta, phi ) bin of the seed jet being examined
+  std::vector<double> _CONSTITUENT_ET;
+  std::vector<unsigned char> _CONSTITUENT_USED;
+  std::vector<int> _CONSTITUENT_BINS;
 
   // 1-D energies vs. phi (integrated over eta strips with complete
   // phi coverage, and all layers)
@@ -92,9 +122,7 @@ class DetermineTowerBackground : public SubsysReco
   std::vector<float> _FULLCALOFLOW_PHI_VAL;
 
   bool _do_reweight{true}; // flag to indicate if reweighting is used
-  std::vector<float> _EMCAL_PHI_WEIGHTS;
-  std::vector<float> _IHCAL_PHI_WEIGHTS;
-  std::vector<float> _OHCAL_PHI_WEIGHTS;
+  std::array<std::vector<float>, 3> _PHI_WEIGHTS;  // EMCal, IHCal, OHCal
 
   std::string _backgroundName{"TestTowerBackground"};
 
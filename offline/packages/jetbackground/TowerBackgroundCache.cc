@@ -0,0 +1,19 @@
+#include "TowerBackgroundCache.h"
+
+void TowerBackgroundCache::identify(std::ostream &os) const
+{
+  os << "TowerBackgroundCache - entries: " << m_entries.size() << std::endl;
+  for (const auto &[key, entry] : m_entries)
+  {
+    os << "   " << key << " valid: " << entry.valid << " towers: " << entry.E.size() << std::endl;
+  }
+}
+
+void TowerBackgroundCache::Reset()
+{
+  // keep the allocations from one event to the next
+  for (auto &[key, entry] : m_entries)
+  {
+    entry.valid = false;
+  }
+}
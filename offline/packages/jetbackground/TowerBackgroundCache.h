@@ -0,0 +1,47 @@
+#ifndef JETBACKGROUND_TOWERBACKGROUNDCACHE_H
+#define JETBACKGROUND_TOWERBACKGROUNDCACHE_H
+
+#include <phool/PHObject.h>
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+// Transient per event cache of the dense tower arrays used by DetermineTowerBackground.
+//
+// The background is determined twice per event (raw and subtracted seeds) from the
+// same unsubtracted towers, so the energies and bad tower flags can be unpacked from the
+// tower containers once and shared by the DetermineTowerBackground instances which
+// enable UseSharedTowers. Nothing may modify the towers in between.
+// Entries are indexed by the tower node prefix and remember the containers they were
+// built from, arrays are indexed by ( layer * neta + eta ) * nphi + phi.
+// The cache lives in a PHDataNode below DST and is reset at the end of every event.
+class TowerBackgroundCache : public PHObject
+{
+ public:
+  struct Entry
+  {
+    bool valid{false};
+    const void *towers[3]{nullptr, nullptr, nullptr};  // EMCal (retowered), IHCal, OHCal
+    std::vector<float> E;
+    std::vector<unsigned char> isBad;
+  };
+
+  static constexpr const char *nodeName = "TowerBackgroundCache";
+
+  TowerBackgroundCache() = default;
+  ~TowerBackgroundCache() override = default;
+
+  void identify(std::ostream &os = std::cout) const override;
+  int isValid() const override { return 1; }
+  void Reset() override;
+
+  // entry for a given tower node prefix, created empty if needed
+  Entry &get(const std::string &key) { return m_entries[key]; }
+
+ private:
+  std::map<std::string, Entry> m_entries;
+};
+
+#endif
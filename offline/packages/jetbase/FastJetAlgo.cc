@@ -200,6 +200,42 @@ FastJetAlgo::jets_to_pseudojets(std::vector<Jet*>& particles) const
   return pseudojets;
 }
 
+std::vector<fastjet::PseudoJet>
+FastJetAlgo::particles_to_pseudojets(const std::vector<JetInputParticle>& particles) const
+{
+  // same selection as jets_to_pseudojets
+  std::vector<fastjet::PseudoJet> pseudojets;
+  pseudojets.reserve(particles.size());
+  for (unsigned int ipart = 0; ipart < particles.size(); ++ipart)
+  {
+    const auto& particle = particles[ipart];
+    if (particle.e < m_opt.constituent_min_E)
+    {
+      continue;
+    }
+    if (!std::isfinite(particle.px) ||
+        !std::isfinite(particle.py) ||
+        !std::isfinite(particle.pz) ||
+        !std::isfinite(particle.e))
+    {
+      std::cout << PHWHERE << " invalid particle kinematics:"
+                << " px: " << particle.px
+                << " py: " << particle.py
+                << " pz: " << particle.pz
+                << " e: " << particle.e << std::endl;
+      gSystem->Exit(1);
+    }
+    fastjet::PseudoJet pseudojet(particle.px, particle.py, particle.pz, particle.e);
+    if (m_opt.use_constituent_min_pt && pseudojet.perp() < m_opt.constituent_min_pt)
+    {
+      continue;
+    }
+    pseudojet.set_user_index(ipart);
+    pseudojets.push_back(pseudojet);
+  }
+  return pseudojets;
+}
+
 void FastJetAlgo::first_call_init(JetContainer* jetcont)
 {
   m_first_cluster_call = false;
@@ -250,7 +286,7 @@ void FastJetAlgo::first_call_init(JetContainer* jetcont)
   jetcont->set_jetpar_R(m_opt.jet_R);
 }
 
-void FastJetAlgo::cluster_and_fill(std::vector<Jet*>& particles, JetContainer* jetcont)
+void FastJetAlgo::begin_cluster_and_fill(JetContainer* jetcont, std::size_t nparticles)
 {
   if (m_first_cluster_call)
   {
@@ -264,12 +300,13 @@ void FastJetAlgo::cluster_and_fill(std::vector<Jet*>& particles, JetContainer* j
   }
   if (m_opt.verbosity > 8)
   {
-    std::cout << "   Verbosity>8 #input particles: " << particles.size() << std::endl;
+    std::cout << "   Verbosity>8 #input particles: " << nparticles << std::endl;
   }
+}
 
-  // translate input jets to input fastjets
-  auto pseudojets = jets_to_pseudojets(particles);
-
+template <class InsertComp>
+void FastJetAlgo::cluster_and_fill_pseudojets(std::vector<fastjet::PseudoJet>& pseudojets, JetContainer* jetcont, InsertComp insert_comp)
+{
   // if using constituent subtraction, oberve maximum eta and subtract the constituents
   if (m_opt.cs_calc_constsub)
   {
@@ -389,7 +426,7 @@ void FastJetAlgo::cluster_and_fill(std::vector<Jet*>& particles, JetContainer* j
         //        ++n_clustered;
         if (m_opt.save_jet_components)
         {
-          jet->insert_comp(particles[comp.user_index()]->get_comp_vec(), true);
+          insert_comp(jet, comp.user_index());
         }
       }  // end loop over all constituents
     }
@@ -400,7 +437,7 @@ void FastJetAlgo::cluster_and_fill(std::vector<Jet*>& particles, JetContainer* j
       {
         for (auto& comp : constituents)
         {
-          jet->insert_comp(particles[comp.user_index()]->get_comp_vec(), true);
+          insert_comp(jet, comp.user_index());
         }
       }
     }
@@ -413,6 +450,29 @@ void FastJetAlgo::cluster_and_fill(std::vector<Jet*>& particles, JetContainer* j
   delete (m_opt.calc_area ? m_cluseqarea : m_cluseq);  // if (m_cluseq) delete m_cluseq;
 }
 
+void FastJetAlgo::cluster_and_fill(std::vector<Jet*>& particles, JetContainer* jetcont)
+{
+  begin_cluster_and_fill(jetcont, particles.size());
+
+  // translate input jets to input fastjets
+  auto pseudojets = jets_to_pseudojets(particles);
+
+  cluster_and_fill_pseudojets(pseudojets, jetcont, [&particles](Jet* jet, int index)
+                              { jet->insert_comp(particles[index]->get_comp_vec(), true); });
+}
+
+bool FastJetAlgo::cluster_and_fill_particles(const std::vector<JetInputParticle>& particles, JetContainer* jetcont)
+{
+  begin_cluster_and_fill(jetcont, particles.size());
+
+  // translate input particles to input fastjets
+  auto pseudojets = particles_to_pseudojets(particles);
+
+  cluster_and_fill_pseudojets(pseudojets, jetcont, [&particles](Jet* jet, int index)
+                              { jet->insert_comp(particles[index].src, particles[index].id, true); });
+  return true;
+}
+
 std::vector<Jet*> FastJetAlgo::get_jets(std::vector<Jet*> particles)
 {
   // translate to fastjet
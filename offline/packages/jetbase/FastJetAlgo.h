@@ -4,10 +4,12 @@
 #include "FastJetOptions.h"
 #include "Jet.h"
 #include "JetAlgo.h"
+#include "JetInputParticle.h"
 
 #include <fastjet/JetDefinition.hh>
 #include <fastjet/PseudoJet.hh>
 
+#include <cstddef>   // for size_t
 #include <iostream>  // for cout, ostream
 #include <vector>    // for vector
 
@@ -48,6 +50,7 @@ class FastJetAlgo : public JetAlgo
 
   std::vector<Jet*> get_jets(std::vector<Jet*> particles) override;
   void cluster_and_fill(std::vector<Jet*>& particles, JetContainer* jetcont) override;
+  bool cluster_and_fill_particles(const std::vector<JetInputParticle>& particles, JetContainer* jetcont) override;
 
  private:
   FastJetOptions m_opt{};
@@ -61,6 +64,11 @@ class FastJetAlgo : public JetAlgo
 
   // Internal processes
   std::vector<fastjet::PseudoJet> jets_to_pseudojets(std::vector<Jet*>& particles) const;
+  std::vector<fastjet::PseudoJet> particles_to_pseudojets(const std::vector<JetInputParticle>& particles) const;
+  void begin_cluster_and_fill(JetContainer* jetcont, std::size_t nparticles);
+  // cluster and fill the container. insert_comp(jet, index) adds the components of input index to the jet
+  template <class InsertComp>
+  void cluster_and_fill_pseudojets(std::vector<fastjet::PseudoJet>& pseudojets, JetContainer* jetcont, InsertComp insert_comp);
   std::vector<fastjet::PseudoJet> cluster_jets(std::vector<fastjet::PseudoJet>& pseudojets);
   std::vector<fastjet::PseudoJet> cluster_area_jets(std::vector<fastjet::PseudoJet>& pseudojets);
   float calc_rhomeddens(std::vector<fastjet::PseudoJet>& constituents) const;
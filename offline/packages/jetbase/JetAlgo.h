@@ -2,6 +2,7 @@
 #define JETBASE_JETALGO_H
 
 #include "Jet.h"
+#include "JetInputParticle.h"
 
 #include <limits>
 
@@ -30,6 +31,12 @@ class JetAlgo
   {
   }
 
+  // same, from plain pseudo-particles. Returns false if the algorithm does not support it (use cluster_and_fill)
+  virtual bool cluster_and_fill_particles(const std::vector<JetInputParticle>& /* particles*/, JetContainer* /*clones*/)
+  {
+    return false;
+  }
+
   virtual std::map<Jet::PROPERTY, unsigned int>& property_indices();
 
  protected:
@@ -0,0 +1,28 @@
+#include "JetInput.h"
+
+#include "Jetv2.h"
+
+std::vector<Jet*> JetInput::particles_to_jets(const std::vector<JetInputParticle>& particles)
+{
+  std::vector<Jet*> jets;
+  jets.reserve(particles.size());
+  for (const auto& particle : particles)
+  {
+    Jet* jet = new Jetv2();
+    jet->set_px(particle.px);
+    jet->set_py(particle.py);
+    jet->set_pz(particle.pz);
+    jet->set_e(particle.e);
+    jet->insert_comp(particle.src, particle.id);
+    if (particle.has_t)
+    {
+      if (jet->size_properties() < Jet::PROPERTY::prop_t + 1)
+      {
+        jet->resize_properties(Jet::PROPERTY::prop_t + 1);
+      }
+      jet->set_property(Jet::PROPERTY::prop_t, particle.t);
+    }
+    jets.push_back(jet);
+  }
+  return jets;
+}
@@ -2,6 +2,7 @@
 #define JETBASE_JETINPUT_H
 
 #include "Jet.h"
+#include "JetInputParticle.h"
 
 #include <iostream>
 #include <vector>
@@ -24,6 +25,16 @@ class JetInput
   {
     return std::vector<Jet*>();
   }
+
+  // append plain pseudo-particles, in the same order as get_input, without allocating jets.
+  // Returns false if the input does not support it (use get_input)
+  virtual bool get_particles(PHCompositeNode* /*topNode*/, std::vector<JetInputParticle>& /*particles*/)
+  {
+    return false;
+  }
+  // one new Jet per particle, with the particle kinematics, component and timing. Caller owns the jets
+  static std::vector<Jet*> particles_to_jets(const std::vector<JetInputParticle>& particles);
+
   virtual int Verbosity() const { return m_Verbosity; }
   virtual void Verbosity(int i) { m_Verbosity = i; }
 
@@ -0,0 +1,29 @@
+#ifndef JETBASE_JETINPUTPARTICLE_H
+#define JETBASE_JETINPUTPARTICLE_H
+
+#include "Jet.h"
+
+#include <limits>
+
+// Plain pseudo-particle handed from a JetInput to a JetAlgo.
+// Inputs which support it fill a vector of these once per event instead of
+// allocating one Jet per tower, and algorithms which support it cluster them
+// directly into a JetContainer (see JetInput::get_particles and
+// JetAlgo::cluster_and_fill_particles).
+struct JetInputParticle
+{
+  float px{0};
+  float py{0};
+  float pz{0};
+  float e{0};
+
+  // the single component this particle stands for
+  Jet::SRC src{Jet::VOID};
+  unsigned int id{0};
+
+  // timing, only meaningful if has_t is set (stored as Jet::PROPERTY::prop_t)
+  bool has_t{false};
+  float t{std::numeric_limits<float>::quiet_NaN()};
+};
+
+#endif
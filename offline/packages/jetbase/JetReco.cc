@@ -94,14 +94,29 @@ int JetReco::process_event(PHCompositeNode *topNode)
   // Get Objects off of the Node Tree
   //------------------------------------------------------------------
 
-  std::vector<Jet *> inputs;  // owns memory
+  // plain pseudo-particles if all inputs provide them. They are built once
+  // and shared by all algorithms, jets are only made for those which need them
+  m_particles.clear();
+  m_use_particles = true;
   for (auto &_input : _inputs)
   {
-    std::vector<Jet *> parts = _input->get_input(topNode);
-    for (auto &part : parts)
+    if (!_input->get_particles(topNode, m_particles))
     {
-      inputs.push_back(part);
-      inputs.back()->set_id(inputs.size() - 1);  // unique ids ensured
+      m_use_particles = false;
+      m_particles.clear();
+      break;
+    }
+  }
+  if (!m_use_particles)
+  {
+    for (auto &_input : _inputs)
+    {
+      std::vector<Jet *> parts = _input->get_input(topNode);
+      for (auto &part : parts)
+      {
+        m_inputs.push_back(part);
+        m_inputs.back()->set_id(m_inputs.size() - 1);  // unique ids ensured
+      }
     }
   }
 
@@ -118,7 +133,7 @@ int JetReco::process_event(PHCompositeNode *topNode)
       {
         std::cout << " Verbosity>5:: filling JetContainter for " << JC_name(_outputs[ialgo]) << std::endl;
       }
-      FillJetContainer(topNode, ialgo, inputs);
+      FillJetContainer(topNode, ialgo);
     }
     if (use_jetmap)
     {
@@ -126,7 +141,7 @@ int JetReco::process_event(PHCompositeNode *topNode)
       {
         std::cout << " Verbosity>5:: filling jetnode for " << _outputs[ialgo] << std::endl;
       }
-      std::vector<Jet *> jets = _algos[ialgo]->get_jets(inputs);  // owns memory
+      std::vector<Jet *> jets = _algos[ialgo]->get_jets(get_jet_inputs());  // owns memory
       FillJetNode(topNode, ialgo, jets);
     }
 
@@ -190,11 +205,11 @@ int JetReco::process_event(PHCompositeNode *topNode)
 
   // clean up input vector
   // <- another place where TClonesArray's would make this more efficient
-  for (auto &input : inputs)
+  for (auto &input : m_inputs)
   {
     delete input;
   }
-  inputs.clear();
+  m_inputs.clear();
 
   if (Verbosity() > 1)
   {
@@ -283,7 +298,20 @@ void JetReco::FillJetNode(PHCompositeNode *topNode, int ipos, const std::vector<
   return;
 }
 
-void JetReco::FillJetContainer(PHCompositeNode *topNode, int ipos, std::vector<Jet *> &inputs)
+std::vector<Jet *> &JetReco::get_jet_inputs()
+{
+  if (m_use_particles && m_inputs.empty() && !m_particles.empty())
+  {
+    m_inputs = JetInput::particles_to_jets(m_particles);
+    for (unsigned int i = 0; i < m_inputs.size(); ++i)
+    {
+      m_inputs[i]->set_id(i);  // unique ids ensured
+    }
+  }
+  return m_inputs;
+}
+
+void JetReco::FillJetContainer(PHCompositeNode *topNode, int ipos)
 {
   JetContainer *jetconn = findNode::getClass<JetContainer>(topNode, JC_name(_outputs[ipos]));
   if (!jetconn)
@@ -292,7 +320,11 @@ void JetReco::FillJetContainer(PHCompositeNode *topNode, int ipos, std::vector<J
     exit(-1);
   }
   jetconn->Reset();
-  _algos[ipos]->cluster_and_fill(inputs, jetconn);  // fills the jet container with clustered jets
+  // fills the jet container with clustered jets, straight from the particles if the algorithm supports it
+  if (!m_use_particles || !_algos[ipos]->cluster_and_fill_particles(m_particles, jetconn))
+  {
+    _algos[ipos]->cluster_and_fill(get_jet_inputs(), jetconn);
+  }
   for (auto &_input : _inputs)
   {
     jetconn->insert_src(_input->get_src());
@@ -10,6 +10,8 @@
 // PHENIX includes
 #include <fun4all/SubsysReco.h>
 
+#include "JetInputParticle.h"
+
 // standard includes
 #include <string>  // for string
 #include <vector>
@@ -61,7 +63,9 @@ class JetReco : public SubsysReco
  private:
   int CreateNodes(PHCompositeNode *topNode);
   void FillJetNode(PHCompositeNode *topNode, int ipos, const std::vector<Jet *> &jets);
-  void FillJetContainer(PHCompositeNode *topNode, int ipos, std::vector<Jet *> &inputs);
+  void FillJetContainer(PHCompositeNode *topNode, int ipos);
+  // input jets, made from the particles on first use in the event
+  std::vector<Jet *> &get_jet_inputs();
 
   std::vector<JetInput *> _inputs;
   std::vector<JetAlgo *> _algos;
@@ -69,6 +73,11 @@ class JetReco : public SubsysReco
   std::string _inputnode;
   std::vector<std::string> _outputs;
 
+  // per event inputs, shared by all algorithms
+  bool m_use_particles{false};
+  std::vector<JetInputParticle> m_particles;
+  std::vector<Jet *> m_inputs;  // owns memory
+
   // transition functions, while moving from JetMap to JetContainer.
   // May be removed after transition is made, depending on state of
   // functions
@@ -2,6 +2,7 @@
 
 #include "Jet.h"
 #include "Jetv2.h"
+#include "TowerJetInputCache.h"
 
 #include <calobase/RawTower.h>
 #include <calobase/RawTowerContainer.h>
@@ -13,12 +14,17 @@
 #include <globalvertex/GlobalVertexv3.h>
 #include <globalvertex/GlobalVertexMapv1.h>
 
+#include <phool/PHCompositeNode.h>
+#include <phool/PHDataNode.h>
+#include <phool/PHNodeIterator.h>
 #include <phool/getClass.h>
 
 #include <cassert>
 #include <cmath>  // for asinh, atan2, cos, cosh
+#include <cstdint>  // for uintptr_t
 #include <iostream>
 #include <map>      // for _Rb_tree_const_iterator
+#include <string>
 #include <utility>  // for pair
 #include <vector>
 
@@ -58,7 +64,7 @@ void TowerJetInput::identify(std::ostream &os)
   os << std::endl;
 }
 
-std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
+bool TowerJetInput::get_particles(PHCompositeNode *topNode, std::vector<JetInputParticle> &particles)
 {
   if (Verbosity() > 0)
   {
@@ -71,7 +77,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     std::cout << "TowerJetInput::get_input - Fatal Error - GlobalVertexMap node is missing. Please turn on the do_global flag in the main macro in order to reconstruct the global vertex." << std::endl;
     assert(vertexmap);  // force quit
 
-    return std::vector<Jet *>();
+    return true;
   }
   if (vertexmap->empty())
   {
@@ -166,7 +172,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_CEMC");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return true;
     }
   }
   else if (m_input == Jet::CEMC_TOWERINFO)
@@ -178,7 +184,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geocaloid = RawTowerDefs::CalorimeterId::CEMC;
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return true;
     }
   }
   else if (m_input == Jet::CEMC_TOWERINFO_EMBED)
@@ -190,7 +196,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geocaloid = RawTowerDefs::CalorimeterId::CEMC;
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return true;
     }
   }
   else if (m_input == Jet::CEMC_TOWERINFO_SIM)
@@ -202,7 +208,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geocaloid = RawTowerDefs::CalorimeterId::CEMC;
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return true;
     }
   }
   else if (m_input == Jet::EEMC_TOWER)
@@ -211,7 +217,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_EEMC");
     if ((!towers && !towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return true;
     }
   }
   else if (m_input == Jet::HCALIN_TOWER)
@@ -220,7 +226,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return true;
     }
   }
   else if (m_input == Jet::HCALIN_TOWERINFO)
@@ -232,7 +238,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return true;
     }
   }
   else if (m_input == Jet::HCALIN_TOWERINFO_EMBED)
@@ -244,7 +250,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geocaloid = RawTowerDefs::CalorimeterId::HCALIN;
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return true;
     }
   }
   else if (m_input == Jet::HCALIN_TOWERINFO_SIM)
@@ -256,7 +262,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geocaloid = RawTowerDefs::CalorimeterId::HCALIN;
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return true;
     }
   }
   else if (m_input == Jet::HCALOUT_TOWER)
@@ -265,7 +271,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALOUT");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return true;
     }
   }
   else if (m_input == Jet::HCALOUT_TOWERINFO)
@@ -277,7 +283,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALOUT");
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return true;
     }
   }
   else if (m_input == Jet::HCALOUT_TOWERINFO_EMBED)
@@ -289,7 +295,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geocaloid = RawTowerDefs::CalorimeterId::HCALOUT;
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return true;
     }
   }
   else if (m_input == Jet::HCALOUT_TOWERINFO_SIM)
@@ -301,7 +307,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geocaloid = RawTowerDefs::CalorimeterId::HCALOUT;
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return true;
     }
   }
 
@@ -311,7 +317,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_FEMC");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return true;
     }
   }
   else if (m_input == Jet::FHCAL_TOWER)
@@ -320,7 +326,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_FHCAL");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return true;
     }
   }
   else if (m_input == Jet::CEMC_TOWER_RETOWER)
@@ -329,7 +335,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return true;
     }
   }
   else if (m_input == Jet::CEMC_TOWERINFO_RETOWER)
@@ -341,7 +347,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return true;
     }
   }
   else if (m_input == Jet::CEMC_TOWER_SUB1)
@@ -350,7 +356,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return true;
     }
   }
   else if (m_input == Jet::CEMC_TOWERINFO_SUB1)
@@ -362,7 +368,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return true;
     }
   }
   else if (m_input == Jet::HCALIN_TOWER_SUB1)
@@ -371,7 +377,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return true;
     }
   }
   else if (m_input == Jet::HCALIN_TOWERINFO_SUB1)
@@ -383,7 +389,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return true;
     }
   }
   else if (m_input == Jet::HCALOUT_TOWER_SUB1)
@@ -392,7 +398,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALOUT");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return true;
     }
   }
   else if (m_input == Jet::HCALOUT_TOWERINFO_SUB1)
@@ -404,7 +410,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALOUT");
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return true;
     }
   }
   else if (m_input == Jet::CEMC_TOWER_SUB1CS)
@@ -413,7 +419,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return true;
     }
   }
   else if (m_input == Jet::HCALIN_TOWER_SUB1CS)
@@ -422,7 +428,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return true;
     }
   }
   else if (m_input == Jet::HCALOUT_TOWER_SUB1CS)
@@ -431,45 +437,41 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALOUT");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return true;
     }
   }
   else
   {
-    return std::vector<Jet *>();
+    return true;
   }
 
   // for those cases we need to use the EMCal R and IHCal eta phi to calculate the vertex correction
-  if (m_input == Jet::CEMC_TOWER_RETOWER || m_input == Jet::CEMC_TOWERINFO_RETOWER || m_input == Jet::CEMC_TOWER_SUB1 || m_input == Jet::CEMC_TOWERINFO_SUB1 || m_input == Jet::CEMC_TOWER_SUB1CS)
+  const bool use_EMCal_radius = (m_input == Jet::CEMC_TOWER_RETOWER || m_input == Jet::CEMC_TOWERINFO_RETOWER || m_input == Jet::CEMC_TOWER_SUB1 || m_input == Jet::CEMC_TOWERINFO_SUB1 || m_input == Jet::CEMC_TOWER_SUB1CS);
+  if (use_EMCal_radius)
   {
     EMCal_geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_CEMC");
     if (!EMCal_geom)
     {
-      return std::vector<Jet *>();
+      return true;
     }
   }
 
-  // first grab the event vertex or bail
-
-
-  std::vector<Jet *> pseudojets;
   if (m_use_towerinfo)
   {
     if (!towerinfos)
     {
-      return std::vector<Jet *>();
+      return true;
     }
 
+    const TowerJetInputCache::Entry &entry = get_factors(topNode, towerinfos, geom, EMCal_geom, vtxz);
+
     unsigned int nchannels = towerinfos->size();
+    particles.reserve(particles.size() + nchannels);
     for (unsigned int channel = 0; channel < nchannels; channel++)
     {
       TowerInfo *tower = towerinfos->get_tower_at_channel(channel);
       assert(tower);
 
-      unsigned int calokey = towerinfos->encode_key(channel);
-      int ieta = towerinfos->getTowerEtaBin(calokey);
-      int iphi = towerinfos->getTowerPhiBin(calokey);
-      const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid(geocaloid, ieta, iphi);
       // skip masked towers
       if (!tower->get_isGood())
       {
@@ -479,51 +481,37 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
       {
         continue;
       }
-      RawTowerGeom *tower_geom = geom->get_tower_geometry(key);
-      assert(tower_geom);
-      double r = tower_geom->get_center_radius();
-      if (m_input == Jet::CEMC_TOWER_RETOWER || m_input == Jet::CEMC_TOWERINFO_RETOWER || m_input == Jet::CEMC_TOWER_SUB1 || m_input == Jet::CEMC_TOWERINFO_SUB1 || m_input == Jet::CEMC_TOWER_SUB1CS)
-      {
-        const RawTowerDefs::keytype EMCal_key = RawTowerDefs::encode_towerid(RawTowerDefs::CalorimeterId::CEMC, 0, 0);
-        RawTowerGeom *EMCal_tower_geom = EMCal_geom->get_tower_geometry(EMCal_key);
-        assert(EMCal_tower_geom);
-        r = EMCal_tower_geom->get_center_radius();
-      }
-      double phi = atan2(tower_geom->get_center_y(), tower_geom->get_center_x());
-      double towereta = tower_geom->get_eta();
-      double z0 = sinh(towereta) * r;
-      double z = z0 - vtxz;
-      double eta = asinh(z / r);  // eta after shift from vertex
-      double pt = tower->get_energy() / cosh(eta);
+      const TowerJetInputCache::Factors &factors = entry.factors[channel];
+      assert(factors.valid);
       double e = tower->get_energy();
-      double px = pt * cos(phi);
-      double py = pt * sin(phi);
-      double pz = pt * sinh(eta);
+      double pt = e / factors.cosh_eta;
 
-      Jet *jet = new Jetv2();
-      jet->set_px(px);
-      jet->set_py(py);
-      jet->set_pz(pz);
-      jet->set_e(e);
-      jet->insert_comp(m_input, channel);
-      float tower_t = 17.6*tower->get_time(); // 17.6 ns/sample and get_time() returns t in samples
-      if(jet->size_properties() < Jet::PROPERTY::prop_t+1)
-	{
-	  jet->resize_properties(Jet::PROPERTY::prop_t + 1);
-	}
-      if(e > m_timing_e_threshold)
-	{
-	  jet->set_property(Jet::PROPERTY::prop_t, tower_t);
-	}
-      else
-	{
-	  jet->set_property(Jet::PROPERTY::prop_t, std::numeric_limits<float>::quiet_NaN());
-	}
-      pseudojets.push_back(jet);
+      JetInputParticle particle;
+      particle.px = pt * factors.cos_phi;
+      particle.py = pt * factors.sin_phi;
+      particle.pz = pt * factors.sinh_eta;
+      particle.e = e;
+      particle.src = m_input;
+      particle.id = channel;
+      particle.has_t = true;
+      if (e > m_timing_e_threshold)
+      {
+        particle.t = 17.6 * tower->get_time();  // 17.6 ns/sample and get_time() returns t in samples
+      }
+      particles.push_back(particle);
     }
   }
   else
   {
+    double EMCal_r = 0;
+    if (use_EMCal_radius)
+    {
+      const RawTowerDefs::keytype EMCal_key = RawTowerDefs::encode_towerid(RawTowerDefs::CalorimeterId::CEMC, 0, 0);
+      RawTowerGeom *EMCal_tower_geom = EMCal_geom->get_tower_geometry(EMCal_key);
+      assert(EMCal_tower_geom);
+      EMCal_r = EMCal_tower_geom->get_center_radius();
+    }
+
     RawTowerContainer::ConstRange begin_end = towers->getTowers();
     RawTowerContainer::ConstIterator rtiter;
     for (rtiter = begin_end.first; rtiter != begin_end.second; ++rtiter)
@@ -533,36 +521,103 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
       RawTowerGeom *tower_geom = geom->get_tower_geometry(tower->get_key());
       assert(tower_geom);
 
-      double r = tower_geom->get_center_radius();
-      if (m_input == Jet::CEMC_TOWER_RETOWER || m_input == Jet::CEMC_TOWERINFO_RETOWER || m_input == Jet::CEMC_TOWER_SUB1 || m_input == Jet::CEMC_TOWERINFO_SUB1 || m_input == Jet::CEMC_TOWER_SUB1CS)
-      {
-        const RawTowerDefs::keytype EMCal_key = RawTowerDefs::encode_towerid(RawTowerDefs::CalorimeterId::CEMC, 0, 0);
-        RawTowerGeom *EMCal_tower_geom = EMCal_geom->get_tower_geometry(EMCal_key);
-        assert(EMCal_tower_geom);
-        r = EMCal_tower_geom->get_center_radius();
-      }
+      double r = (use_EMCal_radius ? EMCal_r : tower_geom->get_center_radius());
       double phi = atan2(tower_geom->get_center_y(), tower_geom->get_center_x());
       double towereta = tower_geom->get_eta();
       double z0 = sinh(towereta) * r;
       double z = z0 - vtxz;
       double eta = asinh(z / r);  // eta after shift from vertex
       double pt = tower->get_energy() / cosh(eta);
-      double px = pt * cos(phi);
-      double py = pt * sin(phi);
-      double pz = pt * sinh(eta);
 
-      Jet *jet = new Jetv2();
-      jet->set_px(px);
-      jet->set_py(py);
-      jet->set_pz(pz);
-      jet->set_e(tower->get_energy());
-      jet->insert_comp(m_input, tower->get_id());
-      pseudojets.push_back(jet);
+      JetInputParticle particle;
+      particle.px = pt * cos(phi);
+      particle.py = pt * sin(phi);
+      particle.pz = pt * sinh(eta);
+      particle.e = tower->get_energy();
+      particle.src = m_input;
+      particle.id = tower->get_id();
+      particles.push_back(particle);
     }
   }
   if (Verbosity() > 0)
   {
     std::cout << "TowerJetInput::process_event -- exited" << std::endl;
   }
-  return pseudojets;
+  return true;
+}
+
+const TowerJetInputCache::Entry &TowerJetInput::get_factors(PHCompositeNode *topNode, TowerInfoContainer *towerinfos,
+                                                            RawTowerGeomContainer *geom, RawTowerGeomContainer *EMCal_geom, float vtxz)
+{
+  // the factors only depend on the geometry, the channel mapping of the container and the vertex.
+  // Geometry containers live for the whole run, so their address identifies them within an event
+  const std::string key = std::to_string(reinterpret_cast<uintptr_t>(geom)) + (EMCal_geom ? "_EMCALR" : "") +
+                          "_" + std::to_string(geocaloid) +
+                          "_" + std::to_string(towerinfos->get_detectorid()) +
+                          "_" + std::to_string(towerinfos->size());
+
+  TowerJetInputCache *cache = findNode::getClass<TowerJetInputCache>(topNode, TowerJetInputCache::nodeName);
+  if (!cache)
+  {
+    PHNodeIterator iter(topNode);
+    PHCompositeNode *dstNode = dynamic_cast<PHCompositeNode *>(iter.findFirst("PHCompositeNode", "DST"));
+    if (dstNode)
+    {
+      // transient node, reset at the end of every event
+      cache = new TowerJetInputCache;
+      dstNode->addNode(new PHDataNode<TowerJetInputCache>(cache, TowerJetInputCache::nodeName, "PHObject"));
+    }
+  }
+  TowerJetInputCache::Entry &entry = cache ? cache->get(key) : m_factors;
+  if (entry.valid && entry.vtxz == vtxz)
+  {
+    return entry;
+  }
+
+  double EMCal_r = 0;
+  if (EMCal_geom)
+  {
+    const RawTowerDefs::keytype EMCal_key = RawTowerDefs::encode_towerid(RawTowerDefs::CalorimeterId::CEMC, 0, 0);
+    RawTowerGeom *EMCal_tower_geom = EMCal_geom->get_tower_geometry(EMCal_key);
+    assert(EMCal_tower_geom);
+    EMCal_r = EMCal_tower_geom->get_center_radius();
+  }
+
+  unsigned int nchannels = towerinfos->size();
+  entry.factors.assign(nchannels, TowerJetInputCache::Factors());
+  for (unsigned int channel = 0; channel < nchannels; channel++)
+  {
+    unsigned int calokey = towerinfos->encode_key(channel);
+    int ieta = towerinfos->getTowerEtaBin(calokey);
+    int iphi = towerinfos->getTowerPhiBin(calokey);
+    const RawTowerDefs::keytype towerkey = RawTowerDefs::encode_towerid(geocaloid, ieta, iphi);
+    RawTowerGeom *tower_geom = geom->get_tower_geometry(towerkey);
+    if (!tower_geom)
+    {
+      continue;
+    }
+    double r = (EMCal_geom ? EMCal_r : tower_geom->get_center_radius());
+    double phi = atan2(tower_geom->get_center_y(), tower_geom->get_center_x());
+    double towereta = tower_geom->get_eta();
+    double z0 = sinh(towereta) * r;
+    double z = z0 - vtxz;
+    double eta = asinh(z / r);  // eta after shift from vertex
+
+    TowerJetInputCache::Factors &factors = entry.factors[channel];
+    factors.cosh_eta = cosh(eta);
+    factors.sinh_eta = sinh(eta);
+    factors.cos_phi = cos(phi);
+    factors.sin_phi = sin(phi);
+    factors.valid = true;
+  }
+  entry.vtxz = vtxz;
+  entry.valid = true;
+  return entry;
+}
+
+std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
+{
+  std::vector<JetInputParticle> particles;
+  get_particles(topNode, particles);
+  return particles_to_jets(particles);
 }
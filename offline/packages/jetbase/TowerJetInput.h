@@ -3,6 +3,8 @@
 
 #include "Jet.h"
 #include "JetInput.h"
+#include "JetInputParticle.h"
+#include "TowerJetInputCache.h"
 
 #include <calobase/RawTowerDefs.h>
 #include <globalvertex/GlobalVertex.h>
@@ -13,6 +15,8 @@
 // forward declarations
 class PHCompositeNode;
 class GlobalVertex;
+class RawTowerGeomContainer;
+class TowerInfoContainer;
 class TowerJetInput : public JetInput
 {
  public:
@@ -24,6 +28,7 @@ class TowerJetInput : public JetInput
   Jet::SRC get_src() override { return m_input; }
 
   std::vector<Jet*> get_input(PHCompositeNode* topNode) override;
+  bool get_particles(PHCompositeNode* topNode, std::vector<JetInputParticle>& particles) override;
 
   void reset_GlobalVertexType()
   {
@@ -59,6 +64,10 @@ class TowerJetInput : public JetInput
   void set_timing_e_threshold(float new_threshold) { m_timing_e_threshold = new_threshold; }
 
  private:
+  // per tower kinematic factors for the current event, shared through the TowerJetInputCache node
+  const TowerJetInputCache::Entry& get_factors(PHCompositeNode* topNode, TowerInfoContainer* towerinfos,
+                                               RawTowerGeomContainer* geom, RawTowerGeomContainer* EMCal_geom, float vtxz);
+
   Jet::SRC m_input;
   RawTowerDefs::CalorimeterId geocaloid{RawTowerDefs::CalorimeterId::NONE};
   bool m_use_towerinfo {false};
@@ -67,6 +76,8 @@ class TowerJetInput : public JetInput
   bool m_use_vertextype {false};
   std::vector<GlobalVertex::VTXTYPE> m_vertex_type{GlobalVertex::UNDEFINED};
   float m_timing_e_threshold{0.1};
+  // used when there is no DST node to attach the shared cache to
+  TowerJetInputCache::Entry m_factors;
 };
 
 #endif
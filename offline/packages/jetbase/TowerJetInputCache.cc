@@ -0,0 +1,20 @@
+#include "TowerJetInputCache.h"
+
+void TowerJetInputCache::identify(std::ostream &os) const
+{
+  os << "TowerJetInputCache - entries: " << m_entries.size() << std::endl;
+  for (const auto &[key, entry] : m_entries)
+  {
+    os << "   " << key << " valid: " << entry.valid << " vtxz: " << entry.vtxz
+       << " towers: " << entry.factors.size() << std::endl;
+  }
+}
+
+void TowerJetInputCache::Reset()
+{
+  // keep the allocations from one event to the next
+  for (auto &[key, entry] : m_entries)
+  {
+    entry.valid = false;
+  }
+}
@@ -0,0 +1,56 @@
+#ifndef JETBASE_TOWERJETINPUTCACHE_H
+#define JETBASE_TOWERJETINPUTCACHE_H
+
+#include <phool/PHObject.h>
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+// Transient per event cache of the tower kinematic factors used by TowerJetInput.
+//
+// The direction of a tower seen from the event vertex only depends on the tower
+// geometry and on the vertex z, so all TowerJetInputs reading towers with the same
+// geometry in an event (e.g. the unsubtracted, retowered and subtracted towers used
+// by the jet reconstruction and background modules) share one set of factors.
+// Entries are indexed by tower channel and store the vertex z they were built for,
+// so they are rebuilt if the vertex changes within an event.
+// The cache lives in a PHDataNode below DST and is reset at the end of every event.
+class TowerJetInputCache : public PHObject
+{
+ public:
+  // per tower factors, px = e / cosh_eta * cos_phi etc.
+  struct Factors
+  {
+    double cosh_eta{1};
+    double sinh_eta{0};
+    double cos_phi{1};
+    double sin_phi{0};
+    bool valid{false};  // false if the tower has no geometry
+  };
+
+  struct Entry
+  {
+    float vtxz{0};
+    bool valid{false};
+    std::vector<Factors> factors;
+  };
+
+  static constexpr const char *nodeName = "TowerJetInputCache";
+
+  TowerJetInputCache() = default;
+  ~TowerJetInputCache() override = default;
+
+  void identify(std::ostream &os = std::cout) const override;
+  int isValid() const override { return 1; }
+  void Reset() override;
+
+  // entry for a given geometry key, created empty if needed
+  Entry &get(const std::string &key) { return m_entries[key]; }
+
+ private:
+  std::map<std::string, Entry> m_entries;
+};
+
+#endif
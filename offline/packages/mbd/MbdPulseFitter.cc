@@ -0,0 +1,214 @@
+#include "MbdPulseFitter.h"
+
+#include <cmath>
+#include <limits>
+
+void MbdPulseFitter::SetTemplate(const std::vector<float> *shape, const int npts, const double begintime, const double endtime)
+{
+  m_shape = shape;
+  m_npts = npts;
+  m_begintime = begintime;
+  m_endtime = endtime;
+  m_step = 1.;
+  if (m_npts > 1)
+  {
+    m_step = (m_endtime - m_begintime) / (m_npts - 1);
+  }
+}
+
+double MbdPulseFitter::Template(const double xx) const
+{
+  if (xx < m_begintime)
+  {
+    return (*m_shape)[0];
+  }
+  if (xx > m_endtime)
+  {
+    return (*m_shape)[m_npts - 1];
+  }
+
+  const double index = (xx - m_begintime) / m_step;
+  int ilow = static_cast<int>(std::floor(index));
+  int ihigh = static_cast<int>(std::ceil(index));
+  if (ilow < 0)
+  {
+    ilow = 0;
+  }
+  else if (ihigh >= m_npts)
+  {
+    ihigh = m_npts - 1;
+  }
+
+  if (ilow == ihigh)
+  {
+    return (*m_shape)[ilow];
+  }
+
+  const double x0 = m_begintime + ilow * m_step;
+  const double y0 = (*m_shape)[ilow];
+  const double x1 = m_begintime + ihigh * m_step;
+  const double y1 = (*m_shape)[ihigh];
+  return y0 + ((y1 - y0) / (x1 - x0)) * (xx - x0);
+}
+
+MbdPulseFitter::Sums MbdPulseFitter::Accumulate(const double *x, const double *y, const double *raw, const int n,
+                                                 const double xmin, const double xmax, const double t) const
+{
+  Sums s;
+  for (int i = 0; i < n; i++)
+  {
+    if (x[i] < xmin || x[i] > xmax)
+    {
+      continue;
+    }
+
+    // outside of the good part of the template
+    const double xx = x[i] - t;
+    if (xx < m_begintime || xx > m_endtime || std::isnan(xx))
+    {
+      continue;
+    }
+
+    // saturated adc
+    const int samp_point = static_cast<int>(x[i]);
+    if (raw != nullptr && samp_point >= 0 && samp_point < n && raw[samp_point] > adc_saturation)
+    {
+      continue;
+    }
+
+    const double tval = Template(xx);
+    s.syy += y[i] * y[i];
+    s.syt += y[i] * tval;
+    s.stt += tval * tval;
+    s.npts++;
+  }
+  return s;
+}
+
+// unnormalized chi2 at the best amplitude
+double MbdPulseFitter::Chi2(const Sums &s)
+{
+  if (s.npts == 0 || s.stt <= 0.)
+  {
+    return std::numeric_limits<double>::max();
+  }
+  const double chi2 = s.syy - (s.syt * s.syt / s.stt);
+  return (chi2 > 0.) ? chi2 : 0.;
+}
+
+MbdPulseFitter::Result MbdPulseFitter::FitTemplate(const double *x, const double *y, const double *raw, const int n,
+                                                   const double sigma, const double xmin, const double xmax,
+                                                   const double time0, const double window) const
+{
+  Result result;
+  result.time = time0;
+  if (m_shape == nullptr || m_npts < 2 || static_cast<int>(m_shape->size()) < m_npts || n <= 0)
+  {
+    return result;
+  }
+
+  // scan the template grid around the seed
+  const int nsteps = static_cast<int>(std::ceil(window / m_step));
+  double best_t = time0;
+  double best_chi2 = std::numeric_limits<double>::max();
+  for (int istep = -nsteps; istep <= nsteps; istep++)
+  {
+    const double t = time0 + istep * m_step;
+    const double chi2 = Chi2(Accumulate(x, y, raw, n, xmin, xmax, t));
+    if (chi2 < best_chi2)
+    {
+      best_chi2 = chi2;
+      best_t = t;
+    }
+  }
+
+  if (best_chi2 == std::numeric_limits<double>::max())
+  {
+    return result;
+  }
+
+  // golden section refinement within the neighbouring grid steps
+  static const double invphi = 0.5 * (std::sqrt(5.) - 1.);
+  double a = best_t - m_step;
+  double b = best_t + m_step;
+  double c = b - invphi * (b - a);
+  double d = a + invphi * (b - a);
+  double fc = Chi2(Accumulate(x, y, raw, n, xmin, xmax, c));
+  double fd = Chi2(Accumulate(x, y, raw, n, xmin, xmax, d));
+  for (int iter = 0; iter < 20; iter++)
+  {
+    if (fc < fd)
+    {
+      b = d;
+      d = c;
+      fd = fc;
+      c = b - invphi * (b - a);
+      fc = Chi2(Accumulate(x, y, raw, n, xmin, xmax, c));
+    }
+    else
+    {
+      a = c;
+      c = d;
+      fc = fd;
+      d = a + invphi * (b - a);
+      fd = Chi2(Accumulate(x, y, raw, n, xmin, xmax, d));
+    }
+  }
+  const double t_refined = 0.5 * (a + b);
+  const Sums s_refined = Accumulate(x, y, raw, n, xmin, xmax, t_refined);
+  if (Chi2(s_refined) < best_chi2)
+  {
+    best_t = t_refined;
+  }
+
+  const Sums s = Accumulate(x, y, raw, n, xmin, xmax, best_t);
+  const double sig2 = (sigma > 0.) ? sigma * sigma : 1.;
+  result.ampl = s.syt / s.stt;
+  result.time = best_t;
+  result.chi2 = Chi2(s) / sig2;
+  result.ndf = s.npts - 2;
+  result.valid = true;
+
+  return result;
+}
+
+MbdPulseFitter::Result MbdPulseFitter::FitConstant(const double *x, const double *y, const int n,
+                                                   const double sigma, const double xmin, const double xmax)
+{
+  Result result;
+
+  double sum{0.};
+  int npts{0};
+  for (int i = 0; i < n; i++)
+  {
+    if (x[i] < xmin || x[i] > xmax)
+    {
+      continue;
+    }
+    sum += y[i];
+    npts++;
+  }
+  if (npts == 0)
+  {
+    return result;
+  }
+
+  const double mean = sum / npts;
+  double chi2{0.};
+  for (int i = 0; i < n; i++)
+  {
+    if (x[i] < xmin || x[i] > xmax)
+    {
+      continue;
+    }
+    chi2 += (y[i] - mean) * (y[i] - mean);
+  }
+
+  const double sig2 = (sigma > 0.) ? sigma * sigma : 1.;
+  result.ampl = mean;
+  result.chi2 = chi2 / sig2;
+  result.ndf = npts - 1;
+  result.valid = true;
+
+  return result;
+}
@@ -0,0 +1,66 @@
+#ifndef MBD_MBDPULSEFITTER_H
+#define MBD_MBDPULSEFITTER_H
+
+#include <vector>
+
+/**
+ * Closed-form least-squares fits of MBD waveforms, operating directly
+ * on the sample arrays.
+ *
+ * For a fixed start time the template fit is linear in the amplitude,
+ * so ampl = sum(y*T)/sum(T*T) and the chi2 follows from the same sums.
+ * The start time is found by scanning the tabulated template grid around
+ * the seed and refining the best bin with a golden section search.
+ * Points are included/rejected the same way as in MbdSig::TemplateFcn.
+ */
+class MbdPulseFitter
+{
+ public:
+  struct Result
+  {
+    double ampl{0.};
+    double time{0.};
+    double chi2{0.};
+    double ndf{0.};
+    bool valid{false};
+  };
+
+  static constexpr double adc_saturation = 16370.;
+
+  /// template is not copied, it must outlive the fitter
+  void SetTemplate(const std::vector<float> *shape, const int npts, const double begintime, const double endtime);
+
+  /// fit ampl*T(x-t) to y over [xmin,xmax], searching t within time0 +- window
+  /// raw is used to reject saturated samples, sigma is the uniform point error
+  Result FitTemplate(const double *x, const double *y, const double *raw, const int n,
+                     const double sigma, const double xmin, const double xmax,
+                     const double time0, const double window = 3.0) const;
+
+  /// fit of a constant to y over [xmin,xmax] with uniform errors sigma
+  static Result FitConstant(const double *x, const double *y, const int n,
+                            const double sigma, const double xmin, const double xmax);
+
+  /// linearly interpolated template, same as MbdSig::TemplateFcn for ampl=1
+  double Template(const double xx) const;
+
+ private:
+  struct Sums
+  {
+    double syy{0.};
+    double syt{0.};
+    double stt{0.};
+    int npts{0};
+  };
+
+  Sums Accumulate(const double *x, const double *y, const double *raw, const int n,
+                  const double xmin, const double xmax, const double t) const;
+  static double Chi2(const Sums &s);
+
+  const std::vector<float> *m_shape{nullptr};
+  double m_begintime{0.};
+  double m_endtime{0.};
+  double m_step{1.};
+  int m_npts{0};
+};
+
+#endif  // MBD_MBDPULSEFITTER_H
@@ -703,9 +703,23 @@ int MbdSig::CalcEventPed0_PreSamp(const int presample, const int nsamps)
   ped_fcn->SetRange(minsamp-0.1,maxsamp+0.1);
   ped_fcn->SetParameter(0,1500.);
 
-  gRawPulse->Fit( ped_fcn, "RNQ" );
-  double chi2 = ped_fcn->GetChisquare();
-  double ndf = ped_fcn->GetNDF();
+  double chi2{0.};
+  double ndf{0.};
+  if ( _fastfit )
+  {
+    // the constant fit is the mean of the samples in range
+    MbdPulseFitter::Result pedfit = MbdPulseFitter::FitConstant( gRawPulse->GetX(), gRawPulse->GetY(), gRawPulse->GetN(),
+                                                                 gRawPulse->GetErrorY(minsamp), minsamp-0.1, maxsamp+0.1 );
+    ped_fcn->SetParameter(0,pedfit.ampl);
+    chi2 = pedfit.chi2;
+    ndf = pedfit.ndf;
+  }
+  else
+  {
+    gRawPulse->Fit( ped_fcn, "RNQ" );
+    chi2 = ped_fcn->GetChisquare();
+    ndf = ped_fcn->GetNDF();
+  }
 
   /*
   if ( chi2/ndf>4 )
@@ -1362,27 +1376,23 @@ int MbdSig::FitTemplate( const Int_t sampmax )
   }
 
   // Start with fit over early part of waveform to reduce pileup and afterpulse effects
-  template_fcn->SetParameters(ymax, x_at_max);
-  if ( nsaturated==0 )
-  {
-    template_fcn->SetRange(0, x_at_max+4.2);
-    f_fitmode = 1;
-  }
-  else
+  Double_t fit_xmax = x_at_max+4.2;
+  f_fitmode = 1;
+  if ( nsaturated>0 )
   {
-    template_fcn->SetRange(0, sampmax + nsaturated + 0.5);
+    fit_xmax = sampmax + nsaturated + 0.5;
     f_fitmode = 4;
   }
 
-  if (_verbose == 0)
+  if (_verbose > 0)
   {
-    //std::cout << PHWHERE << std::endl;
-    gSubPulse->Fit(template_fcn, "RNQ");
+    std::cout << "doing fit1 " << x_at_max << "\t" << ymax << std::endl;
   }
-  else
+
+  MbdPulseFitter::Result fit1 = FitTemplateRange(fit_xmax, ymax, x_at_max);
+
+  if (_verbose > 0)
   {
-    std::cout << "doing fit1 " << x_at_max << "\t" << ymax << std::endl;
-    gSubPulse->Fit(template_fcn, "R");
     gSubPulse->Draw("ap");
     gSubPulse->GetHistogram()->SetTitle(gSubPulse->GetName());
     gPad->SetGridy(1);
@@ -1391,10 +1401,10 @@ int MbdSig::FitTemplate( const Int_t sampmax )
   }
 
   // Get fit parameters
-  f_ampl = template_fcn->GetParameter(0);
-  f_time = template_fcn->GetParameter(1);
-  f_chi2 = template_fcn->GetChisquare();
-  f_ndf = template_fcn->GetNDF();
+  f_ampl = fit1.ampl;
+  f_time = fit1.time;
+  f_chi2 = fit1.chi2;
+  f_ndf = fit1.ndf;
   Double_t chi2ndf = 1e9;
   if ( f_ndf>0. )
   {
@@ -1507,31 +1517,25 @@ int MbdSig::FitTemplate( const Int_t sampmax )
   }
 
   // Try a refit of saturated waveform with different range
-  template_fcn->SetParameters(ymax, x_at_max);
-  template_fcn->SetRange( 0., _nsamples-0.5 );
-
-  if (_verbose == 0)
+  if (_verbose > 0)
   {
-    //std::cout << PHWHERE << std::endl;
-    gSubPulse->Fit(template_fcn, "RNQ");
+    std::cout << "ampl time before refit " << f_ampl << "\t" << f_time << std::endl;
   }
-  else
+
+  MbdPulseFitter::Result fit2 = FitTemplateRange(_nsamples-0.5, ymax, x_at_max);
+
+  if (_verbose > 0)
   {
-    gSubPulse->Fit(template_fcn, "R");
-    //gSubPulse->Print("ALL");
-    std::cout << "ampl time before refit " << f_ampl << "\t" << f_time << std::endl;
-    f_ampl = template_fcn->GetParameter(0);
-    f_time = template_fcn->GetParameter(1);
-    std::cout << "ampl time after  refit " << f_ampl << "\t" << f_time << std::endl;
+    std::cout << "ampl time after  refit " << fit2.ampl << "\t" << fit2.time << std::endl;
   }
 
   // pick lower chi2/ndf of two saturated fits
-  Double_t newchi2 = template_fcn->GetChisquare();
-  Double_t newndf = template_fcn->GetNDF();
+  Double_t newchi2 = fit2.chi2;
+  Double_t newndf = fit2.ndf;
   if ( (newchi2/newndf)<f_chi2/f_ndf )
   {
-    f_ampl = template_fcn->GetParameter(0);
-    f_time = template_fcn->GetParameter(1);
+    f_ampl = fit2.ampl;
+    f_time = fit2.time;
     f_chi2 = newchi2;
     f_ndf = newndf;
     f_fitmode = 5;
@@ -1560,6 +1564,40 @@ int MbdSig::FitTemplate( const Int_t sampmax )
   return 1;
 }
 
+MbdPulseFitter::Result MbdSig::FitTemplateRange(const Double_t xmax, const Double_t ampl0, const Double_t time0)
+{
+  MbdPulseFitter::Result result;
+
+  template_fcn->SetParameters(ampl0, time0);
+  template_fcn->SetRange(0, xmax);
+
+  if ( _fastfit && _verbose == 0 )
+  {
+    _pulsefitter.SetTemplate(&template_y, template_npointsx, template_begintime, template_endtime);
+    result = _pulsefitter.FitTemplate( gSubPulse->GetX(), gSubPulse->GetY(), gRawPulse->GetY(), gSubPulse->GetN(),
+                                       ped0rms, 0., xmax, time0 );
+    template_fcn->SetParameters(result.ampl, result.time);
+    return result;
+  }
+
+  if (_verbose == 0)
+  {
+    gSubPulse->Fit(template_fcn, "RNQ");
+  }
+  else
+  {
+    gSubPulse->Fit(template_fcn, "R");
+  }
+
+  result.ampl = template_fcn->GetParameter(0);
+  result.time = template_fcn->GetParameter(1);
+  result.chi2 = template_fcn->GetChisquare();
+  result.ndf = template_fcn->GetNDF();
+  result.valid = true;
+
+  return result;
+}
+
 int MbdSig::SetTemplate(const std::vector<float>& shape, const std::vector<float>& sherr)
 {
   template_y = shape;
@@ -1,6 +1,7 @@
 #ifndef MBD_MBDSIG_H
 #define MBD_MBDSIG_H
 
+#include "MbdPulseFitter.h"
 #include "MbdRunningStats.h"
 
 #include <Rtypes.h>
@@ -109,6 +110,9 @@ class MbdSig
 
   /** Use template fit to get ampl and time */
   Int_t FitTemplate(const Int_t sampmax = -1);
+
+  /** Use closed-form template and pedestal fits instead of TF1 fits (default on) */
+  void SetFastFit(const bool b) { _fastfit = b; }
   // Double_t Ampl() { return f_ampl; }
   // Double_t Time() { return f_time; }
 
@@ -138,6 +142,9 @@ class MbdSig
  private:
   void Init();
 
+  /** single template fit over [0,xmax], with TF1 or closed-form depending on _fastfit */
+  MbdPulseFitter::Result FitTemplateRange(const Double_t xmax, const Double_t ampl0, const Double_t time0);
+
   int _ch;
   int _nsamples;
   int _status{0};
@@ -203,6 +210,8 @@ class MbdSig
   std::vector<float> template_yrms;
   TF1 *template_fcn{nullptr};
   TF1 *twotemplate_fcn{nullptr};
+  MbdPulseFitter _pulsefitter;      //! closed-form template fitter
+  bool _fastfit{true};              //! use closed-form fits
   Double_t fit_min_time{};  //! min time for fit, in original units of waveform data
   Double_t fit_max_time{};  //! max time for fit, in original units of waveform data
 
@@ -42,19 +42,11 @@
 #include <TMatrixTUtils.h>  // for TMatrixTRow
 #include <TVector3.h>
 
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
-#include <boost/graph/adjacency_list.hpp>
-#pragma GCC diagnostic pop
-
-#include <boost/graph/connected_components.hpp>
-
 #include <array>
 #include <cmath>
 #include <cstdlib>  // for exit
 #include <iostream>
-#include <map>  // for multimap<>::iterator
-#include <set>  // for set, set<>::iterator
+#include <map>
 #include <string>
 #include <vector>  // for vector
 
@@ -69,49 +61,6 @@ namespace
   }
 }  // namespace
 
-bool MvtxClusterizer::are_adjacent(
-    const std::pair<TrkrDefs::hitkey, TrkrHit *> &lhs,
-    const std::pair<TrkrDefs::hitkey, TrkrHit *> &rhs) const
-{
-  if (GetZClustering())
-  {
-    return
-
-        // column adjacent
-        ((MvtxDefs::getCol(lhs.first) > MvtxDefs::getCol(rhs.first)) ? MvtxDefs::getCol(lhs.first) <= MvtxDefs::getCol(rhs.first) + 1 : MvtxDefs::getCol(rhs.first) <= MvtxDefs::getCol(lhs.first) + 1) &&
-
-        // row adjacent
-        ((MvtxDefs::getRow(lhs.first) > MvtxDefs::getRow(rhs.first)) ? MvtxDefs::getRow(lhs.first) <= MvtxDefs::getRow(rhs.first) + 1 : MvtxDefs::getRow(rhs.first) <= MvtxDefs::getRow(lhs.first) + 1);
-  }
-  return
-      // column identical
-      MvtxDefs::getCol(rhs.first) == MvtxDefs::getCol(lhs.first) &&
-
-      // row adjacent
-      ((MvtxDefs::getRow(lhs.first) > MvtxDefs::getRow(rhs.first)) ? MvtxDefs::getRow(lhs.first) <= MvtxDefs::getRow(rhs.first) + 1 : MvtxDefs::getRow(rhs.first) <= MvtxDefs::getRow(lhs.first) + 1);
-}
-
-bool MvtxClusterizer::are_adjacent(RawHit *lhs, RawHit *rhs) const
-{
-  if (GetZClustering())
-  {
-    return
-
-        // phi adjacent (== column)
-        ((lhs->getPhiBin() > rhs->getPhiBin()) ? lhs->getPhiBin() <= rhs->getPhiBin() + 1 : rhs->getPhiBin() <= lhs->getPhiBin() + 1) &&
-
-        // time adjacent (== row)
-        ((lhs->getTBin() > rhs->getTBin()) ? lhs->getTBin() <= rhs->getTBin() + 1 : rhs->getTBin() <= lhs->getTBin() + 1);
-  }
-  return
-
-      // phi identical (== column)
-      lhs->getPhiBin() == rhs->getPhiBin() &&
-
-      // time adjacent (== row)
-      ((lhs->getTBin() > rhs->getTBin()) ? lhs->getTBin() <= rhs->getTBin() + 1 : rhs->getTBin() <= lhs->getTBin() + 1);
-}
-
 MvtxClusterizer::MvtxClusterizer(const std::string &name)
   : SubsysReco(name)
 {
@@ -353,54 +302,32 @@ void MvtxClusterizer::ClusterMvtx(PHCompositeNode *topNode)
     }
 
     // do the clustering
-    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS>;
-    Graph G;
-
-    // loop over hits in this chip
-    for (unsigned int i = 0; i < hitvec.size(); i++)
+    m_clusterer.clear();
+    m_clusterer.set_neighbourhood(1, GetZClustering() ? 1 : 0);
+    for (const auto &hit : hitvec)
     {
-      for (unsigned int j = 0; j < hitvec.size(); j++)
-      {
-        if (are_adjacent(hitvec[i], hitvec[j]))
-        {
-          add_edge(i, j, G);
-        }
-      }
+      m_clusterer.add_hit(MvtxDefs::getRow(hit.first), MvtxDefs::getCol(hit.first));
     }
+    m_clusterer.run();
 
-    // Find the connections between the vertices of the graph (vertices are the
-    // rawhits,
-    // connections are made when they are adjacent to one another)
-    std::vector<int> component(num_vertices(G));
-
-    // this is the actual clustering, performed by boost
-    boost::connected_components(G, component.data());
-
-    // Loop over the components(hits) compiling a list of the
-    // unique connected groups (ie. clusters).
-    std::set<int> cluster_ids;  // unique components
-    std::multimap<int, std::pair<TrkrDefs::hitkey, TrkrHit *> > clusters;
-    for (unsigned int i = 0; i < component.size(); i++)
+    // loop over the clusters
+    const auto &clusters = m_clusterer.clusters();
+    const auto &hit_order = m_clusterer.hit_order();
+    for (unsigned int clusid = 0; clusid < clusters.size(); ++clusid)
     {
-      cluster_ids.insert(component[i]);
-      clusters.insert(make_pair(component[i], hitvec[i]));
-    }
-    for (const auto &clusid : cluster_ids)
-    {
-      auto clusrange = clusters.equal_range(clusid);
+      const auto &cluster = clusters[clusid];
       auto ckey = TrkrDefs::genClusKey(hitset->getHitSetKey(), clusid);
 
       // determine the size of the cluster in phi and z
-      std::set<int> phibins;
-      std::set<int> zbins;
+      const unsigned int nphibins = cluster.nrows();
+      const unsigned int nzbins = cluster.ncols();
       std::map<int, unsigned int> m_phi;
       std::map<int, unsigned int> m_z;  // Note, there are no "cut" bins for Svtx Clusters
 
       // determine the cluster position...
       double locxsum = 0.;
       double loczsum = 0.;
-      const unsigned int nhits =
-          std::distance(clusrange.first, clusrange.second);
+      const unsigned int nhits = cluster.nhits;
 
       double locclusx = std::numeric_limits<double>::quiet_NaN();
       double locclusz = std::numeric_limits<double>::quiet_NaN();
@@ -413,15 +340,12 @@ void MvtxClusterizer::ClusterMvtx(PHCompositeNode *topNode)
         exit(1);
       }
 
-      for (auto mapiter = clusrange.first; mapiter != clusrange.second;
-           ++mapiter)
+      for (unsigned int ihit = cluster.first; ihit < cluster.first + nhits; ++ihit)
       {
-        // size
-        const auto energy = (mapiter->second).second->getAdc();
-        int col = MvtxDefs::getCol((mapiter->second).first);
-        int row = MvtxDefs::getRow((mapiter->second).first);
-        zbins.insert(col);
-        phibins.insert(row);
+        const auto &hit = hitvec[hit_order[ihit]];
+        const auto energy = hit.second->getAdc();
+        int col = MvtxDefs::getCol(hit.first);
+        int row = MvtxDefs::getRow(hit.first);
 
         if (mClusHitsVerbose)
         {
@@ -454,9 +378,9 @@ void MvtxClusterizer::ClusterMvtx(PHCompositeNode *topNode)
         loczsum += local_coords.Z();
         // add the association between this cluster key and this hitkey to the
         // table
-        m_clusterhitassoc->addAssoc(ckey, mapiter->second.first);
+        m_clusterhitassoc->addAssoc(ckey, hit.first);
 
-      }  // mapiter
+      }  // hit loop
 
       if (mClusHitsVerbose)
       {
@@ -485,8 +409,8 @@ void MvtxClusterizer::ClusterMvtx(PHCompositeNode *topNode)
 
       const double pitch = layergeom->get_pixel_x();
       const double length = layergeom->get_pixel_z();
-      const double phisize = phibins.size() * pitch;
-      const double zsize = zbins.size() * length;
+      const double phisize = nphibins * pitch;
+      const double zsize = nzbins * length;
 
       static const double invsqrt12 = 1. / std::sqrt(12);
 
@@ -505,22 +429,22 @@ void MvtxClusterizer::ClusterMvtx(PHCompositeNode *topNode)
       static constexpr std::array<double, 7> scalefactors_phi = {
           {0.36, 0.6, 0.37, 0.49, 0.4, 0.37, 0.33}};
 
-      if ((phibins.size() == 1 && zbins.size() == 1) ||
-          (phibins.size() == 2 && zbins.size() == 2))
+      if ((nphibins == 1 && nzbins == 1) ||
+          (nphibins == 2 && nzbins == 2))
       {
         phierror *= scalefactors_phi[0];
       }
-      else if ((phibins.size() == 2 && zbins.size() == 1) ||
-               (phibins.size() == 2 && zbins.size() == 3))
+      else if ((nphibins == 2 && nzbins == 1) ||
+               (nphibins == 2 && nzbins == 3))
       {
         phierror *= scalefactors_phi[1];
       }
-      else if ((phibins.size() == 1 && zbins.size() == 2) ||
-               (phibins.size() == 3 && zbins.size() == 2))
+      else if ((nphibins == 1 && nzbins == 2) ||
+               (nphibins == 3 && nzbins == 2))
       {
         phierror *= scalefactors_phi[2];
       }
-      else if (phibins.size() == 3 && zbins.size() == 3)
+      else if (nphibins == 3 && nzbins == 3)
       {
         phierror *= scalefactors_phi[3];
       }
@@ -535,19 +459,19 @@ void MvtxClusterizer::ClusterMvtx(PHCompositeNode *topNode)
       static constexpr std::array<double, 4> scalefactors_z = {
           {0.47, 0.48, 0.71, 0.55}};
       double zerror = length * invsqrt12;
-      if (zbins.size() == 2 && phibins.size() == 2)
+      if (nzbins == 2 && nphibins == 2)
       {
         zerror *= scalefactors_z[0];
       }
-      else if (zbins.size() == 2 && phibins.size() == 3)
+      else if (nzbins == 2 && nphibins == 3)
       {
         zerror *= scalefactors_z[1];
       }
-      else if (zbins.size() == 3 && phibins.size() == 2)
+      else if (nzbins == 3 && nphibins == 2)
       {
         zerror *= scalefactors_z[2];
       }
-      else if (zbins.size() == 3 && phibins.size() == 3)
+      else if (nzbins == 3 && nphibins == 3)
       {
         zerror *= scalefactors_z[3];
       }
@@ -556,8 +480,8 @@ void MvtxClusterizer::ClusterMvtx(PHCompositeNode *topNode)
       {
         std::cout << " MvtxClusterizer: cluskey " << ckey << " layer " << layer
                   << " rad " << layergeom->get_radius() << " phibins "
-                  << phibins.size() << " pitch " << pitch << " phisize " << phisize
-                  << " zbins " << zbins.size() << " length " << length << " zsize "
+                  << nphibins << " pitch " << pitch << " phisize " << phisize
+                  << " zbins " << nzbins << " length " << length << " zsize "
                   << zsize << " local x " << locclusx << " local y " << locclusz
                   << std::endl;
       }
@@ -569,8 +493,8 @@ void MvtxClusterizer::ClusterMvtx(PHCompositeNode *topNode)
       clus->setLocalY(locclusz);
       clus->setPhiError(phierror);
       clus->setZError(zerror);
-      clus->setPhiSize(phibins.size());
-      clus->setZSize(zbins.size());
+      clus->setPhiSize(nphibins);
+      clus->setZSize(nzbins);
       // All silicon surfaces have a 1-1 map to hitsetkey.
       // So set subsurface key to 0
       clus->setSubSurfKey(0);
@@ -580,7 +504,7 @@ void MvtxClusterizer::ClusterMvtx(PHCompositeNode *topNode)
         clus->identify();
       }
 
-      if (zbins.size() <= 127)
+      if (nzbins <= 127)
       {
         m_clusterlist->addClusterSpecifyKey(ckey, clus.release());
       }
@@ -655,57 +579,33 @@ void MvtxClusterizer::ClusterMvtxRaw(PHCompositeNode *topNode)
     }
 
     // do the clustering
-    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS>;
-    Graph G;
-
-    // loop over hits in this chip
-    for (unsigned int i = 0; i < hitvec.size(); i++)
+    m_clusterer.clear();
+    m_clusterer.set_neighbourhood(1, GetZClustering() ? 1 : 0);
+    for (auto *hit : hitvec)
     {
-      for (unsigned int j = 0; j < hitvec.size(); j++)
-      {
-        if (are_adjacent(hitvec[i], hitvec[j]))
-        {
-          add_edge(i, j, G);
-        }
-      }
+      // row == time bin, column == phi bin
+      m_clusterer.add_hit(hit->getTBin(), hit->getPhiBin());
     }
+    m_clusterer.run();
 
-    // Find the connections between the vertices of the graph (vertices are the
-    // rawhits,
-    // connections are made when they are adjacent to one another)
-    std::vector<int> component(num_vertices(G));
-
-    // this is the actual clustering, performed by boost
-    boost::connected_components(G, component.data());
-
-    // Loop over the components(hits) compiling a list of the
-    // unique connected groups (ie. clusters).
-    std::set<int> cluster_ids;  // unique components
-
-    std::multimap<int, RawHit *> clusters;
-    for (unsigned int i = 0; i < component.size(); i++)
-    {
-      cluster_ids.insert(component[i]);
-      clusters.emplace(component[i], hitvec[i]);
-    }
-    //    std::cout << "found cluster #: "<< clusters.size()<< std::endl;
-    // loop over the componenets and make clusters
-    for (const auto &clusid : cluster_ids)
+    // loop over the clusters
+    const auto &clusters = m_clusterer.clusters();
+    const auto &hit_order = m_clusterer.hit_order();
+    for (unsigned int clusid = 0; clusid < clusters.size(); ++clusid)
     {
-      auto clusrange = clusters.equal_range(clusid);
+      const auto &cluster = clusters[clusid];
 
       // make the cluster directly in the node tree
       auto ckey = TrkrDefs::genClusKey(hitset->getHitSetKey(), clusid);
 
       // determine the size of the cluster in phi and z
-      std::set<int> phibins;
-      std::set<int> zbins;
+      const unsigned int nphibins = cluster.nrows();
+      const unsigned int nzbins = cluster.ncols();
 
       // determine the cluster position...
       double locxsum = 0.;
       double loczsum = 0.;
-      const unsigned int nhits =
-          std::distance(clusrange.first, clusrange.second);
+      const unsigned int nhits = cluster.nhits;
 
       double locclusx = NAN;
       double locclusz = NAN;
@@ -719,14 +619,11 @@ void MvtxClusterizer::ClusterMvtxRaw(PHCompositeNode *topNode)
         exit(1);
       }
 
-      for (auto mapiter = clusrange.first; mapiter != clusrange.second;
-           ++mapiter)
+      for (unsigned int ihit = cluster.first; ihit < cluster.first + nhits; ++ihit)
       {
-        // size
-        int col = (mapiter->second)->getPhiBin();
-        int row = (mapiter->second)->getTBin();
-        zbins.insert(col);
-        phibins.insert(row);
+        auto *hit = hitvec[hit_order[ihit]];
+        int col = hit->getPhiBin();
+        int row = hit->getTBin();
 
         // get local coordinates, in stae reference frame, for hit
         auto local_coords = layergeom->get_local_coords_from_pixel(row, col);
@@ -746,7 +643,7 @@ void MvtxClusterizer::ClusterMvtxRaw(PHCompositeNode *topNode)
         // table
         //	      m_clusterhitassoc->addAssoc(ckey, mapiter->second.first);
 
-      }  // mapiter
+      }  // hit loop
 
       // This is the local position
       locclusx = locxsum / nhits;
@@ -756,8 +653,8 @@ void MvtxClusterizer::ClusterMvtxRaw(PHCompositeNode *topNode)
       //	std::cout << " pitch: " <<  pitch << std::endl;
       const double length = layergeom->get_pixel_z();
       //	std::cout << " length: " << length << std::endl;
-      const double phisize = phibins.size() * pitch;
-      const double zsize = zbins.size() * length;
+      const double phisize = nphibins * pitch;
+      const double zsize = nzbins * length;
 
       static const double invsqrt12 = 1. / std::sqrt(12);
 
@@ -775,22 +672,22 @@ void MvtxClusterizer::ClusterMvtxRaw(PHCompositeNode *topNode)
 
       static constexpr std::array<double, 7> scalefactors_phi = {
           {0.36, 0.6, 0.37, 0.49, 0.4, 0.37, 0.33}};
-      if ((phibins.size() == 1 && zbins.size() == 1) ||
-          (phibins.size() == 2 && zbins.size() == 2))
+      if ((nphibins == 1 && nzbins == 1) ||
+          (nphibins == 2 && nzbins == 2))
       {
         phierror *= scalefactors_phi[0];
       }
-      else if ((phibins.size() == 2 && zbins.size() == 1) ||
-               (phibins.size() == 2 && zbins.size() == 3))
+      else if ((nphibins == 2 && nzbins == 1) ||
+               (nphibins == 2 && nzbins == 3))
       {
         phierror *= scalefactors_phi[1];
       }
-      else if ((phibins.size() == 1 && zbins.size() == 2) ||
-               (phibins.size() == 3 && zbins.size() == 2))
+      else if ((nphibins == 1 && nzbins == 2) ||
+               (nphibins == 3 && nzbins == 2))
       {
         phierror *= scalefactors_phi[2];
       }
-      else if (phibins.size() == 3 && zbins.size() == 3)
+      else if (nphibins == 3 && nzbins == 3)
       {
         phierror *= scalefactors_phi[3];
       }
@@ -806,19 +703,19 @@ void MvtxClusterizer::ClusterMvtxRaw(PHCompositeNode *topNode)
           {0.47, 0.48, 0.71, 0.55}};
       double zerror = length * invsqrt12;
 
-      if (zbins.size() == 2 && phibins.size() == 2)
+      if (nzbins == 2 && nphibins == 2)
       {
         zerror *= scalefactors_z[0];
       }
-      else if (zbins.size() == 2 && phibins.size() == 3)
+      else if (nzbins == 2 && nphibins == 3)
       {
         zerror *= scalefactors_z[1];
       }
-      else if (zbins.size() == 3 && phibins.size() == 2)
+      else if (nzbins == 3 && nphibins == 2)
       {
         zerror *= scalefactors_z[2];
       }
-      else if (zbins.size() == 3 && phibins.size() == 3)
+      else if (nzbins == 3 && nphibins == 3)
       {
         zerror *= scalefactors_z[3];
       }
@@ -827,8 +724,8 @@ void MvtxClusterizer::ClusterMvtxRaw(PHCompositeNode *topNode)
       {
         std::cout << " MvtxClusterizer: cluskey " << ckey << " layer " << layer
                   << " rad " << layergeom->get_radius() << " phibins "
-                  << phibins.size() << " pitch " << pitch << " phisize " << phisize
-                  << " zbins " << zbins.size() << " length " << length << " zsize "
+                  << nphibins << " pitch " << pitch << " phisize " << phisize
+                  << " zbins " << nzbins << " length " << length << " zsize "
                   << zsize << " local x " << locclusx << " local y " << locclusz
                   << std::endl;
       }
@@ -840,8 +737,8 @@ void MvtxClusterizer::ClusterMvtxRaw(PHCompositeNode *topNode)
       clus->setLocalY(locclusz);
       clus->setPhiError(phierror);
       clus->setZError(zerror);
-      clus->setPhiSize(phibins.size());
-      clus->setZSize(zbins.size());
+      clus->setPhiSize(nphibins);
+      clus->setZSize(nzbins);
       // All silicon surfaces have a 1-1 map to hitsetkey.
       // So set subsurface key to 0
       clus->setSubSurfKey(0);
@@ -851,7 +748,7 @@ void MvtxClusterizer::ClusterMvtxRaw(PHCompositeNode *topNode)
         clus->identify();
       }
 
-      if (zbins.size() <= 127)
+      if (nzbins <= 127)
       {
         m_clusterlist->addClusterSpecifyKey(ckey, clus.release());
       }
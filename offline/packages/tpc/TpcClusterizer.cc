@@ -41,6 +41,7 @@
 #include <ffamodules/CDBInterface.h>
 
 #include <phool/PHCompositeNode.h>
+#include <phool/PHEventArena.h>
 #include <phool/PHIODataNode.h>  // for PHIODataNode
 #include <phool/PHNode.h>        // for PHNode
 #include <phool/PHNodeIterator.h>
@@ -64,7 +65,6 @@
 #include <string>
 #include <utility>  // for pair
 #include <vector>
-#include <unordered_set>
 // Terra incognita....
 #include <pthread.h>
 
@@ -175,42 +175,99 @@ namespace
 
   pthread_mutex_t mythreadlock;
 
-  void remove_hit(double adc, int phibin, int tbin, int edge, std::multimap<unsigned short, ihit> &all_hit_map, std::vector<std::vector<unsigned short>> &adcval)
+  // flat pad x time bin adc array of a hitset, with a border of one empty bin on each side,
+  // so that the 3x3 neighbourhood of any bin can be read without bound checks.
+  // The adcs are not modified once filled: clustered hits are flagged in a state array,
+  // which keeps the original adcs available to the touching cluster check without a copy.
+  class SectorAdcGrid
   {
-    using hit_iterator = std::multimap<unsigned short, ihit>::iterator;
-    std::pair<hit_iterator, hit_iterator> iterpair = all_hit_map.equal_range(adc);
-    hit_iterator it = iterpair.first;
-    for (; it != iterpair.second; ++it)
+   public:
+    void reset(int phibins, int tbins)
     {
-      if (it->second.iphi == phibin && it->second.it == tbin)
+      m_stride = tbins + 2;
+      const size_t size = static_cast<size_t>(phibins + 2) * m_stride;
+      m_adc.assign(size, 0);
+      m_state.assign(size, kAlive);
+    }
+
+    void set(int phibin, int tbin, unsigned short adc)
+    {
+      m_adc[index(phibin, tbin)] = adc;
+    }
+
+    //! adc as filled
+    unsigned short orig(int phibin, int tbin) const
+    {
+      return m_adc[index(phibin, tbin)];
+    }
+
+    //! adc with clustered hits removed. Removed hits read 0, or USHRT_MAX when shared with a neighbouring cluster
+    unsigned short operator()(int phibin, int tbin) const
+    {
+      const size_t i = index(phibin, tbin);
+      switch (m_state[i] & kRemovedMask)
       {
-        all_hit_map.erase(it);
-        break;
+      case kAlive:
+        return m_adc[i];
+      case kRemoved:
+        return 0;
+      default:
+        return USHRT_MAX;
       }
     }
-    if (edge)
+
+    bool removed(int phibin, int tbin) const
+    {
+      return m_state[index(phibin, tbin)] & kRemovedMask;
+    }
+
+    void remove(int phibin, int tbin, bool edge)
     {
-      adcval[phibin][tbin] = USHRT_MAX;
+      uint8_t &state = m_state[index(phibin, tbin)];
+      state = (state & kInCluster) | (edge ? kRemovedEdge : kRemoved);
     }
-    else
+
+    void remove(const std::vector<ihit> &ihit_list)
     {
-      adcval[phibin][tbin] = 0;
+      for (const auto &hit : ihit_list)
+      {
+        remove(hit.iphi, hit.it, hit.edge);
+      }
     }
-  }
 
-  void remove_hits(std::vector<ihit> &ihit_list, std::multimap<unsigned short, ihit> &all_hit_map, std::vector<std::vector<unsigned short>> &adcval)
-  {
-    for (auto &iter : ihit_list)
+    //! flag the hits of the cluster being built
+    void set_in_cluster(const std::vector<ihit> &ihit_list, bool value)
     {
-      unsigned short adc = iter.adc;
-      unsigned short phibin = iter.iphi;
-      unsigned short tbin = iter.it;
-      unsigned short edge = iter.edge;
-      remove_hit(adc, phibin, tbin, edge, all_hit_map, adcval);
+      for (const auto &hit : ihit_list)
+      {
+        uint8_t &state = m_state[index(hit.iphi, hit.it)];
+        state = value ? (state | kInCluster) : (state & kRemovedMask);
+      }
     }
-  }
 
-  void find_t_range(int phibin, int tbin, const thread_data &my_data, const std::vector<std::vector<unsigned short>> &adcval, int &tdown, int &tup, ClusterCounters &counts, bool &ttop_edge, bool &tbottom_edge)
+    bool in_cluster(int phibin, int tbin) const
+    {
+      return m_state[index(phibin, tbin)] & kInCluster;
+    }
+
+   private:
+    static constexpr uint8_t kAlive = 0;
+    static constexpr uint8_t kRemoved = 1;
+    static constexpr uint8_t kRemovedEdge = 2;
+    static constexpr uint8_t kRemovedMask = 3;
+    static constexpr uint8_t kInCluster = 4;
+
+    size_t index(int phibin, int tbin) const
+    {
+      return static_cast<size_t>(phibin + 1) * m_stride + tbin + 1;
+    }
+
+    size_t m_stride = 0;
+    std::vector<unsigned short> m_adc;
+    std::vector<uint8_t> m_state;
+  };
+
+  void find_t_range(int phibin, int tbin, const thread_data &my_data, const SectorAdcGrid &adcval, int &tdown, int &tup, ClusterCounters &counts, bool &ttop_edge, bool &tbottom_edge)
   {
     const int FitRangeT = (int) my_data.maxHalfSizeT;
     const int NTBinsMax = (int) my_data.tbins;
@@ -261,11 +318,11 @@ namespace
         break;  // truncate edge
       }
 
-      if (adcval[phibin][ct] <= 0)
+      if (adcval(phibin, ct) <= 0)
       {
         break;
       }
-      if (adcval[phibin][ct] == USHRT_MAX)
+      if (adcval(phibin, ct) == USHRT_MAX)
       {
         counts.overlap++;
         break;
@@ -275,8 +332,8 @@ namespace
         // check local minima and break at minimum.
         if (ct < NTBinsMax - 4)
         {  // make sure we stay clear from the edge
-          if (adcval[phibin][ct] + adcval[phibin][ct + 1] <
-              adcval[phibin][ct + 2] + adcval[phibin][ct + 3])
+          if (adcval(phibin, ct) + adcval(phibin, ct + 1) <
+              adcval(phibin, ct + 2) + adcval(phibin, ct + 3))
           {  // rising again
             tup = it + 1;
             counts.overlap++;
@@ -300,11 +357,11 @@ namespace
 	}
         break;  // truncate edge
       }
-      if (adcval[phibin][ct] <= 0)
+      if (adcval(phibin, ct) <= 0)
       {
         break;
       }
-      if (adcval[phibin][ct] == USHRT_MAX)
+      if (adcval(phibin, ct) == USHRT_MAX)
       {
         counts.overlap++;
         break;
@@ -313,8 +370,8 @@ namespace
       {  // check local minima and break at minimum.
         if (ct > 4)
         {  // make sure we stay clear from the edge
-          if (adcval[phibin][ct] + adcval[phibin][ct - 1] <
-              adcval[phibin][ct - 2] + adcval[phibin][ct - 3])
+          if (adcval(phibin, ct) + adcval(phibin, ct - 1) <
+              adcval(phibin, ct - 2) + adcval(phibin, ct - 3))
           {  // rising again
             tdown = it + 1;
             counts.overlap++;
@@ -327,7 +384,7 @@ namespace
     return;
   }
 
-  void find_phi_range(int phibin, int tbin, const thread_data &my_data, const std::vector<std::vector<unsigned short>> &adcval, int &phidown, int &phiup, ClusterCounters &counts, bool &phitop_edge, bool &phibottom_edge)
+  void find_phi_range(int phibin, int tbin, const thread_data &my_data, const SectorAdcGrid &adcval, int &phidown, int &phiup, ClusterCounters &counts, bool &phitop_edge, bool &phibottom_edge)
   {
     int FitRangePHI = (int) my_data.maxHalfSizePhi;
     int NPhiBinsMax = (int) my_data.phibins;
@@ -378,12 +435,12 @@ namespace
       }
 
       // break when below minimum
-      if (adcval[cphi][tbin] <= 0)
+      if (adcval(cphi, tbin) <= 0)
       {
         // phiup = iphi;
         break;
       }
-      if (adcval[cphi][tbin] == USHRT_MAX)
+      if (adcval(cphi, tbin) == USHRT_MAX)
       {
         counts.overlap++;
         break;
@@ -392,8 +449,8 @@ namespace
       {  // check local minima and break at minimum.
         if (cphi < NPhiBinsMax - 4)
         {  // make sure we stay clear from the edge
-          if (adcval[cphi][tbin] + adcval[cphi + 1][tbin] <
-              adcval[cphi + 2][tbin] + adcval[cphi + 3][tbin])
+          if (adcval(cphi, tbin) + adcval(cphi + 1, tbin) <
+              adcval(cphi + 2, tbin) + adcval(cphi + 3, tbin))
           {  // rising again
             phiup = iphi + 1;
             counts.overlap++;
@@ -419,12 +476,12 @@ namespace
         break;  // truncate edge
       }
 
-      if (adcval[cphi][tbin] <= 0)
+      if (adcval(cphi, tbin) <= 0)
       {
         // phidown = iphi;
         break;
       }
-      if (adcval[cphi][tbin] == USHRT_MAX)
+      if (adcval(cphi, tbin) == USHRT_MAX)
       {
         counts.overlap++;
         break;
@@ -433,8 +490,8 @@ namespace
       {  // check local minima and break at minimum.
         if (cphi > 4)
         {  // make sure we stay clear from the edge
-          if (adcval[cphi][tbin] + adcval[cphi - 1][tbin] <
-              adcval[cphi - 2][tbin] + adcval[cphi - 3][tbin])
+          if (adcval(cphi, tbin) + adcval(cphi - 1, tbin) <
+              adcval(cphi - 2, tbin) + adcval(cphi - 3, tbin))
           {  // rising again
             phidown = iphi + 1;
             counts.overlap++;
@@ -447,27 +504,17 @@ namespace
     return;
   }
 
-  void check_cluster_touching(const std::vector<ihit>& ihit_list, const std::vector<std::vector<unsigned short>>& adcval, int phibins, int tbins, ClusterCounters &counts)
+  void check_cluster_touching(const std::vector<ihit>& ihit_list, SectorAdcGrid &adcval, ClusterCounters &counts)
   {
-    // Encode (iphi, it) into single integer for fast lookup
-    std::unordered_set<int> cluster_hits;
-    cluster_hits.reserve(ihit_list.size());
-
-    auto encode = [tbins](int phi, int t)
-    {
-      return phi * tbins + t;
-    };
-
-    for (const auto &hit : ihit_list)
-    {
-      cluster_hits.insert(encode(hit.iphi, hit.it));
-    }
+    // flag the cluster hits in the grid, to skip them when looking at neighbours
+    adcval.set_in_cluster(ihit_list, true);
 
     for (const auto &hit : ihit_list)
     {
       int iphi = hit.iphi;
       int it   = hit.it;
 
+      // the grid border makes neighbours outside the sector read as empty
       for (int dphi = -1; dphi <= 1; ++dphi)
       {
 	for (int dt = -1; dt <= 1; ++dt)
@@ -477,17 +524,12 @@ namespace
 	  int nphi = iphi + dphi;
 	  int nt   = it + dt;
 
-	  if (nphi < 0 || nphi >= phibins ||
-	      nt   < 0 || nt   >= tbins) {
-	    continue;
-	  }
-
 	  // skip same cluster
-	  if (cluster_hits.contains(encode(nphi, nt))) { continue; }
+	  if (adcval.in_cluster(nphi, nt)) { continue; }
 
 	  // neighbor has signal → touching
-	  if (adcval[nphi][nt] > 0 &&
-	      adcval[nphi][nt] != USHRT_MAX)
+	  const unsigned short adc = adcval.orig(nphi, nt);
+	  if (adc > 0 && adc != USHRT_MAX)
 	  {
 	    // Check Phi
 	    if (dphi == -1) { counts.slmix = 1; }
@@ -500,55 +542,23 @@ namespace
 	}
       }
     }
+
+    adcval.set_in_cluster(ihit_list, false);
   }
 
-  int is_hit_isolated(int iphi, int it, int NPhiBinsMax, int NTBinsMax, const std::vector<std::vector<unsigned short>> &adcval)
+  int is_hit_isolated(int iphi, int it, const SectorAdcGrid &adcval)
   {
-    // check isolated hits
-    // const int NPhiBinsMax = (int) my_data.phibins;
-    // const int NTBinsMax = (int) my_data.tbins;
-
+    // check isolated hits. The grid border makes bins outside the sector read as empty
     int isosum = 0;
-    int isophimin = iphi - 1;
-    isophimin = std::max(isophimin, 0);
-    int isophimax = iphi + 1;
-    if (!(isophimax < NPhiBinsMax))
-    {
-      isophimax = NPhiBinsMax - 1;
-    }
-    int isotmin = it - 1;
-    isotmin = std::max(isotmin, 0);
-    int isotmax = it + 1;
-    if (!(isotmax < NTBinsMax))
-    {
-      isotmax = NTBinsMax - 1;
-    }
-    for (int isophi = isophimin; isophi <= isophimax; isophi++)
+    for (int isophi = iphi - 1; isophi <= iphi + 1; isophi++)
     {
-      for (int isot = isotmin; isot <= isotmax; isot++)
+      for (int isot = it - 1; isot <= it + 1; isot++)
       {
         if (isophi == iphi && isot == it)
         {
           continue;
         }
-        /*
-        std::cout <<" isominphi: " << isophimin
-                  << "phi: " << isophi
-                  <<" isomaxphi: " << isophimax
-                  <<" maxphi: " << NPhiBinsMax
-                  <<" isomint: " << isotmin
-                  << " t: " << isot
-                  <<" isomaxt: " << isotmax
-                  << " maxt: " << NTBinsMax
-                  << std::endl;
-        */
-        isosum += adcval[isophi][isot];
-        /*
-        std::cout << "adc " << adcval[isophi][isot]
-                  << " isosum " << isosum
-                  << " done"
-                  << std::endl;
-        */
+        isosum += adcval(isophi, isot);
       }
     }
     int isiso = 0;
@@ -559,7 +569,7 @@ namespace
     return isiso;
   }
 
-  void get_cluster(int phibin, int tbin, const thread_data &my_data, const std::vector<std::vector<unsigned short>> &adcval, std::vector<ihit> &ihit_list, ClusterCounters &counts)
+  void get_cluster(int phibin, int tbin, const thread_data &my_data, const SectorAdcGrid &adcval, std::vector<ihit> &ihit_list, ClusterCounters &counts)
   {
     bool ttop_edge = false;
     bool tbottom_edge = false;
@@ -580,11 +590,11 @@ namespace
       find_phi_range(phibin, it, my_data, adcval, phidown, phiup, counts, phitop_edge, phibottom_edge);
       for (int iphi = (phibin - phidown); iphi <= (phibin + phiup); iphi++)
       {
-        if (adcval[iphi][it] > 0 && adcval[iphi][it] != USHRT_MAX)
+        if (adcval(iphi, it) > 0 && adcval(iphi, it) != USHRT_MAX)
         {
           if (my_data.do_singles)
           {
-            if (is_hit_isolated(iphi, it, (int) my_data.phibins, (int) my_data.tbins, adcval))
+            if (is_hit_isolated(iphi, it, adcval))
             {
               continue;
             }
@@ -593,7 +603,7 @@ namespace
           hit.iphi = iphi;
           hit.it = it;
 
-          hit.adc = adcval[iphi][it];
+          hit.adc = adcval(iphi, it);
           if (counts.overlap > 0)
           {
             if ((iphi == (phibin - phidown)) ||
@@ -673,10 +683,6 @@ namespace
     }
 
     // std::cout << "process list" << std::endl;
-    std::vector<TrkrDefs::hitkey> hitkeyvec;
-
-    std::map<std::pair<int,int>, double> adc_map;
-
     // keep track of the hit locations in a given cluster
     std::map<int, unsigned int> m_phi{};
     std::map<int, unsigned int> m_z{};
@@ -728,8 +734,6 @@ namespace
 
       adc_sum += adc;
 
-      adc_map[{iphi, it}] += adc;
-
       if (my_data.fillClusHitsVerbose)
       {
         auto pnew = m_phi.try_emplace(iphi, adc);
@@ -745,11 +749,6 @@ namespace
         }
       }
 
-      // capture the hitkeys for all adc values above a certain threshold
-      TrkrDefs::hitkey hitkey = TpcDefs::genHitKey(iphi, it);
-      // if(adc>5)
-      hitkeyvec.push_back(hitkey);
-
       // training adc
       if (gen_hits && training_hits)
       {
@@ -764,7 +763,6 @@ namespace
     //      std::cout << "done process list" << std::endl;
     if (adc_sum < my_data.min_adc_sum)
     {
-      hitkeyvec.clear();
       return;  // skip obvious noise "clusters"
     }
 
@@ -836,14 +834,16 @@ namespace
     int iphi_centroid = static_cast<int>(std::floor(clusiphi));
     int it_centroid = static_cast<int>(std::floor(clusit));
 
-    auto it_cent = adc_map.find({iphi_centroid, it_centroid});
-    if (it_cent != adc_map.end())
-    {
-      cen_adc = it_cent->second;
-    }
-    else
+    // hits in the list are unique bins. The centroid may not land on a real hit, in which case cen_adc stays 0
+    for (const auto &iter : ihit_list)
     {
-      cen_adc = 0.0; // centroid may not land on a real hit
+      if (iter.adc > 0 &&
+          iter.iphi + my_data.phioffset == iphi_centroid &&
+          iter.it + my_data.toffset == it_centroid)
+      {
+        cen_adc = iter.adc;
+        break;
+      }
     }
 
     // Max ADC position in global coordinates
@@ -892,7 +892,6 @@ namespace
     {
       /// If the surface can't be found, we can't track with it. So
       /// just return and don't add the cluster to the container
-      hitkeyvec.clear();
       return;
     }
     // Acts::Vector3 surfcent = surface->center(my_data.tGeometry->geometry().getGeoContext()) / Acts::UnitConstants::cm;
@@ -935,11 +934,11 @@ namespace
 
       if (my_data.debug)
       {
-	clus = new TrkrClusterv6;
+	clus = PHEventArena::Create<TrkrClusterv6>();
       }
       else
       {
-	clus = new TrkrClusterv5;
+	clus = PHEventArena::Create<TrkrClusterv5>();
       }
 
       clus_base = clus;
@@ -1041,17 +1040,20 @@ namespace
     if (my_data.do_assoc)
     {
       // get cluster index in vector. It is used to store associations, and build relevant cluster keys when filling the containers
+      // associate the hitkeys of all hits with a non zero adc
       uint32_t index = my_data.cluster_vector.size() - 1;
-      for (unsigned int &i : hitkeyvec)
+      for (const auto &iter : ihit_list)
       {
-        my_data.association_vector.emplace_back(index, i);
+        if (iter.adc > 0)
+        {
+          my_data.association_vector.emplace_back(index, TpcDefs::genHitKey(iter.iphi + my_data.phioffset, iter.it + my_data.toffset));
+        }
       }
       if (gen_hits && training_hits)
       {
         training_hits->cluskey = TrkrDefs::genClusKey(tpcHitSetKey, index);
       }
     }
-    hitkeyvec.clear();
     if (gen_hits && training_hits)
     {
       my_data.v_hits.emplace_back(training_hits);
@@ -1069,10 +1071,12 @@ namespace
     const auto &maxz = my_data->tGeometry->get_max_driftlength() + my_data->tGeometry->get_CM_halfwidth();
     const auto &layer = my_data->layer;
     //    int nhits = 0;
-    // for convenience, create a 2D vector to store adc values in and initialize to zero
-    std::vector<std::vector<unsigned short>> adcval(phibins, std::vector<unsigned short>(tbins, 0));
-    std::multimap<unsigned short, ihit> all_hit_map;
-    std::vector<ihit> hit_vect;
+    // flat pad x time bin array to store adc values in, initialized to zero
+    SectorAdcGrid adcval;
+    adcval.reset(phibins, tbins);
+
+    // seed candidates, in fill order. They are sorted by adc once all hits are read
+    std::vector<ihit> seeds;
 
     int tbinmax = tbins;
     int tbinmin = 0;
@@ -1179,11 +1183,11 @@ namespace
             thisHit.it = tbin;
             thisHit.adc = adc;
             thisHit.edge = 0;
-            all_hit_map.insert(std::make_pair(adc, thisHit));
+            seeds.push_back(thisHit);
           }
           if (adc > my_data->edge_threshold)
           {
-            adcval[phibin][tbin] = adc;
+            adcval.set(phibin, tbin, adc);
           }
         }
       }
@@ -1215,6 +1219,10 @@ namespace
         {
           unsigned short val = (*(hitset->getHits(nphi)))[nt];
 
+          if (pindex >= tbins)
+          {
+            break;
+          }
           if (val == 0)
           {
             pindex++;
@@ -1230,9 +1238,9 @@ namespace
                 thisHit.it = pindex;
                 thisHit.adc = val;
                 thisHit.edge = 0;
-                all_hit_map.insert(std::make_pair(val, thisHit));
+                seeds.push_back(thisHit);
               }
-              adcval[nphi][pindex++] = val;
+              adcval.set(nphi, pindex++, val);
             }
             else
             {
@@ -1249,9 +1257,9 @@ namespace
                   thisHit.it = pindex;
                   thisHit.adc = val;
                   thisHit.edge = 0;
-                  all_hit_map.insert(std::make_pair(val, thisHit));
+                  seeds.push_back(thisHit);
                 }
-                adcval[nphi][pindex++] = val;
+                adcval.set(nphi, pindex++, val);
               }
             }
           }
@@ -1261,116 +1269,116 @@ namespace
     /*
     if (my_data->do_singles)
     {
-      for (auto ahit : all_hit_map)
+      for (auto ahit : seeds)
       {
-        ihit hiHit = ahit.second;
+        ihit hiHit = ahit;
         int iphi = hiHit.iphi;
         int it = hiHit.it;
         unsigned short edge = hiHit.edge;
         double adc = hiHit.adc;
         if (it > 0 && it < tbins)
         {
-          if (adcval[iphi][it - 1] == 0 &&
-              adcval[iphi][it + 1] == 0)
+          if (adcval(iphi, it - 1) == 0 &&
+              adcval(iphi, it + 1) == 0)
           {
-            remove_hit(adc, iphi, it, edge, all_hit_map, adcval);
+            adcval.remove(iphi, it, edge);
           }
         }
       }
     }
     */
     
-    std::vector<std::vector<unsigned short>> adcval_orig = adcval;
+    // process the seeds by decreasing adc, and seeds with equal adcs in reverse fill order
+    std::stable_sort(seeds.begin(), seeds.end(), [](const ihit &lhs, const ihit &rhs)
+                     { return lhs.adc < rhs.adc; });
+
+    // scratch buffer, reused for all clusters of the sector
+    std::vector<ihit> ihit_list;
 
     // std::cout << "done filling " << std::endl;
-    while (!all_hit_map.empty())
+    for (auto seed = seeds.rbegin(); seed != seeds.rend(); ++seed)
     {
-      // std::cout << "all hit map size: " << all_hit_map.size() << std::endl;
-      auto iter = all_hit_map.rbegin();
-      if (iter == all_hit_map.rend())
-      {
-        break;
-      }
-      ihit hiHit = iter->second;
-      int iphi = hiHit.iphi;
-      int it = hiHit.it;
-      unsigned short edge = hiHit.edge;
-      double adc = hiHit.adc;
-      if (my_data->do_singles)
+      // a seed remains the highest one left until it is removed, either as part of a cluster or on its own
+      while (!adcval.removed(seed->iphi, seed->it))
       {
-        if (is_hit_isolated(iphi, it, (int) my_data->phibins, (int) my_data->tbins, adcval))
+        ihit hiHit = *seed;
+        int iphi = hiHit.iphi;
+        int it = hiHit.it;
+        unsigned short edge = hiHit.edge;
+        if (my_data->do_singles)
         {
-          remove_hit(adc, iphi, it, edge, all_hit_map, adcval);
-          continue;
+          if (is_hit_isolated(iphi, it, adcval))
+          {
+            adcval.remove(iphi, it, edge);
+            continue;
+          }
         }
-      }
 
-      // put all hits in the all_hit_map (sorted by adc)
-      // start with highest adc hit
-      //  -> cluster around it and get vector of hits
-      std::vector<ihit> ihit_list;
-      // Setting all the counters
-      ClusterCounters counts;
+        // start with highest adc hit
+        //  -> cluster around it and get vector of hits
+        ihit_list.clear();
+        // Setting all the counters
+        ClusterCounters counts;
 
-      get_cluster(iphi, it, *my_data, adcval, ihit_list, counts);
+        get_cluster(iphi, it, *my_data, adcval, ihit_list, counts);
 
-      if (my_data->FixedWindow > 0)
-      {
-        // get cluster dimensions and check if they hit the window boundaries
-        int wphibinhi = -1;
-        int wphibinlo = 666666;
-        int wtbinhi = -1;
-        int wtbinlo = 666666;
-        for (auto witer : ihit_list)
+        if (my_data->FixedWindow > 0)
         {
-          int wiphi = witer.iphi + my_data->phioffset;
-          int wit = witer.it + my_data->toffset;
-          double wadc = witer.adc;
-          if (wadc <= 0)
+          // get cluster dimensions and check if they hit the window boundaries
+          int wphibinhi = -1;
+          int wphibinlo = 666666;
+          int wtbinhi = -1;
+          int wtbinlo = 666666;
+          for (auto witer : ihit_list)
           {
-            continue;
+            int wiphi = witer.iphi + my_data->phioffset;
+            int wit = witer.it + my_data->toffset;
+            double wadc = witer.adc;
+            if (wadc <= 0)
+            {
+              continue;
+            }
+            wphibinhi = std::max(wiphi, wphibinhi);
+            wphibinlo = std::min(wiphi, wphibinlo);
+            wtbinhi = std::max(wit, wtbinhi);
+            wtbinlo = std::min(wit, wtbinlo);
+          }
+          char wtsize = wtbinhi - wtbinlo + 1;
+          char wphisize = wphibinhi - wphibinlo + 1;
+
+          // check if we have a super big cluster and switch from fixed window to step down
+          if (ihit_list.size() > (0.5 * pow((2 * my_data->FixedWindow + 1), 2)) ||
+              wphisize >= (2 * my_data->FixedWindow + 1) ||
+              wtsize >= (2 * my_data->FixedWindow + 1))
+          {
+            int window_cache = my_data->FixedWindow;
+            // std::cout << " fixed size before " << ihit_list.size() << " | " << pow((2*my_data->FixedWindow+1),2) << std::endl;
+            my_data->FixedWindow = 0;
+            // reset hit list and try again without fixed window
+            ihit_list.clear();
+            // resetting all the counters
+            counts.clear();
+            get_cluster(iphi, it, *my_data, adcval, ihit_list, counts);
+            // std::cout << " stepdown size after " << ihit_list.size() << std::endl;
+            my_data->FixedWindow = window_cache;
           }
-          wphibinhi = std::max(wiphi, wphibinhi);
-          wphibinlo = std::min(wiphi, wphibinlo);
-          wtbinhi = std::max(wit, wtbinhi);
-          wtbinlo = std::min(wit, wtbinlo);
         }
-        char wtsize = wtbinhi - wtbinlo + 1;
-        char wphisize = wphibinhi - wphibinlo + 1;
 
-        // check if we have a super big cluster and switch from fixed window to step down
-        if (ihit_list.size() > (0.5 * pow((2 * my_data->FixedWindow + 1), 2)) ||
-            wphisize >= (2 * my_data->FixedWindow + 1) ||
-            wtsize >= (2 * my_data->FixedWindow + 1))
+        check_cluster_touching(ihit_list, adcval, counts);
+
+        if (ihit_list.size() <= 1)
         {
-          int window_cache = my_data->FixedWindow;
-          // std::cout << " fixed size before " << ihit_list.size() << " | " << pow((2*my_data->FixedWindow+1),2) << std::endl;
-          my_data->FixedWindow = 0;
-          // reset hit list and try again without fixed window
+          adcval.remove(ihit_list);
           ihit_list.clear();
-	  // resetting all the counters
-	  counts.clear();
-          get_cluster(iphi, it, *my_data, adcval, ihit_list, counts);
-          // std::cout << " stepdown size after " << ihit_list.size() << std::endl;
-          my_data->FixedWindow = window_cache;
+          adcval.remove(iphi, it, edge);
         }
+        // -> calculate cluster parameters
+        // -> add hits to truth association
+        // remove hits from the grid
+        // repeat until all seeds are removed
+        calc_cluster_parameter(iphi, it, ihit_list, *my_data, counts);
+        adcval.remove(ihit_list);
       }
-      
-      check_cluster_touching(ihit_list, adcval_orig, my_data->phibins, my_data->tbins, counts);
-
-      if (ihit_list.size() <= 1)
-      {
-        remove_hits(ihit_list, all_hit_map, adcval);
-        ihit_list.clear();
-        remove_hit(adc, iphi, it, edge, all_hit_map, adcval);
-      }
-      // -> calculate cluster parameters
-      // -> add hits to truth association
-      // remove hits from all_hit_map
-      // repeat untill all_hit_map empty
-      calc_cluster_parameter(iphi, it, ihit_list, *my_data, counts);
-      remove_hits(ihit_list, all_hit_map, adcval);
-      ihit_list.clear();
     }
     /*    if( my_data->rawhitset!=nullptr){
       RawHitSetv1 *hitset = my_data->rawhitset;
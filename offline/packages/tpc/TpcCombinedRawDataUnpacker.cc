@@ -1,5 +1,8 @@
 #include "TpcCombinedRawDataUnpacker.h"
 
+#include <trackbase/RawHitSet.h>
+#include <trackbase/RawHitSetContainer.h>
+#include <trackbase/RawHitSetContainerv1.h>
 #include <trackbase/TpcDefs.h>
 #include <trackbase/TrkrDefs.h>  // for hitkey, hitsetkey
 #include <trackbase/TrkrHit.h>
@@ -34,15 +37,60 @@
 #include <TNtuple.h>
 #include <TSystem.h>
 
+#include <omp.h>
+
 #include <algorithm>
 #include <cmath>
 #include <cstdint>   // for exit
 #include <cstdlib>   // for exit
 #include <iostream>  // for operator<<, endl, bas...
-#include <map>       // for _Rb_tree_iterator
+#include <limits>
 #include <memory>
 #include <utility>
 
+namespace
+{
+  //! append one pad to a RawHitSet, in the zero run encoding decoded by TpcClusterizer
+  /**
+   * a single 0 is one empty time bin, a run of n > 2 empty time bins is written as 0, n - 2, 0.
+   * A non zero value between two zeros is read as a run length, so isolated single time bin adcs cannot be written and are dropped.
+   * Adcs are saturated at 255 and trailing empty time bins are not written.
+   */
+  void encode_raw_pad(const std::vector<uint16_t>& column, std::vector<uint8_t>& out)
+  {
+    const int nt = column.size();
+    int last = nt - 1;
+    while (last >= 0 && column[last] == 0)
+    {
+      --last;
+    }
+
+    int zero_count = 0;
+    for (int t = 0; t <= last; t++)
+    {
+      const bool isolated = t > 0 && column[t - 1] == 0 && (t == nt - 1 || column[t + 1] == 0);
+      if (column[t] == 0 || isolated)
+      {
+        zero_count++;
+        continue;
+      }
+
+      while (zero_count > 2)
+      {
+        const int run = std::min(zero_count, 257);
+        out.push_back(0);
+        out.push_back(run - 2);
+        out.push_back(0);
+        zero_count -= run;
+      }
+      out.insert(out.end(), zero_count, 0);
+      zero_count = 0;
+
+      out.push_back(std::min<uint16_t>(column[t], 255));
+    }
+  }
+}  // namespace
+
 TpcCombinedRawDataUnpacker::TpcCombinedRawDataUnpacker(std::string const& name, std::string const& outF)
   : SubsysReco(name)
   , outfile_name(outF)
@@ -160,6 +208,23 @@ int TpcCombinedRawDataUnpacker::InitRun(PHCompositeNode* topNode)
     trkr_node->addNode(new_node);
   }
 
+  if (m_do_rawhitset_output)
+  {
+    RawHitSetContainer* raw_hit_set_container = findNode::getClass<RawHitSetContainer>(topNode, "TRKR_RAWHITSET");
+    if (!raw_hit_set_container)
+    {
+      if (Verbosity())
+      {
+        std::cout << "TpcCombinedRawDataUnpacker::InitRun(PHCompositeNode* topNode)" << std::endl;
+        std::cout << "\tMaking RawHitSetContainer" << std::endl;
+      }
+
+      raw_hit_set_container = new RawHitSetContainerv1;
+      PHIODataNode<PHObject>* new_node = new PHIODataNode<PHObject>(raw_hit_set_container, "TRKR_RAWHITSET", "PHObject");
+      trkr_node->addNode(new_node);
+    }
+  }
+
   TpcRawHitContainer* tpccont = findNode::getClass<TpcRawHitContainer>(topNode, m_TpcRawNodeName);
   if (!tpccont)
   {
@@ -217,17 +282,37 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
   }
   _ievent++;
 
-  TrkrHitSetContainer* trkr_hit_set_container = findNode::getClass<TrkrHitSetContainer>(topNode, "TRKR_HITSET");
-  if (!trkr_hit_set_container)
+  TrkrHitSetContainer* trkr_hit_set_container = nullptr;
+  RawHitSetContainer* raw_hit_set_container = nullptr;
+  if (m_do_rawhitset_output)
   {
-    std::cout << PHWHERE << std::endl;
-    std::cout << "TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)" << std::endl;
-    std::cout << "Could not get \"TRKR_HITSET\" from Node Tree" << std::endl;
-    std::cout << "Exiting" << std::endl;
-    gSystem->Exit(1);
-    exit(1);
-
-    return Fun4AllReturnCodes::DISCARDEVENT;
+    raw_hit_set_container = findNode::getClass<RawHitSetContainer>(topNode, "TRKR_RAWHITSET");
+    if (!raw_hit_set_container)
+    {
+      std::cout << PHWHERE << std::endl;
+      std::cout << "TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)" << std::endl;
+      std::cout << "Could not get \"TRKR_RAWHITSET\" from Node Tree" << std::endl;
+      std::cout << "Exiting" << std::endl;
+      gSystem->Exit(1);
+      exit(1);
+
+      return Fun4AllReturnCodes::DISCARDEVENT;
+    }
+  }
+  else
+  {
+    trkr_hit_set_container = findNode::getClass<TrkrHitSetContainer>(topNode, "TRKR_HITSET");
+    if (!trkr_hit_set_container)
+    {
+      std::cout << PHWHERE << std::endl;
+      std::cout << "TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)" << std::endl;
+      std::cout << "Could not get \"TRKR_HITSET\" from Node Tree" << std::endl;
+      std::cout << "Exiting" << std::endl;
+      gSystem->Exit(1);
+      exit(1);
+
+      return Fun4AllReturnCodes::DISCARDEVENT;
+    }
   }
 
   TpcRawHitContainer* tpccont = findNode::getClass<TpcRawHitContainer>(topNode, m_TpcRawNodeName);
@@ -250,25 +335,75 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
     return Fun4AllReturnCodes::ABORTRUN;
   }
 
-  TrkrDefs::hitsetkey hit_set_key = 0;
-  TrkrDefs::hitkey hit_key = 0;
-  TrkrHitSetContainer::Iterator hit_set_container_itr;
-  TrkrHit* hit = nullptr;
+  // the cdb and geometry lookups are done once per raw hit, serially.
+  // Sectors share no fee and no hitset, so they can then be unpacked in parallel (set_num_threads).
+  // The ntuples are not thread safe, sectors are processed one after the other when they are written
+  map_raw_hits(tpccont, geom_container);
 
-  uint64_t bco_min = UINT64_MAX;
-  uint64_t bco_max = 0;
+  const int nsectors = m_sectors.size();
+  const int nthreads = m_num_threads >= 1 ? m_num_threads : omp_get_max_threads();
+#pragma omp parallel for schedule(dynamic, 1) num_threads(nthreads) if (!m_writeTree)
+  for (int sector = 0; sector < nsectors; sector++)
+  {
+    unpack_sector(tpccont, sector);
+  }
 
-  const auto nhits = tpccont->get_nhits();
+  if (m_do_baseline_corr && Verbosity() >= 1)
+  {
+    int nhistfilled = 0;
+    int nhisttotal = 0;
+    for (const auto& sdata : m_sectors)
+    {
+      nhistfilled += sdata.nbaseline_filled;
+      nhisttotal += sdata.nbaseline_total;
+    }
+    std::cout << " filled " << nhistfilled
+              << " total " << nhisttotal
+              << std::endl;
+
+    std::cout << "second loop " << m_do_baseline_corr << std::endl;
+  }
+
+  // the output containers are filled serially, in sector order
+  for (int sector = 0; sector < nsectors; sector++)
+  {
+    fill_hitsets(sector, trkr_hit_set_container, raw_hit_set_container, geom_container);
+  }
+
+  if (Verbosity())
+  {
+    std::cout << " event BCO: " << m_bco_min << " - " << m_bco_max << std::endl;
+    std::cout << "TpcCombinedRawDataUnpacker:: done" << std::endl;
+  }
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+void TpcCombinedRawDataUnpacker::map_raw_hits(TpcRawHitContainer* tpccont, PHG4TpcGeomContainer* geom_container)
+{
+  for (auto& sdata : m_sectors)
+  {
+    sdata.hits.clear();
+    for (auto& hitset : sdata.hitsets)
+    {
+      hitset.used = false;
+      hitset.padmin = std::numeric_limits<uint16_t>::max();
+      hitset.padmax = 0;
+      hitset.ntbins = 0;
+    }
+  }
 
-  int max_time_range = 0;
+  m_bco_min = UINT64_MAX;
+  m_bco_max = 0;
 
+  const auto nhits = tpccont->get_nhits();
   for (unsigned int i = 0; i < nhits; i++)
   {
     TpcRawHit* tpchit = tpccont->get_hit(i);
     uint64_t gtm_bco = tpchit->get_gtm_bco();
 
-    bco_min = std::min(gtm_bco, bco_min);
-    bco_max = std::max(gtm_bco, bco_max);
+    m_bco_min = std::min(gtm_bco, m_bco_min);
+    m_bco_max = std::max(gtm_bco, m_bco_max);
 
     int fee = tpchit->get_fee();
     int channel = tpchit->get_channel();
@@ -287,97 +422,124 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
     int32_t packet_id = tpchit->get_packetid();
     int ep = (packet_id - 4000) % 10;
     int sector = (packet_id - 4000 - ep) / 10;
+    if (sector < 0)
+    {
+      continue;
+    }
     if (sector > 11)
     {
       side = 0;
     }
 
     unsigned int key = (256 * (feeM)) + channel;
-    std::string varname = "layer";
-    int layer = m_cdbttree->GetIntValue(key, varname);
-    // antenna pads will be in 0 layer
+    if (key >= m_chan_cache.size())
+    {
+      m_chan_cache.resize(key + 1);
+    }
+    chan_cache& cache = m_chan_cache[key];
+    if (!cache.filled)
+    {
+      cache.filled = true;
+      cache.layer = m_cdbttree->GetIntValue(key, "layer");
+      // antenna pads will be in 0 layer
+      if (cache.layer > 6)
+      {
+        cache.phi = m_cdbttree->GetDoubleValue(key, "phi");
+      }
+    }
+    int layer = cache.layer;
     if (layer <= 6)
     {
       continue;
     }
 
-    uint16_t sampadd = tpchit->get_sampaaddress();
-    uint16_t sampch = tpchit->get_sampachannel();
-    //    uint16_t sam = tpchit->get_samples();
-    max_time_range = tpchit->get_samples();
-     
     int region = 2;
-    if(layer < 7 + 16)
+    if (layer < 7 + 16)
     {
       region = 0;
     }
-    else if( layer < 7 + 32)
+    else if (layer < 7 + 32)
     {
       region = 1;
     }
 
-    varname = "phi";  // + std::to_string(key);
-    double phi = ((side == 1 ? 1 : -1) * (m_cdbttree->GetDoubleValue(key, varname) - M_PI / 2.)) + ((sector % 12) * M_PI / 6);
+    double phi = ((side == 1 ? 1 : -1) * (cache.phi - M_PI / 2.)) + ((sector % 12) * M_PI / 6);
     PHG4TpcGeom* layergeom = geom_container->GetLayerCellGeom(layer);
     unsigned int phibin = layergeom->get_phibin(phi, side);
-  
-    hit_set_key = TpcDefs::genHitSetKey(layer, (mc_sectors[sector % 12]), side);
-    hit_set_container_itr = trkr_hit_set_container->findOrAddHitSet(hit_set_key);
 
-    double hpedestal = 0;
-    double hpedwidth = 0;
-
-    if (Verbosity() > 2)
-    {
-      std::cout << "TpcCombinedRawDataUnpacker:: do zero suppression" << std::endl;
-    }
-    TH2* feehist = nullptr;
-    hpedestal = 60;
-    hpedwidth = m_zs_threshold[region];
-
-    unsigned int pad_key = create_pad_key(side, layer, phibin);
-
-    std::map<unsigned int, chan_info>::iterator chan_it = chan_map.find(pad_key);
-    if (chan_it != chan_map.end())
+    if (sector >= (int) m_sectors.size())
     {
-      (*chan_it).second.ped = hpedestal;
-      (*chan_it).second.width = hpedwidth;
+      m_sectors.resize(sector + 1);
     }
-    else
+    sector_data& sdata = m_sectors[sector];
+    if (layer >= (int) sdata.hitsets.size())
     {
-      chan_info nucinfo;
-      nucinfo.fee = fee;
-      nucinfo.ped = hpedestal;
-      nucinfo.width = hpedwidth;
-      chan_map.insert(std::make_pair(pad_key, nucinfo));
+      sdata.hitsets.resize(layer + 1);
     }
-    int rx = get_rx(layer);
-    unsigned int fee_key = create_fee_key(side, mc_sectors[sector % 12], rx, fee);
-    // find or insert TH2C;
-    std::map<unsigned int, TH2*>::iterator fee_map_it;
 
-    fee_map_it = feeadc_map.find(fee_key);
-    if (fee_map_it != feeadc_map.end())
+    hitset_data& hitset = sdata.hitsets[layer];
+    if (!hitset.used)
     {
-      feehist = (*fee_map_it).second;
+      hitset.used = true;
+      hitset.hitsetkey = TpcDefs::genHitSetKey(layer, (mc_sectors[sector % 12]), side);
     }
-    else
+    hitset.padmin = std::min<uint16_t>(hitset.padmin, phibin);
+    hitset.padmax = std::max<uint16_t>(hitset.padmax, phibin);
+
+    // time bins are t = s - m_presampleShift - m_t0, with s < samples
+    const uint16_t samples = tpchit->get_samples();
+    const int ntbins = samples - m_presampleShift - m_t0;
+    hitset.ntbins = std::max<int>(hitset.ntbins, ntbins);
+
+    sdata.hits.push_back({i, (uint16_t) layer, (uint16_t) phibin, samples, (uint8_t) region, (uint8_t) fee});
+  }
+}
+
+void TpcCombinedRawDataUnpacker::unpack_sector(TpcRawHitContainer* tpccont, int sector)
+{
+  sector_data& sdata = m_sectors[sector];
+  sdata.nbaseline_filled = 0;
+  sdata.nbaseline_total = 0;
+
+  for (auto& hitset : sdata.hitsets)
+  {
+    if (hitset.used)
     {
-      std::string histname = "h" + std::to_string(fee_key);
-      feehist = new TH2C(histname.c_str(), "histname", max_time_range + 1, -0.5, max_time_range + 0.5, 501, -0.5, 1000.5);
-      feeadc_map.insert(std::make_pair(fee_key, feehist));
-      std::vector<int> feeentries(feehist->GetNbinsX(), 0);
-      feeentries_map.insert(std::make_pair(fee_key, feeentries));
+      hitset.adc.assign(static_cast<size_t>(hitset.npads()) * hitset.ntbins, 0);
+      hitset.padfee.assign(hitset.npads(), 0);
     }
-    auto fee_entries_it = feeentries_map.find(fee_key);
-    std::vector<int>& fee_entries_vec = (*fee_entries_it).second;
+  }
+
+  if (m_do_baseline_corr && sdata.fees.empty())
+  {
+    sdata.fees.resize(m_fee_slots);
+  }
+
+  const double hpedestal = 60;
+  for (const auto& shit : sdata.hits)
+  {
+    TpcRawHit* tpchit = tpccont->get_hit(shit.index);
+    hitset_data& hitset = sdata.hitsets[shit.layer];
+    const int pad = shit.phibin - hitset.padmin;
+    hitset.padfee[pad] = shit.fee;
 
-    double threshold_cut = m_zs_threshold[region];
+    const double hpedwidth = m_zs_threshold[shit.region];
+    const double threshold_cut = m_zs_threshold[shit.region];
 
-    int nhitschan = 0;
+    fee_baseline* feehist = nullptr;
+    if (m_do_baseline_corr)
+    {
+      feehist = &sdata.fees[shit.fee * 3 + get_rx(shit.layer)];
+      if (feehist->ntbins == 0)
+      {
+        feehist->init(shit.samples + 1);
+      }
+      feehist->filled = true;
+    }
 
     if (m_doChanHitsCut)
     {
+      int nhitschan = 0;
       for (std::unique_ptr<TpcRawHit::AdcIterator> adc_iterator(tpchit->CreateAdcIterator()); !adc_iterator->IsDone(); adc_iterator->Next())
       {
         const uint16_t s = adc_iterator->CurrentTimeBin();
@@ -387,20 +549,14 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
         {
           continue;
         }
-        if (feehist != nullptr)
+        if ((double(adc) - hpedestal) > threshold_cut)
         {
-          if (adc > 0)
-          {
-            if ((double(adc) - hpedestal) > threshold_cut)
-            {
-              nhitschan++;
-            }
-          }
+          nhitschan++;
         }
       }
       if (m_writeTree)
       {
-        m_HitChanDis->Fill(nhitschan, channel);
+        m_HitChanDis->Fill(nhitschan, tpchit->get_channel());
         m_HitsinChan->Fill(nhitschan);
       }
       if (nhitschan > m_ChanHitsCut)
@@ -409,6 +565,7 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
       }
     }
 
+    uint16_t* padadc = hitset.adc.data() + static_cast<size_t>(pad) * hitset.ntbins;
     for (std::unique_ptr<TpcRawHit::AdcIterator> adc_iterator(tpchit->CreateAdcIterator());
          !adc_iterator->IsDone();
          adc_iterator->Next())
@@ -420,212 +577,216 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
       {
         continue;
       }
-      if (feehist != nullptr)
+      if ((double(adc) - hpedestal) <= threshold_cut)
       {
-        if (adc > 0)
-        {
-          if ((double(adc) - hpedestal) > threshold_cut)
-          {
-            feehist->Fill(t, adc - hpedestal);
-            if (t < (int) fee_entries_vec.size())
-            {
-              fee_entries_vec[t]++;
-            }
-          }
-        }
+        continue;
       }
 
-      if ((double(adc) - hpedestal) > threshold_cut)
+      if (feehist && adc > 0)
       {
-        hit_key = TpcDefs::genHitKey(phibin, (unsigned int) t);
-        // find existing hit, or create new one
-        hit = hit_set_container_itr->second->getHit(hit_key);
-        if (!hit)
-        {
-          hit = new TrkrHitv2();
-          hit->setAdc(double(adc) - hpedestal);
-          hit_set_container_itr->second->addHitSpecificKey(hit_key, hit);
-        }
+        feehist->fill(t, adc - hpedestal);
+      }
 
-        if (m_writeTree)
-        {
-          float fXh[18];
-          int nh = 0;
-
-          fXh[nh++] = _ievent - 1;
-          fXh[nh++] = gtm_bco;                  // gtm_bco;
-          fXh[nh++] = packet_id;                // packet_id;
-          fXh[nh++] = ep;                       // ep;
-          fXh[nh++] = mc_sectors[sector % 12];  // Sector;
-          fXh[nh++] = side;
-          fXh[nh++] = fee;
-          fXh[nh++] = channel;  // channel;
-          fXh[nh++] = sampadd;  // sampadd;
-          fXh[nh++] = sampch;   // sampch;
-          fXh[nh++] = (double) phibin;
-          fXh[nh++] = (double) t;
-          fXh[nh++] = layer;
-          fXh[nh++] = (double(adc) - hpedestal);
-          fXh[nh++] = hpedestal;
-          fXh[nh++] = hpedwidth;
-          m_ntup_hits->Fill(fXh);
-        }
+      // keep the first adc seen in a given pad and time bin
+      if (t < hitset.ntbins && padadc[t] == 0)
+      {
+        padadc[t] = adc - hpedestal;
+      }
+
+      if (m_writeTree)
+      {
+        const int32_t packet_id = tpchit->get_packetid();
+        float fXh[18];
+        int nh = 0;
+
+        fXh[nh++] = _ievent - 1;
+        fXh[nh++] = tpchit->get_gtm_bco();    // gtm_bco;
+        fXh[nh++] = packet_id;                // packet_id;
+        fXh[nh++] = (packet_id - 4000) % 10;  // ep;
+        fXh[nh++] = mc_sectors[sector % 12];  // Sector;
+        fXh[nh++] = sector > 11 ? 0 : 1;      // side
+        fXh[nh++] = shit.fee;
+        fXh[nh++] = tpchit->get_channel();       // channel;
+        fXh[nh++] = tpchit->get_sampaaddress();  // sampadd;
+        fXh[nh++] = tpchit->get_sampachannel();  // sampch;
+        fXh[nh++] = (double) shit.phibin;
+        fXh[nh++] = (double) t;
+        fXh[nh++] = shit.layer;
+        fXh[nh++] = (double(adc) - hpedestal);
+        fXh[nh++] = hpedestal;
+        fXh[nh++] = hpedwidth;
+        m_ntup_hits->Fill(fXh);
       }
     }
   }
 
-  if (m_do_baseline_corr == true)
+  if (m_do_baseline_corr)
   {
-    // Histos filled now process them for fee local baselines
+    // every fee seen so far gets a baseline, like when the fee histograms were kept in a map
+    for (int feeslot = 0; feeslot < m_fee_slots; feeslot++)
+    {
+      if (sdata.fees[feeslot].ntbins > 0)
+      {
+        calc_fee_baseline(sdata.fees[feeslot], sector, feeslot);
+      }
+    }
+  }
+}
 
-    int nhistfilled = 0;
-    int nhisttotal = 0;
-    for (auto& hiter : feeadc_map)
+void TpcCombinedRawDataUnpacker::calc_fee_baseline(fee_baseline& feehist, int sector, int feeslot)
+{
+  sector_data& sdata = m_sectors[sector];
+  const int nadcbins = m_baseline_adc_bins + 2;
+  const double binwidth = (m_baseline_adc_max - m_baseline_adc_min) / m_baseline_adc_bins;
+
+  // same as the projection of the time bin from the former TH2C, the peak is averaged over +-3 bins
+  for (int t = 0; t < feehist.ntbins - 1; t++)
+  {
+    sdata.nbaseline_total++;
+    double local_ped = 0;
+    double local_width = 0;
+    const int entries = feehist.entries[t];
+    if (entries > 100)
     {
-      if (hiter.second != nullptr)
+      sdata.nbaseline_filled++;
+
+      const uint8_t* column = feehist.counts.data() + static_cast<size_t>(t) * nadcbins;
+      int colsum = 0;
+      int maxbin = 1;
+      for (int bin = 0; bin < nadcbins; bin++)
       {
-        unsigned int fee_key = hiter.first;
-        unsigned int side;
-        unsigned int sector;
-        unsigned int rx;
-        unsigned int fee;
-        unpack_fee_key(side, sector, rx, fee, fee_key);
-        TH2* hist2d = hiter.second;
-        std::map<unsigned int, std::vector<int>>::iterator fee_entries_it = feeentries_map.find(fee_key);
-        if (fee_entries_it == feeentries_map.end())
+        colsum += column[bin];
+        if (bin > 1 && bin <= m_baseline_adc_bins && column[bin] > column[maxbin])
         {
-          continue;
-          //	  fee_entries_vec_it = (*fee_entries_it).second.begin();
+          maxbin = bin;
         }
-        std::vector<int>::iterator fee_entries_vec_it = (*fee_entries_it).second.begin();
+      }
+      if (colsum > 10)
+      {
+        double hadc_sum = 0.0;
+        double hibin_sum = 0.0;
+        double hibin2_sum = 0.0;
 
-        std::vector<double> pedvec(hist2d->GetNbinsX(), 0);
-        feebaseline_map.insert(std::make_pair(hiter.first, pedvec));
-        std::map<unsigned int, std::vector<double>>::iterator fee_blm_it = feebaseline_map.find(hiter.first);
-        (*fee_blm_it).second.resize(hist2d->GetNbinsX(), 0);
-        for (int binx = 1; binx < hist2d->GetNbinsX(); binx++)
+        for (int isum = -3; isum <= 3; isum++)
         {
-          double timebin = (hist2d->GetXaxis())->GetBinCenter(binx);
-          std::string histname1d = "h" + std::to_string(hiter.first) + "_" + std::to_string((int) timebin);
-          nhisttotal++;
-          double local_ped = 0;
-          double local_width = 0;
-          double entries = fee_entries_vec_it[timebin];
-          if (fee_entries_vec_it[timebin] > 100)
-          {
-            nhistfilled++;
-
-            TH1D* hist1d = hist2d->ProjectionY(histname1d.c_str(), binx, binx);
-            if (hist1d->GetEntries() != fee_entries_vec_it[timebin])
-            {
-              std::cout << " vec " << fee_entries_vec_it[timebin]
-                        << " hist " << hist1d->GetEntries()
-                        << std::endl;
-            }
-            if (hist1d->GetEntries() > 10)
-            {
-              int maxbin = hist1d->GetMaximumBin();
-              // calc peak position
-              double hadc_sum = 0.0;
-              double hibin_sum = 0.0;
-              double hibin2_sum = 0.0;
-
-              for (int isum = -3; isum <= 3; isum++)
-              {
-                double val = hist1d->GetBinContent(maxbin + isum);
-                double center = hist1d->GetBinCenter(maxbin + isum);
-                hibin_sum += center * val;
-                hibin2_sum += center * center * val;
-                hadc_sum += val;
-              }
-              local_ped = hibin_sum / hadc_sum;
-              local_width = sqrt((hibin2_sum / hadc_sum) - (local_ped * local_ped));
-            }
-            delete hist1d;
-          }
-          (*fee_blm_it).second[(int) timebin] = local_ped + m_baseline_nsigma * local_width;
-
-          if (m_writeTree)
+          const int bin = maxbin + isum;
+          if (bin < 0 || bin >= nadcbins)
           {
-            float fXh[11];
-            int nh = 0;
-
-            fXh[nh++] = _ievent - 1;
-            fXh[nh++] = 0;                        // gtm_bco;
-            fXh[nh++] = 0;                        // packet_id;
-            fXh[nh++] = 0;                        // ep;
-            fXh[nh++] = mc_sectors[sector % 12];  // Sector;
-            fXh[nh++] = side;
-            fXh[nh++] = fee;
-            fXh[nh++] = rx;
-            fXh[nh++] = entries;
-            fXh[nh++] = local_ped;
-            fXh[nh++] = local_width;
-            m_ntup->Fill(fXh);
+            continue;
           }
+          double val = column[bin];
+          double center = m_baseline_adc_min + (bin - 0.5) * binwidth;
+          hibin_sum += center * val;
+          hibin2_sum += center * center * val;
+          hadc_sum += val;
         }
+        local_ped = hibin_sum / hadc_sum;
+        local_width = sqrt((hibin2_sum / hadc_sum) - (local_ped * local_ped));
       }
     }
-    if (Verbosity() >= 1)
-    {
-      std::cout << " filled " << nhistfilled
-                << " total " << nhisttotal
-                << std::endl;
+    feehist.baseline[t] = local_ped + m_baseline_nsigma * local_width;
 
-      std::cout << "second loop " << m_do_baseline_corr << std::endl;
+    if (m_writeTree)
+    {
+      float fXh[11];
+      int nh = 0;
+
+      fXh[nh++] = _ievent - 1;
+      fXh[nh++] = 0;                        // gtm_bco;
+      fXh[nh++] = 0;                        // packet_id;
+      fXh[nh++] = 0;                        // ep;
+      fXh[nh++] = mc_sectors[sector % 12];  // Sector;
+      fXh[nh++] = sector > 11 ? 0 : 1;      // side
+      fXh[nh++] = feeslot / 3;              // fee
+      fXh[nh++] = feeslot % 3;              // rx
+      fXh[nh++] = entries;
+      fXh[nh++] = local_ped;
+      fXh[nh++] = local_width;
+      m_ntup->Fill(fXh);
     }
+  }
+
+  // reset for the next event, the baselines are kept until the hits are corrected
+  if (feehist.filled)
+  {
+    std::fill(feehist.counts.begin(), feehist.counts.end(), 0);
+    std::fill(feehist.entries.begin(), feehist.entries.end(), 0);
+    feehist.filled = false;
+  }
+}
 
-    // second loop over hits to apply baseline correction
-    TrkrHitSetContainer::ConstRange hitsetrange;
-    hitsetrange = trkr_hit_set_container->getHitSets(TrkrDefs::TrkrId::tpcId);
+void TpcCombinedRawDataUnpacker::fill_hitsets(int sector, TrkrHitSetContainer* trkr_hit_set_container, RawHitSetContainer* raw_hit_set_container, PHG4TpcGeomContainer* geom_container)
+{
+  sector_data& sdata = m_sectors[sector];
+  const int side = sector > 11 ? 0 : 1;
+  const int mc_sector = mc_sectors[sector % 12];
 
-    for (TrkrHitSetContainer::ConstIterator hitsetitr = hitsetrange.first;
-         hitsetitr != hitsetrange.second;
-         ++hitsetitr)
+  std::vector<uint16_t> column;
+  for (unsigned int layer = 0; layer < sdata.hitsets.size(); layer++)
+  {
+    const hitset_data& hitset = sdata.hitsets[layer];
+    if (!hitset.used)
     {
-      // if(count>0)continue;
-      TrkrHitSet* hitset = hitsetitr->second;
-      unsigned int layer = TrkrDefs::getLayer(hitsetitr->first);
-      int side = TpcDefs::getSide(hitsetitr->first);
-      unsigned int sector = TpcDefs::getSectorId(hitsetitr->first);
+      continue;
+    }
 
-      TrkrHitSet::ConstRange hitrangei = hitset->getHits();
+    // local pad range and time bins as seen by the clusterizer
+    unsigned int npadsector = 0;
+    unsigned int padoffset = 0;
+    unsigned int nzbins = 0;
+    TrkrHitSet* trkrhitset = nullptr;
+    RawHitSet* rawhitset = nullptr;
+    if (trkr_hit_set_container)
+    {
+      trkrhitset = trkr_hit_set_container->findOrAddHitSet(hitset.hitsetkey)->second;
+    }
+    else
+    {
+      PHG4TpcGeom* layergeom = geom_container->GetLayerCellGeom(layer);
+      npadsector = layergeom->get_phibins() / 12;
+      padoffset = npadsector * mc_sector;
+      nzbins = layergeom->get_zbins();
+      rawhitset = raw_hit_set_container->findOrAddHitSet(hitset.hitsetkey)->second;
+      rawhitset->setTpcPhiBins(npadsector);
+    }
 
-      for (TrkrHitSet::ConstIterator hitr = hitrangei.first;
-           hitr != hitrangei.second;
-           ++hitr)
+    const unsigned int rx = get_rx(layer);
+    for (unsigned int pad = 0; pad < hitset.npads(); pad++)
+    {
+      const unsigned int phibin = hitset.padmin + pad;
+      const uint16_t* padadc = hitset.adc.data() + static_cast<size_t>(pad) * hitset.ntbins;
+      const std::vector<double>* baseline = nullptr;
+      if (m_do_baseline_corr)
       {
-        unsigned short phibin = TpcDefs::getPad(hitr->first);
-        unsigned short tbin = TpcDefs::getTBin(hitr->first);
-        unsigned short adc = (hitr->second->getAdc());
-
-        unsigned int pad_key = create_pad_key(side, layer, phibin);
+        baseline = &sdata.fees[hitset.padfee[pad] * 3 + rx].baseline;
+      }
 
-        double fee = 0;
-        std::map<unsigned int, chan_info>::iterator chan_it = chan_map.find(pad_key);
-        if (chan_it != chan_map.end())
+      if (rawhitset)
+      {
+        if (phibin < padoffset || phibin >= padoffset + npadsector)
         {
-          chan_info cinfo = (*chan_it).second;
-          fee = cinfo.fee;
-          // hpedestal2 = cinfo.ped;
-          // hpedwidth2 = cinfo.width;
+          continue;
         }
+        column.assign(std::min<unsigned int>(hitset.ntbins, nzbins), 0);
+      }
 
-        int rx = get_rx(layer);
-        double corr = 0;
+      for (unsigned int t = 0; t < hitset.ntbins; t++)
+      {
+        const uint16_t adc = padadc[t];
+        if (adc == 0)
+        {
+          continue;
+        }
 
-        unsigned int fee_key = create_fee_key(side, sector, rx, fee);
-        std::map<unsigned int, std::vector<double>>::iterator fee_blm_it = feebaseline_map.find(fee_key);
-        if (fee_blm_it != feebaseline_map.end())
+        double nuadc = adc;
+        if (baseline)
         {
-          if (tbin < (int) (*fee_blm_it).second.size())
+          double corr = 0;
+          if (t < baseline->size())
           {
-            corr = (*fee_blm_it).second[tbin];
+            corr = (*baseline)[t];
           }
-          hitr->second->setAdc(0);
-          double nuadc = (double(adc) - corr);
-          nuadc = std::max<double>(nuadc, 0);
-          hitr->second->setAdc(nuadc);
+          nuadc = std::max<double>(double(adc) - corr, 0);
 
           if (m_writeTree)
           {
@@ -633,17 +794,17 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
             int nh = 0;
 
             fXh[nh++] = _ievent - 1;
-            fXh[nh++] = 0;       // gtm_bco;
-            fXh[nh++] = 0;       // packet_id;
-            fXh[nh++] = 0;       // ep;
-            fXh[nh++] = sector;  // mc_sectors[sector % 12];//Sector;
+            fXh[nh++] = 0;          // gtm_bco;
+            fXh[nh++] = 0;          // packet_id;
+            fXh[nh++] = 0;          // ep;
+            fXh[nh++] = mc_sector;  // mc_sectors[sector % 12];//Sector;
             fXh[nh++] = side;
-            fXh[nh++] = fee;
+            fXh[nh++] = hitset.padfee[pad];
             fXh[nh++] = 0;  // channel;
             fXh[nh++] = 0;  // sampadd;
             fXh[nh++] = 0;  // sampch;
             fXh[nh++] = (double) phibin;
-            fXh[nh++] = (double) tbin;
+            fXh[nh++] = (double) t;
             fXh[nh++] = layer;
             fXh[nh++] = double(adc);
             fXh[nh++] = 0;  // hpedestal2;
@@ -653,30 +814,25 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
             m_ntup_hits_corr->Fill(fXh);
           }
         }
+
+        if (trkrhitset)
+        {
+          TrkrHit* hit = new TrkrHitv2();
+          hit->setAdc(nuadc);
+          trkrhitset->addHitSpecificKey(TpcDefs::genHitKey(phibin, t), hit);
+        }
+        else if (t < column.size())
+        {
+          column[t] = static_cast<uint16_t>(nuadc);
+        }
       }
-    }
-  }
-  // reset histogramms
-  for (auto& hiter2 : feeadc_map)
-  {
-    if (hiter2.second != nullptr)
-    {
-      hiter2.second->Reset();
-    }
-  }
-  feebaseline_map.clear();
-  for (auto& hiter_entries : feeentries_map)
-  {
-    hiter_entries.second.assign(hiter_entries.second.size(), 0);
-  }
 
-  if (Verbosity())
-  {
-    std::cout << " event BCO: " << bco_min << " - " << bco_max << std::endl;
-    std::cout << "TpcCombinedRawDataUnpacker:: done" << std::endl;
+      if (rawhitset)
+      {
+        encode_raw_pad(column, *(rawhitset->getHits(phibin - padoffset)));
+      }
+    }
   }
-
-  return Fun4AllReturnCodes::EVENT_OK;
 }
 
 int TpcCombinedRawDataUnpacker::End(PHCompositeNode* /*topNode*/)
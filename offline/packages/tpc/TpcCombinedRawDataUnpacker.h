@@ -5,18 +5,23 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <trackbase/TrkrDefs.h>
+
+#include <cstdint>
 #include <limits>
-#include <map>
 #include <string>
 #include <vector>
 
-
 class CDBInterface;
 class CDBTTree;
+class PHG4TpcGeomContainer;
+class RawHitSetContainer;
 class TFile;
 class TH1;
 class TH2;
 class TNtuple;
+class TpcRawHitContainer;
+class TrkrHitSetContainer;
 
 class TpcCombinedRawDataUnpacker : public SubsysReco
 {
@@ -40,9 +45,19 @@ class TpcCombinedRawDataUnpacker : public SubsysReco
   void set_t0(int b) { m_t0 = b; }
   void set_zs_threshold(int threshold, int region) { m_zs_threshold[region] = threshold; }
   void set_baseline_nsigma(int b) { m_baseline_nsigma = b; }
+  //! number of threads used to unpack the sectors. 0 means all available threads
+  void set_num_threads(int n) { m_num_threads = n; }
   void skipNevent(int b) { startevt = b; }
   void useRawHitNodeName(const std::string &name) { m_TpcRawNodeName = name; }
 
+  //! write the unpacked hits to TRKR_RAWHITSET (read by TpcClusterizer::set_read_raw) instead of TRKR_HITSET
+  /**
+   * the RawHitSet format stores 8 bit adcs with zero runs encoded in the adc stream.
+   * Adcs above 255 are saturated and isolated single time bin hits are dropped,
+   * as they cannot be told apart from a zero run count. This is the same as TpcRawWriter.
+   */
+  void doRawHitSetOutput(bool val) { m_do_rawhitset_output = val; }
+
   void event_range(int a, int b)
   {
     startevt = a;
@@ -85,13 +100,111 @@ class TpcCombinedRawDataUnpacker : public SubsysReco
   }
 
  private:
-  struct chan_info
+  //! number of adc bins of the fee baseline histograms, from -0.5 to 1000.5
+  static constexpr int m_baseline_adc_bins = 501;
+  static constexpr double m_baseline_adc_min = -0.5;
+  static constexpr double m_baseline_adc_max = 1000.5;
+
+  //! fee slots per sector, indexed by fee * 3 + rx
+  static constexpr int m_fee_slots = 26 * 3;
+
+  //! channel mapping from the cdb, cached per 256 * feeM + channel
+  struct chan_cache
   {
-    unsigned int fee = std::numeric_limits<unsigned int>::max();
-    double ped = -1;
-    double width = -1;
-    int entries = 0;
+    bool filled = false;
+    int layer = 0;
+    double phi = 0;
   };
+
+  //! raw hit of a sector, with its resolved mapping
+  struct sector_hit
+  {
+    unsigned int index = 0;  // in the raw hit container
+    uint16_t layer = 0;
+    uint16_t phibin = 0;
+    uint16_t samples = 0;
+    uint8_t region = 0;
+    uint8_t fee = 0;
+  };
+
+  //! dense pad x time bin adc array of one (layer, sector, side) hitset
+  struct hitset_data
+  {
+    TrkrDefs::hitsetkey hitsetkey = 0;
+    bool used = false;
+    uint16_t padmin = std::numeric_limits<uint16_t>::max();
+    uint16_t padmax = 0;
+    uint16_t ntbins = 0;
+    std::vector<uint16_t> adc;   // [pad - padmin][tbin], pedestal subtracted, 0 if no hit
+    std::vector<uint8_t> padfee;  // fee reading each pad
+
+    uint16_t npads() const { return padmax - padmin + 1; }
+  };
+
+  //! time bin x adc histogram of one fee, equivalent to the TH2C used before, in a plain array
+  struct fee_baseline
+  {
+    int ntbins = 0;  // 0 until the fee is first seen
+    bool filled = false;
+    std::vector<uint8_t> counts;  // [tbin][adc bin], adc bins include under and overflow. Saturates at 127 like TH2C
+    std::vector<int> entries;      // [tbin]
+    std::vector<double> baseline;  // [tbin]
+
+    void init(int nt)
+    {
+      ntbins = nt;
+      counts.assign(static_cast<size_t>(nt) * (m_baseline_adc_bins + 2), 0);
+      entries.assign(nt, 0);
+      baseline.assign(nt, 0);
+    }
+
+    //! same binning as TH2C(ntbins, -0.5, ntbins - 0.5, 501, -0.5, 1000.5). Time bins outside the range are not used and dropped
+    void fill(int t, double adc)
+    {
+      if (t >= ntbins)
+      {
+        return;
+      }
+      int bin = 0;
+      if (adc >= m_baseline_adc_max)
+      {
+        bin = m_baseline_adc_bins + 1;
+      }
+      else if (adc >= m_baseline_adc_min)
+      {
+        bin = 1 + static_cast<int>(m_baseline_adc_bins * (adc - m_baseline_adc_min) / (m_baseline_adc_max - m_baseline_adc_min));
+      }
+      uint8_t &count = counts[static_cast<size_t>(t) * (m_baseline_adc_bins + 2) + bin];
+      if (count < 127)
+      {
+        ++count;
+      }
+      ++entries[t];
+    }
+  };
+
+  //! everything read out by one packet sector (0 - 23), unpacked independently of the other sectors
+  struct sector_data
+  {
+    std::vector<sector_hit> hits;
+    std::vector<hitset_data> hitsets;  // indexed by layer
+    std::vector<fee_baseline> fees;    // indexed by fee * 3 + rx
+    int nbaseline_filled = 0;
+    int nbaseline_total = 0;
+  };
+
+  //! resolve the mapping of all raw hits and distribute them to their sector
+  void map_raw_hits(TpcRawHitContainer *, PHG4TpcGeomContainer *);
+
+  //! fill the dense adc arrays and fee histograms of one sector, and calculate its fee baselines
+  void unpack_sector(TpcRawHitContainer *, int sector);
+
+  //! calculate the baselines of one fee from its histogram
+  void calc_fee_baseline(fee_baseline &, int sector, int feeslot);
+
+  //! copy the dense arrays of one sector to the output containers, applying the baseline correction
+  void fill_hitsets(int sector, TrkrHitSetContainer *, RawHitSetContainer *, PHG4TpcGeomContainer *);
+
   TNtuple *m_ntup{nullptr};
   TNtuple *m_ntup_hits{nullptr};
   TNtuple *m_ntup_hits_corr{nullptr};
@@ -119,13 +232,15 @@ class TpcCombinedRawDataUnpacker : public SubsysReco
   bool m_do_baseline_corr{false};
   int m_baseline_nsigma{2};
   bool m_do_zs_emulation{false};
+  bool m_do_rawhitset_output{false};
+  int m_num_threads{1};
   int m_zs_threshold[3] = {20}; // zs per TPC region
   std::string m_TpcRawNodeName{"TPCRAWHIT"};
   std::string outfile_name;
-  std::map<unsigned int, chan_info> chan_map;                  // stays in place
-  std::map<unsigned int, TH2 *> feeadc_map;                    // histos reset after each event
-  std::map<unsigned int, std::vector<int>> feeentries_map;     // cleared after each event
-  std::map<unsigned int, std::vector<double>> feebaseline_map;  // cleared after each event
+  std::vector<chan_cache> m_chan_cache;   // stays in place
+  std::vector<sector_data> m_sectors;     // buffers reused, cleared after each event
+  uint64_t m_bco_min{0};
+  uint64_t m_bco_max{0};
 };
 
 #endif  // TPC_COMBINEDRAWDATAUNPACKER_H
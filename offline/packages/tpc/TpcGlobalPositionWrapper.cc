@@ -15,6 +15,9 @@
 #include <trackbase/TpcDefs.h>
 #include <trackbase/TrkrCluster.h>
 
+#include <climits>
+#include <cstdint>
+
 //____________________________________________________________________________________________________________________
 void TpcGlobalPositionWrapper::loadNodes( PHCompositeNode* topNode )
 {
@@ -43,6 +46,71 @@ void TpcGlobalPositionWrapper::loadNodes( PHCompositeNode* topNode )
   {
     std::cout << "TpcGlobalPositionWrapper::loadNodes - found fluctuation TPC distortion correction container" << std::endl;
   }
+
+  // cluster global position cache
+  m_cache = m_use_cache ? findNode::getClass<TrkrClusterGlobalPositionCache>(topNode, cacheNodeName) : nullptr;
+  if (m_cache && m_verbosity > 0)
+  {
+    std::cout << "TpcGlobalPositionWrapper::loadNodes - found cluster global position cache" << std::endl;
+  }
+}
+
+//____________________________________________________________________________________________________________________
+uint64_t TpcGlobalPositionWrapper::configuration() const
+{
+  // combine geometry and enabled correction containers
+  uint64_t out = 0;
+  auto combine = [&out](const void* pointer)
+  {
+    const auto value = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(pointer));
+    out ^= value + 0x9e3779b97f4a7c15ULL + (out << 6U) + (out >> 2U);
+  };
+
+  combine(m_tGeometry);
+  combine(m_enable_module_edge_corr ? m_dcc_module_edge : nullptr);
+  combine(m_enable_static_corr ? m_dcc_static : nullptr);
+  combine(m_enable_average_corr ? m_dcc_average : nullptr);
+  combine(m_enable_fluctuation_corr ? m_dcc_fluctuation : nullptr);
+  return out;
+}
+
+//____________________________________________________________________________________________________________________
+const TrkrClusterGlobalPositionCache::Entry* TpcGlobalPositionWrapper::findCacheEntry(const TrkrDefs::cluskey& key, TrkrCluster* cluster) const
+{
+  if (!m_cache || !m_cache->isValid() || m_cache->configuration() != configuration())
+  {
+    return nullptr;
+  }
+  return m_cache->find(key, cluster);
+}
+
+//____________________________________________________________________________________________________________________
+void TpcGlobalPositionWrapper::fillCache(TrkrClusterGlobalPositionCache* cache, const TrkrDefs::cluskey& key, TrkrCluster* cluster) const
+{
+  if (!m_tGeometry || !cluster)
+  {
+    return;
+  }
+
+  const Acts::Vector3 global = m_tGeometry->getGlobalPosition(key, cluster);
+  cache->set(key, cluster, global, applyCorrections(key, global, 0));
+}
+
+//____________________________________________________________________________________________________________________
+Acts::Vector3 TpcGlobalPositionWrapper::getGlobalPosition(const TrkrDefs::cluskey& key, TrkrCluster* cluster) const
+{
+  if (const auto* entry = findCacheEntry(key, cluster))
+  {
+    return entry->global;
+  }
+
+  if (!m_tGeometry)
+  {
+    std::cout << "TpcGlobalPositionWrapper::getGlobalPosition - m_tGeometry not set" << std::endl;
+    return {0, 0, 0};
+  }
+
+  return m_tGeometry->getGlobalPosition(key, cluster);
 }
 
 //____________________________________________________________________________________________________________________
@@ -76,6 +144,12 @@ Acts::Vector3 TpcGlobalPositionWrapper::applyDistortionCorrections(Acts::Vector3
 Acts::Vector3 TpcGlobalPositionWrapper::getGlobalPositionDistortionCorrected(const TrkrDefs::cluskey& key, TrkrCluster* cluster, short int crossing ) const
 {
 
+  // use cached positions when available
+  if (const auto* entry = findCacheEntry(key, cluster))
+  {
+    return crossing == 0 ? entry->corrected : applyCorrections(key, entry->global, crossing);
+  }
+
   if( !m_tGeometry )
   {
     std::cout << "TpcGlobalPositionWrapper::getGlobalPositionDistortionCorrected - m_tGeometry not set" << std::endl;
@@ -83,8 +157,12 @@ Acts::Vector3 TpcGlobalPositionWrapper::getGlobalPositionDistortionCorrected(con
   }
 
   // get global position from acts
-  Acts::Vector3 global = m_tGeometry->getGlobalPosition(key, cluster);
+  return applyCorrections(key, m_tGeometry->getGlobalPosition(key, cluster), crossing);
+}
 
+//____________________________________________________________________________________________________________________
+Acts::Vector3 TpcGlobalPositionWrapper::applyCorrections(const TrkrDefs::cluskey& key, Acts::Vector3 global, short int crossing) const
+{
   // make sure cluster is from TPC
   if( TrkrDefs::getTrkrId(key) == TrkrDefs::TrkrId::tpcId )
   {
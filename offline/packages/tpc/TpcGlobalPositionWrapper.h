@@ -8,8 +8,11 @@
  */
 #include "TpcDistortionCorrection.h"
 
+#include <trackbase/TrkrClusterGlobalPositionCache.h>
 #include <trackbase/TrkrDefs.h>
 
+#include <cstdint>
+
 
 class ActsGeometry;
 class PHCompositeNode;
@@ -43,6 +46,9 @@ class TpcGlobalPositionWrapper
   //! load relevant nodes from tree
   void loadNodes(PHCompositeNode* /*topnode*/);
 
+  //! enable use of the per event cluster global position cache, if found on the node tree. Default is true
+  void set_use_cache(bool value) { m_use_cache = value; }
+
   void set_enable_module_edge_corr(bool flag) { m_enable_module_edge_corr = flag; }
   void set_enable_static_corr(bool flag) { m_enable_static_corr = flag; }
   void set_enable_average_corr(bool flag) { m_enable_average_corr = flag; }
@@ -58,8 +64,28 @@ class TpcGlobalPositionWrapper
    */
   Acts::Vector3 getGlobalPositionDistortionCorrected(const TrkrDefs::cluskey&, TrkrCluster*, short int /*crossing*/ ) const;
 
+  //! get global position from cluster, without any correction
+  /** uses the cluster global position cache when available */
+  Acts::Vector3 getGlobalPosition(const TrkrDefs::cluskey&, TrkrCluster*) const;
+
+  //! fill cache entry for a given cluster. Thread safe for different clusters
+  /** storage for the cluster hitset must have been reserved in the cache */
+  void fillCache(TrkrClusterGlobalPositionCache*, const TrkrDefs::cluskey&, TrkrCluster*) const;
+
+  //! tag identifying geometry and enabled distortion corrections, used to validate the cache
+  uint64_t configuration() const;
+
+  //! name of the cluster global position cache node
+  static constexpr const char* cacheNodeName = "TRKR_CLUSTER_GLOBALPOSITION";
+
   private:
 
+  //! apply crossing and distortion corrections to global position, for TPC clusters
+  Acts::Vector3 applyCorrections(const TrkrDefs::cluskey&, Acts::Vector3 /*global*/, short int /*crossing*/) const;
+
+  //! return matching cache entry if any
+  const TrkrClusterGlobalPositionCache::Entry* findCacheEntry(const TrkrDefs::cluskey&, TrkrCluster*) const;
+
   //! verbosity
   unsigned int m_verbosity = 0;
 
@@ -87,6 +113,10 @@ class TpcGlobalPositionWrapper
   TpcDistortionCorrectionContainer* m_dcc_fluctuation{nullptr};
   bool m_enable_fluctuation_corr = true;
 
+  //! cluster global position cache
+  TrkrClusterGlobalPositionCache* m_cache{nullptr};
+  bool m_use_cache = true;
+
 };
 
 #endif
@@ -11,6 +11,10 @@
 #include <Eigen/Geometry>
 #include <Eigen/LU>
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 namespace
 {
   /// square
@@ -26,8 +30,69 @@ namespace
   {
     return std::sqrt(square(x) + square(y));
   }
+
+  /// phi cell of the TPC surface phi tables, for phi in [-pi, pi]
+  unsigned int tpc_phi_cell(double phi, unsigned int ncells)
+  {
+    const int cell = std::floor((phi + M_PI) / (2.0 * M_PI) * ncells);
+    return std::clamp<int>(cell, 0, ncells - 1);
+  }
 }  // namespace
 
+//________________________________________________________________________________________________
+void ActsGeometry::buildTpcSurfacePhiTable()
+{
+  m_tpc_phi_tables.clear();
+  m_tpc_phi_cells = 0;
+
+  const double surfStepPhi = m_tGeometry.tpcSurfStepPhi;
+  if (!m_has_tpc_world_envelope_transform || m_surfMaps.m_tpcSurfaceMap.empty() || !(surfStepPhi > 0))
+  {
+    return;
+  }
+
+  // cells of half a surface step, each surface is listed in all cells within one step
+  // of its center. A position only matches surfaces within half a step, so surface
+  // centers can move by up to half a step (alignment) without missing a candidate.
+  // The full scan in get_tpc_surface_from_coords remains the fallback
+  m_tpc_phi_cells = std::max<int>(1, std::ceil(2.0 * M_PI / (surfStepPhi / 2.0)));
+  const double cellWidth = 2.0 * M_PI / m_tpc_phi_cells;
+
+  for (const auto& [layer, surf_vec] : m_surfMaps.m_tpcSurfaceMap)
+  {
+    if (layer >= m_tpc_phi_tables.size())
+    {
+      m_tpc_phi_tables.resize(layer + 1);
+    }
+
+    std::vector<std::vector<unsigned int>> cells(m_tpc_phi_cells);
+    for (unsigned int isurf = 0; isurf < surf_vec.size(); ++isurf)
+    {
+      auto surf_center = surf_vec[isurf]->center(m_tGeometry.getGeoContext());
+      surf_center /= 10.0;  // convert from mm to cm
+      const Acts::Vector3 surf_center_envelope = transformTpcWorldToEnvelope(surf_center);
+      const double surf_phi = atan2(surf_center_envelope[1], surf_center_envelope[0]);
+
+      const int first = std::floor((surf_phi - surfStepPhi + M_PI) / cellWidth);
+      const int last = std::floor((surf_phi + surfStepPhi + M_PI) / cellWidth);
+      for (int cell = first; cell <= last && cell - first < static_cast<int>(m_tpc_phi_cells); ++cell)
+      {
+        const int ncells = m_tpc_phi_cells;
+        cells[((cell % ncells) + ncells) % ncells].push_back(isurf);
+      }
+    }
+
+    auto& table = m_tpc_phi_tables[layer];
+    table.nsurfaces = surf_vec.size();
+    table.offsets.assign(1, 0);
+    for (const auto& cell : cells)
+    {
+      table.indices.insert(table.indices.end(), cell.begin(), cell.end());
+      table.offsets.push_back(table.indices.size());
+    }
+  }
+}
+
 //________________________________________________________________________________________________
 Acts::Vector3 ActsGeometry::getGlobalPosition(TrkrDefs::cluskey key, TrkrCluster* cluster) const
 {
@@ -175,8 +240,48 @@ Surface ActsGeometry::get_tpc_surface_from_coords(
   const auto& surf_vec = mapIter->second;
   unsigned int surf_index = 999;
 
+  // test a surface the way the full scan below does, returns true if it contains the position
+  auto matches = [&](unsigned int isurf)
+  {
+    Surface this_surf = surf_vec[isurf];
+    auto surf_center = this_surf->center(m_tGeometry.getGeoContext());
+    surf_center /= 10.0;  // convert from mm to cm
+    Acts::Vector3 surf_center_envelope = transformTpcWorldToEnvelope(surf_center);
+    double surf_phi = atan2(surf_center_envelope[1], surf_center_envelope[0]);
+    const double dphi = std::atan2(std::sin(world_phi - surf_phi), std::cos(world_phi - surf_phi));
+    if (std::abs(dphi) >= m_tGeometry.tpcSurfStepPhi / 2.0)
+    {
+      return false;
+    }
+    if (surf_center_envelope.z() < 0 && side != 0)
+    {
+      return false;
+    }
+    if (surf_center_envelope.z() > 0 && side != 1)
+    {
+      return false;
+    }
+    return true;
+  };
+
+  // only test the surfaces close in phi, in the same order as the full scan
+  if (layer < m_tpc_phi_tables.size() && m_tpc_phi_tables[layer].nsurfaces == surf_vec.size())
+  {
+    const auto& table = m_tpc_phi_tables[layer];
+    const unsigned int cell = tpc_phi_cell(world_phi, m_tpc_phi_cells);
+    for (unsigned int i = table.offsets[cell]; i < table.offsets[cell + 1]; ++i)
+    {
+      if (matches(table.indices[i]))
+      {
+        surf_index = table.indices[i];
+        subsurfkey = surf_index;
+        return surf_vec[surf_index];
+      }
+    }
+  }
+
   // Apparently, tilting the TPC leads to the surfaces not being sorted in phi in the outer layers
-  // just test all surfaces in each layer for now
+  // just test all surfaces in each layer if there is no table, or the table has no match
   for(unsigned int isurf = 0; isurf < surf_vec.size(); ++isurf)
     {
       Surface this_surf = surf_vec[isurf];
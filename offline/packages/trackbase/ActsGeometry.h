@@ -5,6 +5,8 @@
 
 #include <Acts/Definitions/Units.hpp>
 
+#include <vector>
+
 class TrkrCluster;
 
 class ActsGeometry
@@ -15,11 +17,14 @@ class ActsGeometry
   void setGeometry(const ActsTrackingGeometry& tGeometry)
   {
     m_tGeometry = tGeometry;
+    buildTpcSurfacePhiTable();
   }
 
   void setSurfMaps(const ActsSurfaceMaps& surfMaps)
   {
     m_surfMaps = surfMaps;
+    m_surfMaps.buildLookupTables();
+    buildTpcSurfacePhiTable();
   }
 
   //! const accessor
@@ -51,7 +56,12 @@ class ActsGeometry
   void set_CM_halfwidth(double val) { _CM_halfwidth = val; }
   void set_tpc_tzero(double tz) { _tpc_tzero = tz; }
   void set_sampa_tzero_bias(double tzb) { _sampa_tzero_bias = tzb; }
-  void set_tpc_world_envelope_transform(Acts::Transform3 transf) { m_tpc_world_envelope_transform = transf; }
+  void set_tpc_world_envelope_transform(Acts::Transform3 transf)
+  {
+    m_tpc_world_envelope_transform = transf;
+    m_has_tpc_world_envelope_transform = true;
+    buildTpcSurfacePhiTable();
+  }
 
   double get_tpc_tzero() const { return _tpc_tzero; }
   double get_sampa_tzero_bias() const { return _sampa_tzero_bias; }
@@ -85,6 +95,21 @@ class ActsGeometry
   Acts::Vector2 getLocalCoords(TrkrDefs::cluskey key, TrkrCluster* cluster, short int crossing) const;
 
  private:
+  //! fill the TPC surface candidates per phi cell used by get_tpc_surface_from_coords
+  void buildTpcSurfacePhiTable();
+
+  //! TPC surface candidates of one layer, for each phi cell the indices of the
+  //! surfaces that can contain a position in this cell, in ascending order
+  struct TpcPhiTable
+  {
+    size_t nsurfaces = 0;
+    std::vector<unsigned int> offsets;  // cell begin in indices, size ncells + 1
+    std::vector<unsigned int> indices;
+  };
+  unsigned int m_tpc_phi_cells = 0;
+  std::vector<TpcPhiTable> m_tpc_phi_tables;  // indexed by layer
+  bool m_has_tpc_world_envelope_transform = false;
+
   ActsTrackingGeometry m_tGeometry;
   ActsSurfaceMaps m_surfMaps;
   Acts::Transform3 m_tpc_world_envelope_transform;
@@ -12,6 +12,8 @@
 #include <Acts/Definitions/Units.hpp>
 #include <Acts/Surfaces/Surface.hpp>
 
+#include <algorithm>
+
 namespace
 {
   /// square
@@ -31,19 +33,155 @@ namespace
 
 bool ActsSurfaceMaps::isTpcSurface(const Acts::Surface* surface) const
 {
+  if (m_hasLookupTables)
+  {
+    return hasVolumeFlag(surface, kTpcVolume);
+  }
   return m_tpcVolumeIds.find(surface->geometryId().volume()) != m_tpcVolumeIds.end();
 }
 
 bool ActsSurfaceMaps::isSiSurface(const Acts::Surface* surface) const
 {
+  if (m_hasLookupTables)
+  {
+    return hasVolumeFlag(surface, kSiVolume);
+  }
   return m_siVolumeIds.find(surface->geometryId().volume()) != m_siVolumeIds.end();
 }
 
 bool ActsSurfaceMaps::isMicromegasSurface(const Acts::Surface* surface) const
 {
+  if (m_hasLookupTables)
+  {
+    return hasVolumeFlag(surface, kMicromegasVolume);
+  }
   return m_micromegasVolumeIds.find(surface->geometryId().volume()) != m_micromegasVolumeIds.end();
 }
 
+bool ActsSurfaceMaps::hasVolumeFlag(const Acts::Surface* surface, unsigned char flag) const
+{
+  const auto volume = surface->geometryId().volume();
+  return volume < m_volumeFlags.size() && (m_volumeFlags[volume] & flag);
+}
+
+std::pair<unsigned int, unsigned int> ActsSurfaceMaps::element_indices(TrkrDefs::hitsetkey hitsetkey)
+{
+  switch (TrkrDefs::getTrkrId(hitsetkey))
+  {
+  case TrkrDefs::TrkrId::mvtxId:
+    return {MvtxDefs::getStaveId(hitsetkey), MvtxDefs::getChipId(hitsetkey)};
+
+  case TrkrDefs::TrkrId::inttId:
+    return {InttDefs::getLadderZId(hitsetkey), InttDefs::getLadderPhiId(hitsetkey)};
+
+  default:
+    // micromegas: segmentation and tile
+    return {TrkrDefs::getPhiElement(hitsetkey), TrkrDefs::getZElement(hitsetkey)};
+  }
+}
+
+void ActsSurfaceMaps::buildLookupTables()
+{
+  m_hasLookupTables = false;
+  m_elementTables.clear();
+  m_tpcSurfaceTable.clear();
+  m_volumeFlags.clear();
+
+  // silicon and micromegas: size the layer tables
+  bool consistent = true;
+  for (const auto* surfaceMap : {&m_siliconSurfaceMap, &m_mmSurfaceMap})
+  {
+    for (const auto& [hitsetkey, surface] : *surfaceMap)
+    {
+      const unsigned int layer = TrkrDefs::getLayer(hitsetkey);
+      const auto trkrid = static_cast<TrkrDefs::TrkrId>(TrkrDefs::getTrkrId(hitsetkey));
+      const auto [row, col] = element_indices(hitsetkey);
+      if (layer >= m_elementTables.size())
+      {
+        m_elementTables.resize(layer + 1);
+      }
+      auto& table = m_elementTables[layer];
+      if (table.nrows == 0)
+      {
+        table.trkrid = trkrid;
+      }
+      consistent &= (table.trkrid == trkrid);
+      table.nrows = std::max(table.nrows, row + 1);
+      table.ncols = std::max(table.ncols, col + 1);
+    }
+  }
+
+  // a layer shared by several detectors cannot be indexed, keep using the maps
+  if (!consistent)
+  {
+    std::cout << "ActsSurfaceMaps::buildLookupTables - inconsistent layer assignment, not using lookup tables" << std::endl;
+    m_elementTables.clear();
+    return;
+  }
+
+  for (auto& table : m_elementTables)
+  {
+    table.surfaces.resize(static_cast<size_t>(table.nrows) * table.ncols);
+  }
+
+  for (const auto* surfaceMap : {&m_siliconSurfaceMap, &m_mmSurfaceMap})
+  {
+    for (const auto& [hitsetkey, surface] : *surfaceMap)
+    {
+      auto& table = m_elementTables[TrkrDefs::getLayer(hitsetkey)];
+      const auto [row, col] = element_indices(hitsetkey);
+      table.surfaces[row * table.ncols + col] = surface;
+    }
+  }
+
+  for (const auto& [layer, surfaceVector] : m_tpcSurfaceMap)
+  {
+    if (layer >= m_tpcSurfaceTable.size())
+    {
+      m_tpcSurfaceTable.resize(layer + 1);
+    }
+    m_tpcSurfaceTable[layer] = surfaceVector;
+  }
+
+  auto fill_volume_flags = [this](const std::set<int>& volumeIds, unsigned char flag)
+  {
+    for (const int volume : volumeIds)
+    {
+      if (volume < 0)
+      {
+        continue;
+      }
+      if (static_cast<size_t>(volume) >= m_volumeFlags.size())
+      {
+        m_volumeFlags.resize(volume + 1, 0);
+      }
+      m_volumeFlags[volume] |= flag;
+    }
+  };
+  fill_volume_flags(m_tpcVolumeIds, kTpcVolume);
+  fill_volume_flags(m_siVolumeIds, kSiVolume);
+  fill_volume_flags(m_micromegasVolumeIds, kMicromegasVolume);
+
+  m_hasLookupTables = true;
+}
+
+Surface ActsSurfaceMaps::getElementSurface(TrkrDefs::hitsetkey hitsetkey) const
+{
+  const unsigned int layer = TrkrDefs::getLayer(hitsetkey);
+  if (layer >= m_elementTables.size())
+  {
+    return nullptr;
+  }
+
+  const auto& table = m_elementTables[layer];
+  const auto [row, col] = element_indices(hitsetkey);
+  if (table.trkrid != TrkrDefs::getTrkrId(hitsetkey) || row >= table.nrows || col >= table.ncols)
+  {
+    return nullptr;
+  }
+  return table.surfaces[row * table.ncols + col];
+}
+
 Surface ActsSurfaceMaps::getSurface(TrkrDefs::cluskey key,
                                     TrkrCluster* cluster) const
 {
@@ -93,11 +231,24 @@ Surface ActsSurfaceMaps::getSiliconSurface(TrkrDefs::hitsetkey hitsetkey) const
 
   // std::cout << "tmpkey = " << tmpkey << std::endl;
 
-  auto iter = m_siliconSurfaceMap.find(tmpkey);
-  if (iter != m_siliconSurfaceMap.end())
+  if (m_hasLookupTables)
+  {
+    if (trkrid == TrkrDefs::mvtxId || trkrid == TrkrDefs::inttId)
+    {
+      if (auto surface = getElementSurface(tmpkey))
+      {
+        return surface;
+      }
+    }
+  }
+  else
   {
-    // std::cout << "Found silicon surface for hitsetkey " << hitsetkey << " tmpkey " << tmpkey << std::endl;
-    return iter->second;
+    auto iter = m_siliconSurfaceMap.find(tmpkey);
+    if (iter != m_siliconSurfaceMap.end())
+    {
+      // std::cout << "Found silicon surface for hitsetkey " << hitsetkey << " tmpkey " << tmpkey << std::endl;
+      return iter->second;
+    }
   }
 
   /// If it can't be found, return nullptr
@@ -111,12 +262,20 @@ Surface ActsSurfaceMaps::getTpcSurface(TrkrDefs::hitsetkey hitsetkey,
                                        TrkrDefs::subsurfkey surfkey) const
 {
   unsigned int layer = TrkrDefs::getLayer(hitsetkey);
+  if (m_hasLookupTables)
+  {
+    if (layer < m_tpcSurfaceTable.size() && !m_tpcSurfaceTable[layer].empty())
+    {
+      return m_tpcSurfaceTable[layer].at(surfkey);
+    }
+    return nullptr;
+  }
+
   const auto iter = m_tpcSurfaceMap.find(layer);
 
   if (iter != m_tpcSurfaceMap.end())
   {
-    auto surfvec = iter->second;
-    return surfvec.at(surfkey);
+    return iter->second.at(surfkey);
   }
 
   /// If it can't be found, return nullptr to skip this cluster
@@ -125,6 +284,11 @@ Surface ActsSurfaceMaps::getTpcSurface(TrkrDefs::hitsetkey hitsetkey,
 
 Surface ActsSurfaceMaps::getMMSurface(TrkrDefs::hitsetkey hitsetkey) const
 {
+  if (m_hasLookupTables)
+  {
+    return TrkrDefs::getTrkrId(hitsetkey) == TrkrDefs::micromegasId ? getElementSurface(hitsetkey) : nullptr;
+  }
+
   const auto iter = m_mmSurfaceMap.find(hitsetkey);
   return (iter == m_mmSurfaceMap.end()) ? nullptr : iter->second;
 }
@@ -24,6 +24,7 @@ class TrkrCluster;
 #include <map>
 #include <memory>
 #include <set>
+#include <utility>
 #include <vector>
 
 using Surface = std::shared_ptr<const Acts::Surface>;
@@ -52,6 +53,10 @@ struct ActsSurfaceMaps
 
   Surface getMMSurface(TrkrDefs::hitsetkey hitsetkey) const;
 
+  //! build the dense lookup tables below from the maps and volume id sets.
+  /** must be called again if these are modified. Until then, lookups use the maps directly */
+  void buildLookupTables();
+
   //! map hitset to Surface for the silicon detectors (MVTX and INTT)
   std::map<TrkrDefs::hitsetkey, Surface> m_siliconSurfaceMap;
 
@@ -75,6 +80,41 @@ struct ActsSurfaceMaps
   //! stores all acts volume ids relevant to the micromegas
   /** it is used to quickly tell if a given Acts Surface belongs to micromegas */
   std::set<int> m_micromegasVolumeIds;
+
+  //! dense lookup tables, filled by buildLookupTables
+  //@{
+  bool m_hasLookupTables = false;
+
+  //! silicon and micromegas surfaces of one layer, indexed by row * ncols + col (see element_indices)
+  struct ElementTable
+  {
+    TrkrDefs::TrkrId trkrid = TrkrDefs::TrkrId::mvtxId;
+    unsigned int nrows = 0;
+    unsigned int ncols = 0;
+    SurfaceVec surfaces;
+  };
+  std::vector<ElementTable> m_elementTables;  // indexed by layer
+
+  //! TPC surface vectors indexed by layer
+  std::vector<SurfaceVec> m_tpcSurfaceTable;
+
+  //! subsystem flags ( kTpcVolume, kSiVolume, kMicromegasVolume ) indexed by Acts volume id
+  enum VolumeFlag : unsigned char
+  {
+    kTpcVolume = 1U << 0U,
+    kSiVolume = 1U << 1U,
+    kMicromegasVolume = 1U << 2U
+  };
+  std::vector<unsigned char> m_volumeFlags;
+  //@}
+
+  //! row and column of a silicon or micromegas hitsetkey in its layer table:
+  /** ( stave, chip ) for MVTX, ( ladder z, ladder phi ) for INTT, ( segmentation, tile ) for micromegas */
+  static std::pair<unsigned int, unsigned int> element_indices(TrkrDefs::hitsetkey hitsetkey);
+
+ private:
+  bool hasVolumeFlag(const Acts::Surface* surface, unsigned char flag) const;
+  Surface getElementSurface(TrkrDefs::hitsetkey hitsetkey) const;
 };
 
 #endif
@@ -8,6 +8,8 @@
 #include "TrkrCluster.h"
 #include "TrkrDefs.h"
 
+#include <phool/PHEventArena.h>
+
 #include <algorithm>
 
 namespace
@@ -23,7 +25,7 @@ void TrkrClusterContainerv4::Reset()
   {
     for (auto&& cluster : clus_vector)
     {
-      delete cluster;
+      PHEventArena::Destroy(cluster);
     }
   }
 
@@ -84,7 +86,7 @@ void TrkrClusterContainerv4::removeCluster(TrkrDefs::cluskey key)
     if (index < clus_vector.size())
     {
       // delete corresponding element and set to null
-      delete clus_vector[index];
+      PHEventArena::Destroy(clus_vector[index]);
       clus_vector[index] = nullptr;
     }
   }
@@ -101,7 +103,7 @@ void TrkrClusterContainerv4::removeClusters(TrkrDefs::hitsetkey hitsetkey)
 
   // delete all clusters
   for( auto&& cluster:iter->second)
-  { delete cluster; }
+  { PHEventArena::Destroy(cluster); }
 
   // remove from map
   m_clusmap.erase(iter);
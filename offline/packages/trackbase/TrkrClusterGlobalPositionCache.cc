@@ -0,0 +1,91 @@
+/**
+ * @file trackbase/TrkrClusterGlobalPositionCache.cc
+ * @brief transient per event storage of cluster global positions
+ */
+
+#include "TrkrClusterGlobalPositionCache.h"
+
+//_________________________________________________________________
+void TrkrClusterGlobalPositionCache::identify(std::ostream& os) const
+{
+  os << "TrkrClusterGlobalPositionCache - valid: " << m_valid
+     << " configuration: " << m_configuration
+     << " hitsets: " << m_entries.size()
+     << " entries: " << size()
+     << std::endl;
+}
+
+//_________________________________________________________________
+void TrkrClusterGlobalPositionCache::Reset()
+{
+  // keep per hitset allocations from one event to the next
+  for (auto& [hitsetkey, entries] : m_entries)
+  {
+    entries.clear();
+  }
+  m_valid = false;
+}
+
+//_________________________________________________________________
+void TrkrClusterGlobalPositionCache::reserve(TrkrDefs::hitsetkey hitsetkey, unsigned int size)
+{
+  auto& entries = m_entries[hitsetkey];
+  entries.clear();
+  entries.resize(size);
+}
+
+//_________________________________________________________________
+void TrkrClusterGlobalPositionCache::set(TrkrDefs::cluskey key, const TrkrCluster* cluster, const Acts::Vector3& global, const Acts::Vector3& corrected)
+{
+  const auto iter = m_entries.find(TrkrDefs::getHitSetKeyFromClusKey(key));
+  if (iter == m_entries.end())
+  {
+    return;
+  }
+
+  const auto index = TrkrDefs::getClusIndex(key);
+  if (index >= iter->second.size())
+  {
+    return;
+  }
+
+  auto& entry = iter->second[index];
+  entry.cluster = cluster;
+  entry.global = global;
+  entry.corrected = corrected;
+}
+
+//_________________________________________________________________
+const TrkrClusterGlobalPositionCache::Entry* TrkrClusterGlobalPositionCache::find(TrkrDefs::cluskey key, const TrkrCluster* cluster) const
+{
+  if (!m_valid)
+  {
+    return nullptr;
+  }
+
+  const auto iter = m_entries.find(TrkrDefs::getHitSetKeyFromClusKey(key));
+  if (iter == m_entries.end())
+  {
+    return nullptr;
+  }
+
+  const auto index = TrkrDefs::getClusIndex(key);
+  if (index >= iter->second.size())
+  {
+    return nullptr;
+  }
+
+  const auto& entry = iter->second[index];
+  return (cluster && entry.cluster == cluster) ? &entry : nullptr;
+}
+
+//_________________________________________________________________
+std::size_t TrkrClusterGlobalPositionCache::size() const
+{
+  std::size_t out = 0;
+  for (const auto& [hitsetkey, entries] : m_entries)
+  {
+    out += entries.size();
+  }
+  return out;
+}
@@ -0,0 +1,92 @@
+#ifndef TRACKBASE_TRKRCLUSTERGLOBALPOSITIONCACHE_H
+#define TRACKBASE_TRKRCLUSTERGLOBALPOSITIONCACHE_H
+
+/**
+ * @file trackbase/TrkrClusterGlobalPositionCache.h
+ * @brief transient per event storage of cluster global positions
+ */
+
+#include "TrkrDefs.h"
+
+#include <Acts/Definitions/Algebra.hpp>
+
+#include <phool/PHObject.h>
+
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <vector>
+
+class TrkrCluster;
+
+/**
+ * @brief Transient per event cache of cluster global positions
+ *
+ * Entries are stored in dense arrays, one per hitset, indexed by the cluster index,
+ * in parallel to the cluster container. For each cluster it stores the aligned global position
+ * from ActsGeometry and the global position corrected for crossing zero and all TPC distortions.
+ * The cluster pointer is stored as well so that stale entries are never returned.
+ *
+ * The configuration tag identifies the geometry and set of corrections used to fill the cache.
+ * Consumers only use the cache if their own configuration matches.
+ * The cache is transient: it lives in a PHDataNode and is reset at the end of every event.
+ */
+class TrkrClusterGlobalPositionCache : public PHObject
+{
+ public:
+  //! single cluster entry
+  struct Entry
+  {
+    //! cluster for which the entry was filled
+    const TrkrCluster* cluster = nullptr;
+
+    //! global position, from ActsGeometry
+    Acts::Vector3 global = Acts::Vector3::Zero();
+
+    //! global position, with crossing zero and distortion corrections applied
+    Acts::Vector3 corrected = Acts::Vector3::Zero();
+  };
+
+  TrkrClusterGlobalPositionCache() = default;
+  ~TrkrClusterGlobalPositionCache() override = default;
+
+  void identify(std::ostream& os = std::cout) const override;
+  int isValid() const override { return m_valid; }
+  void Reset() override;
+
+  //! allocate storage for a given hitset. Not thread safe
+  void reserve(TrkrDefs::hitsetkey, unsigned int /*size*/);
+
+  //! store entry. Thread safe as long as storage for the hitset is reserved and different threads fill different hitsets
+  void set(TrkrDefs::cluskey, const TrkrCluster*, const Acts::Vector3& /*global*/, const Acts::Vector3& /*corrected*/);
+
+  //! get entry, or nullptr if the cache is not valid or has no entry for this cluster
+  const Entry* find(TrkrDefs::cluskey, const TrkrCluster*) const;
+
+  //! mark the cache valid for a given configuration
+  void validate(uint64_t configuration)
+  {
+    m_configuration = configuration;
+    m_valid = true;
+  }
+
+  //! invalidate cache, for instance when alignment or corrections change within an event
+  void invalidate() { m_valid = false; }
+
+  //! configuration used to fill the cache
+  uint64_t configuration() const { return m_configuration; }
+
+  //! number of stored entries
+  std::size_t size() const;
+
+ private:
+  using Vector = std::vector<Entry>;
+  std::map<TrkrDefs::hitsetkey, Vector> m_entries;  //!
+
+  uint64_t m_configuration = 0;  //!
+  bool m_valid = false;  //!
+
+  ClassDefOverride(TrkrClusterGlobalPositionCache, 1)
+};
+
+#endif  // TRACKBASE_TRKRCLUSTERGLOBALPOSITIONCACHE_H
@@ -0,0 +1,117 @@
+/**
+ * @file trackbase/TrkrHitMapClusterer.cc
+ * @brief connected component labeling of (row, column) hit maps, shared by the silicon clusterizers
+ */
+
+#include "TrkrHitMapClusterer.h"
+
+#include <algorithm>
+
+//_________________________________________________________________
+void TrkrHitMapClusterer::clear()
+{
+  m_hits.clear();
+  m_clusters.clear();
+}
+
+//_________________________________________________________________
+unsigned int TrkrHitMapClusterer::run()
+{
+  const unsigned int nhits = m_hits.size();
+  m_keys.resize(nhits);
+  m_sorted.resize(nhits);
+  m_parent.resize(nhits);
+  m_labels.resize(nhits);
+  m_order.resize(nhits);
+  m_clusters.clear();
+
+  for (unsigned int i = 0; i < nhits; ++i)
+  {
+    m_keys[i] = key(m_hits[i].row, m_hits[i].col);
+    m_sorted[i] = i;
+    m_parent[i] = i;
+  }
+
+  // sort hits by (column, row), keeping input order for duplicates
+  if (!std::is_sorted(m_keys.begin(), m_keys.end()))
+  {
+    std::sort(m_sorted.begin(), m_sorted.end(), [this](unsigned int lhs, unsigned int rhs)
+              { return m_keys[lhs] < m_keys[rhs] || (m_keys[lhs] == m_keys[rhs] && lhs < rhs); });
+  }
+
+  /*
+   * connect each hit to the neighbours that precede it in sorted order,
+   * in the same column and, if enabled, the previous one.
+   * The lowest neighbour key increases with the hit position,
+   * so the lookup cursor only moves forward
+   */
+  for (int dcol = 0; dcol <= m_maxdcol; ++dcol)
+  {
+    unsigned int cursor = 0;
+    for (unsigned int p = 0; p < nhits; ++p)
+    {
+      const auto& hit = m_hits[m_sorted[p]];
+
+      // nothing left of the first column. There are no negative rows, so the row range starts at 0
+      const int col = hit.col - dcol;
+      if (col < 0)
+      {
+        continue;
+      }
+      const int64_t lowest = key(std::max(hit.row - m_maxdrow, 0), col);
+      const int64_t highest = key(hit.row + m_maxdrow, col);
+      while (cursor < p && m_keys[m_sorted[cursor]] < lowest)
+      {
+        ++cursor;
+      }
+
+      for (unsigned int q = cursor; q < p && m_keys[m_sorted[q]] <= highest; ++q)
+      {
+        merge(m_sorted[p], m_sorted[q]);
+      }
+    }
+  }
+
+  // number clusters by their first hit, and accumulate row and column ranges
+  static constexpr unsigned int invalid = ~0U;
+  m_index.assign(nhits, invalid);
+  for (unsigned int i = 0; i < nhits; ++i)
+  {
+    const auto& hit = m_hits[i];
+    const unsigned int root = find(i);
+    if (m_index[root] == invalid)
+    {
+      m_index[root] = m_clusters.size();
+      Cluster cluster;
+      cluster.rowmin = cluster.rowmax = hit.row;
+      cluster.colmin = cluster.colmax = hit.col;
+      m_clusters.push_back(cluster);
+    }
+
+    const unsigned int label = m_index[root];
+    m_labels[i] = label;
+
+    auto& cluster = m_clusters[label];
+    ++cluster.nhits;
+    cluster.rowmin = std::min(cluster.rowmin, hit.row);
+    cluster.rowmax = std::max(cluster.rowmax, hit.row);
+    cluster.colmin = std::min(cluster.colmin, hit.col);
+    cluster.colmax = std::max(cluster.colmax, hit.col);
+  }
+
+  // group hits by cluster, keeping input order
+  unsigned int offset = 0;
+  for (unsigned int label = 0; label < m_clusters.size(); ++label)
+  {
+    m_clusters[label].first = offset;
+    m_index[label] = offset;
+    offset += m_clusters[label].nhits;
+  }
+
+  for (unsigned int i = 0; i < nhits; ++i)
+  {
+    m_order[m_index[m_labels[i]]++] = i;
+  }
+
+  return m_clusters.size();
+}
@@ -0,0 +1,138 @@
+#ifndef TRACKBASE_TRKRHITMAPCLUSTERER_H
+#define TRACKBASE_TRKRHITMAPCLUSTERER_H
+
+/**
+ * @file trackbase/TrkrHitMapClusterer.h
+ * @brief connected component labeling of (row, column) hit maps, shared by the silicon clusterizers
+ */
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Connected component labeling of (row, column) hit maps
+ *
+ * Hits are added in the order in which the caller wants to process them.
+ * Two hits are connected when their row and column distances are both within
+ * the configured neighbourhood (0 or 1 in each direction).
+ * Labeling is done with union-find over the hits sorted by (column, row),
+ * looking up neighbours with monotonic cursors, so that the cost is linear
+ * in the number of hits once they are sorted (hits coming from a TrkrHitSet are already).
+ *
+ * Clusters are numbered by the first hit they contain, in input order, and
+ * hits in a cluster are kept in input order. This is the same numbering and
+ * ordering as running boost::connected_components on the full adjacency graph.
+ *
+ * Buffers are kept between calls, so that a clusterizer owning one instance
+ * does not allocate once the buffers have grown to the largest hitset.
+ */
+class TrkrHitMapClusterer
+{
+ public:
+  //! cluster summary
+  struct Cluster
+  {
+    //! offset of the cluster first hit in hit_order()
+    unsigned int first = 0;
+
+    //! number of hits
+    unsigned int nhits = 0;
+
+    //! row and column ranges
+    int rowmin = 0;
+    int rowmax = 0;
+    int colmin = 0;
+    int colmax = 0;
+
+    /**
+     * number of distinct rows and columns
+     * connected clusters with a neighbourhood of at most one cover contiguous ranges
+     */
+    unsigned int nrows() const { return rowmax - rowmin + 1; }
+    unsigned int ncols() const { return colmax - colmin + 1; }
+  };
+
+  //! neighbourhood. Hits are connected if |drow| <= maxdrow and |dcol| <= maxdcol
+  void set_neighbourhood(unsigned int maxdrow, unsigned int maxdcol)
+  {
+    m_maxdrow = maxdrow > 1 ? 1 : static_cast<int>(maxdrow);
+    m_maxdcol = maxdcol > 1 ? 1 : static_cast<int>(maxdcol);
+  }
+
+  //! remove all hits, keeping allocated buffers
+  void clear();
+
+  //! add hit. Rows and columns must not be negative
+  void add_hit(int row, int col)
+  {
+    m_hits.push_back({row, col});
+  }
+
+  //! number of hits
+  unsigned int nhits() const { return m_hits.size(); }
+
+  //! perform the labeling. Returns the number of clusters
+  unsigned int run();
+
+  //! clusters, indexed by cluster id
+  const std::vector<Cluster>& clusters() const { return m_clusters; }
+
+  //! hit indices (in add_hit order), grouped by cluster. Use Cluster::first and Cluster::nhits
+  const std::vector<unsigned int>& hit_order() const { return m_order; }
+
+  //! cluster id for a given hit
+  unsigned int label(unsigned int ihit) const { return m_labels[ihit]; }
+
+ private:
+  struct Hit
+  {
+    int row = 0;
+    int col = 0;
+  };
+
+  //! sort key, (column, row). Row and column must not be negative
+  static int64_t key(int row, int col)
+  {
+    return (static_cast<int64_t>(col) << 32) + row;
+  }
+
+  //! union-find root lookup, with path halving
+  unsigned int find(unsigned int i)
+  {
+    while (m_parent[i] != i)
+    {
+      m_parent[i] = m_parent[m_parent[i]];
+      i = m_parent[i];
+    }
+    return i;
+  }
+
+  //! union-find merge. The smallest index becomes the root
+  void merge(unsigned int i, unsigned int j)
+  {
+    i = find(i);
+    j = find(j);
+    if (i < j)
+    {
+      m_parent[j] = i;
+    }
+    else if (j < i)
+    {
+      m_parent[i] = j;
+    }
+  }
+
+  int m_maxdrow = 1;
+  int m_maxdcol = 1;
+
+  std::vector<Hit> m_hits;
+  std::vector<int64_t> m_keys;
+  std::vector<unsigned int> m_sorted;
+  std::vector<unsigned int> m_parent;
+  std::vector<unsigned int> m_labels;
+  std::vector<unsigned int> m_order;
+  std::vector<unsigned int> m_index;
+  std::vector<Cluster> m_clusters;
+};
+
+#endif
@@ -52,6 +52,9 @@ class SvtxTrack : public PHObject
   int isValid() const override { return 0; }
   PHObject* CloneMe() const override { return nullptr; }
 
+  //! clone into the per-event arena (see PHEventArena), falls back to CloneMe
+  virtual SvtxTrack* CloneEventArena() const { return static_cast<SvtxTrack*>(CloneMe()); }
+
   //! import PHObject CopyFrom, in order to avoid clang warning
   using PHObject::CopyFrom;
 
@@ -2,6 +2,7 @@
 
 #include "SvtxTrack.h"
 
+#include <phool/PHEventArena.h>
 #include <phool/PHObject.h>  // for PHObject
 
 #include <iterator>  // for reverse_iterator
@@ -51,7 +52,7 @@ void SvtxTrackMap_v2::Reset()
   for (auto& iter : _map)
   {
     SvtxTrack* track = iter.second;
-    delete track;
+    PHEventArena::Destroy(track);
   }
   _map.clear();
 }
@@ -89,14 +90,14 @@ SvtxTrack* SvtxTrackMap_v2::insert(const SvtxTrack* track)
   {
     index = _map.rbegin()->first + 1;
   }
-  auto copy = static_cast<SvtxTrack*>(track->CloneMe());
+  auto copy = track->CloneEventArena();
   copy->set_id(index);
 
   const auto result = _map.insert(std::make_pair(index, copy));
   if (!result.second)
   {
     std::cout << "SvtxTrackMap_v2::insert - duplicated key. track not inserted" << std::endl;
-    delete copy;
+    PHEventArena::Destroy(copy);
     return nullptr;
   }
   else
@@ -107,13 +108,13 @@ SvtxTrack* SvtxTrackMap_v2::insert(const SvtxTrack* track)
 
 SvtxTrack* SvtxTrackMap_v2::insertWithKey(const SvtxTrack* track, unsigned int index)
 {
-  auto copy = static_cast<SvtxTrack*>(track->CloneMe());
+  auto copy = track->CloneEventArena();
   copy->set_id(index);
   const auto result = _map.insert(std::make_pair(index, copy));
   if (!result.second)
   {
     std::cout << "SvtxTrackMap_v2::insertWithKey - duplicated key. track not inserted" << std::endl;
-    delete copy;
+    PHEventArena::Destroy(copy);
     return nullptr;
   }
   else
@@ -4,6 +4,8 @@
 #include "SvtxTrack.h"
 #include "SvtxTrackMap.h"
 
+#include <phool/PHEventArena.h>
+
 #include <cstddef>   // for size_t
 #include <iostream>  // for cout, ostream
 
@@ -34,7 +36,7 @@ class SvtxTrackMap_v2 : public SvtxTrackMap
   SvtxTrack* insertWithKey(const SvtxTrack* track, unsigned int index) override;
   size_t erase(unsigned int idkey) override
   {
-    delete _map[idkey];
+    PHEventArena::Destroy(_map[idkey]);
     return _map.erase(idkey);
   }
 
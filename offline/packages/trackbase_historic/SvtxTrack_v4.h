@@ -7,6 +7,8 @@
 
 #include <trackbase/TrkrDefs.h>
 
+#include <phool/PHEventArena.h>
+
 #include <cmath>
 #include <cstddef>  // for size_t
 #include <iostream>
@@ -37,6 +39,7 @@ class SvtxTrack_v4 : public SvtxTrack
   void Reset() override { *this = SvtxTrack_v4(); }
   int isValid() const override;
   PHObject* CloneMe() const override { return new SvtxTrack_v4(*this); }
+  SvtxTrack* CloneEventArena() const override { return PHEventArena::Create<SvtxTrack_v4>(*this); }
 
   //! import PHObject CopyFrom, in order to avoid clang warning
   using PHObject::CopyFrom;
@@ -87,13 +87,22 @@
 #include <TSystem.h>
 #include <TVector3.h>
 
+#include <unistd.h>
+
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <map>
 #include <memory>
+#include <sstream>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -157,6 +166,52 @@ namespace
     }
   }
 
+  // FNV-1a hash, used to fingerprint the inputs of the surface map cache
+  constexpr uint64_t hash_seed = 0xcbf29ce484222325ULL;
+
+  uint64_t hash_bytes(uint64_t hash, const void *data, size_t size)
+  {
+    const auto *bytes = static_cast<const unsigned char *>(data);
+    for (size_t i = 0; i < size; ++i)
+    {
+      hash ^= bytes[i];
+      hash *= 0x100000001b3ULL;
+    }
+    return hash;
+  }
+
+  template <class T>
+  uint64_t hash_value(uint64_t hash, const T &value)
+  {
+    return hash_bytes(hash, &value, sizeof(T));
+  }
+
+  uint64_t hash_string(uint64_t hash, const std::string &value)
+  {
+    return hash_bytes(hash_value(hash, value.size()), value.data(), value.size());
+  }
+
+  // surface map cache file: header, then for silicon, TPC and micromegas the
+  // number of entries followed by the ( Acts geometry id, key ) pairs.
+  // TPC entries are stored in the order of the surface vectors of each layer
+  const char geometryCacheMagic[8] = {'A', 'C', 'T', 'S', 'S', 'M', 'A', 'P'};
+  const uint32_t geometryCacheVersion = 1;
+
+  struct GeometryCacheHeader
+  {
+    char magic[8];
+    uint32_t version;
+    uint32_t padding;
+    uint64_t hash;
+  };
+
+  struct GeometryCacheEntry
+  {
+    uint64_t geoid;
+    uint32_t key;
+    uint32_t padding;
+  };
+
 }  // namespace
 
 MakeActsGeometry::MakeActsGeometry(const std::string &name)
@@ -382,6 +437,33 @@ int MakeActsGeometry::buildAllGeometry(PHCompositeNode *topNode)
   }
 
   setPlanarSurfaceDivisions();  // eshulga
+
+  // fingerprint the geometry inputs for the surface map cache,
+  // using the DST geometry before the TPC surfaces are added
+  if (!m_geometryCacheDir.empty())
+  {
+    uint64_t hash = hash_seed;
+    const PHGeomIOTGeo *dstGeomIO = PHGeomUtility::GetGeomIOTGeoNode(topNode, false);
+    if (dstGeomIO)
+    {
+      hash = hash_bytes(hash, dstGeomIO->GetData().data(), dstGeomIO->GetData().size());
+    }
+    hash = hash_value(hash, m_nSurfPhi);
+    hash = hash_value(hash, m_nSurfZ);
+    hash = hash_value(hash, m_minSurfZ);
+    hash = hash_value(hash, m_maxSurfZ);
+    hash = hash_value(hash, m_layerRadius);
+    hash = hash_value(hash, m_layerThickness);
+    hash = hash_bytes(hash, m_tpc_world_envelope_transform.matrix().data(), 16 * sizeof(double));
+    hash = hash_value(hash, m_inttSurvey);
+    hash = hash_value(hash, m_mvtxapplymisalign);
+    if (m_mvtxapplymisalign)
+    {
+      hash = hash_string(hash, CDBInterface::instance()->getUrl("MVTX_ALIGNMENT"));
+    }
+    m_geometryCacheHash = hash;
+  }
+
   // This should be done only on the first tracking pass, to avoid adding surfaces twice.
   // There is a check for existing acts fake surfaces in editTPCGeometry
   editTPCGeometry(topNode);
@@ -641,6 +723,14 @@ void MakeActsGeometry::buildActsSurfaces()
   std::string responseFile, materialFile;
   setMaterialResponseFile(responseFile, materialFile);
 
+  // the response file defines how the surfaces are built from TGeo
+  if (!m_geometryCacheDir.empty())
+  {
+    std::ifstream response(responseFile, std::ios::binary);
+    const std::string content((std::istreambuf_iterator<char>(response)), std::istreambuf_iterator<char>());
+    m_geometryCacheHash = hash_string(m_geometryCacheHash, content);
+  }
+
   // arguments
   // material and response file contains arguments necessary for geometry building
   std::vector<std::string> argstr =
@@ -802,7 +892,12 @@ void MakeActsGeometry::makeGeometry(int argc, char *argv[], const std::string& r
     m_magneticField = nullptr;
   }
 
-  unpackVolumes();
+  // the surface maps only need to be built if they are not cached
+  if (!readGeometryCache())
+  {
+    unpackVolumes();
+    writeGeometryCache();
+  }
 
   return;
 }
@@ -865,6 +960,164 @@ void MakeActsGeometry::unpackVolumes()
   return;
 }
 
+std::string MakeActsGeometry::geometryCacheFile() const
+{
+  std::ostringstream filename;
+  filename << m_geometryCacheDir << "/ActsSurfaceMaps_" << std::hex << m_geometryCacheHash << ".bin";
+  return filename.str();
+}
+
+bool MakeActsGeometry::readGeometryCache()
+{
+  if (m_geometryCacheDir.empty())
+  {
+    return false;
+  }
+
+  const std::string filename = geometryCacheFile();
+  std::ifstream in(filename, std::ios::binary);
+  if (!in)
+  {
+    std::cout << "MakeActsGeometry::readGeometryCache - no surface map cache " << filename << ", building surface maps" << std::endl;
+    return false;
+  }
+
+  GeometryCacheHeader header{};
+  in.read(reinterpret_cast<char *>(&header), sizeof(header));
+  if (!in || std::memcmp(header.magic, geometryCacheMagic, sizeof(geometryCacheMagic)) != 0 ||
+      header.version != geometryCacheVersion || header.hash != m_geometryCacheHash)
+  {
+    std::cout << "MakeActsGeometry::readGeometryCache - " << filename << " does not match this geometry, building surface maps" << std::endl;
+    return false;
+  }
+
+  // all surfaces of the tracking geometry by identifier
+  std::unordered_map<uint64_t, Surface> surfaces;
+  m_tGeometry->visitSurfaces([&surfaces](const Acts::Surface *surface)
+                             {
+    if (surface)
+    {
+      surfaces.emplace(surface->geometryId().value(), surface->getSharedPtr());
+    } }, false);
+
+  // read one section of the cache, calling fill( key, surface ) for each entry
+  auto read_section = [&in, &surfaces](auto &&fill)
+  {
+    uint64_t nentries = 0;
+    in.read(reinterpret_cast<char *>(&nentries), sizeof(nentries));
+    if (!in)
+    {
+      return false;
+    }
+    std::vector<GeometryCacheEntry> entries(nentries);
+    in.read(reinterpret_cast<char *>(entries.data()), nentries * sizeof(GeometryCacheEntry));
+    if (!in)
+    {
+      return false;
+    }
+    for (const auto &entry : entries)
+    {
+      const auto iter = surfaces.find(entry.geoid);
+      if (iter == surfaces.end())
+      {
+        return false;
+      }
+      fill(entry.key, iter->second);
+    }
+    return true;
+  };
+
+  const bool ok =
+      read_section([this](uint32_t hitsetkey, const Surface &surface)
+                   { m_clusterSurfaceMapSilicon.insert(std::make_pair(hitsetkey, surface)); }) &&
+      read_section([this](uint32_t layer, const Surface &surface)
+                   { m_clusterSurfaceMapTpcEdit[layer].push_back(surface); }) &&
+      read_section([this](uint32_t hitsetkey, const Surface &surface)
+                   { m_clusterSurfaceMapMmEdit.insert(std::make_pair(hitsetkey, surface)); });
+
+  if (!ok)
+  {
+    std::cout << "MakeActsGeometry::readGeometryCache - " << filename << " is corrupted or does not match the tracking geometry, building surface maps" << std::endl;
+    m_clusterSurfaceMapSilicon.clear();
+    m_clusterSurfaceMapTpcEdit.clear();
+    m_clusterSurfaceMapMmEdit.clear();
+    return false;
+  }
+
+  std::cout << "MakeActsGeometry::readGeometryCache - read surface maps from " << filename
+            << " silicon: " << m_clusterSurfaceMapSilicon.size()
+            << " tpc layers: " << m_clusterSurfaceMapTpcEdit.size()
+            << " micromegas: " << m_clusterSurfaceMapMmEdit.size() << std::endl;
+  return true;
+}
+
+void MakeActsGeometry::writeGeometryCache() const
+{
+  if (m_geometryCacheDir.empty())
+  {
+    return;
+  }
+
+  std::error_code error;
+  std::filesystem::create_directories(m_geometryCacheDir, error);
+
+  // write under a temporary name and rename, so concurrent jobs never see a partial file
+  const std::string filename = geometryCacheFile();
+  const std::string tmpname = filename + ".tmp" + std::to_string(getpid());
+  std::ofstream out(tmpname, std::ios::binary | std::ios::trunc);
+  if (!out)
+  {
+    std::cout << "MakeActsGeometry::writeGeometryCache - could not open " << tmpname << std::endl;
+    return;
+  }
+
+  GeometryCacheHeader header{};
+  std::memcpy(header.magic, geometryCacheMagic, sizeof(geometryCacheMagic));
+  header.version = geometryCacheVersion;
+  header.hash = m_geometryCacheHash;
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+  auto write_section = [&out](const std::vector<GeometryCacheEntry> &entries)
+  {
+    const uint64_t nentries = entries.size();
+    out.write(reinterpret_cast<const char *>(&nentries), sizeof(nentries));
+    out.write(reinterpret_cast<const char *>(entries.data()), nentries * sizeof(GeometryCacheEntry));
+  };
+
+  std::vector<GeometryCacheEntry> entries;
+  for (const auto &[hitsetkey, surface] : m_clusterSurfaceMapSilicon)
+  {
+    entries.push_back({surface->geometryId().value(), hitsetkey, 0});
+  }
+  write_section(entries);
+
+  entries.clear();
+  for (const auto &[layer, surfaceVector] : m_clusterSurfaceMapTpcEdit)
+  {
+    for (const auto &surface : surfaceVector)
+    {
+      entries.push_back({surface->geometryId().value(), layer, 0});
+    }
+  }
+  write_section(entries);
+
+  entries.clear();
+  for (const auto &[hitsetkey, surface] : m_clusterSurfaceMapMmEdit)
+  {
+    entries.push_back({surface->geometryId().value(), hitsetkey, 0});
+  }
+  write_section(entries);
+
+  out.close();
+  if (!out || std::rename(tmpname.c_str(), filename.c_str()) != 0)
+  {
+    std::cout << "MakeActsGeometry::writeGeometryCache - error writing " << filename << std::endl;
+    std::remove(tmpname.c_str());
+    return;
+  }
+  std::cout << "MakeActsGeometry::writeGeometryCache - wrote surface maps to " << filename << std::endl;
+}
+
 void MakeActsGeometry::makeTpcMapPairs(TrackingVolumePtr &tpcVolume)
 {
   if (Verbosity() > 10)
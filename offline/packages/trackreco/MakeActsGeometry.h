@@ -26,6 +26,7 @@
 #ifndef __CLING__
 #include <boost/program_options.hpp>
 #endif
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <string>
@@ -154,6 +155,12 @@ class MakeActsGeometry : public SubsysReco
   void setUseModuleTiltAlways(bool flag) { m_use_module_tilt_always = flag; }
   void setUseNewSiliconRotationOrder(bool flag) { m_use_new_silicon_rotation_order = flag; }
 
+  /// Directory in which the surface maps are cached, one file per geometry configuration.
+  /// The file name and content carry a hash of the geometry inputs (DST geometry, TPC surface
+  /// divisions, Acts response file, INTT survey and MVTX misalignment settings), so a cache
+  /// built for a different configuration is never picked up. Empty (default) disables the cache
+  void setGeometryCacheDir(const std::string &dir) { m_geometryCacheDir = dir; }
+
 private:
   /// Main function to build all acts geometry for use in the fitting modules
   int buildAllGeometry(PHCompositeNode *topNode);
@@ -207,6 +214,12 @@ private:
   //   void makeTGeoNodeMap(PHCompositeNode *topNode);
 
   void unpackVolumes();
+
+  /// Surface map cache, see setGeometryCacheDir
+  std::string geometryCacheFile() const;
+  bool readGeometryCache();
+  void writeGeometryCache() const;
+
   std::unique_ptr<ActsExamples::TGeoDetectorWithOptions> m_TGeoDetector = nullptr;
 
   /// Subdetector geometry containers for getting layer information
@@ -234,6 +247,10 @@ private:
   std::map<unsigned int, std::vector<Surface>> m_clusterSurfaceMapTpcEdit;  // uses layer as key
   std::map<TrkrDefs::hitsetkey, Surface> m_clusterSurfaceMapMmEdit;
 
+  /// Surface map cache directory and hash of the geometry inputs
+  std::string m_geometryCacheDir;
+  uint64_t m_geometryCacheHash = 0;
+
   /// These don't change, we are building the tpc this way!
   static constexpr unsigned int m_nTpcLayers = 48;
   static constexpr unsigned int m_nTpcModulesPerLayer = 12;
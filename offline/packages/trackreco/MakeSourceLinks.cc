@@ -132,8 +132,8 @@ SourceLinkVec MakeSourceLinks::getSourceLinks(
     if (trkrid == TrkrDefs::tpcId)
     {
       Acts::Vector3 global = globalPositionWrapper.getGlobalPositionDistortionCorrected(key, cluster, crossing);
-      Acts::Vector3 nominal_global_in = tGeometry->getGlobalPosition(key, cluster);
-      Acts::Vector3 global_in = tGeometry->getGlobalPosition(key, cluster);
+      Acts::Vector3 nominal_global_in = globalPositionWrapper.getGlobalPosition(key, cluster);
+      Acts::Vector3 global_in = nominal_global_in;
       // The wrapper returns the global position corrected for distortion and the cluster crossing z offset
       // The cluster z crossing correction has to be applied to the nominal global position (global_in)
       double cluster_crossing_corrected_z = TpcClusterZCrossingCorrection::correctZ(global_in.z(), TpcDefs::getSide(key), crossing);
@@ -48,10 +48,13 @@
 #include <Eigen/Core>
 #include <Eigen/Dense>
 
+#include <omp.h>
+
 #include <algorithm>
 #include <cmath>
 #include <filesystem>
 #include <iostream>
+#include <iterator>
 #include <memory>
 #include <numeric>
 #include <unordered_set>
@@ -225,7 +228,7 @@ Acts::Vector3 PHCASeeding::getGlobalPosition(TrkrDefs::cluskey key, TrkrCluster*
 	    << " subsurfkey " << cluster->getSubSurfKey()
 	    << std::endl;
   */
-  return _pp_mode ? m_tGeometry->getGlobalPosition(key, cluster) : m_globalPositionWrapper.getGlobalPositionDistortionCorrected(key, cluster, 0);
+  return _pp_mode ? m_globalPositionWrapper.getGlobalPosition(key, cluster) : m_globalPositionWrapper.getGlobalPositionDistortionCorrected(key, cluster, 0);
 }
 
 void PHCASeeding::QueryTree(const bgi::rtree<PHCASeeding::pointKey, bgi::quadratic<16>>& rtree, double phimin, double z_min, double phimax, double z_max, std::vector<pointKey>& returned_values) const
@@ -396,7 +399,7 @@ int PHCASeeding::FindSeedsWithMerger(const PHCASeeding::PositionMap& globalPosit
 
   keyLinks trackSeedPairs;
   keyLinkPerLayer bodyLinks;
-  std::tie(trackSeedPairs, bodyLinks) = CreateBiLinks(globalPositions, ckeys);
+  std::tie(trackSeedPairs, bodyLinks) = _use_cell_grid ? CreateBiLinksCellGrid(globalPositions, ckeys) : CreateBiLinks(globalPositions, ckeys);
   PHCASEEDING_PRINT_TIME(t_makebilinks, "init and make bilinks");
 
   t_makeseeds->restart();
@@ -627,7 +630,363 @@ std::pair<PHCASeeding::keyLinks, PHCASeeding::keyLinkPerLayer> PHCASeeding::Crea
   t_seed->restart();
 
   // sort the body links per layer so that links can be binary-searched per layer
-  /* for (auto& layer : bodyLinks) { std::sort(layer.begin(), layer.end()); } */
+  for (auto& layer : bodyLinks)
+  {
+    std::sort(layer.begin(), layer.end());
+  }
+  return std::make_pair(startLinks, bodyLinks);
+}
+
+int PHCASeeding::CellGrid::phi_bin(float value) const
+{
+  return static_cast<int>(std::clamp(value * inv_phi_width, 0.F, static_cast<float>(n_phi - 1)));
+}
+
+int PHCASeeding::CellGrid::z_bin(float value) const
+{
+  return static_cast<int>(std::clamp((value - _cell_grid_z_min) * inv_z_width, 0.F, static_cast<float>(n_z - 1)));
+}
+
+void PHCASeeding::InitializeCellGrids()
+{
+  for (int index = 0; index < _NLAYERS_TPC; ++index)
+  {
+    // a layer is queried with the window of its own layer when used as the above layer,
+    // and with the window of the next layer when used as the below layer.
+    // Cells are at least as large as the largest of the two
+    const int layer = index + _FIRST_LAYER_TPC;
+    float dphi = 0;
+    float dz = 0;
+    for (const int window_layer : {layer, layer + 1})
+    {
+      if (window_layer < static_cast<int>(dphi_per_layer.size()))
+      {
+        dphi = std::max(dphi, dphi_per_layer[window_layer]);
+        dz = std::max(dz, dZ_per_layer[window_layer]);
+      }
+    }
+
+    auto& grid = _cell_grids[index];
+    grid.n_phi = dphi > 0 ? std::max<int>(1, std::min<double>(_cell_grid_max_bins, 2. * M_PI / dphi)) : 1;
+    grid.n_z = dz > 0 ? std::max<int>(1, std::min<double>(_cell_grid_max_bins, (_cell_grid_z_max - _cell_grid_z_min) / dz)) : 1;
+    grid.inv_phi_width = grid.n_phi / (2. * M_PI);
+    grid.inv_z_width = grid.n_z / (_cell_grid_z_max - _cell_grid_z_min);
+    grid.cell_offsets.assign(grid.n_phi * grid.n_z + 1, 0);
+
+    if (Verbosity() > 1)
+    {
+      std::cout << "PHCASeeding::InitializeCellGrids - layer " << layer << " phi bins: " << grid.n_phi << " z bins: " << grid.n_z << std::endl;
+    }
+  }
+}
+
+void PHCASeeding::FillCellGrid(PHCASeeding::CellGrid& grid, const PHCASeeding::keyList& ckeys, const PHCASeeding::PositionMap& globalPositions) const
+{
+  // this is the cell grid equivalent of FillTree, with identical duplicate removal
+  const unsigned int nclusters = ckeys.size();
+
+  // cell and double precision phi of each cluster, in input order
+  std::vector<int> cells(nclusters);
+  std::vector<double> phi_d(nclusters);
+  std::fill(grid.cell_offsets.begin(), grid.cell_offsets.end(), 0);
+  for (unsigned int i = 0; i < nclusters; ++i)
+  {
+    const auto& globalpos = globalPositions.at(ckeys[i]);
+    phi_d[i] = get_phi(globalpos);
+    cells[i] = grid.phi_bin(phi_d[i]) * grid.n_z + grid.z_bin(globalpos.z());
+    ++grid.cell_offsets[cells[i] + 1];
+  }
+  std::partial_sum(grid.cell_offsets.begin(), grid.cell_offsets.end(), grid.cell_offsets.begin());
+
+  // sort clusters by cell, keeping input order inside each cell
+  grid.phi.resize(nclusters);
+  grid.z.resize(nclusters);
+  grid.x.resize(nclusters);
+  grid.y.resize(nclusters);
+  grid.z_global.resize(nclusters);
+  grid.keys.resize(nclusters);
+  grid.kept.assign(nclusters, 0);
+
+  std::vector<unsigned int> positions(nclusters);
+  {
+    std::vector<unsigned int> fill_index(grid.cell_offsets.begin(), grid.cell_offsets.end() - 1);
+    for (unsigned int i = 0; i < nclusters; ++i)
+    {
+      const auto& globalpos = globalPositions.at(ckeys[i]);
+      const unsigned int position = fill_index[cells[i]]++;
+      positions[i] = position;
+      grid.phi[position] = phi_d[i];
+      grid.z[position] = globalpos.z();
+      grid.x[position] = globalpos.x();
+      grid.y[position] = globalpos.y();
+      grid.z_global[position] = globalpos.z();
+      grid.keys[position] = ckeys[i];
+    }
+  }
+
+  // remove duplicates: in input order, a cluster is dropped if it matches a cluster kept before
+  grid.n_duplicates = 0;
+  std::vector<unsigned int> duplicates;
+  for (unsigned int i = 0; i < nclusters; ++i)
+  {
+    const unsigned int position = positions[i];
+    const double clus_z = grid.z_global[position];
+    duplicates.clear();
+    QueryCellGrid(grid, phi_d[i] - 0.00001, clus_z - 0.00001, phi_d[i] + 0.00001, clus_z + 0.00001, duplicates);
+    if (duplicates.empty())
+    {
+      grid.kept[position] = 1;
+    }
+    else
+    {
+      ++grid.n_duplicates;
+    }
+  }
+}
+
+void PHCASeeding::QueryCellGrid(const PHCASeeding::CellGrid& grid, double phimin, double z_min, double phimax, double z_max, std::vector<unsigned int>& returned_values) const
+{
+  // same window and phi wrapping logic as QueryTree, with boundaries in single precision.
+  // Only non duplicated clusters are returned
+  auto query_box = [&grid, &returned_values](float phi_lo, float z_lo, float phi_hi, float z_hi)
+  {
+    const int z_bin_lo = grid.z_bin(z_lo);
+    const int z_bin_hi = grid.z_bin(z_hi);
+    for (int phi_bin = grid.phi_bin(phi_lo); phi_bin <= grid.phi_bin(phi_hi); ++phi_bin)
+    {
+      const unsigned int begin = grid.cell_offsets[phi_bin * grid.n_z + z_bin_lo];
+      const unsigned int end = grid.cell_offsets[phi_bin * grid.n_z + z_bin_hi + 1];
+      for (unsigned int i = begin; i < end; ++i)
+      {
+        if (grid.kept[i] && grid.phi[i] >= phi_lo && grid.phi[i] <= phi_hi && grid.z[i] >= z_lo && grid.z[i] <= z_hi)
+        {
+          returned_values.push_back(i);
+        }
+      }
+    }
+  };
+
+  bool query_both_ends = false;
+  if (phimin < 0)
+  {
+    query_both_ends = true;
+    phimin += 2 * M_PI;
+  }
+  if (phimax > 2 * M_PI)
+  {
+    query_both_ends = true;
+    phimax -= 2 * M_PI;
+  }
+  if (query_both_ends)
+  {
+    query_box(phimin, z_min, 2 * M_PI, z_max);
+    query_box(0., z_min, phimax, z_max);
+  }
+  else
+  {
+    query_box(phimin, z_min, phimax, z_max);
+  }
+}
+
+std::pair<PHCASeeding::keyLinks, PHCASeeding::keyLinkPerLayer> PHCASeeding::CreateBiLinksCellGrid(const PHCASeeding::PositionMap& globalPositions, const PHCASeeding::keyListPerLayer& ckeys)
+{
+  // same links as CreateBiLinks, built in independent passes so that layers can be processed in parallel:
+  // - fill cell grids for all layers
+  // - for each layer, find the down links (start, below) and up links (above, start) of all triplets
+  // - bilinks of a layer are the up links that match the down links of the layer above
+  // - a bilink is a start link unless its top cluster is the bottom of a bilink in the layer above
+  keyLinks startLinks;
+  keyLinkPerLayer bodyLinks;
+
+  const int inner_index = _start_layer - _FIRST_LAYER_TPC + 1;
+  const int outer_index = _end_layer - _FIRST_LAYER_TPC - 2;
+
+  // the thread count only applies to the loops below
+  const int nthreads = _num_threads >= 1 ? _num_threads : omp_get_max_threads();
+
+  t_seed->restart();
+
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads)
+  for (int layer_index = inner_index - 1; layer_index <= outer_index + 1; ++layer_index)
+  {
+    FillCellGrid(_cell_grids[layer_index], ckeys[layer_index], globalPositions);
+  }
+
+  t_seed->stop();
+  const double fill_time = t_seed->elapsed();
+  t_seed->restart();
+
+  // sorted down and up links per layer
+  std::array<keyLinks, _NLAYERS_TPC> downlinks;
+  std::array<keyLinks, _NLAYERS_TPC> uplinks;
+
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads)
+  for (int layer_index = inner_index; layer_index <= outer_index; ++layer_index)
+  {
+    const unsigned int LAYER = layer_index + _FIRST_LAYER_TPC;
+    const auto& grid_above = _cell_grids[layer_index + 1];
+    const auto& grid = _cell_grids[layer_index];
+    const auto& grid_below = _cell_grids[layer_index - 1];
+
+    auto& layer_downlinks = downlinks[layer_index];
+    auto& layer_uplinks = uplinks[layer_index];
+
+    std::vector<unsigned int> ClustersAbove;
+    std::vector<unsigned int> ClustersBelow;
+    std::vector<std::array<double, 3>> delta_below;
+    std::vector<std::array<double, 3>> delta_above;
+    std::vector<unsigned char> aboveUsed;
+    for (unsigned int iStart = 0; iStart < grid.keys.size(); ++iStart)
+    {
+      if (!grid.kept[iStart])
+      {
+        continue;
+      }
+
+      const double StartPhi = grid.phi[iStart];
+      const double StartX = grid.x[iStart];
+      const double StartY = grid.y[iStart];
+      const double StartZ = grid.z_global[iStart];
+      const auto StartKey = grid.keys[iStart];
+
+      ClustersBelow.clear();
+      QueryCellGrid(grid_below,
+                    StartPhi - dphi_per_layer[LAYER],
+                    StartZ - dZ_per_layer[LAYER],
+                    StartPhi + dphi_per_layer[LAYER],
+                    StartZ + dZ_per_layer[LAYER],
+                    ClustersBelow);
+      if (ClustersBelow.empty())
+      {
+        continue;
+      }
+
+      ClustersAbove.clear();
+      QueryCellGrid(grid_above,
+                    StartPhi - dphi_per_layer[LAYER + 1],
+                    StartZ - dZ_per_layer[LAYER + 1],
+                    StartPhi + dphi_per_layer[LAYER + 1],
+                    StartZ + dZ_per_layer[LAYER + 1],
+                    ClustersAbove);
+      if (ClustersAbove.empty())
+      {
+        continue;
+      }
+
+      delta_below.clear();
+      for (const auto& i : ClustersBelow)
+      {
+        delta_below.push_back({grid_below.x[i] - StartX, grid_below.y[i] - StartY, grid_below.z_global[i] - StartZ});
+      }
+
+      delta_above.clear();
+      for (const auto& i : ClustersAbove)
+      {
+        delta_above.push_back({grid_above.x[i] - StartX, grid_above.y[i] - StartY, grid_above.z_global[i] - StartZ});
+      }
+
+      // same straightness criterion as CreateBiLinks
+      aboveUsed.assign(ClustersAbove.size(), 0);
+      for (size_t iBelow = 0; iBelow < delta_below.size(); ++iBelow)
+      {
+        const auto& A = delta_below[iBelow];
+        const double A_len_sq = (A[0] * A[0] + A[1] * A[1] + A[2] * A[2]);
+        bool belowUsed = false;
+        for (size_t iAbove = 0; iAbove < delta_above.size(); ++iAbove)
+        {
+          const auto& B = delta_above[iAbove];
+          const double B_len_sq = (B[0] * B[0] + B[1] * B[1] + B[2] * B[2]);
+          const double dot_prod = (A[0] * B[0] + A[1] * B[1] + A[2] * B[2]);
+          const double cos_angle_sq = dot_prod * dot_prod / A_len_sq / B_len_sq;
+
+          constexpr double maxCosPlaneAngle = -0.95;
+          constexpr double maxCosPlaneAngle_sq = maxCosPlaneAngle * maxCosPlaneAngle;
+          if ((dot_prod < 0.) && (cos_angle_sq > maxCosPlaneAngle_sq))
+          {
+            belowUsed = true;
+            aboveUsed[iAbove] = 1;
+          }
+        }
+        if (belowUsed)
+        {
+          layer_downlinks.emplace_back(StartKey, grid_below.keys[ClustersBelow[iBelow]]);
+        }
+      }
+
+      for (size_t iAbove = 0; iAbove < ClustersAbove.size(); ++iAbove)
+      {
+        if (aboveUsed[iAbove])
+        {
+          layer_uplinks.emplace_back(grid_above.keys[ClustersAbove[iAbove]], StartKey);
+        }
+      }
+    }
+
+    std::sort(layer_downlinks.begin(), layer_downlinks.end());
+    layer_downlinks.erase(std::unique(layer_downlinks.begin(), layer_downlinks.end()), layer_downlinks.end());
+    std::sort(layer_uplinks.begin(), layer_uplinks.end());
+    layer_uplinks.erase(std::unique(layer_uplinks.begin(), layer_uplinks.end()), layer_uplinks.end());
+  }
+
+  t_seed->stop();
+  const double triplet_time = t_seed->elapsed();
+  t_seed->restart();
+
+  // bilinks, and sorted list of their bottom clusters, per layer
+  std::array<keyLinks, _NLAYERS_TPC> bilinks;
+  std::array<keyList, _NLAYERS_TPC> bottom_of_bilink;
+
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads)
+  for (int layer_index = inner_index; layer_index < outer_index; ++layer_index)
+  {
+    auto& layer_bilinks = bilinks[layer_index];
+    std::set_intersection(
+        uplinks[layer_index].begin(), uplinks[layer_index].end(),
+        downlinks[layer_index + 1].begin(), downlinks[layer_index + 1].end(),
+        std::back_inserter(layer_bilinks));
+
+    auto& bottoms = bottom_of_bilink[layer_index];
+    for (const auto& [key_top, key_bot] : layer_bilinks)
+    {
+      bottoms.push_back(key_bot);
+    }
+    std::sort(bottoms.begin(), bottoms.end());
+    bottoms.erase(std::unique(bottoms.begin(), bottoms.end()), bottoms.end());
+  }
+
+  // bilinks are sorted by top cluster, so body links are sorted per layer
+  for (int layer_index = outer_index - 1; layer_index >= inner_index; --layer_index)
+  {
+    const auto& last_bottom_of_bilink = bottom_of_bilink[layer_index + 1];
+    for (const auto& link : bilinks[layer_index])
+    {
+      fill_tuple(_tupclus_bilinks, 0, link.first, globalPositions.at(link.first));
+      fill_tuple(_tupclus_bilinks, 1, link.second, globalPositions.at(link.second));
+      if (std::binary_search(last_bottom_of_bilink.begin(), last_bottom_of_bilink.end(), link.first))
+      {
+        bodyLinks[layer_index + 1].push_back(link);
+      }
+      else
+      {
+        startLinks.push_back(link);
+      }
+    }
+  }
+
+  t_seed->stop();
+  if (Verbosity() > 0)
+  {
+    int n_duplicates = 0;
+    for (int layer_index = inner_index - 1; layer_index <= outer_index + 1; ++layer_index)
+    {
+      n_duplicates += _cell_grids[layer_index].n_duplicates;
+    }
+    std::cout << "cell grid fill time: " << fill_time / 1000 << " s, duplicates: " << n_duplicates << std::endl;
+    std::cout << "triplet forming time: " << triplet_time / 1000 << " s" << std::endl;
+    std::cout << "bilink matching time: " << t_seed->elapsed() / 1000 << " s" << std::endl;
+  }
+  t_seed->restart();
+
   return std::make_pair(startLinks, bodyLinks);
 }
 
@@ -658,15 +1017,11 @@ PHCASeeding::keyLists PHCASeeding::FollowBiLinks(const PHCASeeding::keyLinks& tr
     TrkrDefs::cluskey trackHead = startLink.second;
     unsigned int trackHead_layer = TrkrDefs::getLayer(trackHead) - _FIRST_LAYER_TPC;
     // the following call with get iterators to all bilinks which match the head
-    for (const auto& matchlink : bilinks[trackHead_layer])
+    // bilinks are sorted per layer
+    const auto matched_links = std::equal_range(bilinks[trackHead_layer].begin(), bilinks[trackHead_layer].end(), trackHead, CompKeyToBilink());
+    for (auto matchlink_iter = matched_links.first; matchlink_iter != matched_links.second; ++matchlink_iter)
     {
-      /* auto matched_links = std::equal_range(bilinks[trackHead_layer].begin(), bilinks[trackHead_layer].end(), trackHead, CompKeyToBilink()); */
-      /* for (auto matchlink = matched_links.first; matchlink != matched_links.second; ++matchlink) */
-      /* { */
-      if (matchlink.first != trackHead)
-      {
-        continue;
-      }
+      const auto& matchlink = *matchlink_iter;
       keyList trackSeedTriplet;
       trackSeedTriplet.push_back(startLink.first);
       trackSeedTriplet.push_back(startLink.second);
@@ -730,15 +1085,11 @@ PHCASeeding::keyLists PHCASeeding::FollowBiLinks(const PHCASeeding::keyLinks& tr
         keySet link_matches{};
         for (const auto& head_key : head_keys)
         {
-          // also possible to sort the links and use a sorted search like:
-          // auto matched_links = std::equal_range(bilinks[trackHead_layer].begin(), bilinks[trackHead_layer].end(), trackHead, CompKeyToBilink());
-          // for (auto link = matched_links.first; link != matched_links.second; ++link)
-          for (auto& link : bilinks[iL])
-          {  // iL for "Index of Layer"
-            if (link.first == head_key)
-            {
-              link_matches.insert(link.second);
-            }
+          // links are sorted per layer. iL for "Index of Layer"
+          const auto matched_links = std::equal_range(bilinks[iL].begin(), bilinks[iL].end(), head_key, CompKeyToBilink());
+          for (auto link = matched_links.first; link != matched_links.second; ++link)
+          {
+            link_matches.insert(link->second);
           }
         }
 
@@ -1011,8 +1362,12 @@ int PHCASeeding::Setup(PHCompositeNode* topNode)  // This is called by ::InitRun
     dphi_per_layer[i] = _neighbor_phi_width * delta_rad;
   }
 
+  InitializeCellGrids();
+
 #if defined(_PHCASEEDING_CLUSTERLOG_TUPOUT_)
   std::cout << " Writing _CLUSTER_LOG_TUPOUT.root file " << std::endl;
+  // link window tuples are only filled by the rtree link building
+  _use_cell_grid = false;
   _f_clustering_process = new TFile("_CLUSTER_LOG_TUPOUT.root", "recreate");
   _tupclus_all = new TNtuple("all", "all clusters", "event:layer:num:x:y:z");
   _tupclus_links = new TNtuple("links", "links", "event:layer:updown01:x:y:z:delta_z:delta_phi");
@@ -101,6 +101,11 @@ class PHCASeeding : public PHTrackSeeding
   ~PHCASeeding() override = default;
 
   void SetSplitSeeds(bool opt = true) { _split_seeds = opt; }
+
+  /// use per layer phi x z cell grids and per layer link building, instead of the per event rtrees
+  void SetUseCellGrid(bool opt = true) { _use_cell_grid = opt; }
+  /// number of threads used to build the cell grid links. 0 means all available threads
+  void SetNumThreads(int n) { _num_threads = n; }
   void SetLayerRange(unsigned int layer_low, unsigned int layer_up)
   {
     _start_layer = layer_low;
@@ -212,6 +217,42 @@ class PHCASeeding : public PHTrackSeeding
   };
   std::pair<std::vector<keyLink>::iterator, std::vector<keyLink>::iterator> FindBilinks(const TrkrDefs::cluskey& key);
 
+  /// per layer phi x z cell grid, used for link building
+  /**
+   * cluster coordinates are stored as structure of arrays, sorted by cell,
+   * with cell_offsets giving the range of clusters in each cell.
+   * Cell sizes are computed once in Setup from the search windows. Storage is reused from one event to the next
+   */
+  struct CellGrid
+  {
+    int n_phi = 1;
+    int n_z = 1;
+    float inv_phi_width = 1;
+    float inv_z_width = 1;
+
+    std::vector<unsigned int> cell_offsets;
+
+    /// phi and z, in single precision, as used for window queries
+    std::vector<float> phi;
+    std::vector<float> z;
+
+    /// global position
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<double> z_global;
+
+    std::vector<TrkrDefs::cluskey> keys;
+
+    /// false for duplicated clusters
+    std::vector<unsigned char> kept;
+
+    /// number of duplicated clusters
+    int n_duplicates = 0;
+
+    int phi_bin(float) const;
+    int z_bin(float) const;
+  };
+
   /// tpc distortion correction utility class
   TpcDistortionCorrection m_distortionCorrection;
 
@@ -223,6 +264,10 @@ class PHCASeeding : public PHTrackSeeding
   Acts::Vector3 getGlobalPosition(TrkrDefs::cluskey, TrkrCluster*) const;
   std::pair<PositionMap, keyListPerLayer> FillGlobalPositions();
   std::pair<keyLinks, keyLinkPerLayer> CreateBiLinks(const PositionMap& globalPositions, const keyListPerLayer& ckeys);
+  std::pair<keyLinks, keyLinkPerLayer> CreateBiLinksCellGrid(const PositionMap& globalPositions, const keyListPerLayer& ckeys);
+  void InitializeCellGrids();
+  void FillCellGrid(CellGrid&, const keyList&, const PositionMap&) const;
+  void QueryCellGrid(const CellGrid&, double phimin, double zmin, double phimax, double zmax, std::vector<unsigned int>& returned_values) const;
   PHCASeeding::keyLists FollowBiLinks(const keyLinks& trackSeedPairs, const keyLinkPerLayer& bilinks, const PositionMap& globalPositions) const;
   std::vector<coordKey> FillTree(bgi::rtree<pointKey, bgi::quadratic<16>>&, const keyList&, const PositionMap&, int layer);
   int FindSeedsWithMerger(const PositionMap&, const keyListPerLayer&);
@@ -257,6 +302,8 @@ class PHCASeeding : public PHTrackSeeding
   double _rz_outlier_threshold = 0.1;
   double _xy_outlier_threshold = 0.1;
   bool _split_seeds = true;
+  bool _use_cell_grid = true;
+  int _num_threads = 1;
   bool _reject_zsize1 = false;
   bool _use_fixed_clus_err = false;
   bool _pp_mode = false;
@@ -275,6 +322,14 @@ class PHCASeeding : public PHTrackSeeding
   /* std::array<bgi::rtree<pointKey, bgi::quadratic<16>>, _NLAYERS_TPC> _rtrees; */
   std::array<bgi::rtree<pointKey, bgi::quadratic<16>>, 3> _rtrees;  // need three layers at a time
 
+  /// cell grids, one per TPC layer
+  std::array<CellGrid, _NLAYERS_TPC> _cell_grids;
+
+  /// cell grid z extent and maximum number of bins per direction. Clusters outside the z extent go to the edge cells
+  static constexpr float _cell_grid_z_min = -110;
+  static constexpr float _cell_grid_z_max = 110;
+  static constexpr int _cell_grid_max_bins = 256;
+
   double Ne_frac = 0.00;
   double Ar_frac = 0.75;
   double CF4_frac = 0.20;
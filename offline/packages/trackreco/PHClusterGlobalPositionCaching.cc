@@ -0,0 +1,131 @@
+#include "PHClusterGlobalPositionCaching.h"
+
+#include <trackbase/TrkrCluster.h>
+#include <trackbase/TrkrClusterContainer.h>
+#include <trackbase/TrkrClusterGlobalPositionCache.h>
+#include <trackbase/TrkrDefs.h>
+
+#include <fun4all/Fun4AllReturnCodes.h>
+
+#include <phool/PHCompositeNode.h>
+#include <phool/PHDataNode.h>
+#include <phool/PHNodeIterator.h>
+#include <phool/PHTimer.h>
+#include <phool/getClass.h>
+#include <phool/phool.h>
+
+#include <omp.h>
+
+#include <algorithm>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+//____________________________________________________________________________..
+PHClusterGlobalPositionCaching::PHClusterGlobalPositionCaching(const std::string &name)
+  : SubsysReco(name)
+{
+}
+
+//____________________________________________________________________________..
+int PHClusterGlobalPositionCaching::InitRun(PHCompositeNode *topNode)
+{
+  if (createNodes(topNode) != Fun4AllReturnCodes::EVENT_OK)
+  {
+    return Fun4AllReturnCodes::ABORTEVENT;
+  }
+
+  // the producer never reads from the cache
+  m_globalPositionWrapper.set_use_cache(false);
+  m_globalPositionWrapper.loadNodes(topNode);
+  m_globalPositionWrapper.set_verbosity(Verbosity());
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+//____________________________________________________________________________..
+int PHClusterGlobalPositionCaching::createNodes(PHCompositeNode *topNode)
+{
+  m_cache = findNode::getClass<TrkrClusterGlobalPositionCache>(topNode, TpcGlobalPositionWrapper::cacheNodeName);
+  if (m_cache)
+  {
+    return Fun4AllReturnCodes::EVENT_OK;
+  }
+
+  PHNodeIterator iter(topNode);
+  auto *dstNode = dynamic_cast<PHCompositeNode *>(iter.findFirst("PHCompositeNode", "DST"));
+  if (!dstNode)
+  {
+    std::cout << PHWHERE << " DST node is missing, quitting" << std::endl;
+    return Fun4AllReturnCodes::ABORTRUN;
+  }
+
+  PHNodeIterator dstIter(dstNode);
+  auto *trkrNode = dynamic_cast<PHCompositeNode *>(dstIter.findFirst("PHCompositeNode", "TRKR"));
+  if (!trkrNode)
+  {
+    trkrNode = new PHCompositeNode("TRKR");
+    dstNode->addNode(trkrNode);
+  }
+
+  // transient node, reset at the end of every event
+  m_cache = new TrkrClusterGlobalPositionCache;
+  auto *node = new PHDataNode<TrkrClusterGlobalPositionCache>(m_cache, TpcGlobalPositionWrapper::cacheNodeName, "PHObject");
+  trkrNode->addNode(node);
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+//____________________________________________________________________________..
+int PHClusterGlobalPositionCaching::process_event(PHCompositeNode *topNode)
+{
+  m_clusterContainer = findNode::getClass<TrkrClusterContainer>(topNode, m_clusterContainerName);
+  if (!m_clusterContainer)
+  {
+    std::cout << PHWHERE << " No cluster container " << m_clusterContainerName << ", skipping" << std::endl;
+    return Fun4AllReturnCodes::EVENT_OK;
+  }
+
+  PHTimer timer("PHClusterGlobalPositionCaching");
+  timer.restart();
+
+  // the cache may have been filled already if the module is registered more than once
+  m_cache->Reset();
+
+  // collect clusters and reserve dense storage per hitset.
+  // This must be done serially because the cluster container iteration is not thread safe
+  std::vector<std::pair<TrkrDefs::cluskey, TrkrCluster *>> clusters;
+  clusters.reserve(m_clusterContainer->size());
+  for (const auto &hitsetkey : m_clusterContainer->getHitSetKeys())
+  {
+    unsigned int size = 0;
+    const auto range = m_clusterContainer->getClusters(hitsetkey);
+    for (auto iter = range.first; iter != range.second; ++iter)
+    {
+      clusters.emplace_back(iter->first, iter->second);
+      size = std::max(size, TrkrDefs::getClusIndex(iter->first) + 1);
+    }
+    m_cache->reserve(hitsetkey, size);
+  }
+
+  // compute positions in parallel. The thread count only applies to this loop
+  const int nclusters = clusters.size();
+  const int nthreads = m_num_threads >= 1 ? m_num_threads : omp_get_max_threads();
+#pragma omp parallel for schedule(static) num_threads(nthreads)
+  for (int i = 0; i < nclusters; ++i)
+  {
+    const auto &[key, cluster] = clusters[i];
+    m_globalPositionWrapper.fillCache(m_cache, key, cluster);
+  }
+
+  m_cache->validate(m_globalPositionWrapper.configuration());
+
+  if (Verbosity())
+  {
+    timer.stop();
+    std::cout << "PHClusterGlobalPositionCaching::process_event - clusters: " << nclusters
+              << " time: " << timer.elapsed() << " ms" << std::endl;
+  }
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
@@ -0,0 +1,60 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+
+/*!
+ *  \file PHClusterGlobalPositionCaching.h
+ *  \brief fills the per event cache of cluster global positions shared by tracking modules
+ */
+
+#ifndef PHCLUSTERGLOBALPOSITIONCACHING_H
+#define PHCLUSTERGLOBALPOSITIONCACHING_H
+
+#include <tpc/TpcGlobalPositionWrapper.h>
+
+#include <fun4all/SubsysReco.h>
+
+#include <string>
+
+class PHCompositeNode;
+class TrkrClusterContainer;
+class TrkrClusterGlobalPositionCache;
+
+/*!
+ * computes once per event, in parallel, the aligned and the distortion corrected (crossing zero)
+ * global positions of all clusters, and stores them in a transient TrkrClusterGlobalPositionCache node.
+ * Modules using TpcGlobalPositionWrapper (seeding, propagation, fitting, cluster mover)
+ * read from the cache instead of recomputing, provided their geometry and correction settings match.
+ * Must run after clustering and after the distortion corrections are loaded.
+ */
+class PHClusterGlobalPositionCaching : public SubsysReco
+{
+ public:
+  PHClusterGlobalPositionCaching(const std::string &name = "PHClusterGlobalPositionCaching");
+
+  int InitRun(PHCompositeNode *topNode) override;
+  int process_event(PHCompositeNode *topNode) override;
+
+  void set_cluster_map_name(const std::string &value) { m_clusterContainerName = value; }
+  //! number of threads used to compute the positions. 0 means all available threads
+  void set_num_threads(int value) { m_num_threads = value; }
+
+  //! correction flags. Must match the ones of the consumers for them to use the cache
+  void set_enable_module_edge_corr(bool flag) { m_globalPositionWrapper.set_enable_module_edge_corr(flag); }
+  void set_enable_static_corr(bool flag) { m_globalPositionWrapper.set_enable_static_corr(flag); }
+  void set_enable_average_corr(bool flag) { m_globalPositionWrapper.set_enable_average_corr(flag); }
+  void set_enable_fluctuation_corr(bool flag) { m_globalPositionWrapper.set_enable_fluctuation_corr(flag); }
+
+ private:
+  int createNodes(PHCompositeNode *topNode);
+
+  std::string m_clusterContainerName = "TRKR_CLUSTER";
+  TrkrClusterContainer *m_clusterContainer = nullptr;
+  TrkrClusterGlobalPositionCache *m_cache = nullptr;
+
+  //! global position wrapper, used to compute the cached positions
+  TpcGlobalPositionWrapper m_globalPositionWrapper;
+
+  int m_num_threads = 1;
+};
+
+#endif  // PHCLUSTERGLOBALPOSITIONCACHING_H
@@ -1,7 +1,5 @@
 #include "PHGhostRejection.h"
 
-#include "PHGhostRejection.h"
-
 /// Tracking includes
 
 #include <trackbase/TrkrCluster.h>  // for TrkrCluster
@@ -13,10 +11,9 @@
 #include <trackbase_historic/TrackSeedContainer.h>
 #include <trackbase_historic/TrackSeedHelper.h>
 
+#include <algorithm> // for sort, find_if, count
 #include <cmath>     // for sqrt, fabs, atan2, cos
 #include <iostream>  // for operator<<, basic_ostream
-#include <map>       // for map
-#include <set>       // for _Rb_tree_const_iterator
 #include <utility>   // for pair, make_pair
 
 //____________________________________________________________________________..
@@ -102,54 +99,34 @@ void PHGhostRejection::find_ghosts(const std::vector<float>& trackChi2)
   }
 
   // Elimate low-interest track, and try to eliminate repeated tracks
-  std::set<unsigned int> matches_set;
-  std::multimap<unsigned int, unsigned int> matches;
-  for (size_t trid1 = 0; trid1 < seeds.size(); ++trid1)
-  {
-    if (m_rejected[trid1]) { continue; }
-    const auto& track1 = seeds[trid1];
-    const float track1phi = track1.get_phi();
+  // candidate pairs come out sorted by (trid1, trid2), which keeps the resolution order deterministic
+  const auto matches = find_candidate_pairs();
 
-    const auto track1_pos = TrackSeedHelper::get_xyz(&track1);
-    const float track1eta = track1.get_eta();
-    for (size_t trid2 = trid1+1; trid2 < seeds.size(); ++trid2)
+  // cache sorted cluster keys, for fast cluster sharing check
+  std::vector<std::vector<TrkrDefs::cluskey>> cluster_keys(seeds.size());
+  for (const auto& [trid1, trid2] : matches)
+  {
+    for (const auto& trid : {trid1, trid2})
     {
-      if (m_rejected[trid2])
-      {
-        continue;
-      }
-
-      const auto& track2 = seeds[trid2];
-      const auto track2_pos = TrackSeedHelper::get_xyz(&track2);
-      const float track2eta = track2.get_eta();
-      auto delta_phi = std::abs(track1phi - track2.get_phi());
-
-      if (delta_phi > 2 * M_PI) {
-        delta_phi = delta_phi - 2*M_PI;
-      }
-      if (delta_phi < _phi_cut &&
-          std::abs(track1eta - track2eta) < _eta_cut &&
-          std::abs(track1_pos.x() - track2_pos.x()) < _x_cut &&
-          std::abs(track1_pos.y() - track2_pos.y()) < _y_cut &&
-          std::abs(track1_pos.z() - track2_pos.z()) < _z_cut)
+      auto& keys = cluster_keys[trid];
+      if (keys.empty())
       {
-        matches_set.insert(trid1);
-        matches.insert(std::pair(trid1, trid2));
-
-        if (m_verbosity > 1)
-        {
-          std::cout << "Found match for tracks " << trid1 << " and " << trid2 << std::endl;
-        }
+        keys.assign(seeds[trid].begin_cluster_keys(), seeds[trid].end_cluster_keys());
       }
     }
   }
 
-  for (auto set_it : matches_set)
+  for (auto match_begin = matches.begin(); match_begin != matches.end();)
   {
+    const unsigned int set_it = match_begin->first;
+    const auto match_end = std::find_if(match_begin, matches.end(),
+      [set_it](const auto& match) { return match.first != set_it; });
+    const auto match_list = std::make_pair(match_begin, match_end);
+    match_begin = match_end;
+
     if (m_rejected[set_it]) { continue; } // already rejected
-    auto match_list = matches.equal_range(set_it);
 
-    auto tr1 = seeds[set_it];
+    const auto& tr1 = seeds[set_it];
     double best_qual = trackChi2.at(set_it);
     unsigned int best_track = set_it;
 
@@ -165,10 +142,10 @@ void PHGhostRejection::find_ghosts(const std::vector<float>& trackChi2)
         std::cout << "    match of track " << it->first << " to track " << it->second << std::endl;
       }
 
-      auto tr2 = seeds[it->second];
+      const auto& tr2 = seeds[it->second];
 
       // Check that these two tracks actually share the same clusters, if not skip this pair
-      bool is_same_track = checkClusterSharing(tr1, tr2);
+      bool is_same_track = checkClusterSharing(cluster_keys[set_it], cluster_keys[it->second]);
       if (!is_same_track)
       {
         continue;
@@ -234,6 +211,161 @@ void PHGhostRejection::find_ghosts(const std::vector<float>& trackChi2)
   }
 }
 
+//____________________________________________________________________________..
+std::vector<std::pair<unsigned int, unsigned int>> PHGhostRejection::find_candidate_pairs() const
+{
+  // store relevant quantities for all non-rejected seeds, with phi in [0, 2pi[
+  std::vector<SeedCandidate> candidates;
+  candidates.reserve(seeds.size());
+  for (unsigned int trid = 0; trid < seeds.size(); ++trid)
+  {
+    if (m_rejected[trid]) { continue; }
+    const auto& track = seeds[trid];
+    const auto pos = TrackSeedHelper::get_xyz(&track);
+    float phi = std::fmod(track.get_phi(), 2 * M_PI);
+    if (phi < 0) { phi += 2 * M_PI; }
+    candidates.push_back({trid, phi, track.get_eta(), (float) pos.x(), (float) pos.y(), (float) pos.z()});
+  }
+
+  // sort by eta cell, then by phi. Seeds closer than _eta_cut in eta are in the same or in
+  // neighbouring cells, so only those cells are compared. Without eta cut there is a single cell
+  const bool eta_cells = std::isfinite(_eta_cut) && _eta_cut > 0 && _eta_cut < std::numeric_limits<double>::max();
+  for (auto& candidate : candidates)
+  {
+    candidate.eta_cell = eta_cells ? static_cast<long>(std::floor(candidate.eta / _eta_cut)) : 0;
+  }
+  std::sort(candidates.begin(), candidates.end(),
+    [](const SeedCandidate& first, const SeedCandidate& second)
+    { return (first.eta_cell == second.eta_cell) ? first.phi < second.phi : first.eta_cell < second.eta_cell; });
+
+  // [begin, end[ candidate ranges of the eta cells, in increasing cell order
+  std::vector<std::pair<size_t, size_t>> cells;
+  for (size_t i = 0; i < candidates.size(); ++i)
+  {
+    if (i == 0 || candidates[i].eta_cell != candidates[i - 1].eta_cell) { cells.emplace_back(i, i); }
+    cells.back().second = i + 1;
+  }
+
+  // check all other windows for a given pair
+  const auto in_window = [this](const SeedCandidate& first, const SeedCandidate& second)
+  {
+    return std::abs(first.eta - second.eta) < _eta_cut &&
+      std::abs(first.x - second.x) < _x_cut &&
+      std::abs(first.y - second.y) < _y_cut &&
+      std::abs(first.z - second.z) < _z_cut;
+  };
+
+  std::vector<std::pair<unsigned int, unsigned int>> matches;
+  const auto add_match = [&matches, this](unsigned int trid1, unsigned int trid2)
+  {
+    if (trid2 < trid1) { std::swap(trid1, trid2); }
+    matches.emplace_back(trid1, trid2);
+    if (m_verbosity > 1)
+    {
+      std::cout << "Found match for tracks " << trid1 << " and " << trid2 << std::endl;
+    }
+  };
+
+  // compare a candidate to the candidates in [begin, end[
+  const auto compare_range = [&](const SeedCandidate& first, size_t begin, size_t end)
+  {
+    for (size_t j = begin; j < end; ++j)
+    {
+      const auto& second = candidates[j];
+      const float delta_phi = std::abs(second.phi - first.phi);
+      if (std::min<double>(delta_phi, 2 * M_PI - delta_phi) < _phi_cut && in_window(first, second))
+      {
+        add_match(first.id, second.id);
+      }
+    }
+  };
+
+  // first candidate in [begin, end[ with phi not below a given value, the range being sorted in phi
+  const auto phi_lower_bound = [&candidates](size_t begin, size_t end, double phi)
+  {
+    return static_cast<size_t>(std::lower_bound(candidates.begin() + begin, candidates.begin() + end, phi,
+      [](const SeedCandidate& candidate, double value) { return candidate.phi < value; }) - candidates.begin());
+  };
+
+  // compare a candidate to the candidates in [begin, end[ within the phi window, wrapping around at 2pi.
+  // The window is slightly widened so that rounding cannot drop a pair, the phi cut itself is applied in compare_range.
+  // When the window covers the full azimuth, the whole range is compared
+  const double phi_window = _phi_cut + 1e-5;
+  const bool full_azimuth = !(phi_window < M_PI);
+  const auto sweep_range = [&](const SeedCandidate& first, size_t begin, size_t end)
+  {
+    if (full_azimuth)
+    {
+      compare_range(first, begin, end);
+      return;
+    }
+    const double low = first.phi - phi_window;
+    const double high = first.phi + phi_window;
+    compare_range(first, phi_lower_bound(begin, end, std::max(low, 0.)), phi_lower_bound(begin, end, std::min(high, 2 * M_PI)));
+    if (low < 0)
+    {
+      compare_range(first, phi_lower_bound(begin, end, low + 2 * M_PI), end);
+    }
+    if (high > 2 * M_PI)
+    {
+      compare_range(first, begin, phi_lower_bound(begin, end, high - 2 * M_PI));
+    }
+  };
+
+  // each pair is compared once: within a cell from its first candidate, across cells from the lower cell.
+  // Only a finite phi or eta cut restricts the comparisons, with neither every pair is in the windows
+  for (size_t icell = 0; icell < cells.size(); ++icell)
+  {
+    const auto& [begin, end] = cells[icell];
+    const bool next_cell = icell + 1 < cells.size() && candidates[cells[icell + 1].first].eta_cell == candidates[begin].eta_cell + 1;
+    for (size_t i = begin; i < end; ++i)
+    {
+      const auto& first = candidates[i];
+      sweep_range(first, i + 1, end);
+      if (next_cell)
+      {
+        sweep_range(first, cells[icell + 1].first, cells[icell + 1].second);
+      }
+    }
+  }
+
+  std::sort(matches.begin(), matches.end());
+  return matches;
+}
+
+//____________________________________________________________________________..
+bool PHGhostRejection::checkClusterSharing(const std::vector<TrkrDefs::cluskey>& keys1, const std::vector<TrkrDefs::cluskey>& keys2) const
+{
+  // count shared clusters by merging the two sorted key lists
+  size_t n_shared_clus = 0;
+  auto iter1 = keys1.begin();
+  auto iter2 = keys2.begin();
+  while (iter1 != keys1.end() && iter2 != keys2.end())
+  {
+    if (*iter1 < *iter2)
+    {
+      ++iter1;
+    }
+    else if (*iter2 < *iter1)
+    {
+      ++iter2;
+    }
+    else
+    {
+      ++n_shared_clus;
+      ++iter1;
+      ++iter2;
+    }
+  }
+
+  if (m_verbosity > 2)
+  {
+    std::cout << " N-clusters tr1: " << keys1.size() << " N-clusters tr2: " << keys2.size() << " N-clusters shared: " << n_shared_clus << std::endl;
+  }
+  size_t nreq = 2 * n_shared_clus + 1;
+  return (nreq > keys1.size()) || (nreq > keys2.size());
+}
+
 // there is no check, at this point, about which is the best chi2 track
 bool PHGhostRejection::checkClusterSharing(const TrackSeed& tr1, const TrackSeed& tr2) const
 {
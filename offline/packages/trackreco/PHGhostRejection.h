@@ -13,11 +13,14 @@
 #include <fun4all/SubsysReco.h>
 #include <trackbase/ActsSurfaceMaps.h>
 #include <trackbase/ActsTrackingGeometry.h>
+#include <trackbase/TrkrDefs.h>
 #include <trackbase_historic/TrackSeed_v2.h>
 
 
+#include <limits>
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 class PHCompositeNode;
@@ -49,6 +52,9 @@ class PHGhostRejection
 
   bool checkClusterSharing(const TrackSeed& tr1, const TrackSeed& tr2) const;
 
+  // same as above, on sorted cluster key vectors
+  bool checkClusterSharing(const std::vector<TrkrDefs::cluskey>& keys1, const std::vector<TrkrDefs::cluskey>& keys2) const;
+
   void set_min_pt_cut(float _ptmin) { _min_pt= _ptmin; }
   void set_must_span_sectors(bool _setting) { _must_span_sectors = _setting; }
   void set_min_clusters (int _val) { _min_clusters = _val; }
@@ -59,6 +65,24 @@ class PHGhostRejection
   void set_z_cut(double d) { _z_cut = d; }
 
  private:
+
+  // seed quantities used in the sort-and-sweep pairing, cached once per event
+  struct SeedCandidate
+  {
+    unsigned int id = 0;
+    float phi = 0;
+    float eta = 0;
+    float x = 0;
+    float y = 0;
+    float z = 0;
+    long eta_cell = 0;
+  };
+
+  // find all pairs (trid1 < trid2) of seeds that are within the phi/eta/x/y/z windows.
+  // Seeds are bucketed in eta cells of _eta_cut and swept in phi, so only a finite phi or
+  // eta cut avoids comparing all pairs
+  std::vector<std::pair<unsigned int, unsigned int>> find_candidate_pairs() const;
+
   unsigned int m_verbosity;
   const std::vector<TrackSeed_v2>& seeds;
   std::vector<bool> m_rejected {}; // id
@@ -32,6 +32,9 @@
 #include <TFile.h>
 #include <TNtuple.h>
 
+#include <omp.h>
+
+#include <algorithm>  // for sort, lower_bound
 #include <climits>   // for UINT_MAX
 #include <cmath>     // for fabs, sqrt
 #include <iostream>  // for operator<<, basic_ostream
@@ -174,6 +177,20 @@ bool PHSiliconTpcTrackMatching::WindowMatcher::in_window
   }
 }
 
+std::pair<double, double> PHSiliconTpcTrackMatching::WindowMatcher::get_range
+(const bool posQ, const double tpc_pt)
+{
+  if (posQ) {
+    double pt = (tpc_pt<min_pt_posQ) ? min_pt_posQ : tpc_pt;
+    const double hi = fn_exp(posHi, posHi_b0, pt);
+    return fabs_max_posQ ? std::make_pair(-hi, hi) : std::make_pair(fn_exp(posLo, posLo_b0, pt), hi);
+  } else {
+    double pt = (tpc_pt<min_pt_negQ) ? min_pt_negQ : tpc_pt;
+    const double hi = fn_exp(negHi, negHi_b0, pt);
+    return fabs_max_negQ ? std::make_pair(-hi, hi) : std::make_pair(fn_exp(negLo, negLo_b0, pt), hi);
+  }
+}
+
 //____________________________________________________________________________..
 int PHSiliconTpcTrackMatching::process_event(PHCompositeNode * /*unused*/)
 {
@@ -462,11 +479,135 @@ int PHSiliconTpcTrackMatching::GetNodes(PHCompositeNode *topNode)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+PHSiliconTpcTrackMatching::SeedParameters PHSiliconTpcTrackMatching::getSeedParameters(TrackSeed *seed)
+{
+  SeedParameters parameters;
+  if (_zero_field) {
+    auto cluster_list = getTrackletClusterList(seed);
+
+    Acts::Vector3  mom;
+    bool ok_track;
+
+    std::tie(ok_track, parameters.phi, parameters.eta, parameters.pt, parameters.pos, mom) =
+      TrackFitUtils::zero_field_track_params(_tGeometry, _cluster_map, cluster_list);
+    if (!ok_track) { return parameters; }
+    parameters.px = mom.x();
+    parameters.py = mom.y();
+    parameters.pz = mom.z();
+    parameters.q = -100;
+  } else {
+    parameters.phi = seed->get_phi();
+    parameters.eta = seed->get_eta();
+    parameters.pt = fabs(1. / seed->get_qOverR()) * (0.3 / 100.) * fieldstrength;
+
+    parameters.pos = TrackSeedHelper::get_xyz(seed);
+
+    parameters.px = seed->get_px();
+    parameters.py = seed->get_py();
+    parameters.pz = seed->get_pz();
+
+    parameters.q = seed->get_charge();
+  }
+  parameters.valid = true;
+  return parameters;
+}
+
+void PHSiliconTpcTrackMatching::buildSiliconIndex(const std::vector<SeedParameters> &si_parameters)
+{
+  for (auto &bin : _si_index)
+  {
+    bin.clear();
+  }
+
+  for (unsigned int siid = 0; siid < si_parameters.size(); ++siid)
+  {
+    const auto &parameters = si_parameters[siid];
+    if (!parameters.valid)
+    {
+      continue;
+    }
+    double phi = std::fmod(parameters.phi, 2 * M_PI);
+    if (phi < 0) { phi += 2 * M_PI; }
+    const auto iphi = std::min<unsigned int>(phi * _n_phi_bins_si_index / (2 * M_PI), _n_phi_bins_si_index - 1);
+    _si_index[iphi].emplace_back(parameters.eta, siid);
+  }
+
+  for (auto &bin : _si_index)
+  {
+    std::sort(bin.begin(), bin.end());
+  }
+}
+
+std::vector<unsigned int> PHSiliconTpcTrackMatching::getSiliconCandidates(const SeedParameters &tpc_parameters)
+{
+  const bool is_posQ = (tpc_parameters.q>0.);
+
+  // eta range. Accounts for both the pT dependent window and the minimum deta
+  // deta is defined as tpc_eta - si_eta
+  const auto [deta_lo, deta_hi] = window_deta.get_range(is_posQ, tpc_parameters.pt);
+  const double eta_min = tpc_parameters.eta - std::max<double>(deta_hi, _deltaeta_min);
+  const double eta_max = tpc_parameters.eta - std::min<double>(deta_lo, -_deltaeta_min);
+
+  // phi range, with wrap-around. Bin boundaries are extended by one bin on each side
+  // to stay on the safe side of rounding. The exact windows are checked by the caller
+  const auto [dphi_lo, dphi_hi] = window_dphi.get_range(is_posQ, tpc_parameters.pt);
+  const double bin_width = 2 * M_PI / _n_phi_bins_si_index;
+  int iphi_min = std::floor((tpc_parameters.phi - dphi_hi) / bin_width) - 1;
+  int iphi_max = std::floor((tpc_parameters.phi - dphi_lo) / bin_width) + 1;
+  if (iphi_max - iphi_min + 1 >= (int) _n_phi_bins_si_index)
+  {
+    iphi_min = 0;
+    iphi_max = _n_phi_bins_si_index - 1;
+  }
+
+  std::vector<unsigned int> candidates;
+  for (int iphi = iphi_min; iphi <= iphi_max; ++iphi)
+  {
+    const auto &bin = _si_index[((iphi % (int) _n_phi_bins_si_index) + _n_phi_bins_si_index) % _n_phi_bins_si_index];
+    auto iter = std::lower_bound(bin.begin(), bin.end(), std::make_pair(eta_min, 0U));
+    for (; iter != bin.end() && iter->first <= eta_max; ++iter)
+    {
+      candidates.push_back(iter->second);
+    }
+  }
+
+  // keep the same ordering as a full loop over silicon seeds
+  std::sort(candidates.begin(), candidates.end());
+  return candidates;
+}
+
 void PHSiliconTpcTrackMatching::findEtaPhiMatches(
     std::set<unsigned int> &tpc_matched_set,
     std::set<unsigned int> &tpc_unmatched_set,
     std::multimap<unsigned int, unsigned int> &tpc_matches)
 {
+  // calculate silicon seed parameters once, and index them in phi and eta
+  std::vector<SeedParameters> si_parameters(_track_map_silicon->size());
+  for (unsigned int phtrk_iter_si = 0;
+       phtrk_iter_si < _track_map_silicon->size();
+       ++phtrk_iter_si)
+  {
+    auto *tracklet_si = _track_map_silicon->get(phtrk_iter_si);
+    if (tracklet_si)
+    {
+      si_parameters[phtrk_iter_si] = getSeedParameters(tracklet_si);
+    }
+  }
+  buildSiliconIndex(si_parameters);
+
+  // all silicon seeds, used when testing windows
+  std::vector<unsigned int> all_silicon_seeds;
+  if (_test_windows)
+  {
+    for (unsigned int siid = 0; siid < si_parameters.size(); ++siid)
+    {
+      if (si_parameters[siid].valid)
+      {
+        all_silicon_seeds.push_back(siid);
+      }
+    }
+  }
+
   // loop over the TPC track seeds
   for (unsigned int phtrk_iter = 0;
        phtrk_iter < _track_map->size();
@@ -490,36 +631,14 @@ void PHSiliconTpcTrackMatching::findEtaPhiMatches(
           << endl;
     }
 
-    double tpc_phi, tpc_eta, tpc_pt;
-    float tpc_px, tpc_py, tpc_pz;
-    int tpc_q;
-    Acts::Vector3 tpc_pos;
-    if (_zero_field) {
-      auto cluster_list = getTrackletClusterList(_tracklet_tpc);
-
-      Acts::Vector3  mom;
-      bool ok_track;
-
-      std::tie(ok_track, tpc_phi, tpc_eta, tpc_pt, tpc_pos, mom) =
-        TrackFitUtils::zero_field_track_params(_tGeometry, _cluster_map, cluster_list);
-      if (!ok_track) { continue; }
-      tpc_px = mom.x();
-      tpc_py = mom.y();
-      tpc_pz = mom.z();
-      tpc_q = -100;
-    } else {
-      tpc_phi = _tracklet_tpc->get_phi();
-      tpc_eta = _tracklet_tpc->get_eta();
-      tpc_pt = fabs(1. / _tracklet_tpc->get_qOverR()) * (0.3 / 100.) * fieldstrength;
-
-      tpc_pos = TrackSeedHelper::get_xyz(_tracklet_tpc);
+    const auto tpc_parameters = getSeedParameters(_tracklet_tpc);
+    if (!tpc_parameters.valid) { continue; }
 
-      tpc_px = _tracklet_tpc->get_px();
-      tpc_py = _tracklet_tpc->get_py();
-      tpc_pz = _tracklet_tpc->get_pz();
-
-      tpc_q = _tracklet_tpc->get_charge();
-    }
+    const double tpc_phi = tpc_parameters.phi;
+    const double tpc_eta = tpc_parameters.eta;
+    const double tpc_pt = tpc_parameters.pt;
+    const Acts::Vector3 &tpc_pos = tpc_parameters.pos;
+    const int tpc_q = tpc_parameters.q;
 
     bool is_posQ = (tpc_q>0.);
 
@@ -537,54 +656,25 @@ void PHSiliconTpcTrackMatching::findEtaPhiMatches(
 
     bool matched = false;
 
-    // Now search the silicon track list for a match in eta and phi
-    for (unsigned int phtrk_iter_si = 0;
-         phtrk_iter_si < _track_map_silicon->size();
-         ++phtrk_iter_si)
+    // Now search the silicon seeds close in eta and phi for a match
+    const auto candidates = _test_windows ? all_silicon_seeds : getSiliconCandidates(tpc_parameters);
+    for (const auto siid : candidates)
     {
-      _tracklet_si = _track_map_silicon->get(phtrk_iter_si);
-      if (!_tracklet_si)
-      {
+      _tracklet_si = _track_map_silicon->get(siid);
 
-        continue;
-      }
-
-      double si_phi, si_eta, si_pt;
-      float si_px, si_py, si_pz;
-      int si_q;
-      Acts::Vector3 si_pos;
-      if (_zero_field) {
-      auto cluster_list = getTrackletClusterList(_tracklet_si);
-
-      Acts::Vector3  mom;
-      bool ok_track;
-
-      std::tie(ok_track, si_phi, si_eta, si_pt, si_pos, mom) =
-        TrackFitUtils::zero_field_track_params(_tGeometry, _cluster_map, cluster_list);
-      if (!ok_track) { continue; }
-        si_px = mom.x();
-        si_py = mom.y();
-        si_pz = mom.z();
-        si_q = -100;
-      } else {
-        si_eta = _tracklet_si->get_eta();
-        si_phi = _tracklet_si->get_phi();
-
-        si_pos = TrackSeedHelper::get_xyz(_tracklet_si);
-        si_px = _tracklet_si->get_px();
-        si_py = _tracklet_si->get_py();
-        si_pz = _tracklet_si->get_pz();
-        si_q = _tracklet_si->get_charge();
-      }
+      const auto &si_parameters_this = si_parameters[siid];
+      const double si_phi = si_parameters_this.phi;
+      const double si_eta = si_parameters_this.eta;
+      const Acts::Vector3 &si_pos = si_parameters_this.pos;
+      const int si_q = si_parameters_this.q;
       int si_crossing = _tracklet_si->get_crossing();
-      unsigned int siid = phtrk_iter_si;
 
       if(_test_windows)
       {
         float data[] = {
           (float) m_event, (float) si_crossing,
-          (float) si_q, (float) si_phi, (float) si_eta, (float) si_pos.x(), (float) si_pos.y(), (float) si_pos.z(), (float) si_px, (float) si_py, (float) si_pz,
-          (float) tpc_q, (float) tpc_phi, (float) tpc_eta, (float) tpc_pos.x(), (float) tpc_pos.y(), (float) tpc_pos.z(), (float) tpc_px, (float) tpc_py, (float) tpc_pz,
+          (float) si_q, (float) si_phi, (float) si_eta, (float) si_pos.x(), (float) si_pos.y(), (float) si_pos.z(), si_parameters_this.px, si_parameters_this.py, si_parameters_this.pz,
+          (float) tpc_q, (float) tpc_phi, (float) tpc_eta, (float) tpc_pos.x(), (float) tpc_pos.y(), (float) tpc_pos.z(), tpc_parameters.px, tpc_parameters.py, tpc_parameters.pz,
           (float) tpcid, (float) siid
 	};
         _tree->Fill(data);
@@ -692,8 +782,36 @@ void PHSiliconTpcTrackMatching::checkZMatches(
 
   float vdrift = _tGeometry->get_drift_velocity();
 
-  for (auto [tpcid, si_id] : tpc_matches)
+  // z matching of each TPC/silicon seed pair is independent, and is done in parallel
+  // results are stored per pair, and bad matches collected afterwards in the original order
+  enum class ZMatchStatus
   {
+    Skip,
+    Match,
+    Failure
+  };
+
+  struct ZMatchResult
+  {
+    ZMatchStatus status = ZMatchStatus::Skip;
+    short int crossing = 0;
+    float tpc_z = 0;
+    float si_z = 0;
+    float z_mismatch = 0;
+    float tpc_z_corrected = 0;
+    float z_mismatch_corrected = 0;
+  };
+
+  const std::vector<std::pair<unsigned int, unsigned int>> matches(tpc_matches.begin(), tpc_matches.end());
+  std::vector<ZMatchResult> results(matches.size());
+
+  const int nthreads = _num_threads >= 1 ? _num_threads : omp_get_max_threads();
+  #pragma omp parallel for schedule(dynamic) num_threads(nthreads)
+  for (size_t imatch = 0; imatch < matches.size(); ++imatch)
+  {
+    const auto& [tpcid, si_id] = matches[imatch];
+    auto& result = results[imatch];
+
     TrackSeed *tpc_track = _track_map->get(tpcid);
     TrackSeed *si_track = _track_map_silicon->get(si_id);
 
@@ -704,15 +822,16 @@ void PHSiliconTpcTrackMatching::checkZMatches(
       auto cluster_list_tpc = getTrackletClusterList(tpc_track);
       auto cluster_list_si = getTrackletClusterList(si_track);
 
-      tpc_pt = std::get<3>(TrackFitUtils::zero_field_track_params(_tGeometry, _cluster_map, cluster_list_tpc));
-      tpc_z = std::get<4>(TrackFitUtils::zero_field_track_params(_tGeometry, _cluster_map, cluster_list_tpc)).z();
+      const auto tpc_params = TrackFitUtils::zero_field_track_params(_tGeometry, _cluster_map, cluster_list_tpc);
+      tpc_pt = std::get<3>(tpc_params);
+      tpc_z = std::get<4>(tpc_params).z();
       tpc_q = -100;
 
       si_z = std::get<4>(TrackFitUtils::zero_field_track_params(_tGeometry, _cluster_map, cluster_list_si)).z();
     } else {
-      tpc_pt = fabs(1. / _tracklet_tpc->get_qOverR()) * (0.3 / 100.) * fieldstrength;
+      tpc_pt = fabs(1. / tpc_track->get_qOverR()) * (0.3 / 100.) * fieldstrength;
       tpc_z = TrackSeedHelper::get_z(tpc_track);
-      tpc_q = _tracklet_tpc->get_charge();
+      tpc_q = tpc_track->get_charge();
       si_z = TrackSeedHelper::get_z(si_track);
     }
 
@@ -723,59 +842,76 @@ void PHSiliconTpcTrackMatching::checkZMatches(
 
     bool is_posQ = (tpc_q>0.);
 
-    float z_mismatch = tpc_z - si_z;
-    float tpc_z_corrected = _clusterCrossingCorrection.correctZ(tpc_z, this_side, crossing);
-    float z_mismatch_corrected = tpc_z_corrected - si_z;
+    result.crossing = crossing;
+    result.tpc_z = tpc_z;
+    result.si_z = si_z;
+    result.z_mismatch = tpc_z - si_z;
+    result.tpc_z_corrected = _clusterCrossingCorrection.correctZ(tpc_z, this_side, crossing);
+    result.z_mismatch_corrected = result.tpc_z_corrected - si_z;
 
     bool z_match = false;
     if (_pp_mode)
     {
       if (crossing == SHRT_MAX)
       {
-        if (Verbosity() > 2)
-        {
-          std::cout << " drop si_track " << si_id << " with eta " << si_track->get_eta() << " and z " << TrackSeedHelper::get_z(si_track) << " because crossing is undefined " << std::endl;
-        }
+        // leave status to Skip
         continue;
       }
 
-      if (window_dz.in_window(is_posQ, tpc_pt, tpc_z_corrected, si_z) && (fabs(z_mismatch_corrected) < _crossing_deltaz_max))
+      if (window_dz.in_window(is_posQ, tpc_pt, result.tpc_z_corrected, si_z) && (fabs(result.z_mismatch_corrected) < _crossing_deltaz_max))
       {
         z_match = true;
       }
-      else if (fabs(z_mismatch_corrected) < _crossing_deltaz_min)
+      else if (fabs(result.z_mismatch_corrected) < _crossing_deltaz_min)
       {
 	z_match = true;
       }
     }
     else
     {
-      if (window_dz.in_window(is_posQ, tpc_pt, tpc_z, si_z) && (fabs(z_mismatch) < _crossing_deltaz_max))
+      if (window_dz.in_window(is_posQ, tpc_pt, tpc_z, si_z) && (fabs(result.z_mismatch) < _crossing_deltaz_max))
       {
         z_match = true;
       }
-      else if (fabs(z_mismatch) < _crossing_deltaz_min)
+      else if (fabs(result.z_mismatch) < _crossing_deltaz_min)
       {
 	z_match = true;
       }
     }
 
-    if (z_match)
+    result.status = z_match ? ZMatchStatus::Match : ZMatchStatus::Failure;
+  }
+
+  for (size_t imatch = 0; imatch < matches.size(); ++imatch)
+  {
+    const auto& [tpcid, si_id] = matches[imatch];
+    const auto& result = results[imatch];
+    if (result.status == ZMatchStatus::Skip)
+    {
+      if (_pp_mode && result.crossing == SHRT_MAX && Verbosity() > 2)
+      {
+        TrackSeed *si_track = _track_map_silicon->get(si_id);
+        std::cout << " drop si_track " << si_id << " with eta " << si_track->get_eta() << " and z " << TrackSeedHelper::get_z(si_track) << " because crossing is undefined " << std::endl;
+      }
+      continue;
+    }
+
+    if (result.status == ZMatchStatus::Match)
     {
       if (Verbosity() > 1)
       {
-        std::cout << "  Success:  crossing " << crossing << " tpcid " << tpcid << " si id " << si_id
-                  << " tpc z " << tpc_z << " si z " << si_z << " z_mismatch " << z_mismatch << "tpc z corrected " << tpc_z_corrected
-                  << " z_mismatch_corrected " << z_mismatch_corrected << " drift velocity " << vdrift << std::endl;
+        std::cout << "  Success:  crossing " << result.crossing << " tpcid " << tpcid << " si id " << si_id
+                  << " tpc z " << result.tpc_z << " si z " << result.si_z << " z_mismatch " << result.z_mismatch << "tpc z corrected " << result.tpc_z_corrected
+                  << " z_mismatch_corrected " << result.z_mismatch_corrected << " drift velocity " << vdrift << std::endl;
       }
     }
     else
     {
       if (Verbosity() > 1)
       {
-        std::cout << "  FAILURE:  crossing " << crossing << " tpcid " << tpcid << " si id " << si_id
-                  << " tpc z " << tpc_z << " si z " << si_z << " z_mismatch " << z_mismatch << "tpc_z_corrected " << tpc_z_corrected
-                  << " z_mismatch_corrected " << z_mismatch_corrected << std::endl;
+        std::cout << "  FAILURE:  crossing " << result.crossing << " tpcid " << tpcid << " si id " << si_id
+                  << " tpc z " << result.tpc_z << " si z " << result.si_z << " z_mismatch " << result.z_mismatch << "tpc_z_corrected " << result.tpc_z_corrected
+                  << " z_mismatch_corrected " << result.z_mismatch_corrected << std::endl;
       }
 
       bad_map.insert(std::make_pair(tpcid, si_id));
@@ -8,8 +8,12 @@
 #include <tpc/TpcClusterZCrossingCorrection.h>
 #include <trackbase/ActsGeometry.h>
 
+#include <array>
 #include <map>
+#include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
 class PHCompositeNode;
 class TrackSeedContainer;
@@ -86,6 +90,9 @@ class PHSiliconTpcTrackMatching : public SubsysReco, public PHParameterInterface
 
     bool in_window(bool posQ, const double tpc_pt, const double tpc_X, const double si_X);
 
+    // range [lo, hi] of deltaX = tpc_X - si_X accepted by in_window, for a given charge and pT
+    std::pair<double, double> get_range(bool posQ, const double tpc_pt);
+
     // initialize to fn_lo < deltaX < fn_hi for +Q, and fn_lo < deltaX < fn_hi for -Q
 
     void reset_fns() {
@@ -133,6 +140,9 @@ class PHSiliconTpcTrackMatching : public SubsysReco, public PHParameterInterface
 
   void zeroField(const bool flag) { _zero_field = flag; }
 
+  //! number of threads used for the z matching of the track pairs. 0 means all available threads
+  void set_num_threads(const int n) { _num_threads = n; }
+
   //  void set_use_old_matching(const bool flag) { _use_old_matching = flag; }
 
   void set_test_windows_printout(const bool test) { _test_windows = test; }
@@ -158,6 +168,28 @@ class PHSiliconTpcTrackMatching : public SubsysReco, public PHParameterInterface
  private:
   int GetNodes(PHCompositeNode *topNode);
 
+  // seed parameters used for matching, calculated once per seed and per event
+  struct SeedParameters
+  {
+    bool valid = false;
+    double phi = 0;
+    double eta = 0;
+    double pt = 0;
+    Acts::Vector3 pos = Acts::Vector3::Zero();
+    float px = 0;
+    float py = 0;
+    float pz = 0;
+    int q = 0;
+  };
+
+  SeedParameters getSeedParameters(TrackSeed *seed);
+
+  // index silicon seeds in phi bins, sorted by eta inside each bin
+  void buildSiliconIndex(const std::vector<SeedParameters> &si_parameters);
+
+  // get silicon seeds compatible with a given TPC seed, sorted by increasing id
+  std::vector<unsigned int> getSiliconCandidates(const SeedParameters &tpc_parameters);
+
   void findEtaPhiMatches(std::set<unsigned int> &tpc_matched_set,
                          std::set<unsigned int> &tpc_unmatched_set,
                          std::multimap<unsigned int, unsigned int> &tpc_matches);
@@ -196,6 +228,10 @@ class PHSiliconTpcTrackMatching : public SubsysReco, public PHParameterInterface
   int m_event = 0;
   std::map<unsigned int, double> _z_mismatch_map;
 
+  // silicon seed index, as (eta, silicon seed id) in each phi bin
+  static constexpr unsigned int _n_phi_bins_si_index = 64;
+  std::array<std::vector<std::pair<double, unsigned int>>, _n_phi_bins_si_index> _si_index;
+
   TpcClusterZCrossingCorrection _clusterCrossingCorrection;
   float _crossing_deltaz_max = 10.0;
   float _crossing_deltaz_min = 1.5;
@@ -211,6 +247,7 @@ class PHSiliconTpcTrackMatching : public SubsysReco, public PHParameterInterface
   bool _use_intt_crossing = true;  // should always be true except for testing
 
   int _n_iteration = 0;
+  int _num_threads = 1;
   std::string _track_map_name = "TpcTrackSeedContainer";
   std::string _silicon_track_map_name = "SiliconTrackSeedContainer";
   std::string _cluster_map_name = "TRKR_CLUSTER";
@@ -429,9 +429,9 @@ int PHSimpleKFProp::process_event(PHCompositeNode* topNode)
 
 Acts::Vector3 PHSimpleKFProp::getGlobalPosition(TrkrDefs::cluskey key, TrkrCluster* cluster) const
 {
-  // get global position from Acts transform
+  // get global position from Acts transform, or from the per event cache if available
   return _pp_mode ?
-    m_tgeometry->getGlobalPosition(key, cluster):
+    m_globalPositionWrapper.getGlobalPosition(key, cluster):
     m_globalPositionWrapper.getGlobalPositionDistortionCorrected( key, cluster, 0 );
 }
 
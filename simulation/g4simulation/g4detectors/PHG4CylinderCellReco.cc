@@ -396,8 +396,8 @@ int PHG4CylinderCellReco::process_event(PHCompositeNode *topNode)
     {
       continue;
     }
-    PHG4HitContainer::ConstIterator hiter;
-    PHG4HitContainer::ConstRange hit_begin_end = g4hit->getHits(*layer);
+    // hit map range, or the layer arena hit list in arena mode
+    const auto layer_hits = g4hit->getLayerHits(*layer);
     PHG4CylinderCellGeom *geo = seggeo->GetLayerCellGeom(*layer);
     int nphibins = n_phi_z_bins[*layer].first;
     int nzbins = n_phi_z_bins[*layer].second;
@@ -405,19 +405,19 @@ int PHG4CylinderCellReco::process_event(PHCompositeNode *topNode)
     // ------- eta/phi binning ------------------------------------------------------------------------
     if (binning[*layer] == PHG4CellDefs::etaphibinning)
     {
-      for (hiter = hit_begin_end.first; hiter != hit_begin_end.second; hiter++)
+      for (auto *layer_hit : layer_hits)
       {
-        sum_energy_before_cuts += hiter->second->get_edep();
+        sum_energy_before_cuts += layer_hit->get_edep();
         // checking ADC timing integration window cut
-        if (hiter->second->get_t(0) > tmin_max[*layer].second)
+        if (layer_hit->get_t(0) > tmin_max[*layer].second)
         {
           continue;
         }
-        if (hiter->second->get_t(1) < tmin_max[*layer].first)
+        if (layer_hit->get_t(1) < tmin_max[*layer].first)
         {
           continue;
         }
-        if (hiter->second->get_t(1) - hiter->second->get_t(0) > m_DeltaTMap[*layer])
+        if (layer_hit->get_t(1) - layer_hit->get_t(0) > m_DeltaTMap[*layer])
         {
           continue;
         }
@@ -427,7 +427,7 @@ int PHG4CylinderCellReco::process_event(PHCompositeNode *topNode)
         double etabin[2];
         for (int i = 0; i < 2; i++)
         {
-          etaphi[i] = PHG4Utils::get_etaphi(hiter->second->get_x(i), hiter->second->get_y(i), hiter->second->get_z(i));
+          etaphi[i] = PHG4Utils::get_etaphi(layer_hit->get_x(i), layer_hit->get_y(i), layer_hit->get_z(i));
           etabin[i] = geo->get_etabin(etaphi[i].first);
           phibin[i] = geo->get_phibin(etaphi[i].second);
         }
@@ -445,11 +445,11 @@ int PHG4CylinderCellReco::process_event(PHCompositeNode *topNode)
         {
           if (Verbosity() > 0)
           {
-            hiter->second->identify();
+            layer_hit->identify();
           }
           continue;
         }
-        sum_energy_g4hit += hiter->second->get_edep();
+        sum_energy_g4hit += layer_hit->get_edep();
         int intphibin = phibin[0];
         int intetabin = etabin[0];
         int intphibinout = phibin[1];
@@ -577,22 +577,22 @@ int PHG4CylinderCellReco::process_event(PHCompositeNode *topNode)
             cell = new PHG4Cellv1(cellkey);
             cellptmap[key] = cell;
           }
-          if (!std::isfinite(hiter->second->get_edep() * vdedx[i1]))
+          if (!std::isfinite(layer_hit->get_edep() * vdedx[i1]))
           {
-            std::cout << "hit 0x" << std::hex << hiter->first << std::dec << " not finite, edep: "
-                      << hiter->second->get_edep() << " weight " << vdedx[i1] << std::endl;
+            std::cout << "hit 0x" << std::hex << layer_hit->get_hit_id() << std::dec << " not finite, edep: "
+                      << layer_hit->get_edep() << " weight " << vdedx[i1] << std::endl;
           }
-          cell->add_edep(hiter->first, hiter->second->get_edep() * vdedx[i1]);  // add hit with edep to g4hit list
-          cell->add_edep(hiter->second->get_edep() * vdedx[i1]);                // add edep to cell
-          if (hiter->second->has_property(PHG4Hit::prop_light_yield))
+          cell->add_edep(layer_hit->get_hit_id(), layer_hit->get_edep() * vdedx[i1]);  // add hit with edep to g4hit list
+          cell->add_edep(layer_hit->get_edep() * vdedx[i1]);                // add edep to cell
+          if (layer_hit->has_property(PHG4Hit::prop_light_yield))
           {
-            cell->add_light_yield(hiter->second->get_light_yield() * vdedx[i1]);
+            cell->add_light_yield(layer_hit->get_light_yield() * vdedx[i1]);
           }
-          cell->add_shower_edep(hiter->second->get_shower_id(), hiter->second->get_edep() * vdedx[i1]);
+          cell->add_shower_edep(layer_hit->get_shower_id(), layer_hit->get_edep() * vdedx[i1]);
           // just a sanity check - we don't want to mess up by having Nan's or Infs in our energy deposition
-          if (!std::isfinite(hiter->second->get_edep() * vdedx[i1]))
+          if (!std::isfinite(layer_hit->get_edep() * vdedx[i1]))
           {
-            std::cout << PHWHERE << " invalid energy dep " << hiter->second->get_edep()
+            std::cout << PHWHERE << " invalid energy dep " << layer_hit->get_edep()
                       << " or path length: " << vdedx[i1] << std::endl;
           }
         }
@@ -635,19 +635,19 @@ int PHG4CylinderCellReco::process_event(PHCompositeNode *topNode)
       double zstepsize = (sizeiter->second).second;
       double phistepsize = phistep[*layer];
 
-      for (hiter = hit_begin_end.first; hiter != hit_begin_end.second; hiter++)
+      for (auto *layer_hit : layer_hits)
       {
-        sum_energy_before_cuts += hiter->second->get_edep();
+        sum_energy_before_cuts += layer_hit->get_edep();
         // checking ADC timing integration window cut
-        if (hiter->second->get_t(0) > tmin_max[*layer].second)
+        if (layer_hit->get_t(0) > tmin_max[*layer].second)
         {
           continue;
         }
-        if (hiter->second->get_t(1) < tmin_max[*layer].first)
+        if (layer_hit->get_t(1) < tmin_max[*layer].first)
         {
           continue;
         }
-        if (hiter->second->get_t(1) - hiter->second->get_t(0) > 100)
+        if (layer_hit->get_t(1) - layer_hit->get_t(0) > 100)
         {
           continue;
         }
@@ -667,14 +667,14 @@ int PHG4CylinderCellReco::process_event(PHCompositeNode *topNode)
 
         for (int i = 0; i < 2; i++)
         {
-          xinout[i] = hiter->second->get_x(i);
-          yinout[i] = hiter->second->get_y(i);
-          px[i] = hiter->second->get_px(i);
-          py[i] = hiter->second->get_py(i);
-          phi[i] = std::atan2(hiter->second->get_y(i), hiter->second->get_x(i));
-          z[i] = hiter->second->get_z(i);
+          xinout[i] = layer_hit->get_x(i);
+          yinout[i] = layer_hit->get_y(i);
+          px[i] = layer_hit->get_px(i);
+          py[i] = layer_hit->get_py(i);
+          phi[i] = std::atan2(layer_hit->get_y(i), layer_hit->get_x(i));
+          z[i] = layer_hit->get_z(i);
           phibin[i] = geo->get_phibin(phi[i]);
-          zbin[i] = geo->get_zbin(hiter->second->get_z(i));
+          zbin[i] = geo->get_zbin(layer_hit->get_z(i));
 
           if (Verbosity() > 0)
           {
@@ -682,7 +682,7 @@ int PHG4CylinderCellReco::process_event(PHCompositeNode *topNode)
           }
           if (Verbosity() > 0)
           {
-            std::cout << " " << i << "  zbin: " << zbin[i] << ", z = " << hiter->second->get_z(i) << ", stepsize: " << zstepsize << " offset: " << zmin_max[*layer].first << std::endl;
+            std::cout << " " << i << "  zbin: " << zbin[i] << ", z = " << layer_hit->get_z(i) << ", stepsize: " << zstepsize << " offset: " << zmin_max[*layer].first << std::endl;
           }
         }
         // check bin range
@@ -697,10 +697,10 @@ int PHG4CylinderCellReco::process_event(PHCompositeNode *topNode)
 
         if (zbin[0] < 0)
         {
-          hiter->second->identify();
+          layer_hit->identify();
           continue;
         }
-        sum_energy_g4hit += hiter->second->get_edep();
+        sum_energy_g4hit += layer_hit->get_edep();
 
         int intphibin = phibin[0];
         int intzbin = zbin[0];
@@ -836,10 +836,10 @@ int PHG4CylinderCellReco::process_event(PHCompositeNode *topNode)
               std::cout << "  add energy to existing cell for key = " << cellptmap.find(key)->first << std::endl;
             }
 
-            if (Verbosity() > 1 && hiter->second->has_property(PHG4Hit::prop_light_yield) && std::isnan(hiter->second->get_light_yield() * vdedx[i1]))
+            if (Verbosity() > 1 && layer_hit->has_property(PHG4Hit::prop_light_yield) && std::isnan(layer_hit->get_light_yield() * vdedx[i1]))
             {
               std::cout << "    NAN lighy yield with vdedx[i1] = " << vdedx[i1]
-                        << " and hiter->second->get_light_yield() = " << hiter->second->get_light_yield() << std::endl;
+                        << " and layer_hit->get_light_yield() = " << layer_hit->get_light_yield() << std::endl;
             }
           }
           else
@@ -852,23 +852,23 @@ int PHG4CylinderCellReco::process_event(PHCompositeNode *topNode)
             cell = new PHG4Cellv1(cellkey);
             cellptmap[key] = cell;
           }
-          if (!std::isfinite(hiter->second->get_edep() * vdedx[i1]))
+          if (!std::isfinite(layer_hit->get_edep() * vdedx[i1]))
           {
-            std::cout << "hit 0x" << std::hex << hiter->first << std::dec << " not finite, edep: "
-                      << hiter->second->get_edep() << " weight " << vdedx[i1] << std::endl;
+            std::cout << "hit 0x" << std::hex << layer_hit->get_hit_id() << std::dec << " not finite, edep: "
+                      << layer_hit->get_edep() << " weight " << vdedx[i1] << std::endl;
           }
-          cell->add_edep(hiter->first, hiter->second->get_edep() * vdedx[i1]);
-          cell->add_edep(hiter->second->get_edep() * vdedx[i1]);  // add edep to cell
-          if (hiter->second->has_property(PHG4Hit::prop_light_yield))
+          cell->add_edep(layer_hit->get_hit_id(), layer_hit->get_edep() * vdedx[i1]);
+          cell->add_edep(layer_hit->get_edep() * vdedx[i1]);  // add edep to cell
+          if (layer_hit->has_property(PHG4Hit::prop_light_yield))
           {
-            cell->add_light_yield(hiter->second->get_light_yield() * vdedx[i1]);
-            if (Verbosity() > 1 && !std::isfinite(hiter->second->get_light_yield() * vdedx[i1]))
+            cell->add_light_yield(layer_hit->get_light_yield() * vdedx[i1]);
+            if (Verbosity() > 1 && !std::isfinite(layer_hit->get_light_yield() * vdedx[i1]))
             {
               std::cout << "    NAN lighy yield with vdedx[i1] = " << vdedx[i1]
-                        << " and hiter->second->get_light_yield() = " << hiter->second->get_light_yield() << std::endl;
+                        << " and layer_hit->get_light_yield() = " << layer_hit->get_light_yield() << std::endl;
             }
           }
-          cell->add_shower_edep(hiter->second->get_shower_id(), hiter->second->get_edep() * vdedx[i1]);
+          cell->add_shower_edep(layer_hit->get_shower_id(), layer_hit->get_edep() * vdedx[i1]);
         }
         vphi.clear();
         vz.clear();
@@ -301,7 +301,18 @@ bool PHG4CylinderSteppingAction::UserSteppingAction(const G4Step* aStep, bool /*
         m_UseG4StepsFlag > 0)
     {
       // save only hits with energy deposit (or -1 for geantino) or if save all hits flag is set
-      if (m_Hit->get_edep() || m_SaveAllHitsFlag)
+      if ((m_Hit->get_edep() || m_SaveAllHitsFlag) && m_HitContainer->ArenaMode())
+      {
+        // the container stores a copy of the hit in its arena
+        // our hit is reset and reused for the next track
+        const auto hititer = m_HitContainer->AddHitCopy(layer_id, m_Hit);
+        if (m_SaveShower)
+        {
+          m_SaveShower->add_g4hit_id(m_HitContainer->GetID(), hititer->first);
+        }
+        m_Hit->Reset();
+      }
+      else if (m_Hit->get_edep() || m_SaveAllHitsFlag)
       {
         m_HitContainer->AddHit(layer_id, m_Hit);
         if (m_SaveShower)
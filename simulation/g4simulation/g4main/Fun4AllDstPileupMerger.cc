@@ -7,7 +7,6 @@
 
 #include "PHG4Hit.h"  // for PHG4Hit
 #include "PHG4HitContainer.h"
-#include "PHG4Hitv1.h"
 #include "PHG4Particle.h"  // for PHG4Particle
 #include "PHG4Particlev3.h"
 #include "PHG4TruthInfoContainer.h"
@@ -39,7 +38,6 @@ namespace
 {
   using PHG4Particle_t = PHG4Particlev3;
   using PHG4VtxPoint_t = PHG4VtxPointv1;
-  using PHG4Hit_t = PHG4Hitv1;
 
   //! utility class to find all PHG4Hit container nodes from the DST node
   class FindG4HitContainer : public PHNodeOperation
@@ -327,9 +325,14 @@ void Fun4AllDstPileupMerger::copy_background_event(PHCompositeNode *dstNode, dou
       const auto range = container_hit->getHits();
       for (auto iter = range.first; iter != range.second; ++iter)
       {
-        // clone hit
+        /*
+         * clone hit
+         * this will generate a new key for the hit and assign it to the hit
+         * this ensures that there is no conflict with the hits from the 'main' event
+         * in arena mode the copy is stored in the destination container arena, without heap allocation
+         */
         const auto &sourceHit = iter->second;
-        auto *newHit = new PHG4Hit_t(sourceHit);
+        auto *newHit = pair.second->AddHitCopy(sourceHit->get_detid(), sourceHit)->second;
 
         // shift time
         newHit->set_t(0, sourceHit->get_t(0) + delta_t);
@@ -352,12 +355,6 @@ void Fun4AllDstPileupMerger::copy_background_event(PHCompositeNode *dstNode, dou
          * as such we just reset the hits shower id
          */
         newHit->set_shower_id(std::numeric_limits<int>::min());
-
-        /*
-         * this will generate a new key for the hit and assign it to the hit
-         * this ensures that there is no conflict with the hits from the 'main' event
-         */
-        pair.second->AddHit(newHit->get_detid(), newHit);
       }
     }
 
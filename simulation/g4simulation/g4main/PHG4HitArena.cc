@@ -0,0 +1,67 @@
+#include "PHG4HitArena.h"
+
+#include "PHG4Hit.h"
+#include "PHG4Hitv1.h"
+
+#include <vector>  // for erase_if
+
+PHG4HitArena::~PHG4HitArena()
+{
+  Reset();
+}
+
+PHG4Hit *PHG4HitArena::NewHit()
+{
+  if (m_Used == capacity())
+  {
+    m_Chunks.emplace_back(new PHG4Hitv1[m_ChunkSize]);
+  }
+  PHG4Hitv1 *hit = &m_Chunks[m_Used / m_ChunkSize][m_Used % m_ChunkSize];
+  ++m_Used;
+
+  // records are recycled, make sure nothing is left from a previous event
+  hit->Reset();
+  m_Hits.push_back(hit);
+  return hit;
+}
+
+PHG4Hit *PHG4HitArena::NewHit(const PHG4Hit *source)
+{
+  PHG4Hit *hit = NewHit();
+  hit->CopyFrom(source);
+  return hit;
+}
+
+PHG4Hit *PHG4HitArena::AdoptHit(PHG4Hit *hit)
+{
+  m_Adopted.push_back(hit);
+  m_Hits.push_back(hit);
+  return hit;
+}
+
+void PHG4HitArena::RemoveZeroEDep()
+{
+  std::erase_if(m_Hits, [](const PHG4Hit *hit)
+                { return hit->get_edep() == 0; });
+  std::erase_if(m_Adopted, [](const PHG4Hit *hit)
+                {
+                  if (hit->get_edep() == 0)
+                  {
+                    delete hit;
+                    return true;
+                  }
+                  return false; });
+}
+
+void PHG4HitArena::Reset()
+{
+  for (const auto *hit : m_Adopted)
+  {
+    delete hit;
+  }
+  m_Adopted.clear();
+
+  // chunks are kept for the next event
+  m_Used = 0;
+  m_Hits.clear();
+}
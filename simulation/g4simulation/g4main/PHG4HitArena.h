@@ -0,0 +1,74 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4MAIN_PHG4HITARENA_H
+#define G4MAIN_PHG4HITARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+class PHG4Hit;
+class PHG4Hitv1;
+
+/*!
+ * contiguous storage for the g4hits of one layer
+ * hit records are allocated in fixed size chunks which are kept from one event to the next.
+ * Reset only rewinds the chunks, so only the PHG4Hit objects themselves are pooled:
+ * the container still inserts every hit into its hit map, and the property map of a
+ * recycled PHG4Hitv1 still allocates its nodes when properties are set.
+ * pointers to the hits stay valid until the next Reset
+ */
+class PHG4HitArena
+{
+ public:
+  using HitList = std::vector<PHG4Hit *>;
+
+  PHG4HitArena() = default;
+  ~PHG4HitArena();
+
+  // no copy, the container hit map points to the records
+  PHG4HitArena(const PHG4HitArena &) = delete;
+  PHG4HitArena &operator=(const PHG4HitArena &) = delete;
+
+  //! get a new hit record, reset to default values
+  PHG4Hit *NewHit();
+
+  //! get a new hit record, copied from the source hit
+  PHG4Hit *NewHit(const PHG4Hit *source);
+
+  //! take ownership of a heap allocated hit, deleted at the next Reset
+  PHG4Hit *AdoptHit(PHG4Hit *hit);
+
+  //! remove hits with no energy deposit from the list of hits. The records are recycled at the next Reset
+  void RemoveZeroEDep();
+
+  //! release all hits
+  void Reset();
+
+  //! hits, in allocation order
+  const HitList &GetHits() const { return m_Hits; }
+
+  //! number of hits
+  std::size_t size() const { return m_Hits.size(); }
+
+  //! number of allocated hit records
+  std::size_t capacity() const { return m_Chunks.size() * m_ChunkSize; }
+
+ private:
+  //! number of records per chunk
+  static constexpr std::size_t m_ChunkSize = 1024;
+
+  //! record chunks
+  std::vector<std::unique_ptr<PHG4Hitv1[]>> m_Chunks;
+
+  //! number of records used so far, in all chunks
+  std::size_t m_Used = 0;
+
+  //! hits currently in use
+  HitList m_Hits;
+
+  //! heap allocated hits owned by the arena
+  HitList m_Adopted;
+};
+
+#endif
@@ -4,6 +4,7 @@
 #include "PHG4Hitv1.h"
 
 #include <phool/phool.h>
+#include <phool/recoConsts.h>
 
 #include <TSystem.h>
 
@@ -13,10 +14,26 @@ PHG4HitContainer::PHG4HitContainer(const std::string &nodename)
   : id(PHG4HitDefs::get_volume_id(nodename))
 
 {
+  // arena mode is enabled globally from the macro, for containers created in memory
+  recoConsts *rc = recoConsts::instance();
+  if (rc->FlagExist("G4HITARENA"))
+  {
+    m_ArenaMode = rc->get_IntFlag("G4HITARENA");
+  }
 }
 
 void PHG4HitContainer::Reset()
 {
+  if (m_ArenaMode)
+  {
+    // hits are owned by the arenas, which are released in one go
+    hitmap.clear();
+    for (auto &arena : m_Arenas)
+    {
+      arena.second.Reset();
+    }
+    return;
+  }
   while (hitmap.begin() != hitmap.end())
   {
     delete hitmap.begin()->second;
@@ -107,6 +124,11 @@ PHG4HitContainer::AddHit(PHG4Hit *newhit)
   PHG4HitDefs::keytype detidlong = key >> PHG4HitDefs::hit_idbits;
   unsigned int detid = detidlong;
   layers.insert(detid);
+  if (m_ArenaMode)
+  {
+    // the hit stays valid for the caller, the arena of its layer takes ownership
+    m_Arenas[detid].AdoptHit(newhit);
+  }
   return hitmap.insert(std::make_pair(key, newhit)).first;
 }
 
@@ -116,9 +138,62 @@ PHG4HitContainer::AddHit(const unsigned int detid, PHG4Hit *newhit)
   PHG4HitDefs::keytype key = genkey(detid);
   layers.insert(detid);
   newhit->set_hit_id(key);
+  if (m_ArenaMode)
+  {
+    m_Arenas[detid].AdoptHit(newhit);
+  }
+  return hitmap.insert(std::make_pair(key, newhit)).first;
+}
+
+PHG4HitContainer::ConstIterator
+PHG4HitContainer::AddHitCopy(const unsigned int detid, const PHG4Hit *hit)
+{
+  PHG4HitDefs::keytype key = genkey(detid);
+  layers.insert(detid);
+  if (m_ArenaMode)
+  {
+    return AddArenaHit(key, hit);
+  }
+  PHG4Hit *newhit = new PHG4Hitv1(hit);
+  newhit->set_hit_id(key);
   return hitmap.insert(std::make_pair(key, newhit)).first;
 }
 
+PHG4HitContainer::ConstIterator
+PHG4HitContainer::AddArenaHit(const PHG4HitDefs::keytype key, const PHG4Hit *hit)
+{
+  const unsigned int detid = key >> PHG4HitDefs::hit_idbits;
+  PHG4Hit *newhit = m_Arenas[detid].NewHit(hit);
+  newhit->set_hit_id(key);
+  return hitmap.insert(std::make_pair(key, newhit)).first;
+}
+
+void PHG4HitContainer::SetArenaMode(const bool b)
+{
+  if (b == m_ArenaMode)
+  {
+    return;
+  }
+  if (!hitmap.empty())
+  {
+    std::cout << PHWHERE << " cannot change arena mode of a non empty container, size: " << hitmap.size() << std::endl;
+    return;
+  }
+  m_ArenaMode = b;
+  m_Arenas.clear();
+}
+
+PHG4HitContainer::LayerHitRange PHG4HitContainer::getLayerHits(const unsigned int detid) const
+{
+  static const PHG4HitArena::HitList empty;
+  if (m_ArenaMode)
+  {
+    const auto iter = m_Arenas.find(detid);
+    return {getHits(), (iter == m_Arenas.end()) ? empty : iter->second.GetHits(), true};
+  }
+  return {getHits(detid), empty, false};
+}
+
 PHG4HitContainer::ConstRange PHG4HitContainer::getHits(const unsigned int detid) const
 {
   PHG4HitDefs::keytype detidlong = detid;
@@ -145,8 +220,16 @@ PHG4HitContainer::Iterator PHG4HitContainer::findOrAddHit(PHG4HitDefs::keytype k
   PHG4HitContainer::Iterator it = hitmap.find(key);
   if (it == hitmap.end())
   {
-    hitmap[key] = new PHG4Hitv1();
-    it = hitmap.find(key);
+    if (m_ArenaMode)
+    {
+      const unsigned int detid = key >> PHG4HitDefs::hit_idbits;
+      it = hitmap.insert(std::make_pair(key, m_Arenas[detid].NewHit())).first;
+    }
+    else
+    {
+      hitmap[key] = new PHG4Hitv1();
+      it = hitmap.find(key);
+    }
     PHG4Hit *mhit = it->second;
     mhit->set_hit_id(key);
     mhit->set_edep(0.);
@@ -169,6 +252,17 @@ PHG4Hit *PHG4HitContainer::findHit(PHG4HitDefs::keytype key)
 void PHG4HitContainer::RemoveZeroEDep()
 {
   //  unsigned int hitsbef = hitmap.size();
+  if (m_ArenaMode)
+  {
+    // records are owned by the arenas, only drop them from the lists
+    std::erase_if(hitmap, [](const auto &item)
+                  { return item.second->get_edep() == 0; });
+    for (auto &arena : m_Arenas)
+    {
+      arena.second.RemoveZeroEDep();
+    }
+    return;
+  }
   Iterator itr = hitmap.begin();
   Iterator last = hitmap.end();
   for (; itr != last;)
@@ -3,6 +3,7 @@
 #ifndef G4MAIN_PHG4HITCONTAINER_H
 #define G4MAIN_PHG4HITCONTAINER_H
 
+#include "PHG4HitArena.h"
 #include "PHG4HitDefs.h"
 
 #include <phool/PHObject.h>
@@ -12,6 +13,7 @@
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 class PHG4Hit;
 
@@ -42,6 +44,9 @@ class PHG4HitContainer : public PHObject
 
   ConstIterator AddHit(const unsigned int detid, PHG4Hit *newhit);
 
+  //! add a copy of the hit with a newly generated key. The source hit is left untouched
+  ConstIterator AddHitCopy(const unsigned int detid, const PHG4Hit *hit);
+
   Iterator findOrAddHit(PHG4HitDefs::keytype key);
 
   PHG4Hit *findHit(PHG4HitDefs::keytype key);
@@ -70,11 +75,86 @@ class PHG4HitContainer : public PHObject
   void RemoveZeroEDep();
   PHG4HitDefs::keytype getmaxkey(const unsigned int detid);
 
+  /*!
+   * arena mode: the PHG4Hit objects are stored in per layer contiguous arenas owned by the container,
+   * instead of being allocated one by one on the heap. The hits are still indexed in the hit map.
+   * Hits passed to AddHit are owned by the arena of their layer and deleted at Reset.
+   * Use AddHitCopy to avoid the heap allocation of the hit object.
+   * Reset releases all hits at once, keeping the hit records for the next event.
+   * Can only be changed when the container is empty. Not persistent.
+   */
+  void SetArenaMode(const bool b);
+  bool ArenaMode() const { return m_ArenaMode; }
+
+  /*!
+   * hits of one layer, iterated as PHG4Hit pointers without copying.
+   * In arena mode this walks the hit list of the layer arena, in insertion order.
+   * Otherwise it walks the hit map range of the layer, in key order, like getHits(detid)
+   */
+  class LayerHitRange
+  {
+   public:
+    class const_iterator
+    {
+     public:
+      const_iterator(const ConstIterator map_iter, const PHG4HitArena::HitList::const_iterator arena_iter, const bool arena_mode)
+        : m_MapIter(map_iter)
+        , m_ArenaIter(arena_iter)
+        , m_ArenaMode(arena_mode)
+      {
+      }
+      PHG4Hit *operator*() const { return m_ArenaMode ? *m_ArenaIter : m_MapIter->second; }
+      const_iterator &operator++()
+      {
+        if (m_ArenaMode)
+        {
+          ++m_ArenaIter;
+        }
+        else
+        {
+          ++m_MapIter;
+        }
+        return *this;
+      }
+      bool operator==(const const_iterator &other) const { return m_ArenaMode ? m_ArenaIter == other.m_ArenaIter : m_MapIter == other.m_MapIter; }
+      bool operator!=(const const_iterator &other) const { return !(*this == other); }
+
+     private:
+      ConstIterator m_MapIter;
+      PHG4HitArena::HitList::const_iterator m_ArenaIter;
+      bool m_ArenaMode;
+    };
+
+    LayerHitRange(const ConstRange &map_range, const PHG4HitArena::HitList &arena_hits, const bool arena_mode)
+      : m_MapRange(map_range)
+      , m_ArenaHits(arena_hits)
+      , m_ArenaMode(arena_mode)
+    {
+    }
+    const_iterator begin() const { return {m_MapRange.first, m_ArenaHits.begin(), m_ArenaMode}; }
+    const_iterator end() const { return {m_MapRange.second, m_ArenaHits.end(), m_ArenaMode}; }
+
+   private:
+    ConstRange m_MapRange;
+    const PHG4HitArena::HitList &m_ArenaHits;
+    bool m_ArenaMode;
+  };
+
+  //! return all hits matching a given detid, see LayerHitRange
+  LayerHitRange getLayerHits(const unsigned int detid) const;
+
  protected:
   int id{-1};  //< unique identifier from hash of node name. Defined following PHG4HitDefs::get_volume_id
   Map hitmap;
   std::set<unsigned int> layers;  // layers is not reset since layers must not change event by event
 
+ private:
+  //! add hit to the arena of its layer, and insert in hit map
+  ConstIterator AddArenaHit(const PHG4HitDefs::keytype key, const PHG4Hit *hit);
+
+  bool m_ArenaMode{false};                         //!
+  std::map<unsigned int, PHG4HitArena> m_Arenas;  //!
+
   ClassDefOverride(PHG4HitContainer, 1)
 };
 
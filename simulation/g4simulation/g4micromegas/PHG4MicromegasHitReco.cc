@@ -259,14 +259,12 @@ int PHG4MicromegasHitReco::process_event(PHCompositeNode* topNode)
     //       (layergeom->get_radius() + layergeom->get_thickness()/2):
     //       (layergeom->get_radius() - layergeom->get_thickness()/2);
 
-    // get hits
-    const PHG4HitContainer::ConstRange g4hit_range = g4hitcontainer->getHits(layer);
+    // get hits. In arena mode they are read directly from the layer arena
+    const auto g4hits = g4hitcontainer->getLayerHits(layer);
 
     // loop over hits
-    for (auto g4hit_it = g4hit_range.first; g4hit_it != g4hit_range.second; ++g4hit_it)
+    for (PHG4Hit* g4hit : g4hits)
     {
-      // get hit
-      PHG4Hit* g4hit = g4hit_it->second;
 
       // check time window
       if (g4hit->get_t(0) > m_tmax)
@@ -393,7 +391,7 @@ int PHG4MicromegasHitReco::process_event(PHCompositeNode* topNode)
         hit->addEnergy(pair.second);
 
         // associate this hitset and hit to the geant4 hit key
-        hittruthassoc->addAssoc(hitsetkey, hitkey, g4hit_it->first);
+        hittruthassoc->addAssoc(hitsetkey, hitkey, g4hit->get_hit_id());
       }
     }
   }
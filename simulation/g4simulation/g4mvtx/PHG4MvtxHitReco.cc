@@ -68,6 +68,20 @@
 #include <set>     // for vector
 #include <vector>  // for vector
 
+namespace
+{
+  //! pixel fired by a g4hit, with the energy summed over the track segments
+  struct FiredPixel
+  {
+    int xbin{0};
+    int zbin{0};
+    double energy{0};
+  };
+
+  //! the pixel window of a g4hit is at most this many pixels in x and z
+  constexpr int max_pixel_range = 13;
+}  // namespace
+
 // New headers I added
 
 PHG4MvtxHitReco::PHG4MvtxHitReco(const std::string& name, const std::string& detector)
@@ -266,6 +280,10 @@ int PHG4MvtxHitReco::process_event(PHCompositeNode* topNode)
     std::cout << " m_strobe_width " << m_strobe_width << " m_strobe_separation " << m_strobe_separation << " strobe_zero_tm_start " << strobe_zero_tm_start << " m_extended_readout_time " << m_extended_readout_time << std::endl;
   }
 
+  // pixels fired by the current g4hit and the hitsets of its strobe replicas, reused between g4hits
+  std::vector<FiredPixel> fired_pixels;
+  std::vector<TrkrHitSetContainer::Iterator> replica_hitsets;
+
   // loop over all of the layers in the g4hit container
   auto layer_range = g4hitContainer->getLayers();
   for (auto layer_it = layer_range.first; layer_it != layer_range.second; ++layer_it)
@@ -278,8 +296,8 @@ int PHG4MvtxHitReco::process_event(PHCompositeNode* topNode)
     auto *layergeom = dynamic_cast<CylinderGeom_Mvtx*>(geoNode->GetLayerGeom(layer));
     assert(layergeom);
 
-    // loop over the hits in this layer
-    const PHG4HitContainer::ConstRange g4hit_range = g4hitContainer->getHits(layer);
+    // loop over the hits in this layer. In arena mode they are read directly from the layer arena
+    const auto g4hits = g4hitContainer->getLayerHits(layer);
 
     // Get some layer parameters for later use
     double xpixw = layergeom->get_pixel_x();
@@ -290,10 +308,8 @@ int PHG4MvtxHitReco::process_event(PHCompositeNode* topNode)
     int maxNZ = layergeom->get_NZ();
 
     // Now loop over all g4 hits for this layer
-    for (auto g4hit_it = g4hit_range.first; g4hit_it != g4hit_range.second; ++g4hit_it)
+    for (auto *g4hit : g4hits)
     {
-      // get hit
-      auto *g4hit = g4hit_it->second;
 
       truthcheck_g4hit(g4hit, topNode);
 
@@ -454,10 +470,6 @@ int PHG4MvtxHitReco::process_event(PHCompositeNode* topNode)
             << std::endl;
       }
 
-      std::vector<int> vpixel;
-      std::vector<int> vxbin;
-      std::vector<int> vzbin;
-      std::vector<std::pair<double, double> > venergy;
       // double trklen = 0.0;
 
       //===================================================
@@ -552,8 +564,31 @@ int PHG4MvtxHitReco::process_event(PHCompositeNode* topNode)
       }
 
       // this hit is skipped earlier if this dimensioning would be exceeded
-      double pixenergy[12][12] = {};  // init to 0
-      double pixeion[12][12] = {};    // init to 0
+      double pixenergy[max_pixel_range][max_pixel_range] = {};  // init to 0
+      const int nxbins = xbin_max - xbin_min + 1;
+      const int nzbins = zbin_max - zbin_min + 1;
+
+      // Find the pixel edges. The local x of a pixel only depends on its xbin and its local z only on its zbin,
+      // so they are calculated once per bin rather than for every pixel and track segment
+      // note that (x1,z1) is the top left corner, (x2,z2) is the bottom right corner of the pixel - circle_rectangle_intersection expects this ordering
+      double pixel_x1[max_pixel_range];
+      double pixel_x2[max_pixel_range];
+      double pixel_z1[max_pixel_range];
+      double pixel_z2[max_pixel_range];
+      for (int ix = 0; ix < nxbins; ix++)
+      {
+        const double pixel_x = layergeom->get_local_coords_from_pixel(xbin_min + ix, zbin_min).X();
+        pixel_x1[ix] = pixel_x - xpixw_half;
+        pixel_x2[ix] = pixel_x + xpixw_half;
+      }
+      for (int iz = 0; iz < nzbins; iz++)
+      {
+        const double pixel_z = layergeom->get_local_coords_from_pixel(xbin_min, zbin_min + iz).Z();
+        pixel_z1[iz] = pixel_z + zpixw_half;
+        pixel_z2[iz] = pixel_z - zpixw_half;
+      }
+
+      const double edep = g4hit->get_edep();
 
       // Loop over track segments and diffuse charge at each segment location, collect energy in pixels
       for (int i = 0; i < nsegments; i++)
@@ -595,69 +630,49 @@ int PHG4MvtxHitReco::process_event(PHCompositeNode* topNode)
               << std::endl;
         }
         // Now find the area of overlap of the diffusion circle with each pixel and apportion the energy
-        for (int ix = xbin_min; ix <= xbin_max; ix++)
+        const double circle_area = M_PI * pow(ydiffusion_radius, 2);
+        for (int ix = 0; ix < nxbins; ix++)
         {
-          for (int iz = zbin_min; iz <= zbin_max; iz++)
+          // the overlap is exactly zero for pixels entirely on one side of the circle in x
+          const double dx1 = pixel_x1[ix] - segvec.X();
+          const double dx2 = pixel_x2[ix] - segvec.X();
+          if ((dx1 >= ydiffusion_radius && dx2 >= ydiffusion_radius) || (dx1 <= -ydiffusion_radius && dx2 <= -ydiffusion_radius))
           {
-            // Find the pixel corners for this pixel number
-            int pixnum = layergeom->get_pixel_number_from_xbin_zbin(ix, iz);
-
-            if (pixnum < 0)
-            {
-              std::cout
-                  << " pixnum < 0 , pixnum = " << pixnum << "\n"
-                  << " ix " << ix << " iz " << iz << "\n"
-                  << " xbin_min " << xbin_min << " zbin_min " << zbin_min << "\n"
-                  << " xbin_max " << xbin_max << " zbin_max " << zbin_max << "\n"
-                  << " maxNX " << maxNX << " maxNZ " << maxNZ
-                  << std::endl;
-            }
-
-            TVector3 tmp = layergeom->get_local_coords_from_pixel(pixnum);
-            // note that (x1,z1) is the top left corner, (x2,z2) is the bottom right corner of the pixel - circle_rectangle_intersection expects this ordering
-            double x1 = tmp.X() - xpixw_half;
-            double z1 = tmp.Z() + zpixw_half;
-            double x2 = tmp.X() + xpixw_half;
-            double z2 = tmp.Z() - zpixw_half;
+            continue;
+          }
 
+          for (int iz = 0; iz < nzbins; iz++)
+          {
             // here segvec.X and segvec.Z are the center of the circle, and diffusion_radius is the circle radius
-            // circle_rectangle_intersection returns the overlap area of the circle and the pixel. It is very fast if there is no overlap.
-            double pixarea_frac = PHG4Utils::circle_rectangle_intersection(x1, z1, x2, z2, segvec.X(), segvec.Z(), ydiffusion_radius) / (M_PI * pow(ydiffusion_radius, 2));
+            // circle_rectangle_intersection returns the overlap area of the circle and the pixel
+            double pixarea_frac = PHG4Utils::circle_rectangle_intersection(pixel_x1[ix], pixel_z1[iz], pixel_x2[ix], pixel_z2[iz], segvec.X(), segvec.Z(), ydiffusion_radius) / circle_area;
             // assume that the energy is deposited uniformly along the tracklet length, so that this segment gets the fraction 1/nsegments of the energy
-            pixenergy[ix - xbin_min][iz - zbin_min] += pixarea_frac * g4hit->get_edep() / (float) nsegments;
-            if (g4hit->has_property(PHG4Hit::prop_eion))
-            {
-              pixeion[ix - xbin_min][iz - zbin_min] += pixarea_frac * g4hit->get_eion() / (float) nsegments;
-            }
+            pixenergy[ix][iz] += pixarea_frac * edep / (float) nsegments;
             if (Verbosity() > 5)
             {
               std::cout
-                  << "    pixnum " << pixnum << " xbin " << ix << " zbin " << iz
-                  << " pixel_area fraction of circle " << pixarea_frac << " accumulated pixel energy " << pixenergy[ix - xbin_min][iz - zbin_min]
+                  << "    pixnum " << layergeom->get_pixel_number_from_xbin_zbin(xbin_min + ix, zbin_min + iz) << " xbin " << xbin_min + ix << " zbin " << zbin_min + iz
+                  << " pixel_area fraction of circle " << pixarea_frac << " accumulated pixel energy " << pixenergy[ix][iz]
                   << std::endl;
             }
           }
         }
       }  // end loop over segments
 
-      // now we have the energy deposited in each pixel, summed over all tracklet segments. We make a vector of all pixels with non-zero energy deposited
-      for (int ix = xbin_min; ix <= xbin_max; ix++)
+      // now we have the energy deposited in each pixel, summed over all tracklet segments. We make a list of all pixels with non-zero energy deposited
+      fired_pixels.clear();
+      for (int ix = 0; ix < nxbins; ix++)
       {
-        for (int iz = zbin_min; iz <= zbin_max; iz++)
+        for (int iz = 0; iz < nzbins; iz++)
         {
-          if (pixenergy[ix - xbin_min][iz - zbin_min] > 0.0)
+          if (pixenergy[ix][iz] > 0.0)
           {
-            int pixnum = layergeom->get_pixel_number_from_xbin_zbin(ix, iz);
-            vpixel.push_back(pixnum);
-            vxbin.push_back(ix);
-            vzbin.push_back(iz);
-            std::pair<double, double> tmppair = std::make_pair(pixenergy[ix - xbin_min][iz - zbin_min], pixeion[ix - xbin_min][iz - zbin_min]);
-            venergy.push_back(tmppair);
+            fired_pixels.push_back({xbin_min + ix, zbin_min + iz, pixenergy[ix][iz]});
             if (Verbosity() > 1)
             {
               std::cout
-                  << " Added pixel number " << pixnum << " xbin " << ix
-                  << " zbin " << iz << " to vectors with energy " << pixenergy[ix - xbin_min][iz - zbin_min]
+                  << " Added pixel number " << layergeom->get_pixel_number_from_xbin_zbin(xbin_min + ix, zbin_min + iz) << " xbin " << xbin_min + ix
+                  << " zbin " << zbin_min + iz << " to vectors with energy " << pixenergy[ix][iz]
                   << std::endl;
             }
           }
@@ -668,33 +683,44 @@ int PHG4MvtxHitReco::process_event(PHCompositeNode* topNode)
       // End of charge sharing implementation
       //===================================
 
-      // loop over all fired cells for this g4hit and add them to the TrkrHitSet
+      if (fired_pixels.empty())
+      {
+        continue;
+      }
+
+      // We need to create the TrkrHitSet if not already made - each TrkrHitSet should correspond to a chip and strobe for the Mvtx
+      // the hitsets of all strobe replicas are looked up once for this g4hit
+      replica_hitsets.clear();
+      for (unsigned int i_rep = 0; i_rep < n_replica; i_rep++)
+      {
+        int strobe = t0_strobe_frame + i_rep;
+        // to fit in a 5 bit field in the hitsetkey [-16,15]
+        strobe = std::max(strobe, -16);
+        if (strobe >= 16)
+        {
+          strobe = 15;
+        }
+        replica_hitsets.push_back(trkrHitSetContainer->findOrAddHitSet(MvtxDefs::genHitSetKey(layer, stave_number, chip_number, strobe)));
+      }
 
-      for (unsigned int i1 = 0; i1 < vpixel.size(); i1++)  // loop over all fired cells
+      // loop over all fired cells for this g4hit and add them to the TrkrHitSet
+      const TrkrDefs::hitsetkey hitsetkeymask = MvtxDefs::genHitSetKey(layer, stave_number, chip_number, 0);
+      for (const auto& pixel : fired_pixels)
       {
+        // generate the key for this hit
+        TrkrDefs::hitkey hitkey = MvtxDefs::genHitKey(pixel.zbin, pixel.xbin);
+        const bool masked = std::binary_search(m_deadPixelMap.begin(), m_deadPixelMap.end(), std::make_pair(hitsetkeymask, hitkey)) ||
+                            std::binary_search(m_hotPixelMap.begin(), m_hotPixelMap.end(), std::make_pair(hitsetkeymask, hitkey));
+        double hitenergy = pixel.energy * TrkrDefs::MvtxEnergyScaleup;
+
         // This is the new storage object version
         //====================================
-        for (unsigned int i_rep = 0; i_rep < n_replica; i_rep++)
+        for (const auto& hitsetit : replica_hitsets)
         {
-          int strobe = t0_strobe_frame + i_rep;
-          // to fit in a 5 bit field in the hitsetkey [-16,15]
-          strobe = std::max(strobe, -16);
-          if (strobe >= 16)
-          {
-            strobe = 15;
-          }
+          const TrkrDefs::hitsetkey hitsetkey = hitsetit->first;
 
-          // We need to create the TrkrHitSet if not already made - each TrkrHitSet should correspond to a chip for the Mvtx
-          TrkrDefs::hitsetkey hitsetkey = MvtxDefs::genHitSetKey(layer, stave_number, chip_number, strobe);
-          // Use existing hitset or add new one if needed
-          TrkrHitSetContainer::Iterator hitsetit = trkrHitSetContainer->findOrAddHitSet(hitsetkey);
-
-          // generate the key for this hit
-          TrkrDefs::hitkey hitkey = MvtxDefs::genHitKey(vzbin[i1], vxbin[i1]);
           // See if this hit already exists
-          TrkrHit* hit = nullptr;
-          hit = hitsetit->second->getHit(hitkey);
-
+          TrkrHit* hit = hitsetit->second->getHit(hitkey);
           if (hit)
           {
             if (Verbosity() > 0)
@@ -705,25 +731,20 @@ int PHG4MvtxHitReco::process_event(PHCompositeNode* topNode)
             }
             continue;
           }
-          const TrkrDefs::hitsetkey hitsetkeymask = MvtxDefs::genHitSetKey(layer, stave_number, chip_number, 0);
 
           // Regardless of whether the hit should be masked, add the energy to the truth hit
-          double hitenergy = venergy[i1].first * TrkrDefs::MvtxEnergyScaleup;
           addtruthhitset(hitsetkey, hitkey, hitenergy);
 
-          if ((std::find(m_deadPixelMap.begin(), m_deadPixelMap.end(), std::make_pair(hitsetkeymask, hitkey)) == m_deadPixelMap.end()) && (std::find(m_hotPixelMap.begin(), m_hotPixelMap.end(), std::make_pair(hitsetkeymask, hitkey)) == m_hotPixelMap.end()))
-          {
-            // create hit and insert in hitset
-            hit = new TrkrHitv2();
-
-            hit->addEnergy(hitenergy);
-            hitsetit->second->addHitSpecificKey(hitkey, hit);
-          }
-          else
+          if (masked)
           {
             continue;
           }
 
+          // create hit and insert in hitset
+          hit = new TrkrHitv2();
+          hit->addEnergy(hitenergy);
+          hitsetit->second->addHitSpecificKey(hitkey, hit);
+
           if (Verbosity() > 0)
           {
             std::cout << "Layer: " << layer << ", Stave: " << (uint16_t) MvtxDefs::getStaveId(hitsetkey) << ", Chip: " << (uint16_t) MvtxDefs::getChipId(hitsetkey) << ", Row: " << MvtxDefs::getRow(hitkey) << ", Col: " << MvtxDefs::getCol(hitkey) << ", Strobe: " << MvtxDefs::getStrobeId(hitsetkey) << ", added hit " << hitkey << " to hitset " << hitsetkey << " with energy " << hit->getEnergy() / TrkrDefs::MvtxEnergyScaleup << std::endl;
@@ -736,7 +757,7 @@ int PHG4MvtxHitReco::process_event(PHCompositeNode* topNode)
           // we set the strobe ID to zero in the hitsetkey
           // we use the findOrAdd method to keep from adding identical entries
           TrkrDefs::hitsetkey bare_hitsetkey = zero_strobe_bits(hitsetkey);
-          hitTruthAssoc->findOrAddAssoc(bare_hitsetkey, hitkey, g4hit_it->first);
+          hitTruthAssoc->findOrAddAssoc(bare_hitsetkey, hitkey, g4hit->get_hit_id());
         }
       }  // end loop over hit cells
     }    // end loop over g4hits for this layer
@@ -1360,5 +1381,8 @@ void PHG4MvtxHitReco::makePixelMask(hitMask& aMask, const std::string& dbName, c
     aMask.push_back({std::make_pair(DeadPixelHitKey, DeadHitKey)});
   }
 
+  // sorted, so that fired pixels can be looked up with a binary search
+  std::sort(aMask.begin(), aMask.end());
+
   delete cdbttree;
 }